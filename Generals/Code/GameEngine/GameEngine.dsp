@@ -621,6 +621,14 @@ SOURCE=.\Source\Common\Recorder.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\Common\ReplayBenchmark.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Common\SelfTest.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Common\SkirmishBattleHonors.cpp
 # End Source File
 # Begin Source File
@@ -672,6 +680,10 @@ SOURCE=.\Source\GameLogic\AI\AIPathfind.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\GameLogic\AI\AIPathfindWorkers.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\GameLogic\AI\AIPlayer.cpp
 # End Source File
 # Begin Source File
@@ -2437,6 +2449,10 @@ SOURCE=.\Source\GameNetwork\NetPacket.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\GameNetwork\NetPacketBenchmark.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\GameNetwork\Network.cpp
 # End Source File
 # Begin Source File
@@ -2727,6 +2743,10 @@ SOURCE=.\Include\Common\Handicap.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Include\Common\IDLookupTable.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Include\Common\IgnorePreferences.h
 # End Source File
 # Begin Source File
@@ -2883,6 +2903,14 @@ SOURCE=.\Include\Common\Recorder.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Include\Common\ReplayBenchmark.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Include\Common\SelfTest.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Include\Common\Registry.h
 # End Source File
 # Begin Source File
@@ -3823,6 +3851,10 @@ SOURCE=.\Include\GameLogic\AIPathfind.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Include\GameLogic\AIPathfindWorkers.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Include\GameLogic\AIPlayer.h
 # End Source File
 # Begin Source File
@@ -80,30 +80,24 @@ class ArchiveFile;
 	* openFile() member searches all Archive files for the specified sub file.
 	*/
 //===============================
-class ArchivedDirectoryInfo;
+class ArchivedFileLocation;
 class DetailedArchivedDirectoryInfo;
 class ArchivedFileInfo;
 
 typedef std::map<AsciiString, DetailedArchivedDirectoryInfo> DetailedArchivedDirectoryInfoMap;
-typedef std::map<AsciiString, ArchivedDirectoryInfo> ArchivedDirectoryInfoMap;
 typedef std::map<AsciiString, ArchivedFileInfo> ArchivedFileInfoMap;
 typedef std::map<AsciiString, ArchiveFile *> ArchiveFileMap;
-typedef std::map<AsciiString, AsciiString> ArchivedFileLocationMap; // first string is the file name, second one is the archive filename.
+typedef std::hash_map<AsciiString, ArchivedFileLocation, rts::hash<AsciiString>, rts::equal_to<AsciiString> > ArchivedFilePathIndex; // keyed on the normalized path, see ArchiveFileSystem::makePathKey
 
-class ArchivedDirectoryInfo 
+/** Where the file with a given normalized path lives. */
+class ArchivedFileLocation
 {
 public:
-	AsciiString								m_directoryName;
-	ArchivedDirectoryInfoMap	m_directories;
-	ArchivedFileLocationMap		m_files;
-
-	void clear()
-	{
-		m_directoryName.clear();
-		m_directories.clear();
-		m_files.clear();
-	}
+	AsciiString							m_archiveFilename;
+	ArchiveFile *						m_archiveFile;			///< NULL while the archive is closed
+	const ArchivedFileInfo *	m_fileInfo;					///< offset and size within m_archiveFile
 
+	ArchivedFileLocation() : m_archiveFile(NULL), m_fileInfo(NULL) { }
 };
 
 class DetailedArchivedDirectoryInfo 
@@ -176,10 +170,14 @@ class ArchiveFileSystem : public SubsystemInterface
 	void loadMods( void );
 
 protected:
-	virtual void					loadIntoDirectoryTree(const ArchiveFile *archiveFile, const AsciiString& archiveFilename, Bool overwrite = FALSE);	///< load the archive file's header information and apply it to the global archive directory tree.
+	virtual void					loadIntoDirectoryTree(ArchiveFile *archiveFile, const AsciiString& archiveFilename, Bool overwrite = FALSE);	///< load the archive file's header information and apply it to the global archive path index.
+	void									removeFromPathIndex(const ArchiveFile *archiveFile);	///< the archive is being closed; its files can no longer be opened
+
+	static Bool						makePathKey(const Char *filename, Char *key);	///< lowercase, '\\' separated form of filename, in a buffer of _MAX_PATH chars
+	const ArchivedFileLocation *findFileLocation(const Char *filename) const;
 
 	ArchiveFileMap m_archiveFileMap;
-	ArchivedDirectoryInfo m_rootDirectory;
+	ArchivedFilePathIndex m_pathIndex;
 };
 
 
@@ -54,6 +54,7 @@ public:
 		AudioEventRTS *m_pendingEvent;
 		AudioHandle m_handleToInteractOn;
 	};
+	const AudioEventInfo *m_eventInfo;	///< the pending event's info, looked up when the request is appended
 	Bool m_usePendingEvent;
 	Bool m_requiresCheckForSample;
 };
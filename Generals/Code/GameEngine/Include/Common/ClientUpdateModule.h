@@ -59,6 +59,11 @@ public:
 
 	virtual void clientUpdate() = 0;
 
+	/** The frame at which this module next has to run while its drawable is off camera.  Drawables
+		that are off camera and have nothing else in progress are not updated until one of their
+		modules wants to wake up.  The default of 0 means run every frame. */
+	virtual UnsignedInt getOffscreenWakeFrame() const { return 0; }
+
 };
 inline ClientUpdateModule::ClientUpdateModule( Thing *thing, const ModuleData* moduleData ) : DrawableModule( thing, moduleData ) { }
 inline ClientUpdateModule::~ClientUpdateModule() { }
@@ -80,6 +80,49 @@ enum
 	PROVIDER_ERROR = 0xFFFFFFFF
 };
 
+// Class AudioRequestQueue
+/**
+	The requests made of the audio device that haven't been carried out yet, in the order they 
+	were made. A removed request leaves a NULL hole that processRequests squeezes out later, so
+	the device can remove, count and append requests even while the queue is being processed.
+	Finished requests go on a free list and are handed out again, so posting a request doesn't 
+	need a new allocation once the game is running.
+*/
+class AudioRequestQueue
+{
+	public:
+		// The audio device's side of processRequests
+		class Processor
+		{
+			public:
+				virtual ~Processor() { }
+				virtual Bool shouldProcessRequestThisFrame( AudioRequest *req ) const = 0;
+				virtual void adjustRequest( AudioRequest *req ) = 0;	///< called instead, when it has to wait
+				virtual Bool checkForSample( AudioRequest *req ) = 0;
+				virtual void processRequest( AudioRequest *req ) = 0;
+		};
+
+		AudioRequestQueue();
+		~AudioRequestQueue();
+
+		AudioRequest *allocateRequest( Bool usePendingEvent );
+		void releaseRequest( AudioRequest *req );
+		void appendRequest( AudioRequest *req );
+		void removeRequest( Int index );		///< releases the request, leaving a hole
+		void processRequests( Processor *processor );
+
+		Int getSlotCount( void ) const { return (Int)m_requests.size(); }
+		AudioRequest *getRequest( Int index ) const { return m_requests[index]; }	///< NULL for a hole
+
+		// How many requests are waiting to play this event, by its pre-resolved info
+		Int countRequestsToPlay( const AudioEventInfo *eventInfo ) const;
+
+	private:
+		std::vector<AudioRequest*> m_requests;
+		std::vector<AudioRequest*> m_freeRequests;
+		Int m_processingIndex;		///< the slot processRequests is handling, or -1
+};
+
 // Class AudioManager
 /**
 	The life of audio.
@@ -324,7 +367,7 @@ class AudioManager : public SubsystemInterface
 		SoundManager *m_sound;
 		Coord3D m_listenerPosition;
 		Coord3D m_listenerOrientation;
-		std::list<AudioRequest*> m_audioRequests;
+		AudioRequestQueue m_audioRequests;
 		std::vector<AsciiString> m_musicTracks;
 
 		AudioEventInfoHash m_allAudioEventInfo;
@@ -60,6 +60,13 @@
 	#define MEMORYPOOL_DEBUG
 #endif
 
+// per-thread block magazines let most allocs/frees skip the pool critical section.
+// they are off in MEMORYPOOL_DEBUG builds, since parked blocks would throw off the
+// per-block leak, tag and checkpoint bookkeeping.
+#if !defined(MEMORYPOOL_DEBUG) && !defined(MEMORYPOOL_THREAD_MAGAZINES) && !defined(DISABLE_MEMORYPOOL_THREAD_MAGAZINES)
+	#define MEMORYPOOL_THREAD_MAGAZINES
+#endif
+
 // SYSTEM INCLUDES ////////////////////////////////////////////////////////////
 
 #include <new.h>
@@ -236,6 +243,51 @@ enum
 	MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS = 8	///< The max number of subpools allowed in a DynamicMemoryAllocator
 };
 
+// ----------------------------------------------------------------------------
+/**
+	Counters for how often the pool/dma critical sections are actually taken. In builds
+	with MEMORYPOOL_THREAD_MAGAZINES most allocs and frees are satisfied from the calling
+	thread's magazine and never touch the lock; the rest show up as lockedAllocs/lockedFrees.
+*/
+struct MemoryPoolLockStats
+{
+	Int magazineAllocs;						///< allocs satisfied from a thread magazine (no lock)
+	Int magazineFrees;						///< frees parked in a thread magazine (no lock)
+	Int lockedAllocs;							///< allocs that took the pool lock (refill, or no magazine available)
+	Int lockedFrees;							///< frees that took the pool lock (flush, or no magazine available)
+	Int dmaLocks;									///< times the dma lock was taken
+
+	void clear() { magazineAllocs = magazineFrees = lockedAllocs = lockedFrees = dmaLocks = 0; }
+	void add(const MemoryPoolLockStats& that) 
+	{ 
+		magazineAllocs += that.magazineAllocs; magazineFrees += that.magazineFrees;
+		lockedAllocs += that.lockedAllocs; lockedFrees += that.lockedFrees; dmaLocks += that.dmaLocks;
+	}
+};
+
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+enum
+{
+	MAX_MEMORYPOOL_MAGAZINE_THREADS = 8,		///< threads beyond this many always use the locked path
+	MEMORYPOOL_MAGAZINE_SIZE = 16,					///< blocks a thread may park per pool
+	MEMORYPOOL_MAGAZINE_BATCH = 8						///< blocks moved per refill/flush
+};
+
+// ----------------------------------------------------------------------------
+/**
+	A small stack of free blocks owned by a single thread. Only the owning thread ever
+	touches it, so it needs no locking. Blocks parked here are still counted as used
+	by their blobs; they are moved to and from the blobs in batches, under the pool lock.
+*/
+struct MemoryPoolMagazine
+{
+	Int										m_count;
+	Int										m_allocs;
+	Int										m_frees;
+	MemoryPoolSingleBlock	*m_blocks[MEMORYPOOL_MAGAZINE_SIZE];
+};
+#endif
+
 #ifdef MEMORYPOOL_CHECKPOINTING
 // ----------------------------------------------------------------------------
 /**
@@ -296,11 +348,34 @@ private:
 	MemoryPoolBlob		*m_firstBlob;								///< head of linked list: first blob for this pool.
 	MemoryPoolBlob		*m_lastBlob;								///< tail of linked list: last blob for this pool. (needed for efficiency)
 	MemoryPoolBlob		*m_firstBlobWithFreeBlocks;	///< first blob in this pool that has at least one unallocated block.
+	Int								m_lockedAllocs;							///< allocs that had to take the pool lock
+	Int								m_lockedFrees;							///< frees that had to take the pool lock
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	MemoryPoolMagazine	m_magazines[MAX_MEMORYPOOL_MAGAZINE_THREADS];	///< per-thread free block caches
+#endif
 
 private:
 	/// create a new blob with the given number of blocks.
 	MemoryPoolBlob* createBlob(Int allocationCount);
 
+	/// take a block from the blobs. the caller must hold the pool lock.
+	MemoryPoolSingleBlock *allocateBlockFromBlobs(DECLARE_LITERALSTRING_ARG1);
+
+	/// return a block to its blob. the caller must hold the pool lock.
+	void freeBlockToBlobs(MemoryPoolSingleBlock *block);
+
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	/// discard the contents of every thread's magazine. only for use when the blobs are being thrown away.
+	void discardMagazines();
+#endif
+
+public:
+
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	/// return everything parked in the given magazine slot to the blobs. the caller must hold the pool lock.
+	void drainMagazine(Int slot);
+#endif
+
 	/// destroy a blob.
 	Int freeBlob(MemoryPoolBlob *blob);
 
@@ -364,6 +439,9 @@ public:
 
 	Int countBlobsInPool();
 
+	/// add this pool's lock/magazine counters to stats.
+	void getLockStats(MemoryPoolLockStats& stats);
+
 	/// if this pool has any empty blobs, return them to the system.
 	Int releaseEmpties();
 
@@ -394,6 +472,7 @@ private:
 	DynamicMemoryAllocator		*m_nextDmaInFactory;	///< linked list node, managed by factory
 	Int												m_numPools;						///< number of subpools (up to MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS)
 	Int												m_usedBlocksInDma;		///< total number of blocks allocated, from subpools and "raw"
+	Int												m_dmaLocks;						///< number of times the dma lock was taken
 	MemoryPool								*m_pools[MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS];	///< the subpools
 	MemoryPoolSingleBlock			*m_rawBlocks;					///< linked list of "raw" blocks allocated directly from system
 
@@ -452,6 +531,9 @@ public:
 	/// destroy all allocations performed by this DMA.
 	void reset();
 
+	/// return the number of times the dma lock was taken.
+	Int getDmaLockCount() const { return m_dmaLocks; }
+
 	Int getDmaMemoryPoolCount() const { return m_numPools; }
 	MemoryPool* getNthDmaMemoryPool(Int i) const { return m_pools[i]; }
 
@@ -537,6 +619,12 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = NULL );
 
+	/// sum the lock/magazine counters of every pool and dma. the values are approximate while other threads are allocating.
+	void getLockStats(MemoryPoolLockStats& stats);
+
+	/// return the given magazine slot's blocks to every pool. the caller must hold the pool lock.
+	void drainThreadMagazines(Int slot);
+
 	#ifdef MEMORYPOOL_DEBUG
 
 		/// perform internal consistency checking
@@ -829,6 +917,14 @@ extern Bool isMemoryManagerOfficiallyInited();
 */
 extern void shutdownMemoryManager();
 
+/**
+	Give up the calling thread's magazine slot, returning any blocks it has cached to their
+	pools. Threads the engine creates should call this just before they exit; slots held
+	by threads that exit without calling it are reclaimed lazily once all slots are taken.
+	It is harmless to call this from a thread that never had a slot.
+*/
+extern void releaseThreadMemoryPoolMagazines();
+
 extern MemoryPoolFactory *TheMemoryPoolFactory;
 extern DynamicMemoryAllocator *TheDynamicMemoryAllocator;
 
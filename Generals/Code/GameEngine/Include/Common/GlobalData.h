@@ -316,6 +316,12 @@ public:
 	Real m_cameraAdjustSpeed;					///< Rate at which we adjust camera height
 	Bool m_enforceMaxCameraHeight;		///< Enfoce max camera height while scrolling?
 	Bool m_buildMapCache;
+	Bool m_replayBenchmark;						///< play m_initialFile as fast as possible, report timing and CRC, then quit
+	Bool m_selfTest;									///< run the registered self tests (see SelfTest.h) once the engine is up, then quit
+	Int m_pathfindBenchmarkPaths;			///< if nonzero, the replay benchmark also times this many ground paths on the final map
+	Int m_pathfindBenchmarkThreads;		///< most pathfind workers the benchmark times, 0 = one per processor
+	Int m_frameDataBenchmarkCommands;	///< if nonzero, the replay benchmark also times network frame data at about this many commands per player per frame
+	Int m_netPacketBenchmarkCommands;	///< if nonzero, the replay benchmark also times encoding and decoding this many game commands
 	AsciiString m_initialFile;				///< If this is specified, load a specific map/replay from the command-line
 	AsciiString m_pendingFile;				///< If this is specified, use this map at the next game start
 
@@ -0,0 +1,181 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// FILE: IDLookupTable.h //////////////////////////////////////////////////////
+// Open-addressed ObjectID/DrawableID -> pointer table.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef __IDLOOKUPTABLE_H_
+#define __IDLOOKUPTABLE_H_
+
+#include "Lib/BaseType.h"
+#include "Common/Debug.h"
+#include "Common/GameMemory.h"
+
+//-----------------------------------------------------------------------------
+/**
+	Maps ObjectIDs or DrawableIDs to the things they name. IDs are handed out in
+	increasing order and never reused, which keeps them stable for saved games and
+	the network, so the table doesn't try to pick them; it just uses the low bits of
+	an ID as its slot and keeps the whole ID in the slot to tell this thing from
+	an older or newer one that landed in the same place (the high bits work like a
+	generation count). A slot is 8 bytes and consecutive IDs land in consecutive
+	slots, so a lookup is usually one cache line.
+
+	Collisions probe forward, and removal shifts the rest of the run back so there
+	are no tombstones. The table doubles when it is half full and halves when it is
+	an eighth full, so its size follows the number of live things rather than the
+	highest ID ever handed out.
+
+	ID 0 is the invalid ID for both ObjectID and DrawableID, and marks an empty slot.
+*/
+template <class T>
+class IDLookupTable
+{
+public:
+
+	IDLookupTable( void ) : m_slots(NULL), m_mask(0), m_count(0) { }
+	~IDLookupTable( void ) { delete [] m_slots; }
+
+	/// return the thing with this ID, or NULL
+	T *find( UnsignedInt id ) const
+	{
+		if (m_slots == NULL || id == 0)
+			return NULL;
+		for (UnsignedInt i = id & m_mask; ; i = (i + 1) & m_mask)
+		{
+			const Slot &slot = m_slots[i];
+			if (slot.m_id == id)
+				return slot.m_thing;
+			if (slot.m_id == 0)
+				return NULL;
+		}
+	}
+
+	/// add thing under id, replacing whatever was there
+	void insert( UnsignedInt id, T *thing )
+	{
+		DEBUG_ASSERTCRASH(id != 0, ("IDLookupTable: can't insert the invalid ID"));
+		if (id == 0)
+			return;
+		if ((m_count + 1) * 2 > capacity())
+			resize(capacity() ? capacity() * 2 : MIN_CAPACITY);
+
+		UnsignedInt i = id & m_mask;
+		while (m_slots[i].m_id != 0 && m_slots[i].m_id != id)
+			i = (i + 1) & m_mask;
+		if (m_slots[i].m_id == 0)
+			++m_count;
+		m_slots[i].m_id = id;
+		m_slots[i].m_thing = thing;
+	}
+
+	/// remove id, if it's there
+	void remove( UnsignedInt id )
+	{
+		if (m_slots == NULL || id == 0)
+			return;
+
+		UnsignedInt i = id & m_mask;
+		while (m_slots[i].m_id != id)
+		{
+			if (m_slots[i].m_id == 0)
+				return;
+			i = (i + 1) & m_mask;
+		}
+
+		// pull back any later entry of this run that may no longer be found past the hole
+		for (UnsignedInt j = (i + 1) & m_mask; m_slots[j].m_id != 0; j = (j + 1) & m_mask)
+		{
+			UnsignedInt home = m_slots[j].m_id & m_mask;
+			Bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+			if (stays)
+				continue;
+			m_slots[i] = m_slots[j];
+			i = j;
+		}
+		m_slots[i].m_id = 0;
+		m_slots[i].m_thing = NULL;
+		--m_count;
+
+		if (capacity() > MIN_CAPACITY && m_count * 8 < capacity())
+			resize(capacity() / 2);
+	}
+
+	/// remove everything, and give back the memory
+	void clear( void )
+	{
+		delete [] m_slots;
+		m_slots = NULL;
+		m_mask = 0;
+		m_count = 0;
+	}
+
+	Int size( void ) const { return (Int)m_count; }
+
+private:
+
+	enum { MIN_CAPACITY = 1024 };
+
+	struct Slot
+	{
+		UnsignedInt		m_id;
+		T *						m_thing;
+	};
+
+	UnsignedInt capacity( void ) const { return m_slots ? m_mask + 1 : 0; }
+
+	void resize( UnsignedInt newCapacity )
+	{
+		Slot *oldSlots = m_slots;
+		UnsignedInt oldCapacity = capacity();
+
+		m_slots = NEW Slot[newCapacity];
+		m_mask = newCapacity - 1;
+		UnsignedInt i;
+		for (i = 0; i < newCapacity; ++i)
+		{
+			m_slots[i].m_id = 0;
+			m_slots[i].m_thing = NULL;
+		}
+
+		for (i = 0; i < oldCapacity; ++i)
+		{
+			if (oldSlots[i].m_id == 0)
+				continue;
+			UnsignedInt j = oldSlots[i].m_id & m_mask;
+			while (m_slots[j].m_id != 0)
+				j = (j + 1) & m_mask;
+			m_slots[j] = oldSlots[i];
+		}
+		delete [] oldSlots;
+	}
+
+	Slot *				m_slots;
+	UnsignedInt		m_mask;
+	UnsignedInt		m_count;
+
+	// not implemented
+	IDLookupTable( const IDLookupTable & );
+	IDLookupTable & operator=( const IDLookupTable & );
+};
+
+#endif // __IDLOOKUPTABLE_H_
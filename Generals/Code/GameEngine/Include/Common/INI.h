@@ -386,9 +386,12 @@ protected:
 	void unPrepFile();
 
 	void readLine( void );
+	void splitLines( const char *source, Int sourceSize );	///< fill m_lineStorage with what readLine returns
 
 //	FILE *m_file;															///< file pointer of file currently loading
-	File *m_file;															///< file pointer of file currently loading
+	std::vector<char> m_lineStorage;					///< lines of the current file, each '\0' terminated
+	const char *m_nextLine;										///< next line of the current file, '\0' terminated
+	Int m_linesLeft;													///< lines of the current file not yet read
 	AsciiString m_filename;										///< filename of file currently loading
 	INILoadType m_loadType;										///< load time for current file
 	UnsignedInt m_lineNum;										///< current line number that's been read
@@ -56,6 +56,9 @@
 #define K_LIGHTING_VERSION_3	3	// Added 2 additional global lights for terrain.
 #define K_WORLDDICT_VERSION_1 1
 #define K_MAPPREVIEW_VERSION_1 1
+
+class File;
+
 /** Virtual helper class, so that we can write map data using FILE* or CFile. */
 class OutputStream {
 public:
@@ -84,7 +87,9 @@ class CachedFileInputStream : public ChunkInputStream
 {
 protected:
 	int m_size;
-	char* m_buffer;
+	char* m_buffer;				///< data we own, NULL when reading straight out of m_file
+	const char* m_data;		///< what we read from; either m_buffer or m_file's own data
+	File* m_file;					///< kept open while m_data points into it
 	int m_pos;
 public:
 	CachedFileInputStream(void);
@@ -96,6 +101,8 @@ public:
 	virtual Bool absoluteSeek(UnsignedInt pos);
 	virtual Bool eof(void);
 	void rewind(void);
+protected:
+	void releaseSource(void);	///< drop m_buffer and m_file, whichever we hold
 };
 
 /** An instance of InputStream that uses a FILE* to read data. */
@@ -113,6 +113,7 @@ public:
 	static void termPerfDump();
 	static void dumpAll(UnsignedInt frame);
 	static void displayGraph(UnsignedInt frame);
+	static void dumpTotals(FILE *fp);	///< one line per timer: gross ms, net ms, calls since the last resetAll
 
 	void reset();
 
@@ -380,6 +380,22 @@ public:
 	*/
 	void becomingTeamMember(Object *obj, Bool yes);
 
+	/// the states an object can be counted under in our object counts
+	enum ObjectCountState
+	{
+		OBJECT_COUNT_DEAD									= (1 << 0),		///< effectively dead
+		OBJECT_COUNT_DESTROYED						= (1 << 1),		///< destroyed, but not deleted yet
+		OBJECT_COUNT_UNDER_CONSTRUCTION		= (1 << 2),		///< still being built
+
+		OBJECT_COUNT_STATE_COUNT					= (1 << 3)		///< number of combinations of the above
+	};
+
+	/**
+		add (or remove, with a negative delta) an object of the given template and ObjectCountState
+		to our object counts. Only Object should call this, as its team or state changes.
+	*/
+	void friend_adjustObjectCount(const ThingTemplate *tmpl, UnsignedInt countState, Int delta);
+
 	/**
 		this is called when the player becomes the local player (yes==true)
 		or ceases to be the local player (yes==false). you can't stop this
@@ -443,8 +459,8 @@ public:
 	/**
 		a convenience routine to count the number of owned objects that match a set of ThingTemplates.
 		You input the count and an array of ThingTemplate*, and provide an array of Int of the same
-		size. It fills in the array to the correct counts. This is handy because we must traverse
-		the player's list-of-objects only once.
+		size. It fills in the array to the correct counts. This answers from our object counts, so
+		it only looks at the templates we own, not at every object.
 	*/
 	void countObjectsByThingTemplate(Int numTmplates, const ThingTemplate* const * things, Bool ignoreDead, Int *counts, Bool ignoreUnderConstruction = TRUE ) const;
 
@@ -696,6 +712,8 @@ protected:
 	virtual void loadPostProcess( void );
 	
 	void deleteUpgradeList( void );															///< delete all our upgrades
+	void resetObjectCounts( void );															///< forget all our object counts
+	const std::vector<NameKeyType>& getEquivalenceKeys( const ThingTemplate *tmpl ) const;	///< see m_equivalenceKeys
 
 private:
 
@@ -746,6 +764,32 @@ private:
 	UnicodeString				m_generalName;		///< (SAVE) This is the name of the general the player is allowed to change.
 	
 	PlayerTeamList				m_playerTeamPrototypes;				///< ALL the teams we control, via prototype
+
+	/// how many objects of one template we have, in each ObjectCountState
+	struct TemplateObjectCount
+	{
+		Int m_total;
+		Int m_count[OBJECT_COUNT_STATE_COUNT];
+		std::vector<KindOfType> m_kindOfBits;		///< the KindOf bits the template has, so adjusting the counts doesn't test them all
+
+		TemplateObjectCount() : m_total(0)
+		{
+			for (Int i = 0; i < OBJECT_COUNT_STATE_COUNT; ++i)
+				m_count[i] = 0;
+		}
+
+		/// the ones that are neither effectively dead nor destroyed
+		Int getLiveCount() const { return m_count[0] + m_count[OBJECT_COUNT_UNDER_CONSTRUCTION]; }
+	};
+	typedef std::map< const ThingTemplate*, TemplateObjectCount, std::less<const ThingTemplate*> > ObjectCountMap;
+	typedef std::multimap< NameKeyType, ObjectCountMap::const_iterator, std::less<NameKeyType> > EquivalenceIndex;
+	typedef std::map< const ThingTemplate*, std::vector<NameKeyType>, std::less<const ThingTemplate*> > EquivalenceKeyMap;
+
+	ObjectCountMap				m_objectCounts;								///< (NO-SAVE) the objects on all our teams, by template. Templates stay in here, at zero, until reset. Objects refile themselves on load.
+	EquivalenceIndex			m_equivalenceIndex;						///< (NO-SAVE) m_objectCounts, filed under each of its templates' equivalence keys
+	mutable EquivalenceKeyMap	m_equivalenceKeys;				///< (NO-SAVE) lowercased names any template isEquivalentTo a given one shares with it: its own, what it was reskinned from, its build variations
+	Int										m_kindOfCounts[KINDOF_COUNT];			///< (NO-SAVE) the objects on all our teams, by KindOf bit
+	Int										m_liveKindOfCounts[KINDOF_COUNT];	///< (NO-SAVE) as above, leaving out the dead and destroyed
 	PlayerRelationMap			*m_playerRelations;						///< allies & enemies
 	TeamRelationMap				*m_teamRelations;							///< allies & enemies
 
@@ -80,6 +80,7 @@ class RAMFile : public File
 		Char				*m_data;											///< File data in memory
 		Int					m_pos;												///< current read position
 		Int					m_size;												///< size of file in memory
+		Bool				m_ownsData;										///< FALSE when m_data is a view of memory owned by someone else (a mapped archive)
 		
 	public:
 		
@@ -100,6 +101,7 @@ class RAMFile : public File
 
 		virtual Bool	open( File *file );																	///< Open file for fast RAM access
 		virtual Bool	openFromArchive(File *archiveFile, const AsciiString& filename, Int offset, Int size); ///< copy file data from the given file at the given offset for the given size.
+		virtual Bool	openFromMemory(const Char *data, const AsciiString& filename, Int size); ///< read only view of data, which must outlive this file; nothing is copied.
 		virtual Bool	copyDataToFile(File *localFile);										///< write the contents of the RAM file to the given local file.  This could be REALLY slow.
 
 		/**
@@ -111,6 +113,10 @@ class RAMFile : public File
 		*/
 		virtual char* readEntireAndClose();
 		virtual File* convertToRAMFile();
+		virtual const Char* peekData( void );
+
+	protected:
+		void					freeData( void );																		///< release m_data, deleting it only if we own it
 };
 
 
@@ -107,6 +107,7 @@ public:
 	Bool readReplayHeader( ReplayHeader& header );
 
 	RecorderModeType getMode();												///< Returns the current operating mode.
+	Bool isPlaybackInProgress( void ) { return m_mode == RECORDERMODETYPE_PLAYBACK && m_nextFrame != (UnsignedInt)-1; }	///< playing back and not yet out of commands
 	void initControls();															///< Show or Hide the Replay controls
 
 	AsciiString getReplayDir();												///< Returns the directory that holds the replay files.
@@ -0,0 +1,65 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// FILE: ReplayBenchmark.h ////////////////////////////////////////////////////
+// Times a replay played back with drawing, audio and the frame-rate cap off,
+// and reports logic throughput and the final CRC.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef __REPLAYBENCHMARK_H_
+#define __REPLAYBENCHMARK_H_
+
+#include "Lib/BaseType.h"
+
+//-----------------------------------------------------------------------------
+/**
+	Drives "-replayBenchmark <file.rep>". GameEngine::execute calls update() once per
+	engine frame. Timing starts on the first frame the replay is in game, and stops
+	on the frame the recorder runs out of commands, at which point the frame count,
+	frames/sec, the PerfGather totals (in PERF_TIMERS builds) and
+	GameLogic::getCRC are written to ReplayBenchmark.txt and the debug log, and the
+	engine is told to quit. With "-pathfindBenchmark <n>" it then also times n ground
+	paths on the final map (Pathfinder::runStressBenchmark): paths/sec for findGroundPath
+	one at a time, and for the same searches on a map snapshot with 1..N workers, where N
+	is "-pathfindBenchmarkThreads <n>" or else one per processor. With "-frameDataBenchmark <n>"
+	it also feeds an 8 player stream of about n commands per player per frame through the
+	network frame data (FrameDataManager::runStressBenchmark). With "-netPacketBenchmark <n>"
+	it encodes and decodes n game commands with NetPacket and with the old GameMessageParser
+	encoding (NetPacket::runCodecBenchmark).
+*/
+class ReplayBenchmark
+{
+public:
+	ReplayBenchmark( void );
+
+	void update( void );										///< call once per engine frame, after GameEngine::update
+	Bool isDone( void ) const { return m_done; }
+
+private:
+	void finish( void );
+
+	Bool				m_started;
+	Bool				m_done;
+	UnsignedInt	m_startFrame;
+	UnsignedInt	m_startTime;
+};
+
+#endif // __REPLAYBENCHMARK_H_
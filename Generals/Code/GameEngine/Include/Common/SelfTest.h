@@ -0,0 +1,61 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// FILE: SelfTest.h ///////////////////////////////////////////////////////////
+// Checks of engine internals that run inside a fully initialized engine.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef __SELFTEST_H_
+#define __SELFTEST_H_
+
+#include "Lib/BaseType.h"
+
+class AsciiString;
+
+/// a self test returns FALSE, and says what went wrong in failure, if it fails
+typedef Bool (*SelfTestProc)( AsciiString *failure );
+
+//-----------------------------------------------------------------------------
+/**
+	Adds a test to the list "-selfTest" runs. Declare one at file scope next to the
+	code the test covers, e.g.
+
+		static SelfTestRegistration theFooSelfTest( "Foo", fooSelfTest );
+
+	Registration happens during static construction, so it must not allocate.
+*/
+class SelfTestRegistration
+{
+public:
+	SelfTestRegistration( const char *name, SelfTestProc proc );
+};
+
+//-----------------------------------------------------------------------------
+/**
+	Drives "-selfTest". GameEngine::execute calls this once, after the engine is
+	initialized and before the first frame. Every registered test is run in
+	order, the results go to SelfTest.txt and the debug log, and the engine is
+	told to quit. Returns the number of tests that failed.
+*/
+extern Int runSelfTests( void );
+
+#endif // __SELFTEST_H_
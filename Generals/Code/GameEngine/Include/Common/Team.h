@@ -309,7 +309,7 @@ public:
 	/** 
 		Set the team as active.  A team is considered created when set active.
 	*/
-	void setActive(void) {if (!m_active) { m_created = true;m_active = true;}}
+	void setActive(void);
 
 	/** 
 		Is this team active?
@@ -358,6 +358,7 @@ public:
 
 	*/
 	Relationship getRelationship(const Team *that) const;
+	Bool hasRelationshipOverrides() const;		///< true if this team overrides any of its player's relationships
 
 	/**
 		set a special relationship between this team and that team, that overrides
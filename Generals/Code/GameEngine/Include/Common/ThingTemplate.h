@@ -589,6 +589,7 @@ public:
 	void setCopiedFromDefault();
 
 	void setReskinnedFrom(const ThingTemplate* tt) { DEBUG_ASSERTCRASH(m_reskinnedFrom == NULL, ("should be null")); m_reskinnedFrom = tt; }
+	const ThingTemplate* getReskinnedFrom() const { return m_reskinnedFrom; }	///< NULL if we weren't generated via a reskin
 
 	Bool isPrerequisite() const { return m_isPrerequisite; }
 
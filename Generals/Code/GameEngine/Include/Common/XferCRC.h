@@ -60,6 +60,8 @@ public:
 	// Xfer CRC methods
 	virtual UnsignedInt getCRC( void );										///< get computed CRC in network byte order
 
+	void addCRCWords( const UnsignedInt *words, Int count );			///< CRC a run of 4-byte blocks, exactly as addCRC on each in turn
+
 protected:
 
 	virtual void xferImplementation( void *data, Int dataSize );
@@ -156,6 +156,7 @@ class File : public MemoryPoolObject
 		virtual Bool	print ( const Char *format, ...);										///< Prints formated string to text file
 		virtual Int		size( void );																				///< Returns the size of the file
 		virtual Int		position( void );																		///< Returns the current read/write position
+		virtual const Char*	peekData( void );															///< Returns the whole file's contents if they are already in memory (read only, owned by the file), else NULL
 
 
 		void					setName( const char *name );												///< Set the name of the file
@@ -175,6 +175,7 @@ public:
 	void release(void) { m_envState = ENVELOPE_STATE_DECAY; }
 	void rest(void)    { m_envState = ENVELOPE_STATE_REST; } // goes away now!
 	Bool isEffective() const { return m_affect; }
+	Bool isResting() const { return m_envState == ENVELOPE_STATE_REST && !m_affect; }	///< update() has nothing left to do
 	const Vector3* getColor() const { return &m_currentColor; }
 
 protected:
@@ -289,6 +290,9 @@ public:
 
 	Drawable *getNextDrawable( void ) const { return m_nextDrawable; }	///< return the next drawable in the global list
 	Drawable *getPrevDrawable( void ) const { return m_prevDrawable; }  ///< return the prev drawable in the global list
+	Drawable *getNextGridDrawable( void ) const { return m_nextGridDrawable; }	///< return the next drawable in our client grid bucket
+	Int getGridBucket( void ) const { return m_gridBucket; }						///< client grid bucket we are in, -1 if none
+	UnsignedInt getListOrder( void ) const { return m_listOrder; }			///< higher means nearer the head of the global list
 	DrawableID getID( void ) const;																			///< return this drawable's unique ID
 
 	void friend_bindToObject( Object *obj ); ///< bind this drawable to an object ID. for use ONLY by GameLogic!
@@ -402,6 +406,9 @@ public:
 
 	void prependToList(Drawable **pListHead);
 	void removeFromList(Drawable **pListHead);
+	void prependToGridList(Drawable **pListHead, Int bucket);	///< for use ONLY by the GameClient drawable grid
+	void removeFromGridList(Drawable **pListHead);							///< for use ONLY by the GameClient drawable grid
+	void setListOrder( UnsignedInt order ) { m_listOrder = order; }	///< for use ONLY by GameClient::registerDrawable
 	void setID( DrawableID id );											///< set this drawable's unique ID
 
 	inline const ModelConditionFlags& getModelConditionFlags( void ) const { return m_conditionState; }
@@ -523,6 +530,7 @@ public:
 	void preloadAssets( TimeOfDay timeOfDay );	///< preload the assets
 	
 	Bool isVisible();											///< for limiting tree sway, etc to visible objects
+	Bool needsClientUpdate( void );				///< FALSE if updateDrawable() has nothing to do this frame
 
 	Bool getShouldAnimate( Bool considerPower ) const;
 
@@ -624,6 +632,10 @@ private:
 	DrawableID m_id;						///< this drawable's unique ID
 	Drawable *m_nextDrawable; 
 	Drawable *m_prevDrawable;		///< list links
+	Drawable *m_nextGridDrawable;
+	Drawable *m_prevGridDrawable;	///< client grid bucket links
+	Int m_gridBucket;						///< client grid bucket we are linked into, -1 if none
+	UnsignedInt m_listOrder;		///< when we were put on the global list, see getListOrder()
 
 	UnsignedInt m_status;				///< status bits (see DrawableStatus enum)
 	UnsignedInt m_tintStatus;				///< tint color status bits (see TintStatus enum)
@@ -32,6 +32,7 @@
 #define _GAME_INTERFACE_H_
 
 #include "common/GameType.h"
+#include "Common/IDLookupTable.h"
 #include "Common/MessageStream.h"		// for GameMessageTranslator
 #include "Common/Snapshot.h"
 #include "Common/STLTypedefs.h"
@@ -57,8 +58,7 @@ struct RayEffectData;
 
 /// Function pointers for use by GameClient callback functions.
 typedef void (*GameClientFuncPtr)( Drawable *draw, void *userData ); 
-typedef std::hash_map<DrawableID, Drawable *, rts::hash<DrawableID>, rts::equal_to<DrawableID> > DrawablePtrHash;
-typedef DrawablePtrHash::iterator DrawablePtrHashIt;
+typedef IDLookupTable<Drawable> DrawablePtrHash;
 
 //-----------------------------------------------------------------------------
 /** The Client message dispatcher, this is the last "translator" on the message
@@ -122,6 +122,9 @@ public:
 
 	virtual void iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr userFunc, void *userData );		///< Calls userFunc for each drawable contained within the region
 
+	void updateDrawableInGrid( Drawable *draw );												///< move a drawable to the grid bucket for its current position
+	void getDrawableHeightRange( Real *loZ, Real *hiZ ) const;					///< z range every drawable has been in since the last reset
+
 	virtual Drawable *friend_createDrawable( const ThingTemplate *thing, DrawableStatus statusBits = DRAWABLE_STATUS_NONE ) = 0;
 	virtual void destroyDrawable( Drawable *draw );											///< Destroy the given drawable
 
@@ -147,6 +150,9 @@ public:
 	UnsignedInt getRenderedObjectCount() const { return m_renderedObjectCount; }
 	void incrementRenderedObjectCount() { m_renderedObjectCount++; }
 
+	UnsignedInt getUpdatedDrawableCount() const { return m_updatedDrawableCount; }	///< drawables that ran updateDrawable() last client frame
+	UnsignedInt getSkippedDrawableCount() const { return m_skippedDrawableCount; }	///< drawables that were asleep last client frame
+
 protected:
 
 	// snapshot methods
@@ -158,6 +164,40 @@ protected:
 	UnsignedInt m_frame;																				///< Simulation frame number from server
 
 	Drawable *m_drawableList;																		///< All of the drawables in the world
+
+	//
+	// drawables are also bucketed by xy position in a uniform grid so that region queries only
+	// look at what is nearby.  The grid wraps around in both directions, so any world position
+	// has a bucket and a query spanning fewer than DRAWABLE_GRID_DIM cells never hits one twice
+	//
+	enum
+	{
+		DRAWABLE_GRID_SHIFT = 6,
+		DRAWABLE_GRID_DIM = 1 << DRAWABLE_GRID_SHIFT,
+		DRAWABLE_GRID_MASK = DRAWABLE_GRID_DIM - 1,
+		DRAWABLE_GRID_BUCKETS = DRAWABLE_GRID_DIM * DRAWABLE_GRID_DIM
+	};
+	Drawable *m_drawableGrid[ DRAWABLE_GRID_BUCKETS ];					///< drawables bucketed by xy position
+	Real m_drawableGridLoZ;																			///< lowest z any drawable has been at since reset
+	Real m_drawableGridHiZ;																			///< highest z any drawable has been at since reset
+
+	static Int getDrawableGridBucket( const Coord3D *pos );
+	static void getDrawableGridCellRange( Real lo, Real hi, Int *cellLo, Int *cellHi );
+	void addDrawableToGrid( Drawable *draw );
+	void removeDrawableFromGrid( Drawable *draw );
+	void clearDrawableGrid( void );
+
+	/// a drawable found by a region query.  Held by id so the callbacks are free to move or destroy drawables
+	struct RegionDrawable
+	{
+		UnsignedInt listOrder;
+		DrawableID id;
+	};
+	typedef std::vector< RegionDrawable > RegionDrawableVector;
+	static Bool isEarlierInDrawableList( const RegionDrawable &a, const RegionDrawable &b );
+	RegionDrawableVector m_regionDrawables;											///< scratch for the outermost iterateDrawablesInRegion
+	Int m_regionIterationDepth;																	///< how many iterateDrawablesInRegion calls are running
+	UnsignedInt m_nextDrawableListOrder;												///< stamp for the next drawable put on m_drawableList
 	DrawablePtrHash m_drawableHash;															///< Used for DrawableID lookups
 
 	DrawableID m_nextDrawableID;																///< For allocating drawable id's
@@ -171,6 +211,8 @@ protected:
 private:
 
 	UnsignedInt m_renderedObjectCount;													///< Keeps track of the number of rendered objects -- resets each frame.
+	UnsignedInt m_updatedDrawableCount;													///< drawables updated during the last client frame
+	UnsignedInt m_skippedDrawableCount;													///< drawables skipped as asleep during the last client frame
 
 	//---------------------------------------------------------------------------
 
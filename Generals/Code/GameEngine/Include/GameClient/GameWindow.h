@@ -409,6 +409,8 @@ protected:
 	GameWindow *m_parent;				// Window which contains this window
 	GameWindow *m_child;			  // List of windows within this window
 
+	Int m_idIndexSlot;					///< where we are in the window manager's id index bucket, -1 if not indexed
+
 	//
 	// the following are for "layout screens" and ONLY apply to root/parent
 	// windows in a layout, any children of a window that is part of a layout
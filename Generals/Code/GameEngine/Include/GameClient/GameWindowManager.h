@@ -35,6 +35,7 @@
 #define __GAMEWINDOWMANAGER_H_
 
 
+#include "Common/NameKeyGenerator.h"
 #include "Common/STLTypedefs.h"
 #include "Common/SubsystemInterface.h"
 #include "GameClient/WindowLayout.h"
@@ -52,6 +53,8 @@ class GameWindow;
 enum { MAX_LAYOUT_FUNC_LEN = 256 };
 
 typedef std::list <GameWindow *> GameWindowList;
+typedef std::vector <GameWindow *> GameWindowVector;
+typedef std::hash_map< Int, GameWindowVector, std::hash<Int>, std::equal_to<Int> > GameWindowIdMap;
 
 class WindowLayoutInfo
 {
@@ -69,6 +72,33 @@ public:
 	std::list<GameWindow *> windows;						///< list of top-level windows in the layout
 };
 
+//-------------------------------------------------------------------------------------------------
+/** Code that looks up the same named window over and over (every frame, say) can keep one
+	* of these instead of calling nameToKey() and winGetWindowFromId() each time.  The name
+	* is turned into an id the first time it is used, and the window found is remembered until
+	* windows are created, destroyed, moved around or renamed.  The name must be a string
+	* literal (or otherwise outlive the handle) */
+//-------------------------------------------------------------------------------------------------
+class GameWindowHandle
+{
+
+friend class GameWindowManager;
+
+public:
+
+	GameWindowHandle( const char *name ) : m_name( name ), m_id( NAMEKEY_INVALID ), 
+		m_parent( NULL ), m_window( NULL ), m_treeGeneration( 0 ) { }
+
+protected:
+
+	const char *m_name;						///< full name of the window, e.g. "ControlBar.wnd:ControlBarParent"
+	NameKeyType m_id;							///< id for m_name, once looked up
+	GameWindow *m_parent;					///< window the last search started from
+	GameWindow *m_window;					///< result of the last search
+	UnsignedInt m_treeGeneration;	///< window tree generation of the last search
+
+};
+
 //-------------------------------------------------------------------------------------------------
 /** There exists a singleton GameWindowManager that defines how we can 
 	* interact with the game windowing system */
@@ -273,6 +303,8 @@ public:
 	down the heirarchy.  If 'window' is NULL then all windows will
 	be searched */ 
 	virtual GameWindow *winGetWindowFromId( GameWindow *window, Int id );
+	/// get the window a handle names, searching like winGetWindowFromId() but only when something changed
+	virtual GameWindow *winGetWindowFromHandle( GameWindowHandle &handle, GameWindow *window = NULL );
 	virtual Int winCapture( GameWindow *window );  ///< captures the mouse
 	virtual Int winRelease( GameWindow *window );  ///< release mouse capture
 	virtual GameWindow *winGetCapture( void );  ///< current mouse capture settings
@@ -336,6 +368,12 @@ protected:
 
 	void processDestroyList( void );  ///< process windows waiting to be killed
 
+	void addWindowToIdIndex( GameWindow *window );  ///< make window findable by its id
+	void removeWindowFromIdIndex( GameWindow *window, Int id );  ///< take window out of the bucket for id, if it's in it
+	void windowIdChanged( GameWindow *window, Int oldId );  ///< move window to the bucket for its new id
+	Bool isWindowInSearch( GameWindow *window, GameWindow *first );  ///< would a search from 'first' reach window
+	GameWindow *searchWindowTreeForId( GameWindow *window, Int id );  ///< depth first search from window for id
+
 	Int drawWindow( GameWindow *window );  ///< draw this window
 
 	void dumpWindow( GameWindow *window );  ///< for debugging
@@ -345,6 +383,9 @@ protected:
 
 	GameWindow *m_destroyList;			// list of windows to destroy
 
+	GameWindowIdMap m_windowIdIndex;	// every window we've created and not yet deleted, by id
+	UnsignedInt m_windowTreeGeneration;	// changes whenever the tree or a window id does, for GameWindowHandle
+
 	GameWindow *m_currMouseRgn;		// window that mouse is over
 	GameWindow *m_mouseCaptor;			// window that captured mouse
 	GameWindow *m_keyboardFocus;		// window that has input focus
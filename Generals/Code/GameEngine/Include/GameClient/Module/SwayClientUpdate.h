@@ -54,6 +54,7 @@ public:
 
 	/// the client update callback
 	virtual void clientUpdate( void );
+	virtual UnsignedInt getOffscreenWakeFrame() const;
 
 	void stopSway( void ) { m_swaying = false; }
 
@@ -180,11 +180,12 @@ public:
 	void applyForce( const Coord3D *force );		///< add the given acceleration
 	void detachDrawable( void ) { m_drawable = NULL; }	///< detach the Drawable pointer from this particle
 
-	inline const Coord3D *getPosition( void ) { return &m_pos; }
-	inline Real getSize( void ) { return m_size; }
-	inline Real getAngle( void ) { return m_angleZ; }
-	inline Real getAlpha( void ) { return m_alpha; }
-	inline const RGBColor *getColor( void ) { return &m_color; }
+	// these read a stream particle's field straight out of its system's stream (see end of file)
+	inline const Coord3D *getPosition( void );
+	inline Real getSize( void );
+	inline Real getAngle( void );
+	inline Real getAlpha( void );
+	inline const RGBColor *getColor( void );
 	inline void setColor( RGBColor *color ) { m_color = *color; }
 
 	Bool isInvisible( void );										///< return true if this particle is invisible
@@ -209,6 +210,12 @@ protected:
 
 	void computeAlphaRate( void );							///< compute alpha rate to get to next key
 	void computeColorRate( void );							///< compute color change to get to next key
+	UnsignedInt getNextKeyframeTime( void ) const;	///< client frame at which the next alpha or color key is reached
+	Bool areColorKeysDone( void ) const;				///< true if there are no more color keys to move towards
+
+	void syncFromStream( void );								///< copy all of our state out of the system's particle stream
+
+	friend class ParticleSystem;								///< the system steps stream particles itself
 
 public:
 	Particle *				m_systemNext;
@@ -241,6 +248,7 @@ protected:
 public:
 	Bool							m_inSystemList;
 	Bool							m_inOverallList;
+	Int								m_streamIndex;												///< slot in our system's particle stream, or -1 if we update ourselves
 
 	union
 	{
@@ -528,6 +536,69 @@ protected:
 	// template attribute data inherited from ParticleSystemInfo class
 };
 
+/**
+ * Structure-of-arrays storage for the per-frame state of a particle system's particles.
+ * Point-style systems keep the integration state of their particles here so the whole system
+ * can be stepped four particles at a time and handed to the renderer without visiting each
+ * Particle.  The Particle objects still own their keyframes, links and save data.
+ * Removing a particle leaves a hole that is squeezed out by compact(), which keeps creation
+ * order (streaks rely on it).
+ */
+class ParticleStream
+{
+
+public:
+
+	enum RealField
+	{
+		POS_X = 0, POS_Y, POS_Z,
+		VEL_X, VEL_Y, VEL_Z, VEL_DAMPING,
+		ANGLE_X, ANGLE_Y, ANGLE_Z,
+		ANGULAR_RATE_X, ANGULAR_RATE_Y, ANGULAR_RATE_Z, ANGULAR_DAMPING,
+		SIZE, SIZE_RATE, SIZE_RATE_DAMPING,
+		ALPHA, ALPHA_RATE,
+		RED, GREEN, BLUE,
+		RED_RATE, GREEN_RATE, BLUE_RATE,
+		COLOR_SCALE,
+
+		REAL_FIELD_COUNT
+	};
+
+	ParticleStream( void );
+	~ParticleStream();
+
+	Int add( Particle *p );											///< take a slot for this particle, return the slot
+	void remove( Int slot );										///< free a slot (leaves a hole until compact())
+	void compact( void );												///< squeeze out holes, preserving order
+	void clear( void );													///< forget everything and release storage
+
+	inline Int getSlotCount( void ) const { return m_count; }		///< slots in use, including holes
+	inline Int getParticleCount( void ) const { return m_count - m_holes; }
+	inline Bool hasHoles( void ) const { return m_holes != 0; }
+
+	inline Real *get( RealField field ) { return m_reals + field * m_capacity; }
+
+	Particle **				m_particle;									///< owner of each slot, NULL for a hole
+	UnsignedInt *			m_lifetimeLeft;							///< frames of life left, 0 = forever
+	UnsignedInt *			m_nextKeyframeTime;					///< client frame of the next alpha or color key
+	UnsignedInt *			m_personality;							///< copy of each particle's personality for the renderer
+	UnsignedByte *		m_colorKeysDone;						///< true when the particle has no more color keys
+
+private:
+
+	void grow( void );
+
+	Real *						m_reals;										///< REAL_FIELD_COUNT arrays of m_capacity each
+	Int								m_count;
+	Int								m_holes;
+	Int								m_capacity;
+
+	// not implemented
+	ParticleStream( const ParticleStream& );
+	ParticleStream& operator=( const ParticleStream& );
+
+};
+
 /**
  * A particle system, responsible for creating Particles.
  * If a particle system has finished, but still has particles "in the air", it must wait
@@ -629,6 +700,25 @@ public:
 	void removeParticle( Particle *p );
 	UnsignedInt getParticleCount( void ) const { return m_particleCount; }
 
+	/// true if this system keeps (some of) its particles' state in a particle stream
+	Bool isUsingParticleStream( void ) const { return m_useStream; }
+	UnsignedInt getStreamParticleCount( void ) const { return (UnsignedInt)m_stream.getParticleCount(); }
+
+	/** Write the visible stream particles that fall inside the given box straight into the
+		renderer's buffers (xyz positions, rgba colors, sizes, angles and personalities), and
+		return how many were written. */
+	Int fillRenderBuffers( Real *pos, Real *rgba, Real *size, UnsignedByte *angle, UnsignedInt *personality,
+												 Int maxCount, const Coord3D *boxCenter, const Coord3D *boxExtent );
+
+	/// read one field of a stream particle - ONLY FOR USE BY PARTICLE
+	inline Real friend_getStreamReal( Int slot, ParticleStream::RealField field ) { return m_stream.get( field )[ slot ]; }
+	/// true if the particle in this stream slot can't be seen - ONLY FOR USE BY PARTICLE
+	Bool friend_isStreamSlotInvisible( Int slot );
+	/// copy a stream particle's state back into the Particle - ONLY FOR USE BY PARTICLE
+	void friend_syncParticleFromStream( Particle *p );
+	/// copy a Particle's state into its stream slot - ONLY FOR USE BY PARTICLE
+	void friend_syncStreamFromParticle( Particle *p );
+
 	inline ObjectID getAttachedObject( void ) { return m_attachedToObjectID; }
 	inline DrawableID getAttachedDrawable( void ) { return m_attachedToDrawableID; }
 
@@ -659,6 +749,10 @@ protected:
 	const Coord3D *computeParticleVelocity( const Coord3D *pos );	///< compute a velocity vector based on emission properties
 	const Coord3D *computePointOnUnitSphere( void );	///< compute a random point on a unit sphere
 
+	Bool canUseParticleStream( void ) const;		///< true if this system's particles can live in a stream
+	void updateParticleStream( void );					///< step every particle in the stream by one frame
+	void updateStreamKeyframes( Int slot, UnsignedInt now );	///< handle a stream particle reaching a key
+
 protected:
 	Particle *				m_systemParticlesHead;
 	Particle *				m_systemParticlesTail;
@@ -706,6 +800,9 @@ protected:
 	Bool							m_isDestroyed;												///< are we destroyed and waiting for particles to die
 	Bool							m_isFirstPos;													///< true if this system hasn't been drawn before.
 	Bool							m_isSaveable;													///< true if this system should be saved/loaded
+	Bool							m_useStream;													///< true if point particles go into m_stream
+
+	ParticleStream		m_stream;												///< per-frame state of our stream particles
 
 
 	// the actual particle system data is inherited from ParticleSystemInfo
@@ -818,6 +915,47 @@ private:
 /// The particle system manager singleton
 extern ParticleSystemManager *TheParticleSystemManager;
 
+// ------------------------------------------------------------------------------------------------
+// Particle accessors.  A stream particle's Particle members go stale as its system steps the
+// stream, so pull just the field being asked for instead of syncing the whole particle.
+// ------------------------------------------------------------------------------------------------
+inline const Coord3D *Particle::getPosition( void )
+{
+	if (m_streamIndex >= 0)
+	{
+		m_pos.x = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::POS_X );
+		m_pos.y = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::POS_Y );
+		m_pos.z = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::POS_Z );
+	}
+	return &m_pos;
+}
+
+inline Real Particle::getSize( void )
+{
+	return (m_streamIndex >= 0) ? m_system->friend_getStreamReal( m_streamIndex, ParticleStream::SIZE ) : m_size;
+}
+
+inline Real Particle::getAngle( void )
+{
+	return (m_streamIndex >= 0) ? m_system->friend_getStreamReal( m_streamIndex, ParticleStream::ANGLE_Z ) : m_angleZ;
+}
+
+inline Real Particle::getAlpha( void )
+{
+	return (m_streamIndex >= 0) ? m_system->friend_getStreamReal( m_streamIndex, ParticleStream::ALPHA ) : m_alpha;
+}
+
+inline const RGBColor *Particle::getColor( void )
+{
+	if (m_streamIndex >= 0)
+	{
+		m_color.red = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::RED );
+		m_color.green = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::GREEN );
+		m_color.blue = m_system->friend_getStreamReal( m_streamIndex, ParticleStream::BLUE );
+	}
+	return &m_color;
+}
+
 class DebugDisplayInterface;
 extern void ParticleSystemDebugDisplay( DebugDisplayInterface *dd, void *, FILE *fp = NULL );
 
@@ -153,9 +153,11 @@ public:
 
 
 	//
-	// Modify height.
+	// Modify height.  TerrainLogic owns the heights and passes its changes on through these, 
+	// nothing else should call them.
 	//
 	virtual void setRawMapHeight(const ICoord2D *gridPos, Int height)=0;
+	virtual void setRawMapHeights(const UnsignedByte *heights, Int count)=0;
 	
 	/// Replace the skybox texture
 	virtual void replaceSkyboxTextures(const AsciiString *oldTexName[NumSkyboxTextures], const AsciiString *newTexName[NumSkyboxTextures])=0;
@@ -41,6 +41,32 @@ class Bridge;
 class Object;
 class Weapon;
 class PathfindZoneManager;
+class PathfindCell;
+class PathfindOpenList;
+class PathfindMapSnapshot;
+
+/**
+ * What Pathfinder::runStressBenchmark measured.  The first part is findGroundPath run one
+ * search at a time; the second is the same searches on a PathfindMapSnapshot, run by a
+ * PathfindWorkerPool of 1, 2, ... m_threadRuns workers.
+ */
+struct PathfindBenchmarkResult
+{
+	enum { MAX_THREAD_RUNS = 8 };	///< PathfindWorkerPool::MAX_WORKERS
+
+	Int						m_paths;				///< searches run
+	Int						m_pathsFound;		///< searches that returned a path
+	Int						m_cells;				///< pathfind cells examined
+	UnsignedInt		m_elapsedMS;		///< wall clock time for all of the searches
+	UnsignedInt		m_checksum;			///< of every node of every path found, to check that results didn't change
+
+	UnsignedInt		m_snapshotMS;								///< time to copy the ground layer into the snapshot
+	Int						m_snapshotPathsFound;				///< searches that found a path on the snapshot
+	Int						m_snapshotCells;						///< snapshot cells examined
+	Int						m_threadRuns;								///< how many worker counts were timed, from 1 up
+	UnsignedInt		m_threadElapsedMS[ MAX_THREAD_RUNS ];		///< wall clock time for all of the searches with i+1 workers
+	UnsignedInt		m_threadChecksum[ MAX_THREAD_RUNS ];		///< of the results in queue order, the same for every worker count
+};
 
 // How close is close enough when moving.
 
@@ -202,6 +228,7 @@ enum {MAX_WALL_PIECES = 128};
 class PathfindCellInfo
 {
 	friend class PathfindCell;
+	friend class PathfindOpenList;
 public:
 	static void allocateCellInfos(void);
 	static void releaseCellInfos(void);
@@ -214,7 +241,10 @@ protected:
 	static PathfindCellInfo *s_firstFree;							///< 
 
 
-	PathfindCellInfo *m_nextOpen, *m_prevOpen;						///< for A* "open" list, shared by closed list
+	PathfindCellInfo *m_nextOpen, *m_prevOpen;						///< for A* "closed" list
+
+	Int m_openIndex;																	///< Index of this info in the open list heap, while open.
+	UnsignedInt m_openSequence;												///< Insertion order on the open list, breaks ties in total cost.
 
 	PathfindCellInfo *m_pathParent;												///< "parent" cell from pathfinder
 	PathfindCell *m_cell;															///< Cell this info belongs to currently.
@@ -239,6 +269,48 @@ protected:
 	UnsignedInt m_closed:1;												///< place for marking this cell as on the closed list
 };
 
+/**
+ * The A* "open" list.  This is an indexed binary min-heap of cell infos, ordered
+ * by total cost, with ties going to the cell that was put on the list first.  That
+ * is exactly the order the old sorted linked list produced (a new cell was inserted
+ * after every cell of equal cost), so searches expand cells in the same order and
+ * produce the same paths.  Cells are removed by index, so a cost change is handled
+ * by removing and re-inserting the cell, as before.
+ */
+class PathfindOpenList
+{
+public:
+	PathfindOpenList(void);
+	~PathfindOpenList(void);
+
+	void allocate(Int capacity);								///< Allocate room for capacity cells.
+	void release(void);													///< Free the heap storage.
+
+	Bool isEmpty(void) const {return m_count==0;}
+	Int getCount(void) const {return m_count;}
+	PathfindCell *getHead(void) const;					///< Cell with the lowest total cost, or NULL.
+	PathfindCell *getNth(Int i) const;					///< Cells in heap order, for debug display.
+
+	void insert(PathfindCellInfo *info);
+	void remove(PathfindCellInfo *info);
+	void clear(void) {m_count = 0; m_nextSequence = 0;}
+
+protected:
+	inline Bool isBefore(const PathfindCellInfo *a, const PathfindCellInfo *b) const
+	{
+		if (a->m_totalCost != b->m_totalCost) return a->m_totalCost < b->m_totalCost;
+		return a->m_openSequence < b->m_openSequence;
+	}
+	void siftUp(Int ndx);
+	void siftDown(Int ndx);
+
+protected:
+	PathfindCellInfo **m_heap;
+	Int m_count;
+	Int m_capacity;
+	UnsignedInt m_nextSequence;	///< insertion order, to break cost ties.  Restarts whenever the list is empty.
+};
+
 /**
  * This represents one cell in the pathfinding grid.
  * These cells categorize the world into idealized cellular states,
@@ -295,11 +367,11 @@ public:
 
 	UnsignedInt costSoFar( PathfindCell *parent );
 
-	/// put self on "open" list in ascending cost order, return new list
-	PathfindCell *putOnSortedOpenList( PathfindCell *list );		
+	/// put self on "open" list in ascending cost order
+	void putOnSortedOpenList( PathfindOpenList &list );		
 
 	/// remove self from "open" list
-	PathfindCell *removeFromOpenList( PathfindCell *list );		
+	void removeFromOpenList( PathfindOpenList &list );		
 
 	/// put self on "closed" list, return new list
 	PathfindCell *putOnClosedList( PathfindCell *list );		
@@ -310,8 +382,8 @@ public:
 	/// remove all cells from closed list.
 	static Int releaseClosedList( PathfindCell *list );	
 
-	/// remove all cells from closed list.
-	static Int releaseOpenList( PathfindCell *list );	
+	/// remove all cells from open list.
+	static Int releaseOpenList( PathfindOpenList &list );	
 
 	inline PathfindCell *getNextOpen(void) {return m_info->m_nextOpen?m_info->m_nextOpen->m_cell:NULL;}
 
@@ -619,6 +691,8 @@ public:
 
 	Bool queueForPath(ObjectID id);	 ///< The object wants to request a pathfind, so put it on the list to process.
 	void processPathfindQueue(void); ///< Process some or all of the queued pathfinds.
+	void runStressBenchmark(Int numPaths, Int maxThreads, PathfindBenchmarkResult *result); ///< Time numPaths ground paths on the current map, serially and on 1..maxThreads workers.
+	void buildMapSnapshot(PathfindMapSnapshot *snapshot, Int pathDiameter); ///< Copy the ground layer for searches on other threads.
 	void forceMapRecalculation( );	///< Force pathfind map recomputation. If region is given, only that area is recomputed
 
 	/** Returns an aircraft path to the goal.  */
@@ -826,7 +900,7 @@ private:
 	IRegion2D m_extent;														///< Grid extent limits
 	IRegion2D m_logicalExtent;										///< Logical grid extent limits
 
-	PathfindCell *m_openList;											///< Cells ready to be explored
+	PathfindOpenList m_openList;									///< Cells ready to be explored
 	PathfindCell *m_closedList;										///< Cells already explored
 
 	Bool m_isMapReady;														///< True if all cells of map have been classified
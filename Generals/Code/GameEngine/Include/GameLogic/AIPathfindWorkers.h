@@ -0,0 +1,169 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// FILE: AIPathfindWorkers.h //////////////////////////////////////////////////
+// Ground path searches against a read-only copy of the pathfind map, so that
+// many can run at once on worker threads.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef __AIPATHFINDWORKERS_H_
+#define __AIPATHFINDWORKERS_H_
+
+#include "Lib/BaseType.h"
+#include "Common/STLTypedefs.h"
+#include <windows.h>
+
+//-----------------------------------------------------------------------------
+/**
+	A read-only copy of the ground layer of the pathfind map: for each cell, whether a
+	ground unit may step into it, how wide a unit fits there, and its effective ground
+	zone. Nothing in it changes once it is built, so any number of threads may search it
+	at the same time.
+*/
+class PathfindMapSnapshot
+{
+public:
+	enum
+	{
+		CELL_ENTERABLE = 0x01,					///< clear and not pinched, findGroundPath would step here
+		CELL_PINCHED = 0x02,						///< costs extra to path through
+		CELL_DIAMETER_SHIFT = 2					///< clear diameter (0..3) lives in the bits above the flags
+	};
+
+	PathfindMapSnapshot( void );
+
+	void init( Int width, Int height );	///< size the snapshot, every cell impassable and in zone 0
+	void setCell( Int x, Int y, UnsignedByte flags, Int clearDiameter, UnsignedShort zone );
+
+	Int getWidth( void ) const { return m_width; }
+	Int getHeight( void ) const { return m_height; }
+	Int getCellCount( void ) const { return m_width * m_height; }
+
+	UnsignedByte getFlags( Int index ) const { return m_cells[ index ]; }
+	Int getClearDiameter( Int index ) const { return m_cells[ index ] >> CELL_DIAMETER_SHIFT; }
+	UnsignedShort getZone( Int index ) const { return m_zones[ index ]; }
+
+private:
+	Int														m_width;
+	Int														m_height;
+	std::vector< UnsignedByte >		m_cells;
+	std::vector< UnsignedShort >	m_zones;
+};
+
+//-----------------------------------------------------------------------------
+/// one search handed to the workers, in snapshot cell coordinates
+struct PathfindSnapshotJob
+{
+	ICoord2D	m_from;
+	ICoord2D	m_to;
+};
+
+/// what one search came up with
+struct PathfindSnapshotResult
+{
+	Bool				m_found;
+	Int					m_cells;							///< cells examined
+	Int					m_length;							///< cells in the path, start and goal included
+	UnsignedInt	m_checksum;						///< of the path's cells, goal back to start
+};
+
+//-----------------------------------------------------------------------------
+/**
+	The open and closed state of one search at a time, kept beside the snapshot rather
+	than in the cells so that each thread can have its own. A generation stamp marks which
+	cells the current search has touched, so nothing is cleared between searches.
+*/
+class PathfindSearchScratch
+{
+public:
+	PathfindSearchScratch( void );
+
+	void reserve( const PathfindMapSnapshot &map );	///< size for this map; call before handing to a thread
+
+	/// A* from job.m_from to job.m_to with findGroundPath's ground costs
+	void search( const PathfindMapSnapshot &map, const PathfindSnapshotJob &job, Int pathDiameter, PathfindSnapshotResult *result );
+
+private:
+	struct OpenEntry
+	{
+		UnsignedInt	m_totalCost;
+		Int					m_cell;
+	};
+	static Bool isCostlier( const OpenEntry &a, const OpenEntry &b );	///< heap order, puts the cheapest entry on top
+
+	void beginSearch( void );
+	void pushOpen( Int cell, UnsignedInt totalCost );
+
+	std::vector< UnsignedInt >	m_visited;			///< (generation << 1) | closed, for cells touched this search
+	std::vector< UnsignedInt >	m_costSoFar;
+	std::vector< Int >					m_parent;				///< cell we reached this one from, -1 for the start
+	std::vector< OpenEntry >		m_open;					///< binary heap, cheapest on top; stale entries are skipped
+	UnsignedInt									m_generation;
+};
+
+//-----------------------------------------------------------------------------
+/**
+	A fixed set of threads that run a batch of snapshot searches. The workers take jobs in
+	any order, but each result goes in the slot of its job, so reading the results front to
+	back commits them in queue order whatever the thread count and timing.
+*/
+class PathfindWorkerPool
+{
+public:
+	enum { MAX_WORKERS = 8 };
+
+	PathfindWorkerPool( Int numWorkers );
+	~PathfindWorkerPool();
+
+	Int getWorkerCount( void ) const { return m_numWorkers; }
+
+	/// run every job against the map, returning when all of results[0..numJobs) are filled in
+	void run( const PathfindMapSnapshot &map, const PathfindSnapshotJob *jobs, PathfindSnapshotResult *results, 
+						Int numJobs, Int pathDiameter );
+
+private:
+	struct Worker
+	{
+		PathfindWorkerPool			*m_pool;
+		HANDLE									m_thread;
+		HANDLE									m_startEvent;		///< set by run() to hand over a batch
+		HANDLE									m_doneEvent;		///< set by the worker when the batch has no jobs left
+		PathfindSearchScratch		m_scratch;
+	};
+
+	static DWORD WINAPI workerThreadProc( LPVOID param );
+	void workerMain( Worker *worker );
+
+	Worker													m_workers[ MAX_WORKERS ];
+	Int															m_numWorkers;
+	LONG														m_nextJob;			///< only touched with InterlockedIncrement while a batch runs
+	volatile Bool										m_shouldExit;
+
+	// the batch being run
+	const PathfindMapSnapshot				*m_map;
+	const PathfindSnapshotJob				*m_jobs;
+	PathfindSnapshotResult					*m_results;
+	Int															m_numJobs;
+	Int															m_pathDiameter;
+};
+
+#endif // __AIPATHFINDWORKERS_H_
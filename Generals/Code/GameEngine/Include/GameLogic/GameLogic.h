@@ -34,6 +34,7 @@
 
 #include "Common/GameCommon.h"	// ensure we get DUMP_PERF_STATS, or not
 #include "Common/GameType.h"
+#include "Common/IDLookupTable.h"
 #include "Common/Snapshot.h"
 #include "Common/STLTypedefs.h"
 #include "GameNetwork/NetworkDefs.h"
@@ -92,8 +93,7 @@ enum
 
 /// Function pointers for use by GameLogic callback functions.
 typedef void (*GameLogicFuncPtr)( Object *obj, void *userData ); 
-typedef std::hash_map<ObjectID, Object *, rts::hash<ObjectID>, rts::equal_to<ObjectID> > ObjectPtrHash;
-typedef ObjectPtrHash::const_iterator ObjectPtrIter;
+typedef IDLookupTable<Object> ObjectPtrHash;
 
 
 // ------------------------------------------------------------------------------------------------
@@ -396,11 +396,7 @@ inline Object* GameLogic::findObjectByID( ObjectID id )
 	if( id == INVALID_ID )
 		return NULL;
 
-	ObjectPtrHash::iterator it = m_objHash.find(id);
-	if (it == m_objHash.end())
-		return NULL;
-	
-	return (*it).second;
+	return m_objHash.find(id);
 }
 
 
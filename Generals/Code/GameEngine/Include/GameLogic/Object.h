@@ -352,6 +352,9 @@ public:
 	inline Bool isEffectivelyDead() const { return (m_privateStatus & EFFECTIVELY_DEAD) != 0; }
 	void setEffectivelyDead(Bool dead);
 
+	/// file us under our controlling player's object counts for our current team and state
+	void updatePlayerObjectCount();
+
 	void markSingleUseCommandUsed() { m_singleUseCommandUsed = true; }
 	Bool hasSingleUseCommandBeenUsed() const { return m_singleUseCommandUsed; }
 	
@@ -623,6 +626,8 @@ protected:
 	/// Look and unlook are protected.  They should be called from Object::reasonToLook.  Like Capture, or death.
 	void look();
 	void unlook();
+	void relook();	///< unlook and look again in one step, so only the cells that change are touched
+	Bool calcLookingMask( PlayerMaskType *lookingMask );	///< FALSE if we can't look at all
 	void shroud();
 	void unshroud();
 
@@ -706,6 +711,7 @@ private:
 	Int64													m_objectUpgradesCompleted;	///< Bit field of upgrades locally completed.
 
 	Team*													m_team;								///< team that is current owner of this guy
+	Player*												m_countedPlayer;			///< player whose object counts we are currently included in
 	AsciiString										m_originalTeamName;		///< team that was the original ("birth") team of this guy
 	Color													m_indicatorColor;			///< if nonzero, use this instead of controlling player's color
 
@@ -752,6 +758,7 @@ private:
 #endif
 	UnsignedByte									m_scriptStatus;					///< status as set by scripting, corresponds to ORed ObjectScriptStatusBits
 	UnsignedByte									m_privateStatus;					///< status bits that are never directly accessible to outside world
+	UnsignedByte									m_countedState;						///< Player::ObjectCountState bits we are counted under by m_countedPlayer
 	Byte													m_numTriggerAreasActive;
 	Bool													m_singleUseCommandUsed;
 	Bool													m_isReceivingDifficultyBonus;
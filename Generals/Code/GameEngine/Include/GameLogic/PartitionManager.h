@@ -257,6 +257,9 @@ public:
 	
 	UnsignedInt			m_data;			// Threat and value use as the value.  Sighting uses it for a Timestamp
 
+	Coord3D					m_exceptWhere;		///< A queued undo leaves the cells inside this circle alone...
+	Real						m_exceptHowFar;		///< ...unless this is zero.
+
 protected:
 
 	// snapshot method
@@ -303,6 +306,7 @@ private:
 	Int														m_threatValue[MAX_PLAYER_COUNT];
 	Int														m_cashValue[MAX_PLAYER_COUNT];
 	Short													m_coiCount;					///< number of COIs in this cell.
+	UnsignedInt										m_coiSerial;				///< bumped whenever a COI enters or leaves this cell
 	Short													m_cellX;						///< x-coord of this cell within the Partition Mgr coords (NOT in world coords)
 	Short													m_cellY;						///< y-coord of this cell within the Partition Mgr coords (NOT in world coords)
 
@@ -323,6 +327,7 @@ public:
 	void loadPostProcess( void );
 
 	Int getCoiCount() const { return m_coiCount; }		///< return number of COIs touching this cell.
+	UnsignedInt getCoiSerial() const { return m_coiSerial; }	///< changes whenever the COIs touching this cell change
 	Int getCellX() const { return m_cellX; }
 	Int getCellY() const { return m_cellY; }
 
@@ -361,6 +366,9 @@ public:
 
 	// intended only for CellAndObjectIntersection.
 	void friend_removeFromCellList(CellAndObjectIntersection *coi);
+
+	// intended only for PartitionData: something about an object in this cell changed that lists built from the cell care about.
+	void friend_bumpCoiSerial() { ++m_coiSerial; }
 };
 
 //=====================================
@@ -544,6 +552,7 @@ public:
 	void friend_removeAllTouchedCells() { removeAllTouchedCells(); }	///< this is only for use by PartitionManager
 	void friend_updateCellsTouched()	{ updateCellsTouched(); } ///< this is only for use by PartitionManager
 	Int friend_getCoiInUseCount() { return m_coiInUseCount; } ///< this is only for use by PartitionManager
+	void touchedCellsChanged();	///< the object's team changed, so per-cell lists that depend on it must be rebuilt
 	Bool friend_collidesWith(const PartitionData *that, CollideLocAndNormal *cinfo) const { return collidesWith(that, cinfo); }	///< this is only for use by PartitionContactList
 
 	// these are only for use by getClosestObjects.
@@ -1213,12 +1222,35 @@ private:
 	Bool						m_updatedSinceLastReset;	///< Used to force a return of OBJECTSHROUD_INVALID before update has been called.
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
+	std::vector<ICoord2D> m_exceptSpans;	///< scratch for drawing one circle minus another, per row of the excepted circle (x is start, y is end)
+
+	// The shroud reveals draw lookers with these and stamp their undos with getShroudFrame(), which lets
+	// the ShroudMove self test run them against its own counting grids and clock.
+	void (*m_addLookerFunc)(Int, Int, Int, void *);			///< hLineAddLooker, except in the self test
+	void (*m_removeLookerFunc)(Int, Int, Int, void *);	///< hLineRemoveLooker, except in the self test
+	UnsignedInt			m_shroudTestFrame;		///< if nonzero, used in place of the logic frame
 
 #ifdef FASTER_GCO
 	Int							m_maxGcoRadius;
 	RadiusVec				m_radiusVec;
 #endif
 
+	/**
+		For one player, the objects in each cell that are ENEMIES of that player, in the order
+		the cell lists them. A cell's list is built the first time an enemy scan visits it and
+		is kept until the cell's COIs or anybody's relationships change.
+	*/
+	struct EnemyCellCache
+	{
+		UnsignedInt									m_relationshipSerial;	///< m_relationshipSerial the lists were built under
+		std::vector<UnsignedInt>		m_cellStamp;					///< per cell: 1 + its COI serial when its list was built, 0 if never
+		std::vector<Int>						m_cellFirst;					///< per cell: index of its first entry in m_enemies
+		std::vector<Int>						m_cellCount;					///< per cell: number of its entries in m_enemies
+		std::vector<PartitionData*>	m_enemies;						///< the lists themselves, back to back
+	};
+	EnemyCellCache*	m_enemyCellCache[MAX_PLAYER_COUNT];	///< lazily allocated, per player index
+	UnsignedInt			m_relationshipSerial;								///< bumped whenever any relationship might have changed
+
 protected:
 
 	/**
@@ -1233,9 +1265,14 @@ protected:
 		PartitionFilter **filters, 
 		SimpleObjectIterator *iter,	// if nonnull, append ALL satisfactory objects to the iterator (not just the single closest)
 		Real *closestDistArg,
-		Coord3D *closestVecArg
+		Coord3D *closestVecArg,
+		Bool enemiesOnly = false		// if true, only consider objects that are ENEMIES of obj
 	);
 
+	const Player *getEnemyCellCachePlayer( const Object *obj ) const;
+	PartitionData * const *getCellEnemies( const Player *player, PartitionCell *cell, Int *count );
+	void clearEnemyCellCaches( void );
+
 	void shutdown( void );
 
 	/// used to validate the positions for findPositionAround family of methods
@@ -1268,7 +1305,10 @@ protected:
 	friend void hLineAddValue(Int x1, Int x2, Int y, void *threatValueParms);
 	friend void hLineRemoveValue(Int x1, Int x2, Int y, void *threatValueParms);
 
+	UnsignedInt getShroudFrame() const;
 	void processPendingUndoShroudRevealQueue(Bool considerTimestamp = TRUE);				///< keep popping and processing untill you get to one that is in the future
+	void drawShroudCircleExcept( Real centerX, Real centerY, Real radius, Real exceptX, Real exceptY, Real exceptRadius, 
+															 PlayerMaskType playerMask, void (*drawFunc)(Int, Int, Int, void *) );	///< draw for every player in the mask, skipping cells inside the except circle
 	void resetPendingUndoShroudRevealQueue();					///< Just delete everything in the queue without doing anything with them
 
 public:
@@ -1311,6 +1351,10 @@ public:
 	void doShroudReveal( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
 	void undoShroudReveal( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
 	void queueUndoShroudReveal( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask );
+	/// Move a reveal, as a queued undo of the old one and a reveal of the new one would, but only touching the cells that differ
+	void moveShroudReveal( const SightingInfo *oldLook, Real centerX, Real centerY, Real radius, PlayerMaskType playerMask );
+	/// Check moveShroudReveal against the queued undo and reveal it stands in for
+	static Bool runShroudMoveSelfTest( AsciiString *failure );
 
 	void doShroudCover( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
 	void undoShroudCover( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
@@ -1389,6 +1433,29 @@ public:
 
 	SimpleObjectIterator *iterateAllObjects(PartitionFilter **filters = NULL);		
 
+	/**
+		Just like getClosestObject and iterateObjectsInRange, except that only objects that are
+		ENEMIES of obj are considered. The filters see exactly the enemies, in exactly the order,
+		that the unrestricted calls would show them, but the allies and neutrals around obj are
+		skipped using per-player lists of each cell's enemies instead of being asked one by one.
+	*/
+	Object *getClosestEnemy(
+		const Object *obj, 
+		Real maxDist, 
+		DistanceCalculationType dc, 
+		PartitionFilter **filters = NULL
+	);
+	SimpleObjectIterator *iterateEnemiesInRange(
+		const Object *obj, 
+		Real maxDist, 
+		DistanceCalculationType dc, 
+		PartitionFilter **filters = NULL, 
+		IterOrderType order = ITER_FASTEST
+	);
+
+	/// call whenever a relationship between teams, players or objects may have changed
+	void notifyRelationshipsChanged() { ++m_relationshipSerial; }
+
 	/**
 		return the Objects that would (or would not) collide with the given
 		geometry.
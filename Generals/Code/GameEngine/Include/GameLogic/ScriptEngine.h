@@ -87,6 +87,8 @@ struct TCounter
 	Int value;
 	AsciiString name;
 	Bool isCountdownTimer;
+	Bool isWatchedValue;		///< a COUNTER condition has read this, so changes to it can change a script's result
+	Bool isWatchedExpiry;		///< a TIMER_EXPIRED condition has read this
 };
 
 struct TFlag
@@ -235,6 +237,9 @@ public:
 	void notifyOfTeamDestruction(Team *teamDestroyed);
 	void notifyOfObjectCreationOrDestruction(void);
 	UnsignedInt getFrameObjectCountChanged(void) {return m_frameObjectCountChanged;}
+	void notifyOfScriptInputChange(UnsignedInt inputBits);	///< SCRIPT_INPUT_BIT()s of things script conditions look at that may have just changed
+	static UnsignedInt getConditionInputs(Int conditionType);	///< SCRIPT_INPUT_BIT()s a condition type looks at, or SCRIPT_INPUTS_UNTRACKED
+	Bool selfTestScriptInputs( AsciiString *failure );	///< for -selfTest: counters only invalidate cached results when a condition reads them
 	void setSequentialTimer(Object *obj, Int frameCount);
 	void setSequentialTimer(Team *team, Int frameCount);
 	
@@ -389,6 +394,10 @@ protected:
 	Bool evaluateFlag( Condition *pCondition );
 	Bool evaluateTimer( Condition *pCondition );
 	Bool evaluateCondition( Condition *pCondition );
+	UnsignedInt getScriptConditionInputs( Script *pScript );
+	Bool areScriptInputsUnchanged( UnsignedInt inputs, UnsignedInt64 sinceSerial ) const;
+	void notifyOfCounterChange( Int counterNdx );	///< the counter's value or timer state changed
+	void updateCountdownTimers( void );
 	void executeActions( ScriptAction *pActionHead );
 
 	void setPriorityThing( ScriptAction *pAction );
@@ -451,6 +460,9 @@ protected:
 
 	UnsignedInt				m_frameObjectCountChanged;
 
+	UnsignedInt64			m_scriptInputSerial;													///< bumped every time a tracked script input changes. 64 bits, so it never wraps
+	UnsignedInt64			m_scriptInputChangedAt[SCRIPT_INPUT_COUNT];		///< m_scriptInputSerial when each input last changed
+
 	ObjectTypeCount		m_objectCounts[MAX_PLAYER_COUNT];
 
 	/// These are three separate lists rather than one to increase speed efficiency
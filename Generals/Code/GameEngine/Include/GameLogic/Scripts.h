@@ -84,6 +84,22 @@ class Condition;
 class DataChunkInput;
 struct DataChunkInfo;
 class DataChunkOutput;
+class Player;
+
+// What script conditions look at.  A script whose conditions only look at tracked inputs reuses its last
+// result until the ScriptEngine is told one of those inputs changed.  See ScriptEngine::getConditionInputs().
+enum ScriptInputType
+{
+	SCRIPT_INPUT_COUNTERS = 0,		///< counters and timers
+	SCRIPT_INPUT_FLAGS,						///< flags and UI interactions
+	SCRIPT_INPUT_OBJECTS,					///< named objects, objects dying or being destroyed, team membership, teams coming and going
+
+	SCRIPT_INPUT_COUNT
+};
+
+#define SCRIPT_INPUT_BIT(x)				(1 << (x))
+#define SCRIPT_INPUTS_UNTRACKED		(0x40000000)		///< looks at something we don't track, so evaluate it every time
+#define SCRIPT_INPUTS_UNKNOWN			(0x80000000)		///< not worked out yet
 
 #define NO_MORE_COMPLEX_SKIRMISH_SCRIPTS
 #ifndef NO_MORE_COMPLEX_SKIRMISH_SCRIPTS
@@ -626,6 +642,12 @@ protected:	// Note - If you add any member vars, you must take them into account
 	Real				m_conditionTime;		///< Amount of time (cum) to evaluate conditions.
 	Real				m_curTime;		///< Amount of time (cum) to evaluate conditions.
 	Int					m_conditionExecutedCount; ///< Number of times conditions evaluated.
+	Int					m_conditionSkippedCount;	///< Number of times the cached condition result was used instead.
+	UnsignedInt	m_conditionInputs;				///< ScriptInputType bits the conditions look at, or SCRIPT_INPUTS_UNKNOWN.
+	UnsignedInt64	m_conditionResultSerial;	///< ScriptEngine input serial m_conditionResult was computed at.
+	Player*			m_conditionResultPlayer;	///< Player m_conditionResult was computed for.
+	Bool				m_conditionResultValid;		///< True if m_conditionResult may be reused.
+	Bool				m_conditionResult;				///< Last result of the conditions.
 
 public:
 	Script();
@@ -647,18 +669,27 @@ public:
 	void setHard(Bool hard) { m_hard = hard;}
 	void setSubroutine(Bool subr) { m_isSubroutine = subr;}
 	void setNextScript(Script *pScr) {m_nextScript = pScr;}
-	void setOrCondition(OrCondition *pCond) {m_condition = pCond;}
+	void setOrCondition(OrCondition *pCond) {m_condition = pCond; m_conditionInputs = SCRIPT_INPUTS_UNKNOWN; m_conditionResultValid = false;}
 	void setAction(ScriptAction *pAction) {m_action = pAction;}
 	void setFalseAction(ScriptAction *pAction) {m_actionFalse = pAction;}
 	void updateFrom(Script *pSrc); ///< Updates this from pSrc.  pSrc IS MODIFIED - it's guts are removed.  jba.
 	void setFrameToEvaluate(UnsignedInt frame) {m_frameToEvaluateAt=frame;}
 	void incrementConditionCount(void) {m_conditionExecutedCount++;}
+	void incrementConditionSkippedCount(void) {m_conditionSkippedCount++;}
+	void setConditionInputs(UnsignedInt inputs) {m_conditionInputs = inputs;}
+	void setConditionResult(Bool result, Player *player, UnsignedInt64 serial) {m_conditionResult = result; m_conditionResultPlayer = player; m_conditionResultSerial = serial; m_conditionResultValid = true;}
+	void invalidateConditionResult(void) {m_conditionResultValid = false;}
 	void addToConditionTime(Real time) {m_conditionTime += time;}
 	void setCurTime(Real time) {m_curTime	= time;}
 	void setDelayEvalSeconds(Int delay) {m_delayEvaluationSeconds = delay;}
 
 	UnsignedInt getFrameToEvaluate(void) {return m_frameToEvaluateAt;}
 	Int getConditionCount(void) {return m_conditionExecutedCount;}
+	Int getConditionSkippedCount(void) {return m_conditionSkippedCount;}
+	UnsignedInt getConditionInputs(void) const {return m_conditionInputs;}
+	Bool hasConditionResult(Player *player) const {return m_conditionResultValid && m_conditionResultPlayer == player;}
+	UnsignedInt64 getConditionResultSerial(void) const {return m_conditionResultSerial;}
+	Bool getConditionResult(void) const {return m_conditionResult;}
 	Real getConditionTime(void) {return m_conditionTime;}
 	Real getCurTime(void) {return m_curTime;}
 	Int getDelayEvalSeconds(void) {return m_delayEvaluationSeconds;}
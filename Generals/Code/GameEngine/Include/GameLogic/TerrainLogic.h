@@ -231,6 +231,7 @@ public:
 	virtual void newMap( Bool saveGame );	///< Initialize the logic for new map.
 
 	virtual Real getGroundHeight( Real x, Real y, Coord3D* normal = NULL )  const;
+	virtual void getGroundHeights( Coord3D *points, Int count ) const;	///< set the z of each point to getGroundHeight( x, y ), but in one go
 	virtual Real getLayerHeight(Real x, Real y, PathfindLayerEnum layer, Coord3D* normal = NULL, Bool clip = true) const;
 	virtual void getExtent( Region3D *extent ) const { DEBUG_CRASH(("not implemented"));  }		///< @todo This should not be a stub - this should own this functionality
 	virtual void getExtentIncludingBorder( Region3D *extent ) const { DEBUG_CRASH(("not implemented"));  }		///< @todo This should not be a stub - this should own this functionality
@@ -316,6 +317,11 @@ public:
 
   void flattenTerrain(Object *obj);  ///< Flatten the terrain under a building.
 
+	/** Every change to the terrain heights goes through these.  They keep the height pyramid up to date 
+		and hand the new heights on to TheTerrainVisual, which only draws them. */
+	void setRawMapHeight( const ICoord2D *gridPos, Int height );	///< lower one height sample, never raises it
+	void setRawMapHeights( const UnsignedByte *heights, Int count );	///< replace every height sample, as loaded from a save
+
 protected:
 
 	// snapshot methods
@@ -339,9 +345,33 @@ protected:
 	/// find the axis aligned region bounding the water table
 	void findAxisAlignedBoundingRect( const WaterHandle *waterHandle, Region3D *region );
 
+	void initMapHeights( const UnsignedByte *heights, Int dx, Int dy, Int borderSize );	///< take a copy of the map's height samples
+	void freeMapHeights( void );
+	void buildHeightPyramid( void );
+	void updateHeightPyramid( Int sampleX, Int sampleY );
+	void updateHeightPyramidBlock( Int level, Int blockX, Int blockY );
+	UnsignedByte getClipHeight( Int x, Int y ) const;
+	inline Bool interpolateHeight( Real x, Real y, Real *height, Int *idx, Real *fx, Real *fy ) const;
+
 	UnsignedByte	*m_mapData;									///< array of height samples
 	Int	m_mapDX;															///< width of map samples
 	Int	m_mapDY;															///< height of map samples
+	Int	m_mapBorderSize;											///< samples of border around the playable map, on each side
+	Int	m_mapMinHeight;												///< lowest height sample
+	Int	m_mapMaxHeight;												///< highest height sample, only ever gets stale high
+
+	/** Min/max pyramid over the cells of the height map, for line of sight to step over whole blocks 
+		of cells it is clear of.  A cell is the quad of samples from (x, y) to (x+1, y+1).  Level 0 blocks are 
+		HEIGHT_PYRAMID_BASE_SIZE cells on a side, and each level up doubles that. */
+	enum { HEIGHT_PYRAMID_LEVELS = 4, HEIGHT_PYRAMID_BASE_SHIFT = 2, HEIGHT_PYRAMID_BASE_SIZE = 1<<HEIGHT_PYRAMID_BASE_SHIFT };
+	struct HeightRange
+	{
+		UnsignedByte lo;
+		UnsignedByte hi;
+	};
+	HeightRange	*m_heightPyramid[ HEIGHT_PYRAMID_LEVELS ];
+	Int	m_heightPyramidDX[ HEIGHT_PYRAMID_LEVELS ];	///< blocks across at each level
+	Int	m_heightPyramidDY[ HEIGHT_PYRAMID_LEVELS ];	///< blocks down at each level
 
 	VecICoord2D m_boundaries;
 	Int m_activeBoundary;
@@ -321,7 +321,8 @@ struct HistoricWeaponDamageInfo
 	}
 };
 
-typedef std::list<HistoricWeaponDamageInfo> HistoricWeaponDamageList;
+// kept in strict chronological order: appended at the back, expired from the front
+typedef std::deque<HistoricWeaponDamageInfo> HistoricWeaponDamageList;
 
 //-------------------------------------------------------------------------------------------------
 class WeaponTemplate : public MemoryPoolObject
@@ -840,10 +841,34 @@ private:
 		ObjectID m_delaySourceID;										///< who dealt the damage (by ID since it might be dead due to delay)
 		ObjectID m_delayIntendedVictimID;						///< who the damage was intended for (or zero if no specific target)
 		WeaponBonus m_bonus;												///< the weapon bonus to use
+		UnsignedInt m_delaySequence;								///< order this was scheduled in, so due damage is dealt in that order
 	};
 
+	struct DelayedDamageSequenceLess
+	{
+		Bool operator()(const WeaponDelayedDamageInfo& a, const WeaponDelayedDamageInfo& b) const
+		{
+			return a.m_delaySequence < b.m_delaySequence;
+		}
+	};
+
+	/**
+		Pending delayed damage lives in a wheel of buckets indexed by frame, so each update only
+		looks at the buckets for the frames that have elapsed rather than at everything pending.
+		Damage scheduled further out than the wheel size simply stays in its bucket until its
+		frame comes around.
+	*/
+	enum { DELAYED_DAMAGE_WHEEL_SIZE = 256 };	///< must be a power of two
+	typedef std::vector<WeaponDelayedDamageInfo> DelayedDamageBucket;
+
+	void collectDueDelayedDamage(DelayedDamageBucket& bucket, UnsignedInt curFrame);
+
 	std::vector<WeaponTemplate*> m_weaponTemplateVector;
-	std::list<WeaponDelayedDamageInfo> m_weaponDDI;
+	DelayedDamageBucket m_delayedDamageWheel[DELAYED_DAMAGE_WHEEL_SIZE];
+	DelayedDamageBucket m_dueDelayedDamage;			///< scratch list of the damage being dealt this update
+	UnsignedInt m_nextDelayedDamageFrame;				///< first frame whose bucket has not been processed yet
+	UnsignedInt m_delayedDamageSequence;				///< sequence number for the next scheduled damage
+	Int m_delayedDamageCount;										///< total entries pending in the wheel
 };
 
 // EXTERNALS //////////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@
 #define __FRAMEDATA_H
 
 #include "Lib/BaseType.h"
+#include "Common/STLTypedefs.h"
 #include "GameNetwork/NetCommandList.h"
 
 enum FrameDataReturnType {
@@ -49,7 +50,8 @@ public:
 	UnsignedInt getFrame();
 	void setFrame(UnsignedInt frame);
 	FrameDataReturnType allCommandsReady(Bool debugSpewage);
-	NetCommandList * getCommandList();
+	Int getNumCommands();
+	NetCommandMsg * getCommand(Int index);
 	void setFrameCommandCount(UnsignedInt totalCommandCount);
 	UnsignedInt getFrameCommandCount();
 	void addCommand(NetCommandMsg *msg);
@@ -58,10 +60,21 @@ public:
 	void destroyGameMessages();
 
 protected:
+	/// A command and the key NetCommandList sorts it by, so placing a command needs no virtual calls.
+	struct FrameCommand {
+		Int m_type;
+		Int m_playerID;
+		Int m_sortNumber;
+		NetCommandMsg *m_msg;
+	};
+	static Bool isFrameCommandBefore(const FrameCommand &a, const FrameCommand &b);
+	void clearCommands();
+
 	UnsignedInt m_frame;
 	UnsignedInt m_frameCommandCount;
 	UnsignedInt m_commandCount;
-	NetCommandList *m_commandList;
+	std::vector<FrameCommand> m_commands;		///< attached, in NetCommandList order; keeps its storage when the frame is reused
+	std::vector<UnsignedInt> m_commandIDKeys;	///< sorted player/command ID pairs of the commands in m_commands that have command IDs
 	UnsignedInt m_lastFailedCC;
 	UnsignedInt m_lastFailedFrameCC;
 };
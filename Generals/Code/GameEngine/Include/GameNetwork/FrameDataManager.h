@@ -31,6 +31,24 @@
 #include "GameNetwork/NetworkDefs.h"
 #include "GameNetwork/FrameData.h"
 
+/**
+ * What FrameDataManager::runStressBenchmark measured. The same command stream goes through
+ * FrameDataManagers and, as a baseline, through the NetCommandList per frame that FrameData
+ * used to keep. The two checksums cover the order of the merged frame command lists, so they
+ * must match.
+ */
+struct FrameDataBenchmarkResult
+{
+	Int						m_frames;						///< frames run
+	Int						m_players;					///< players sending commands every frame
+	Int						m_commands;					///< distinct commands
+	Int						m_deliveries;				///< commands handed to the frame data, counting resends
+	UnsignedInt		m_elapsedMS;				///< time spent in FrameDataManager
+	UnsignedInt		m_checksum;					///< of the merged frame command lists
+	UnsignedInt		m_listElapsedMS;		///< time spent doing the same with NetCommandLists
+	UnsignedInt		m_listChecksum;			///< of the baseline's merged frame command lists
+};
+
 class FrameDataManager : public MemoryPoolObject
 {
 	MEMORY_POOL_GLUE_WITH_USERLOOKUP_CREATE(FrameDataManager, "FrameDataManager")		
@@ -45,7 +63,8 @@ public:
 	void addNetCommandMsg(NetCommandMsg *msg);
 	void setIsLocal(Bool isLocal);
 	FrameDataReturnType allCommandsReady(UnsignedInt frame, Bool debugSpewage);
-	NetCommandList * getFrameCommandList(UnsignedInt frame);
+	Int getNumFrameCommands(UnsignedInt frame);
+	NetCommandMsg * getFrameCommand(UnsignedInt frame, Int index);
 	UnsignedInt getCommandCount(UnsignedInt frame);
 	void setFrameCommandCount(UnsignedInt frame, UnsignedInt commandCount);
 	UnsignedInt getFrameCommandCount(UnsignedInt frame);
@@ -56,6 +75,10 @@ public:
 	UnsignedInt getQuitFrame();
 	Bool getIsQuitting();
 
+	// Feed an 8 player high APM command stream through the frame data, as the replay benchmark's
+	// "-frameDataBenchmark <commands per player per frame>".
+	static void runStressBenchmark(Int commandsPerFrame, FrameDataBenchmarkResult *result);
+
 protected:
 	FrameData *m_frameData;
 	Bool m_isLocal;
@@ -60,6 +60,8 @@ public:
 	virtual AsciiString getContentsAsAsciiString(void) { return AsciiString::TheEmptyString; }
 
 protected:
+	virtual void releaseInstance();		///< called by detach when the last reference goes away
+
 	UnsignedInt m_timestamp;
 	UnsignedInt m_executionFrame;
 	UnsignedInt m_playerID;
@@ -82,18 +84,31 @@ public:
 	NetGameCommandMsg(GameMessage *msg);
 	//virtual ~NetGameCommandMsg();
 
+	static NetGameCommandMsg *newReusableInstance();	///< a blank message, reusing a released one and its argument storage if there is one
+	static void freeReusableInstances();							///< deletes the released messages held for reuse
+
 	GameMessage *constructGameMessage();
 	void addArgument(const GameMessageArgumentDataType type, GameMessageArgumentType arg);
 	void setGameMessageType(GameMessage::Type type);
+	GameMessage::Type getGameMessageType();
+	GameMessageArgument *getFirstArgument();
 
 	// For debugging purposes
 	virtual AsciiString getContentsAsAsciiString(void);
 
 protected:
+	virtual void releaseInstance();
+	void clearArguments();
+
 	Int m_numArgs;
 	Int m_argSize;
 	GameMessage::Type m_type;
 	GameMessageArgument *m_argList, *m_argTail;
+	GameMessageArgument *m_spareArgs;					///< arguments kept from the last time this message was used
+	NetGameCommandMsg *m_nextReusable;
+
+	static NetGameCommandMsg *s_reusableList;
+	static Int s_reusableCount;
 };
 
 //-----------------------------------------------------------------------------
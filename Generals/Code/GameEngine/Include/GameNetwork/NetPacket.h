@@ -46,6 +46,22 @@ be specialized code.
 
 class NetPacket;
 
+/**
+ * What NetPacket::runCodecBenchmark measured. The same game commands are encoded and decoded
+ * by NetPacket and, as a baseline, with the GameMessage/GameMessageParser encoding it used to
+ * have. The checksums cover the decoded commands, so they must match.
+ */
+struct NetPacketBenchmarkResult
+{
+	Int						m_commands;						///< game commands encoded and decoded
+	Int						m_arguments;					///< arguments in those commands
+	Int						m_bytes;							///< bytes they took up
+	UnsignedInt		m_elapsedMS;					///< time spent in NetPacket
+	UnsignedInt		m_checksum;						///< of the decoded commands
+	UnsignedInt		m_baselineElapsedMS;	///< time spent doing the same the old way
+	UnsignedInt		m_baselineChecksum;		///< of the commands the old way decoded
+};
+
 typedef std::list<NetPacket *> NetPacketList;
 typedef std::list<NetPacket *>::iterator NetPacketListIter;
 
@@ -68,6 +84,10 @@ public:
 	static NetCommandRef * ConstructNetCommandMsgFromRawData(UnsignedByte *data, UnsignedShort dataLength);
 	static NetPacketList ConstructBigCommandPacketList(NetCommandRef *ref);
 
+	// see NetPacketBenchmark.cpp
+	static Bool runRoundTripSelfTest(AsciiString *failure);
+	static void runCodecBenchmark(Int commands, NetPacketBenchmarkResult *result);
+
 	UnsignedByte *getData();
 	Int getLength();
 	UnsignedInt getAddr();
@@ -105,6 +125,9 @@ protected:
 	static UnsignedInt GetDisconnectScreenOffCommandSize(NetCommandMsg *msg);
 	static UnsignedInt GetFrameResendRequestCommandSize(NetCommandMsg *msg);
 
+	static UnsignedInt GetGameMessageArgumentsSize(NetGameCommandMsg *msg);
+	static UnsignedInt FillBufferWithGameMessageArguments(UnsignedByte *buffer, NetGameCommandMsg *msg);
+
 	static void FillBufferWithGameCommand(UnsignedByte *buffer, NetCommandRef *msg);
 	static void FillBufferWithAckCommand(UnsignedByte *buffer, NetCommandRef *msg);
 	static void FillBufferWithFrameCommand(UnsignedByte *buffer, NetCommandRef *msg);
@@ -138,7 +161,7 @@ protected:
 	Bool addAckBothCommand(NetCommandRef *msg);
 	Bool isRoomForAckMessage(NetCommandRef *msg);
 	Bool addGameCommand(NetCommandRef *msg);
-	Bool isRoomForGameMessage(NetCommandRef *msg, GameMessage *gmsg);
+	Bool isRoomForGameMessage(NetCommandRef *msg);
 	Bool addPlayerLeaveCommand(NetCommandRef *msg);
 	Bool isRoomForPlayerLeaveMessage(NetCommandRef *msg);
 	Bool addRunAheadMetricsCommand(NetCommandRef *msg);
@@ -218,7 +241,6 @@ protected:
 	static NetCommandMsg * readDisconnectScreenOffMessage(UnsignedByte *data, Int &i);
 	static NetCommandMsg * readFrameResendRequestMessage(UnsignedByte *data, Int &i);
 
-	void writeGameMessageArgumentToPacket(GameMessageArgumentDataType type, GameMessageArgumentType arg);
 	static void readGameMessageArgumentFromPacket(GameMessageArgumentDataType type, NetGameCommandMsg *msg, UnsignedByte *data, Int &i);
 
 	void dumpPacketToLog();
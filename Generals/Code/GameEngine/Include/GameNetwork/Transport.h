@@ -73,8 +73,8 @@ public:
 	Real getUnknownBytesPerSecond( void );
 	Real getUnknownPacketsPerSecond( void );
 
-	TransportMessage m_outBuffer[MAX_MESSAGES];
-	TransportMessage m_inBuffer[MAX_MESSAGES];
+	TransportMessage m_outBuffer[MAX_MESSAGES];		///< ring of packets waiting to go out, see m_outHead/m_outCount
+	TransportMessage m_inBuffer[MAX_MESSAGES];		///< received packets; a slot is free when its length is 0
 
 #if defined(_DEBUG) || defined(_INTERNAL)
 	DelayedTransportMessage m_delayedInBuffer[MAX_MESSAGES];
@@ -99,7 +99,13 @@ private:
 	Int m_statisticsSlot;
 	UnsignedInt m_lastSecond;
 
+	// Outgoing ring
+	Int m_outHead;										///< index in m_outBuffer of the oldest queued packet
+	Int m_outCount;										///< number of queued packets
+
 	Bool isGeneralsPacket( TransportMessage *msg );
+	Int getFreeIncomingSlot( Int start );		///< first free incoming slot at or after start, or -1 if there's no room
+	TransportMessage *getIncomingSlotMessage( Int slot, TransportMessage *scratch );	///< the message for a slot (scratch if -1)
 };
 
 #endif // _TRANSPORT_H_
@@ -258,6 +258,7 @@ DWORD WINAPI AsyncReplayWriter::writerThreadProc(LPVOID param)
 
 	writer->writerThreadMain();
 
+	releaseThreadMemoryPoolMagazines();
 	return 0;
 }
 
@@ -25,10 +25,356 @@
 
 #include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
 
+#include "Common/AudioEventInfo.h"
 #include "Common/AudioRequest.h"
+#include "Common/SelfTest.h"
 
+// enough for a busy frame's worth of requests, so neither list grows during play
+static const Int AUDIO_REQUESTS_TO_RESERVE = 256;
 
 AudioRequest::~AudioRequest() 
 {
 	
 }
+
+//-------------------------------------------------------------------------------------------------
+AudioRequestQueue::AudioRequestQueue() : m_processingIndex(-1)
+{
+	m_requests.reserve(AUDIO_REQUESTS_TO_RESERVE);
+	m_freeRequests.reserve(AUDIO_REQUESTS_TO_RESERVE);
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioRequestQueue::~AudioRequestQueue()
+{
+	std::vector<AudioRequest*>::iterator it;
+	for (it = m_requests.begin(); it != m_requests.end(); ++it) {
+		if (*it) {
+			(*it)->deleteInstance();
+		}
+	}
+	for (it = m_freeRequests.begin(); it != m_freeRequests.end(); ++it) {
+		(*it)->deleteInstance();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioRequest *AudioRequestQueue::allocateRequest( Bool usePendingEvent )
+{
+	AudioRequest *req;
+	if (m_freeRequests.empty()) {
+		req = newInstance(AudioRequest);
+	} else {
+		req = m_freeRequests.back();
+		m_freeRequests.pop_back();
+	}
+	req->m_request = AR_Play;
+	req->m_pendingEvent = NULL;
+	req->m_eventInfo = NULL;
+	req->m_usePendingEvent = usePendingEvent;
+	req->m_requiresCheckForSample = false;
+	return req;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioRequestQueue::releaseRequest( AudioRequest *req )
+{
+	if (req == NULL) {
+		return;
+	}
+
+	if ((Int)m_freeRequests.size() >= AUDIO_REQUESTS_TO_RESERVE) {
+		req->deleteInstance();
+		return;
+	}
+
+	// clear it, so anything still holding on to it sees an empty request rather than a stale one
+	req->m_pendingEvent = NULL;
+	req->m_eventInfo = NULL;
+	req->m_usePendingEvent = false;
+	m_freeRequests.push_back(req);
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioRequestQueue::appendRequest( AudioRequest *req )
+{
+	m_requests.push_back(req);
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioRequestQueue::removeRequest( Int index )
+{
+	AudioRequest *req = m_requests[index];
+	if (req == NULL) {
+		return;
+	}
+
+	m_requests[index] = NULL;
+
+	// processRequests releases the request it's in the middle of itself
+	if (index != m_processingIndex) {
+		releaseRequest(req);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Carry out, or put off, every request in the queue. The ones that have to wait are moved down
+	over the holes as we go. Requests appended while we're at it land past the end and get handled 
+	in this same pass. A request stays in its slot while the processor handles it, so it is seen
+	(and counted against its own limit) by anything the processor asks of the queue, but no slot 
+	ever points at a request that has been released or moved. */
+//-------------------------------------------------------------------------------------------------
+void AudioRequestQueue::processRequests( Processor *processor )
+{
+	DEBUG_ASSERTCRASH(m_processingIndex < 0, ("AudioRequestQueue::processRequests is not reentrant"));
+
+	Int numKept = 0;
+	for (Int i = 0; i < (Int)m_requests.size(); ++i) {
+		AudioRequest *req = m_requests[i];
+		if (req == NULL) {
+			continue;
+		}
+
+		if (!processor->shouldProcessRequestThisFrame(req)) {
+			m_requests[i] = NULL;
+			m_requests[numKept++] = req;
+			processor->adjustRequest(req);
+			continue;
+		}
+
+		m_processingIndex = i;
+		if (!req->m_requiresCheckForSample || processor->checkForSample(req)) {
+			processor->processRequest(req);
+		}
+		m_processingIndex = -1;
+
+		m_requests[i] = NULL;
+		releaseRequest(req);
+	}
+	m_requests.resize(numKept);
+}
+
+//-------------------------------------------------------------------------------------------------
+Int AudioRequestQueue::countRequestsToPlay( const AudioEventInfo *eventInfo ) const
+{
+	Int count = 0;
+	std::vector<AudioRequest*>::const_iterator it;
+	for (it = m_requests.begin(); it != m_requests.end(); ++it) {
+		const AudioRequest *req = *it;
+		if (req && req->m_usePendingEvent && req->m_eventInfo == eventInfo) {
+			++count;
+		}
+	}
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+// AudioRequestQueue self test
+//-------------------------------------------------------------------------------------------------
+/** Drives the queue the way the audio device does, with a processor that plays nothing but 
+	keeps a record of every request, and checks the queue against that record throughout. The 
+	processor appends, removes and counts requests from inside processRequests, including 
+	removing the one it is handling, the way playAudioEvent and doesViolateLimit can. */
+//-------------------------------------------------------------------------------------------------
+class NullAudioRequestProcessor : public AudioRequestQueue::Processor
+{
+public:
+	enum { MAX_REQUESTS = 4096, NUM_EVENTS = 3 };
+	enum RequestState { PENDING, PLAYED, REMOVED };
+
+	NullAudioRequestProcessor( AudioRequestQueue *queue ) : m_queue(queue), m_seed(1), m_numRequests(0), m_failed(false)
+	{
+		for (Int i = 0; i < NUM_EVENTS; ++i) {
+			m_events[i] = newInstance(AudioEventInfo);
+		}
+	}
+
+	virtual ~NullAudioRequestProcessor()
+	{
+		for (Int i = 0; i < NUM_EVENTS; ++i) {
+			m_events[i]->deleteInstance();
+		}
+	}
+
+	UnsignedInt random( UnsignedInt range )
+	{
+		m_seed = m_seed * 1664525 + 1013904223;
+		return (m_seed >> 8) % range;
+	}
+
+	// each request stands for a sound to play; its id goes in m_handleToInteractOn
+	void post( void )
+	{
+		if (m_numRequests >= MAX_REQUESTS) {
+			return;
+		}
+		Int id = m_numRequests++;
+		m_state[id] = PENDING;
+		m_delay[id] = random(4) == 0 ? random(5) : 0;
+		m_event[id] = random(NUM_EVENTS);
+
+		// countRequestsToPlay only looks at m_eventInfo, so the id can stand in for the event
+		AudioRequest *req = m_queue->allocateRequest(true);
+		req->m_handleToInteractOn = id + 1;
+		req->m_eventInfo = m_events[m_event[id]];
+		m_queue->appendRequest(req);
+	}
+
+	Int idOf( const AudioRequest *req )
+	{
+		Int id = (Int)req->m_handleToInteractOn - 1;
+		if (id < 0 || id >= m_numRequests || m_state[id] != PENDING) {
+			fail("the queue handed out a request that was already played, removed or released");
+			return -1;
+		}
+		return id;
+	}
+
+	void removeRandom( void )
+	{
+		Int numSlots = m_queue->getSlotCount();
+		if (numSlots == 0) {
+			return;
+		}
+		Int slot = random(numSlots);
+		AudioRequest *req = m_queue->getRequest(slot);
+		if (req == NULL) {
+			return;
+		}
+		Int id = idOf(req);
+		if (id >= 0) {
+			m_state[id] = REMOVED;
+		}
+		m_queue->removeRequest(slot);
+	}
+
+	void checkCounts( void )
+	{
+		for (Int e = 0; e < NUM_EVENTS; ++e) {
+			Int want = 0;
+			for (Int id = 0; id < m_numRequests; ++id) {
+				if (m_state[id] == PENDING && m_event[id] == e) {
+					++want;
+				}
+			}
+			if (m_queue->countRequestsToPlay(m_events[e]) != want) {
+				fail("countRequestsToPlay disagrees with the requests posted");
+			}
+		}
+	}
+
+	void fail( const char *what )
+	{
+		if (!m_failed) {
+			m_failed = true;
+			m_failure = what;
+		}
+	}
+
+	virtual Bool shouldProcessRequestThisFrame( AudioRequest *req ) const
+	{
+		// a bad id is caught by whichever of the other two gets called next
+		Int id = (Int)req->m_handleToInteractOn - 1;
+		return id < 0 || id >= m_numRequests || m_delay[id] <= 0;
+	}
+
+	virtual void adjustRequest( AudioRequest *req )
+	{
+		Int id = idOf(req);
+		if (id >= 0) {
+			--m_delay[id];
+		}
+	}
+
+	virtual Bool checkForSample( AudioRequest *req )
+	{
+		return true;
+	}
+
+	virtual void processRequest( AudioRequest *req )
+	{
+		Int id = idOf(req);
+		if (id < 0) {
+			return;
+		}
+
+		checkCounts();
+
+		switch (random(6)) {
+			case 0:
+				post();
+				break;
+			case 1:
+				removeRandom();
+				break;
+			case 2:
+			{
+				// kill ourselves, the way killAudioEventImmediately can
+				for (Int slot = 0; slot < m_queue->getSlotCount(); ++slot) {
+					if (m_queue->getRequest(slot) == req) {
+						m_queue->removeRequest(slot);
+						m_state[id] = REMOVED;
+						return;
+					}
+				}
+				fail("the request being processed isn't in its slot");
+				return;
+			}
+		}
+
+		m_state[id] = PLAYED;
+	}
+
+	AudioRequestQueue *m_queue;
+	UnsignedInt m_seed;
+	Int m_numRequests;
+	Int m_state[MAX_REQUESTS];
+	Int m_delay[MAX_REQUESTS];
+	Int m_event[MAX_REQUESTS];
+	AudioEventInfo *m_events[NUM_EVENTS];
+	Bool m_failed;
+	AsciiString m_failure;
+};
+
+static Bool audioRequestQueueSelfTest( AsciiString *failure )
+{
+	AudioRequestQueue queue;
+	NullAudioRequestProcessor processor(&queue);
+
+	for (Int frame = 0; frame < 300 && !processor.m_failed; ++frame) {
+		Int numPosts = processor.random(12);
+		for (Int i = 0; i < numPosts; ++i) {
+			processor.post();
+		}
+		if (processor.random(3) == 0) {
+			processor.removeRandom();
+		}
+		processor.checkCounts();
+		queue.processRequests(&processor);
+		processor.checkCounts();
+	}
+
+	// run it dry; nothing waits more than four frames, though processing can post more
+	for (Int drain = 0; drain < 100 && queue.getSlotCount() > 0 && !processor.m_failed; ++drain) {
+		queue.processRequests(&processor);
+	}
+
+	if (!processor.m_failed) {
+		if (queue.getSlotCount() != 0) {
+			processor.fail("requests were left in the queue");
+		}
+		for (Int id = 0; id < processor.m_numRequests; ++id) {
+			if (processor.m_state[id] == NullAudioRequestProcessor::PENDING) {
+				processor.fail("a request was dropped without being played or removed");
+				break;
+			}
+		}
+	}
+
+	if (processor.m_failed) {
+		*failure = processor.m_failure;
+		return false;
+	}
+	return true;
+}
+static SelfTestRegistration theAudioRequestQueueSelfTest( "AudioRequestQueue", audioRequestQueueSelfTest );
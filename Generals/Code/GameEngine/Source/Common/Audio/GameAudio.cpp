@@ -157,7 +157,6 @@ AudioManager::AudioManager() :
 {
 	// Added by Sadullah Nader
 	m_adjustedVolumes.clear();
-	m_audioRequests.clear();
 	m_listenerPosition.zero();
 	m_musicTracks.clear();
 	m_musicVolume = 0.0f;
@@ -412,7 +411,7 @@ void AudioManager::getInfoForAudioEvent( const AudioEventRTS *eventToFindAndFill
 //-------------------------------------------------------------------------------------------------
 AudioHandle AudioManager::addAudioEvent(const AudioEventRTS *eventToAdd)
 {
-	if (eventToAdd->getEventName().isEmpty() || eventToAdd->getEventName() == AsciiString("NoSound")) {
+	if (eventToAdd->getEventName().isEmpty() || eventToAdd->getEventName() == "NoSound") {
 		return AHSV_NoSound;
 	}
 
@@ -800,24 +799,24 @@ const Coord3D *AudioManager::getListenerPosition( void ) const
 //-------------------------------------------------------------------------------------------------
 AudioRequest *AudioManager::allocateAudioRequest( Bool useAudioEvent )
 {
-	AudioRequest *audioReq = newInstance(AudioRequest);
-	audioReq->m_usePendingEvent = useAudioEvent;
-	audioReq->m_requiresCheckForSample = false;
-	return audioReq;
+	return m_audioRequests.allocateRequest(useAudioEvent);
 }
 
 //-------------------------------------------------------------------------------------------------
 void AudioManager::releaseAudioRequest( AudioRequest *requestToRelease )
 {
-	if (requestToRelease) {
-		requestToRelease->deleteInstance();
-	}
+	m_audioRequests.releaseRequest(requestToRelease);
 }
 
 //-------------------------------------------------------------------------------------------------
 void AudioManager::appendAudioRequest( AudioRequest *m_request )
 {
-	m_audioRequests.push_back(m_request);
+	// look the event up now, so the device can match requests by info rather than by name
+	if (m_request->m_usePendingEvent && m_request->m_pendingEvent) {
+		getInfoForAudioEvent(m_request->m_pendingEvent);
+		m_request->m_eventInfo = m_request->m_pendingEvent->getAudioEventInfo();
+	}
+	m_audioRequests.appendRequest(m_request);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1000,6 +1000,78 @@ Int parseJumpToFrame(char *args[], int num)
 	return 1;
 }
 
+Int parseReplayBenchmark(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		// play the replay as fast as the logic will go: no drawing, audio, intro or fps cap
+		parseNoAudio(args, num);
+		parseNoFPSLimit(args, num);
+		TheWritableGlobalData->m_replayBenchmark = TRUE;
+		TheWritableGlobalData->m_initialFile = args[1];
+		TheWritableGlobalData->m_noDraw = 0xffffffff;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchmark(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		// only meaningful with -replayBenchmark; the paths are timed once the replay is done
+		TheWritableGlobalData->m_pathfindBenchmarkPaths = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchmarkThreads(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchmarkThreads = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseFrameDataBenchmark(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_frameDataBenchmarkCommands = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseNetPacketBenchmark(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_netPacketBenchmarkCommands = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseSelfTest(char *args[], int num)
+{
+	if (TheWritableGlobalData)
+	{
+		// the tests run before the first frame, so skip everything that would come up before it
+		TheWritableGlobalData->m_selfTest = TRUE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+	}
+	return 1;
+}
+
 Int parseUpdateImages(char *args[], int num)
 {
 	if (TheWritableGlobalData)
@@ -1185,6 +1257,12 @@ static CommandLineParam params[] =
 	{ "-noFPSLimit", parseNoFPSLimit },
 	{ "-dumpAssetUsage", parseDumpAssetUsage },
 	{ "-jumpToFrame", parseJumpToFrame },
+	{ "-replayBenchmark", parseReplayBenchmark },
+	{ "-selfTest", parseSelfTest },
+	{ "-pathfindBenchmark", parsePathfindBenchmark },
+	{ "-pathfindBenchmarkThreads", parsePathfindBenchmarkThreads },
+	{ "-frameDataBenchmark", parseFrameDataBenchmark },
+	{ "-netPacketBenchmark", parseNetPacketBenchmark },
 	{ "-updateImages", parseUpdateImages },
 	{ "-showTeamDot", parseShowTeamDot },
 #endif
@@ -69,6 +69,8 @@
 #include "Common/XferCRC.h"
 #include "Common/GameLOD.h"
 #include "Common/Registry.h"
+#include "Common/ReplayBenchmark.h"
+#include "Common/SelfTest.h"
 
 #include "GameLogic/Armor.h"
 #include "GameLogic/AI.h"
@@ -614,12 +616,19 @@ void GameEngine::execute( void )
 #if defined(_DEBUG) || defined(_INTERNAL)
 	DWORD startTime = timeGetTime() / 1000;
 #endif
+	ReplayBenchmark replayBenchmark;
+	Bool benchmarkingReplay = TheGlobalData->m_replayBenchmark;
+
+	if (TheGlobalData->m_selfTest)
+	{
+		runSelfTests();	// tells us to quit when it's done
+	}
 
 	// pretty basic for now
 	while( !m_quitting )
 	{
 
-		//if (TheGlobalData->m_vTune)
+		if (!benchmarkingReplay)	// the replay benchmark reports totals for the whole run
 		{
 #ifdef PERF_TIMERS
 			PerfGather::resetAll();
@@ -679,6 +688,11 @@ void GameEngine::execute( void )
 				}	// catch
 			}	// perf
 
+			if (benchmarkingReplay)
+			{
+				replayBenchmark.update();
+			}
+			else
 			{
 
 				if (TheTacticalView->getTimeMultiplier()<=1 && !TheScriptEngine->isTimeFast()) 
@@ -708,7 +722,7 @@ void GameEngine::execute( void )
 		}	// perfgather for execute_loop
 
 #ifdef PERF_TIMERS
-		if (!m_quitting && TheGameLogic->isInGame() && !TheGameLogic->isInShellGame() && !TheGameLogic->isGamePaused())
+		if (!benchmarkingReplay && !m_quitting && TheGameLogic->isInGame() && !TheGameLogic->isInShellGame() && !TheGameLogic->isGamePaused())
 		{
 			PerfGather::dumpAll(TheGameLogic->getFrame());
 			PerfGather::displayGraph(TheGameLogic->getFrame());
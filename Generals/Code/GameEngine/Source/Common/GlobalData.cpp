@@ -937,6 +937,12 @@ GlobalData::GlobalData()
 	setTimeOfDay( m_timeOfDay );
 
 	m_buildMapCache = FALSE;
+	m_replayBenchmark = FALSE;
+	m_selfTest = FALSE;
+	m_pathfindBenchmarkPaths = 0;
+	m_pathfindBenchmarkThreads = 0;
+	m_frameDataBenchmarkCommands = 0;
+	m_netPacketBenchmarkCommands = 0;
 	m_initialFile.clear();
 	m_pendingFile.clear();
 
@@ -179,7 +179,8 @@ Bool INI::isValidINIFilename( const char *filename )
 INI::INI( void )
 {
 
-	m_file							= NULL;
+	m_nextLine					= NULL;
+	m_linesLeft					= 0;
 	m_filename					= "None";
 	m_loadType					= INI_LOAD_INVALID;
 	m_lineNum						= 0;
@@ -255,11 +256,12 @@ void INI::loadDirectory( AsciiString dirName, Bool subdirs, INILoadType loadType
 }  // end loadDirectory
 
 //-------------------------------------------------------------------------------------------------
+/** Read the whole file and turn it into the lines readLine will hand out */
 //-------------------------------------------------------------------------------------------------
 void INI::prepFile( AsciiString filename, INILoadType loadType )
 {
 	// if we have a file open already -- we can't do another one
-	if( m_file != NULL )
+	if( m_nextLine != NULL )
 	{
 
 		DEBUG_CRASH(( "INI::load, cannot open file '%s', file already open\n", filename.str() ));
@@ -267,9 +269,15 @@ void INI::prepFile( AsciiString filename, INILoadType loadType )
 
 	}  // end if
 
+	// save our filename
+	m_filename = filename;
+
+	// save our load time
+	m_loadType = loadType;
+
 	// open the file
-	m_file = TheFileSystem->openFile(filename.str(), File::READ);
-	if( m_file == NULL )
+	File *file = TheFileSystem->openFile(filename.str(), File::READ);
+	if( file == NULL )
 	{
 
 		DEBUG_CRASH(( "INI::load, cannot open file '%s'\n", filename.str() ));
@@ -277,22 +285,33 @@ void INI::prepFile( AsciiString filename, INILoadType loadType )
 
 	}  // end if
 
-	m_file = m_file->convertToRAMFile();
+	// files out of a mapped archive can be read in place; anything else gets read into a buffer
+	Int sourceSize = file->size();
+	char *ownedSource = NULL;
+	const char *source = file->peekData();
+	if( source == NULL )
+	{
+		ownedSource = file->readEntireAndClose();
+		source = ownedSource;
+		file = NULL;
+	}
 
-	// save our filename
-	m_filename = filename;
+	splitLines( source, sourceSize );
+	m_nextLine = &m_lineStorage[ 0 ];
 
-	// save our load time
-	m_loadType = loadType;
+	if( file )
+		file->close();
+	delete [] ownedSource;
 }
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void INI::unPrepFile()
 {
-	// close the file
-	m_file->close();
-	m_file = NULL;
+	// release the lines
+	m_lineStorage.clear();
+	m_nextLine = NULL;
+	m_linesLeft = 0;
 	m_filename = "None";
 	m_loadType = INI_LOAD_INVALID;
 	m_lineNum = 0;
@@ -300,38 +319,100 @@ void INI::unPrepFile()
 	s_xfer = NULL;
 }
 
+//-------------------------------------------------------------------------------------------------
+// Token lookups used to be a linear strcmp over the table, once per table, for every line of every
+// block. The tables are all static, so each one is indexed by hash the first time it is searched
+// and the index is kept for the life of the process. Matching is still exact (strcmp), and when a
+// table lists the same token twice the first entry wins, as it did with the linear scan.
+//-------------------------------------------------------------------------------------------------
+typedef std::hash_map< const char*, INIBlockParse, std::hash<const char*>, rts::equal_to<const char*> > BlockParseMap;
+typedef std::hash_map< const char*, const FieldParse*, std::hash<const char*>, rts::equal_to<const char*> > FieldParseTokenMap;
+
+struct FieldParseIndex
+{
+	FieldParseTokenMap	m_tokens;
+	const FieldParse*		m_default;		///< the terminating entry, if it has a parse proc for unlisted tokens
+
+	FieldParseIndex() : m_default(NULL) { }
+};
+
+struct FieldParseTableHash
+{
+	size_t operator()(const FieldParse* table) const
+	{
+		std::hash<UnsignedInt> tmp;
+		return tmp((UnsignedInt)table);
+	}
+};
+
+typedef std::hash_map< const FieldParse*, FieldParseIndex, FieldParseTableHash, rts::equal_to<const FieldParse*> > FieldParseIndexMap;
+
 //-------------------------------------------------------------------------------------------------
 static INIBlockParse findBlockParse(const char* token)
 {
-	for (const BlockParse* parse = theTypeTable; parse->token; ++parse)
+	static BlockParseMap theBlockParseMap;
+	if (theBlockParseMap.empty())
 	{
-		if (strcmp( parse->token, token ) == 0)
+		for (const BlockParse* parse = theTypeTable; parse->token; ++parse)
 		{
-			return parse->parse;
+			if (theBlockParseMap.find(parse->token) == theBlockParseMap.end())
+				theBlockParseMap[parse->token] = parse->parse;
 		}
 	}
+
+	BlockParseMap::const_iterator it = theBlockParseMap.find(token);
+	if (it != theBlockParseMap.end())
+	{
+		return it->second;
+	}
 	return NULL;
 }
 
 //-------------------------------------------------------------------------------------------------
-static INIFieldParseProc findFieldParse(const FieldParse* parseTable, const char* token, int& offset, const void*& userData)
+static const FieldParseIndex& getFieldParseIndex(const FieldParse* parseTable)
 {
-	for (const FieldParse* parse = parseTable; parse->token; ++parse)
+	static FieldParseIndexMap theFieldParseIndexMap;
+
+	FieldParseIndexMap::iterator it = theFieldParseIndexMap.find(parseTable);
+	if (it != theFieldParseIndexMap.end())
 	{
-		if (strcmp( parse->token, token ) == 0)
-		{
-			offset = parse->offset;
-			userData = parse->userData;
-			return parse->parse;
-		}
+		return it->second;
+	}
+
+	FieldParseIndex& index = theFieldParseIndexMap[parseTable];
+	const FieldParse* parse;
+	for (parse = parseTable; parse->token; ++parse)
+	{
+		if (index.m_tokens.find(parse->token) == index.m_tokens.end())
+			index.m_tokens[parse->token] = parse;
+	}
+	if (parse->parse)
+	{
+		index.m_default = parse;
 	}
+	return index;
+}
 
-	if (!parse->token && parse->parse) 
+//-------------------------------------------------------------------------------------------------
+static INIFieldParseProc findFieldParse(const FieldParse* parseTable, const char* token, int& offset, const void*& userData)
+{
+	const FieldParseIndex& index = getFieldParseIndex(parseTable);
+
+	FieldParseTokenMap::const_iterator it = index.m_tokens.find(token);
+	if (it != index.m_tokens.end())
 	{
+		const FieldParse* parse = it->second;
 		offset = parse->offset;
-		userData = token;
+		userData = parse->userData;
 		return parse->parse;
 	}
+
+	if (index.m_default) 
+	{
+		offset = index.m_default->offset;
+		userData = token;
+		return index.m_default->parse;
+	}
 	else
 	{
 		return NULL;
@@ -408,65 +489,62 @@ void INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 }  // end load
 
 //-------------------------------------------------------------------------------------------------
-/** Read a line from the already open file.  Any comments will be remved and
-	* therefore ignored from any given line */
+/** Break the raw file text into the lines readLine returns: every whitespace character becomes
+	* a space, anything from a ';' on is dropped, and lines longer than the buffer are split.
+	* Each line is stored '\0' terminated in m_lineStorage and m_linesLeft is set to the count.
+	* The final line is the one during which the end of the file was reached. */
 //-------------------------------------------------------------------------------------------------
-void INI::readLine( void )
+void INI::splitLines( const char *source, Int sourceSize )
 {
-	Bool isComment = FALSE;
+	char line[ INI_MAX_CHARS_PER_LINE + 1 ];
+	Int pos = 0;
+	Bool endOfFile = FALSE;
 
-	// sanity
-	DEBUG_ASSERTCRASH( m_file, ("readLine(), file pointer is NULL\n") );
+	m_lineStorage.clear();
+	m_lineStorage.reserve( sourceSize + 1 );
+	m_linesLeft = 0;
 
-	// if we've reached end of file we'll just keep returning empty string in our buffer
-	if( m_endOfFile )
-	{
-		m_buffer[ 0 ] = '\0';	
-	}
-	else
+	while( endOfFile == FALSE )
 	{
+		Bool isComment = FALSE;
+
 		// read up till the newline character or until out of space
 		Int i = 0;
 		Bool done = FALSE;
 		while( !done )
 		{
 
-			// read character
-			m_endOfFile = (m_file->read(m_buffer + i, 1) == 0);
-
 			// check for end of file
-			if( m_endOfFile )
+			endOfFile = (pos >= sourceSize);
+			if( endOfFile )
 			{
-		
+
 				done = TRUE;
-				m_buffer[ i ] = '\0';
+				line[ i ] = '\0';
 
 			}  // end if
+			else
+			{
+				line[ i ] = source[ pos++ ];
+			}
 
 			// check for new line
-			if( m_buffer[ i ] == '\n' )
+			if( line[ i ] == '\n' )
 				done = TRUE;
 
-			DEBUG_ASSERTCRASH(m_buffer[ i ] != '\t', ("tab characters are not allowed in INI files (%s). please check your editor settings. Line Number %d\n",m_filename.str(), getLineNum()));
+			DEBUG_ASSERTCRASH(line[ i ] != '\t', ("tab characters are not allowed in INI files (%s). please check your editor settings. Line Number %d\n",m_filename.str(), m_linesLeft + 1));
 
 			// make all whitespace characters actual spaces
-			if( isspace( m_buffer[ i ] ) )
-				m_buffer[ i ] = ' ';
+			if( isspace( line[ i ] ) )
+				line[ i ] = ' ';
 
 			// if this is a semicolon, that represents the start of a comment
-			if( m_buffer[ i ] == ';' )
+			if( line[ i ] == ';' )
 				isComment = TRUE;
 
 			// if we've set the comment flag, just insert terminators in the place of each character read
 			if( isComment == TRUE )
-				m_buffer[ i ] = '\0';
-
-			//
-			// when we've become done, as the last thing just set the current index position + 1
-			// to the string terminator
-			//
-			if( done == TRUE && i + 1 < INI_MAX_CHARS_PER_LINE )
-				m_buffer[ i + 1 ] = '\0';
+				line[ i ] = '\0';
 
 			// increase our buffer index, but watch out for the max
 			if( ++i == INI_MAX_CHARS_PER_LINE )
@@ -474,9 +552,6 @@ void INI::readLine( void )
 
 		}  // end while
 
-		// increase our line count
-		m_lineNum++;
-
 		// check for at the max
 		if( i == INI_MAX_CHARS_PER_LINE )
 		{
@@ -485,6 +560,44 @@ void INI::readLine( void )
 														 INI_MAX_CHARS_PER_LINE) );
 
 		}  // end if
+
+		// keep everything up to the first terminator
+		line[ i ] = '\0';
+		m_lineStorage.insert( m_lineStorage.end(), line, line + strlen( line ) + 1 );
+		++m_linesLeft;
+
+	}  // end while
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read the next line of the already open file. Comments have already been removed
+	* by splitLines and are therefore ignored */
+//-------------------------------------------------------------------------------------------------
+void INI::readLine( void )
+{
+	// sanity
+	DEBUG_ASSERTCRASH( m_nextLine, ("readLine(), no file is open\n") );
+
+	// if we've reached end of file we'll just keep returning empty string in our buffer
+	if( m_endOfFile )
+	{
+		m_buffer[ 0 ] = '\0';	
+	}
+	else
+	{
+		Int len = strlen( m_nextLine );
+		if( len >= INI_MAX_CHARS_PER_LINE )
+			len = INI_MAX_CHARS_PER_LINE - 1;
+		memcpy( m_buffer, m_nextLine, len );
+		m_buffer[ len ] = '\0';
+		m_nextLine += strlen( m_nextLine ) + 1;
+
+		// increase our line count
+		m_lineNum++;
+
+		// the last line is the one that reached the end of the file
+		m_endOfFile = (--m_linesLeft == 0);
 	}
 
 	if (s_xfer)
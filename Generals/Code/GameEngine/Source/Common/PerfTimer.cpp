@@ -460,6 +460,21 @@ void PerfGather::reset()
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+/*static*/ void PerfGather::dumpTotals(FILE *fp)
+{
+	if (fp == NULL)
+		return;
+
+	fprintf(fp, "%-40s %12s %12s %10s\n", "Timer", "Gross(ms)", "Net(ms)", "Calls");
+	for (const PerfGather* head = getHeadPtr(); head != NULL; head = head->m_next)
+	{
+		double gross = head->m_runningTimeGross / (s_ticksPerUSec * 1000.0);
+		double net = head->m_runningTimeNet / (s_ticksPerUSec * 1000.0);
+		fprintf(fp, "%-40s %12.3f %12.3f %10d\n", head->m_identifier, gross, net, head->m_callCount);
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 /*static*/ void PerfGather::termPerfDump()
 {
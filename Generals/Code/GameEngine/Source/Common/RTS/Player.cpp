@@ -108,6 +108,11 @@
 //Grey for neutral.  
 #define NEUTRAL_PLAYER_COLOR 0xffffffff
 
+// in debug builds, check every object count query against a walk of all our team members
+#if defined(_DEBUG) && !defined(DISABLE_PLAYER_OBJECT_COUNT_CHECKING)
+	#define PLAYER_OBJECT_COUNT_CHECKING
+#endif
+
 // ------------------------------------------------------------------------------------------------
 class ClosestKindOfData
 {
@@ -305,6 +310,8 @@ Player::Player( Int playerIndex )
 
 	m_playerIndex = playerIndex;
 
+	resetObjectCounts();
+
 	// allocate new relation map pools
 	m_playerRelations = newInstance(PlayerRelationMap);
 	m_teamRelations = newInstance(TeamRelationMap);
@@ -364,6 +371,13 @@ void Player::init(const PlayerTemplate* pt)
 {
 
 	DEBUG_ASSERTCRASH(m_playerTeamPrototypes.size() == 0, ("Player::m_playerTeamPrototypes is not empty at game start!\n"));
+#ifdef DEBUG_CRASHING
+	for (ObjectCountMap::const_iterator cit = m_objectCounts.begin(); cit != m_objectCounts.end(); ++cit)
+	{
+		DEBUG_ASSERTCRASH(cit->second.m_total == 0, ("Player still has objects counted at game start!\n"));
+	}
+#endif
+	resetObjectCounts();
 	m_skillPointsModifier = 1.0f;
 	m_attackedFrame = 0;
 
@@ -598,6 +612,8 @@ void Player::setPlayerRelationship(const Player *that, Relationship r)
 	{
 		// note that this creates the entry if it doesn't exist.
 		m_playerRelations->m_map[that->getPlayerIndex()] = r;
+		if (ThePartitionManager)
+			ThePartitionManager->notifyRelationshipsChanged();
 	}
 }
 
@@ -609,6 +625,8 @@ Bool Player::removePlayerRelationship(const Player *that)
 		if (that == NULL)
 		{
 			m_playerRelations->m_map.clear();
+			if (ThePartitionManager)
+				ThePartitionManager->notifyRelationshipsChanged();
 			return true;
 		}
 		else
@@ -617,6 +635,8 @@ Bool Player::removePlayerRelationship(const Player *that)
 			if (it != m_playerRelations->m_map.end())
 			{
 				m_playerRelations->m_map.erase(it);
+				if (ThePartitionManager)
+					ThePartitionManager->notifyRelationshipsChanged();
 				return true;
 			}
 		}
@@ -631,6 +651,8 @@ void Player::setTeamRelationship(const Team *that, Relationship r)
 	{
 		// note that this creates the entry if it doesn't exist.
 		m_teamRelations->m_map[that->getID()] = r;
+		if (ThePartitionManager)
+			ThePartitionManager->notifyRelationshipsChanged();
 	}
 }
 
@@ -642,6 +664,8 @@ Bool Player::removeTeamRelationship(const Team *that)
 		if (that == NULL)
 		{
 			m_teamRelations->m_map.clear();
+			if (ThePartitionManager)
+				ThePartitionManager->notifyRelationshipsChanged();
 			return true;
 		}
 		else
@@ -650,6 +674,8 @@ Bool Player::removeTeamRelationship(const Team *that)
 			if (it != m_teamRelations->m_map.end())
 			{
 				m_teamRelations->m_map.erase(it);
+				if (ThePartitionManager)
+					ThePartitionManager->notifyRelationshipsChanged();
 				return true;
 			}
 		}
@@ -979,6 +1005,8 @@ void Player::initFromDict(const Dict* d)
 	/// @todo Ack!  the todo in PlayerList::reset() mentioning the need for a Player::reset() really needs to get done.
 	m_playerRelations->m_map.clear(); // For now, it has been decided to just fix this one.  Dear god me must reset.
 	m_teamRelations->m_map.clear(); // For now, it has been decided to just fix this one.  Dear god me must reset.
+	if (ThePartitionManager)
+		ThePartitionManager->notifyRelationshipsChanged();
 	
 	Int i;
 	for ( i = 0; i < MAX_PLAYER_COUNT; ++i ) // For now, it has been decided to just fix this one.  Dear god me must reset.
@@ -1071,6 +1099,96 @@ void Player::becomingTeamMember(Object *obj, Bool yes)
 	}
 }
 
+//=============================================================================
+void Player::resetObjectCounts( void )
+{
+	m_equivalenceIndex.clear();
+	m_equivalenceKeys.clear();
+	m_objectCounts.clear();
+	for (Int i = KINDOF_FIRST; i < KINDOF_COUNT; ++i)
+	{
+		m_kindOfCounts[i] = 0;
+		m_liveKindOfCounts[i] = 0;
+	}
+}
+
+//=============================================================================
+void Player::friend_adjustObjectCount(const ThingTemplate *tmpl, UnsignedInt countState, Int delta)
+{
+	if (!tmpl)
+		return;
+
+	DEBUG_ASSERTCRASH(countState < OBJECT_COUNT_STATE_COUNT, ("bad object count state %d\n", countState));
+
+	ObjectCountMap::iterator it = m_objectCounts.find(tmpl);
+	if (it == m_objectCounts.end())
+	{
+		DEBUG_ASSERTCRASH(delta > 0, ("removing a %s that was never counted for player %d\n", tmpl->getName().str(), getPlayerIndex()));
+		it = m_objectCounts.insert(ObjectCountMap::value_type(tmpl, TemplateObjectCount())).first;
+
+		// first time we've seen this template, so work out the things about it we'll want every time
+		TemplateObjectCount& newCount = it->second;
+		for (Int i = KINDOF_FIRST; i < KINDOF_COUNT; ++i)
+		{
+			if (tmpl->isKindOf((KindOfType)i))
+				newCount.m_kindOfBits.push_back((KindOfType)i);
+		}
+
+		const std::vector<NameKeyType>& keys = getEquivalenceKeys(tmpl);
+		for (std::vector<NameKeyType>::const_iterator kit = keys.begin(); kit != keys.end(); ++kit)
+			m_equivalenceIndex.insert(EquivalenceIndex::value_type(*kit, it));
+	}
+
+	TemplateObjectCount& count = it->second;
+	count.m_count[countState] += delta;
+	count.m_total += delta;
+	DEBUG_ASSERTCRASH(count.m_count[countState] >= 0, ("object count for %s went negative\n", tmpl->getName().str()));
+
+	Bool live = (countState & (OBJECT_COUNT_DEAD | OBJECT_COUNT_DESTROYED)) == 0;
+	for (std::vector<KindOfType>::const_iterator bit = count.m_kindOfBits.begin(); bit != count.m_kindOfBits.end(); ++bit)
+	{
+		m_kindOfCounts[*bit] += delta;
+		if (live)
+			m_liveKindOfCounts[*bit] += delta;
+	}
+
+	// templates stay in the map at zero, so that their KindOf bits and index entries are only worked out 
+	// once a game.  A player only ever has a few hundred templates, and the queries skip the empty ones.
+}
+
+//=============================================================================
+/**
+	The keys countObjectsByThingTemplate files and looks up templates under.  Two templates that are 
+	isEquivalentTo each other always share at least one of these: overrides have the same name, reskins 
+	share the name of what they were reskinned from, and build variations are matched by name, ignoring case.
+	Sharing a key doesn't make them equivalent though, so the lookups still check with isEquivalentTo.
+*/
+const std::vector<NameKeyType>& Player::getEquivalenceKeys( const ThingTemplate *tmpl ) const
+{
+	EquivalenceKeyMap::iterator it = m_equivalenceKeys.find(tmpl);
+	if (it != m_equivalenceKeys.end())
+		return it->second;
+
+	std::vector<NameKeyType>& keys = m_equivalenceKeys[tmpl];
+
+	std::vector<AsciiString> names;
+	names.push_back(tmpl->getName());
+	if (tmpl->getReskinnedFrom())
+		names.push_back(tmpl->getReskinnedFrom()->getName());
+	const std::vector<AsciiString>& variations = tmpl->getBuildVariations();
+	names.insert(names.end(), variations.begin(), variations.end());
+
+	for (std::vector<AsciiString>::iterator nit = names.begin(); nit != names.end(); ++nit)
+	{
+		nit->toLower();
+		NameKeyType key = TheNameKeyGenerator->nameToKey(*nit);
+		if (std::find(keys.begin(), keys.end(), key) == keys.end())
+			keys.push_back(key);
+	}
+
+	return keys;
+}
+
 //=============================================================================
 void Player::becomingLocalPlayer(Bool yes)
 {
@@ -1456,37 +1574,130 @@ void Player::countObjectsByThingTemplate(Int numTmplates, const ThingTemplate* c
 	for (i = 0; i < numTmplates; ++i)
 		counts[i] = 0;
 
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); 
-			 ++it)
+	// Look up just the templates we own that share a key with each one asked for, rather than testing 
+	// every template we own against every one asked for.
+	for (i = 0; i < numTmplates; ++i)
+	{
+		if (things[i] == NULL)
+			continue;
+
+		const std::vector<NameKeyType>& keys = getEquivalenceKeys(things[i]);
+		Int numKeys = keys.size();
+		for (Int k = 0; k < numKeys; ++k)
+		{
+			EquivalenceIndex::const_iterator it = m_equivalenceIndex.lower_bound(keys[k]);
+			EquivalenceIndex::const_iterator end = m_equivalenceIndex.upper_bound(keys[k]);
+			for (; it != end; ++it)
+			{
+				const ThingTemplate *tmpl = it->second->first;
+				const TemplateObjectCount& count = it->second->second;
+				if (count.m_total == 0)
+					continue;
+
+				// if it shares one of the keys we've already looked under, we've seen it already.
+				const std::vector<NameKeyType>& ownedKeys = getEquivalenceKeys(tmpl);
+				Bool seen = false;
+				for (Int earlier = 0; earlier < k && !seen; ++earlier)
+					seen = std::find(ownedKeys.begin(), ownedKeys.end(), keys[earlier]) != ownedKeys.end();
+				if (seen)
+					continue;
+
+				//Kris: Compare
+				if (!tmpl->isEquivalentTo(things[i]))
+					continue;
+
+				// each template we own only counts toward the first one asked for that it matches
+				Bool matchedEarlier = false;
+				for (Int j = 0; j < i && !matchedEarlier; ++j)
+					matchedEarlier = tmpl->isEquivalentTo(things[j]);
+				if (matchedEarlier)
+					continue;
+
+				for (UnsignedInt state = 0; state < OBJECT_COUNT_STATE_COUNT; ++state)
+				{
+					if (ignoreDead && (state & OBJECT_COUNT_DEAD))
+						continue;
+
+					if (ignoreUnderConstruction && (state & OBJECT_COUNT_UNDER_CONSTRUCTION))
+						continue;
+
+					counts[i] += count.m_count[state];
+				}
+			}
+		}
+	}
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Int *scanned = NEW Int[numTmplates];
+	for (i = 0; i < numTmplates; ++i)
+		scanned[i] = 0;
+
+	for (PlayerTeamList::const_iterator pit = m_playerTeamPrototypes.begin(); pit != m_playerTeamPrototypes.end(); ++pit)
 	{	
-		(*it)->countObjectsByThingTemplate(numTmplates, things, ignoreDead, counts, ignoreUnderConstruction);
+		(*pit)->countObjectsByThingTemplate(numTmplates, things, ignoreDead, scanned, ignoreUnderConstruction);
 	}
+
+	for (i = 0; i < numTmplates; ++i)
+	{
+		DEBUG_ASSERTCRASH(counts[i] == scanned[i], ("Player %d counted %d of %s, but its teams have %d\n", 
+			getPlayerIndex(), counts[i], things[i] ? things[i]->getName().str() : "NULL", scanned[i]));
+	}
+	delete [] scanned;
+#endif
 }
 
 //=============================================================================
 Int Player::countBuildings(void)
 {
-	int retVal = 0;
+	Int retVal = m_kindOfCounts[KINDOF_STRUCTURE];
 
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Int scanned = 0;
+	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); it != m_playerTeamPrototypes.end(); ++it)
 	{	
-		retVal += (*it)->countBuildings();
+		scanned += (*it)->countBuildings();
 	}
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d counted %d buildings, but its teams have %d\n", getPlayerIndex(), retVal, scanned));
+#endif
+
 	return retVal;
 }
 
 //=============================================================================
 Int Player::countObjects(KindOfMaskType setMask, KindOfMaskType clearMask)
 {
-	int retVal = 0;
+	Int retVal = 0;
 
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
+	if (setMask.count() == 1 && !clearMask.any())
+	{
+		// the usual question, how many of one KindOf do we have, is already counted
+		for (Int i = KINDOF_FIRST; i < KINDOF_COUNT; ++i)
+		{
+			if (setMask.test(i))
+			{
+				retVal = m_kindOfCounts[i];
+				break;
+			}
+		}
+	}
+	else
+	{
+		for (ObjectCountMap::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+		{
+			if (it->first->isKindOfMulti(setMask, clearMask))
+				retVal += it->second.m_total;
+		}
+	}
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Int scanned = 0;
+	for (PlayerTeamList::const_iterator pit = m_playerTeamPrototypes.begin(); pit != m_playerTeamPrototypes.end(); ++pit)
 	{	
-		retVal += (*it)->countObjects(setMask, clearMask);
+		scanned += (*pit)->countObjects(setMask, clearMask);
 	}
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d counted %d objects, but its teams have %d\n", getPlayerIndex(), retVal, scanned));
+#endif
+
 	return retVal;
 }
 
@@ -1510,53 +1721,107 @@ Object *Player::findClosestByKindOf( Object *queryObject, KindOfMaskType setMask
 //=============================================================================
 Bool Player::hasAnyBuildings(void) const
 {
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
+	Bool retVal = m_liveKindOfCounts[KINDOF_STRUCTURE] > 0;
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Bool scanned = false;
+	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); it != m_playerTeamPrototypes.end() && !scanned; ++it)
 	{	
-		if ((*it)->hasAnyBuildings()) {
-			return true;
-		}
+		scanned = (*it)->hasAnyBuildings();
 	}
-	return false;
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d object counts disagree with its teams about having buildings\n", getPlayerIndex()));
+#endif
+
+	return retVal;
 }
 
 //=============================================================================
 Bool Player::hasAnyBuildings(KindOfMaskType kindOf) const
 {
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
-	{	
-		if ((*it)->hasAnyBuildings(kindOf)) {
-			return true;
+	Bool retVal = false;
+
+	kindOf.set(KINDOF_STRUCTURE);
+	for (ObjectCountMap::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->second.getLiveCount() > 0 && it->first->isKindOfMulti(kindOf, KINDOFMASK_NONE))
+		{
+			retVal = true;
+			break;
 		}
 	}
-	return false;
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Bool scanned = false;
+	for (PlayerTeamList::const_iterator pit = m_playerTeamPrototypes.begin(); pit != m_playerTeamPrototypes.end() && !scanned; ++pit)
+	{	
+		scanned = (*pit)->hasAnyBuildings(kindOf);
+	}
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d object counts disagree with its teams about having buildings\n", getPlayerIndex()));
+#endif
+
+	return retVal;
 }
 
 //=============================================================================
 Bool Player::hasAnyUnits(void) const
 {
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
+	Bool retVal = false;
+
+	for (ObjectCountMap::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->second.getLiveCount() == 0)
+			continue;
+
+		// structures, projectiles and mines aren't units.
+		const ThingTemplate *tmpl = it->first;
+		if (tmpl->isKindOf(KINDOF_STRUCTURE) || tmpl->isKindOf(KINDOF_PROJECTILE) || tmpl->isKindOf(KINDOF_MINE))
+			continue;
+
+		retVal = true;
+		break;
+	}
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Bool scanned = false;
+	for (PlayerTeamList::const_iterator pit = m_playerTeamPrototypes.begin(); pit != m_playerTeamPrototypes.end() && !scanned; ++pit)
 	{	
-		if ((*it)->hasAnyUnits()) {
-			return true;
-		}
+		scanned = (*pit)->hasAnyUnits();
 	}
-	return false;
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d object counts disagree with its teams about having units\n", getPlayerIndex()));
+#endif
+
+	return retVal;
 }
 
 //=============================================================================
 Bool Player::hasAnyObjects(void) const
 {
-	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin(); 
-			 it != m_playerTeamPrototypes.end(); ++it)
+	Bool retVal = false;
+
+	for (ObjectCountMap::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->second.getLiveCount() == 0)
+			continue;
+
+		// shells & missiles, inert things (like radiation fields) and mines don't count.
+		const ThingTemplate *tmpl = it->first;
+		if (tmpl->isKindOf(KINDOF_PROJECTILE) || tmpl->isKindOf(KINDOF_INERT) || tmpl->isKindOf(KINDOF_MINE))
+			continue;
+
+		retVal = true;
+		break;
+	}
+
+#ifdef PLAYER_OBJECT_COUNT_CHECKING
+	Bool scanned = false;
+	for (PlayerTeamList::const_iterator pit = m_playerTeamPrototypes.begin(); pit != m_playerTeamPrototypes.end() && !scanned; ++pit)
 	{	
-		if ((*it)->hasAnyObjects()) {
-			return true;
-		}
+		scanned = (*pit)->hasAnyObjects();
 	}
-	return false;
+	DEBUG_ASSERTCRASH(retVal == scanned, ("Player %d object counts disagree with its teams about having objects\n", getPlayerIndex()));
+#endif
+
+	return retVal;
 }
 
 //=============================================================================
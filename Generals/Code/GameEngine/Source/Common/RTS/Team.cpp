@@ -898,6 +898,19 @@ void TeamPrototype::setControllingPlayer(Player *newController)
 
 	// impossible to get here with a NULL pointer.
 	m_owningPlayer->addTeamToList(this);
+
+	// our members now count towards the new owner
+	for (DLINK_ITERATOR<Team> iter = iterate_TeamInstanceList(); !iter.done(); iter.advance())
+	{
+		for (DLINK_ITERATOR<Object> iterObj = iter.cur()->iterate_TeamMemberList(); !iterObj.done(); iterObj.advance())
+		{
+			iterObj.cur()->updatePlayerObjectCount();
+		}
+	}
+
+	// everyone's relationship to our teams may have changed
+	if (ThePartitionManager)
+		ThePartitionManager->notifyRelationshipsChanged();
 }
 
 // ------------------------------------------------------------------------
@@ -1337,6 +1350,8 @@ Team::Team(TeamPrototype *proto, TeamID id ) :
 	if (proto)
 	{
 		proto->prependTo_TeamInstanceList(this);
+		if (TheScriptEngine)
+			TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 		if (!proto->getTemplateInfo()->m_scriptOnAllClear.isEmpty() ||
 				!proto->getTemplateInfo()->m_scriptOnEnemySighted.isEmpty())
 		{
@@ -1498,6 +1513,12 @@ Relationship Team::getRelationship(const Team *that) const
 	return getControllingPlayer()->getRelationship(that);
 }
 
+// ------------------------------------------------------------------------
+Bool Team::hasRelationshipOverrides() const
+{
+	return !m_teamRelations->m_map.empty() || !m_playerRelations->m_map.empty();
+}
+
 // ------------------------------------------------------------------------
 void Team::setTeamTargetObject(const Object *target)
 {
@@ -1795,6 +1816,19 @@ Bool Team::hasAnyObjects() const
 	return false;
 }
 
+// ------------------------------------------------------------------------
+/** Set the team as active.  A team is considered created when set active. */
+void Team::setActive(void)
+{
+	if (!m_active) 
+	{
+		m_created = true;
+		m_active = true;
+		if (TheScriptEngine)
+			TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
+	}
+}
+
 // ------------------------------------------------------------------------
 /** Clears m_enteredExited, checks & clears m_created. */
 void Team::updateState(void) 
@@ -1807,6 +1841,8 @@ void Team::updateState(void)
 	if (m_created) 
 	{
 		m_created = false;
+		if (TheScriptEngine)
+			TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 		// Run the on create script, if any.
 		if (!pInfo->m_scriptOnCreate.isEmpty()) 
 		{
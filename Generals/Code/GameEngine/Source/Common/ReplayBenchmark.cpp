@@ -0,0 +1,188 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// FILE: ReplayBenchmark.cpp //////////////////////////////////////////////////
+// Times a replay played back with drawing, audio and the frame-rate cap off.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+
+#include "Common/ReplayBenchmark.h"
+#include "Common/GameEngine.h"
+#include "Common/GlobalData.h"
+#include "Common/PerfTimer.h"
+#include "Common/Recorder.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
+#include "GameLogic/GameLogic.h"
+#include "GameNetwork/FrameDataManager.h"
+#include "GameNetwork/NetPacket.h"
+
+static const char *REPLAY_BENCHMARK_REPORT = "ReplayBenchmark.txt";
+
+//-------------------------------------------------------------------------------------------------
+ReplayBenchmark::ReplayBenchmark( void )
+{
+	m_started = FALSE;
+	m_done = FALSE;
+	m_startFrame = 0;
+	m_startTime = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::update( void )
+{
+	if (m_done || TheRecorder == NULL || TheGameLogic == NULL)
+		return;
+
+	if (!m_started)
+	{
+		// map loading is not part of the measurement; start on the first frame that is in game
+		if (TheGameLogic->isInGame() && !TheGameLogic->isInShellGame() && TheRecorder->isPlaybackInProgress())
+		{
+			m_started = TRUE;
+			m_startFrame = TheGameLogic->getFrame();
+			m_startTime = timeGetTime();
+#ifdef PERF_TIMERS
+			PerfGather::resetAll();
+#endif
+		}
+		return;
+	}
+
+	if (!TheRecorder->isPlaybackInProgress())
+		finish();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::finish( void )
+{
+	m_done = TRUE;
+
+	UnsignedInt elapsedMS = timeGetTime() - m_startTime;
+	UnsignedInt frames = TheGameLogic->getFrame() - m_startFrame;
+	UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+	Real seconds = elapsedMS / 1000.0f;
+	Real fps = (elapsedMS > 0) ? (frames * 1000.0f / elapsedMS) : 0.0f;
+
+	DEBUG_LOG(("ReplayBenchmark: %s - %d frames in %.3f sec (%.2f logic frames/sec), CRC %8.8X\n",
+		TheGlobalData->m_initialFile.str(), frames, seconds, fps, crc));
+
+	// the pathfind stress runs on the map as the replay left it, after the CRC is taken
+	PathfindBenchmarkResult paths;
+	Real pathsPerSec = 0.0f;
+	Bool benchmarkingPaths = (TheGlobalData->m_pathfindBenchmarkPaths > 0 && TheAI != NULL);
+	if (benchmarkingPaths)
+	{
+		TheAI->pathfinder()->runStressBenchmark(TheGlobalData->m_pathfindBenchmarkPaths, TheGlobalData->m_pathfindBenchmarkThreads, &paths);
+		pathsPerSec = (paths.m_elapsedMS > 0) ? (paths.m_paths * 1000.0f / paths.m_elapsedMS) : 0.0f;
+		DEBUG_LOG(("ReplayBenchmark: %d paths (%d found, %d cells) in %d ms (%.2f paths/sec), checksum %8.8X\n",
+			paths.m_paths, paths.m_pathsFound, paths.m_cells, paths.m_elapsedMS, pathsPerSec, paths.m_checksum));
+		for (Int t = 0; t < paths.m_threadRuns; ++t)
+		{
+			DEBUG_LOG(("ReplayBenchmark: snapshot, %d workers: %d paths (%d found) in %d ms (%.2f paths/sec), checksum %8.8X\n",
+				t + 1, paths.m_paths, paths.m_snapshotPathsFound, paths.m_threadElapsedMS[t],
+				(paths.m_threadElapsedMS[t] > 0) ? (paths.m_paths * 1000.0f / paths.m_threadElapsedMS[t]) : 0.0f, paths.m_threadChecksum[t]));
+		}
+	}
+
+	FrameDataBenchmarkResult frameData;
+	Bool benchmarkingFrameData = (TheGlobalData->m_frameDataBenchmarkCommands > 0);
+	if (benchmarkingFrameData)
+	{
+		FrameDataManager::runStressBenchmark(TheGlobalData->m_frameDataBenchmarkCommands, &frameData);
+		DEBUG_LOG(("ReplayBenchmark: frame data, %d frames x %d players, %d commands (%d with resends) in %d ms, checksum %8.8X; NetCommandList %d ms, checksum %8.8X\n",
+			frameData.m_frames, frameData.m_players, frameData.m_commands, frameData.m_deliveries, frameData.m_elapsedMS, frameData.m_checksum,
+			frameData.m_listElapsedMS, frameData.m_listChecksum));
+	}
+
+	NetPacketBenchmarkResult netPacket;
+	Bool benchmarkingNetPacket = (TheGlobalData->m_netPacketBenchmarkCommands > 0);
+	if (benchmarkingNetPacket)
+	{
+		NetPacket::runCodecBenchmark(TheGlobalData->m_netPacketBenchmarkCommands, &netPacket);
+		DEBUG_LOG(("ReplayBenchmark: net packet, %d game commands (%d arguments, %d bytes) in %d ms, checksum %8.8X; GameMessageParser %d ms, checksum %8.8X\n",
+			netPacket.m_commands, netPacket.m_arguments, netPacket.m_bytes, netPacket.m_elapsedMS, netPacket.m_checksum,
+			netPacket.m_baselineElapsedMS, netPacket.m_baselineChecksum));
+	}
+
+	FILE *fp = fopen(REPLAY_BENCHMARK_REPORT, "wt");
+	if (fp)
+	{
+		fprintf(fp, "Replay:     %s\n", TheGlobalData->m_initialFile.str());
+		fprintf(fp, "Frames:     %d\n", frames);
+		fprintf(fp, "Seconds:    %.3f\n", seconds);
+		fprintf(fp, "Frames/sec: %.2f\n", fps);
+		fprintf(fp, "CRC:        %8.8X\n", crc);
+		if (benchmarkingPaths)
+		{
+			fprintf(fp, "\n");
+			fprintf(fp, "Paths:      %d (%d found, one at a time)\n", paths.m_paths, paths.m_pathsFound);
+			fprintf(fp, "Cells:      %d\n", paths.m_cells);
+			fprintf(fp, "Path ms:    %d\n", paths.m_elapsedMS);
+			fprintf(fp, "Paths/sec:  %.2f\n", pathsPerSec);
+			fprintf(fp, "Path sum:   %8.8X\n", paths.m_checksum);
+			if (paths.m_threadRuns > 0)
+			{
+				fprintf(fp, "\n");
+				fprintf(fp, "Snapshot:   %d ms to build, %d found, %d cells\n", paths.m_snapshotMS, paths.m_snapshotPathsFound, paths.m_snapshotCells);
+				fprintf(fp, "Workers  ms        paths/sec  speedup  sum\n");
+				for (Int t = 0; t < paths.m_threadRuns; ++t)
+				{
+					UnsignedInt ms = paths.m_threadElapsedMS[t];
+					fprintf(fp, "%-7d  %-8d  %-9.2f  %-7.2f  %8.8X\n", t + 1, ms,
+						(ms > 0) ? (paths.m_paths * 1000.0f / ms) : 0.0f,
+						(ms > 0) ? ((Real)paths.m_threadElapsedMS[0] / ms) : 0.0f,
+						paths.m_threadChecksum[t]);
+				}
+			}
+		}
+		if (benchmarkingFrameData)
+		{
+			fprintf(fp, "\n");
+			fprintf(fp, "Frame data: %d frames x %d players, %d commands, %d with resends\n", frameData.m_frames, frameData.m_players, frameData.m_commands, frameData.m_deliveries);
+			fprintf(fp, "Storage         ms        commands/sec  sum\n");
+			fprintf(fp, "FrameData       %-8d  %-12.0f  %8.8X\n", frameData.m_elapsedMS,
+				(frameData.m_elapsedMS > 0) ? (frameData.m_deliveries * 1000.0f / frameData.m_elapsedMS) : 0.0f, frameData.m_checksum);
+			fprintf(fp, "NetCommandList  %-8d  %-12.0f  %8.8X\n", frameData.m_listElapsedMS,
+				(frameData.m_listElapsedMS > 0) ? (frameData.m_deliveries * 1000.0f / frameData.m_listElapsedMS) : 0.0f, frameData.m_listChecksum);
+		}
+		if (benchmarkingNetPacket)
+		{
+			fprintf(fp, "\n");
+			fprintf(fp, "Net packet: %d game commands, %d arguments, %d bytes, encoded and decoded\n", netPacket.m_commands, netPacket.m_arguments, netPacket.m_bytes);
+			fprintf(fp, "Encoding           ms        commands/sec  sum\n");
+			fprintf(fp, "NetPacket          %-8d  %-12.0f  %8.8X\n", netPacket.m_elapsedMS,
+				(netPacket.m_elapsedMS > 0) ? (netPacket.m_commands * 1000.0f / netPacket.m_elapsedMS) : 0.0f, netPacket.m_checksum);
+			fprintf(fp, "GameMessageParser  %-8d  %-12.0f  %8.8X\n", netPacket.m_baselineElapsedMS,
+				(netPacket.m_baselineElapsedMS > 0) ? (netPacket.m_commands * 1000.0f / netPacket.m_baselineElapsedMS) : 0.0f, netPacket.m_baselineChecksum);
+		}
+#ifdef PERF_TIMERS
+		fprintf(fp, "\n");
+		PerfGather::dumpTotals(fp);
+#endif
+		fclose(fp);
+	}
+	else
+	{
+		DEBUG_CRASH(("ReplayBenchmark: could not open %s for writing", REPLAY_BENCHMARK_REPORT));
+	}
+
+	TheGameEngine->setQuitting(TRUE);
+}
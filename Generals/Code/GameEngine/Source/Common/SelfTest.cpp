@@ -0,0 +1,101 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// FILE: SelfTest.cpp /////////////////////////////////////////////////////////
+// Checks of engine internals that run inside a fully initialized engine.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+
+#include "Common/SelfTest.h"
+#include "Common/GameEngine.h"
+
+static const char *SELF_TEST_REPORT = "SelfTest.txt";
+
+enum { MAX_SELF_TESTS = 64 };
+
+struct SelfTestEntry
+{
+	const char		*m_name;
+	SelfTestProc	m_proc;
+};
+
+// plain data, so it is zeroed before any registration's constructor runs
+static SelfTestEntry theSelfTests[MAX_SELF_TESTS];
+static Int theSelfTestCount;
+
+//-------------------------------------------------------------------------------------------------
+SelfTestRegistration::SelfTestRegistration( const char *name, SelfTestProc proc )
+{
+	if (theSelfTestCount < MAX_SELF_TESTS)
+	{
+		theSelfTests[theSelfTestCount].m_name = name;
+		theSelfTests[theSelfTestCount].m_proc = proc;
+		++theSelfTestCount;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+Int runSelfTests( void )
+{
+	DEBUG_ASSERTCRASH(theSelfTestCount < MAX_SELF_TESTS, ("SelfTest: too many tests, raise MAX_SELF_TESTS"));
+
+	FILE *fp = fopen(SELF_TEST_REPORT, "wt");
+	if (fp == NULL)
+	{
+		DEBUG_CRASH(("SelfTest: could not open %s for writing", SELF_TEST_REPORT));
+	}
+
+	Int failed = 0;
+	for (Int i = 0; i < theSelfTestCount; ++i)
+	{
+		const SelfTestEntry& test = theSelfTests[i];
+		AsciiString failure;
+		Bool passed = FALSE;
+		UnsignedInt startTime = timeGetTime();
+		try
+		{
+			passed = test.m_proc(&failure);
+		}
+		catch (...)
+		{
+			passed = FALSE;
+			failure = "threw an exception";
+		}
+		UnsignedInt elapsedMS = timeGetTime() - startTime;
+
+		if (!passed)
+			++failed;
+
+		DEBUG_LOG(("SelfTest: %-32s %s (%d ms) %s\n", test.m_name, passed ? "passed" : "FAILED", elapsedMS, failure.str()));
+		if (fp)
+			fprintf(fp, "%-32s %s (%d ms) %s\n", test.m_name, passed ? "passed" : "FAILED", elapsedMS, failure.str());
+	}
+
+	DEBUG_LOG(("SelfTest: %d of %d tests failed\n", failed, theSelfTestCount));
+	if (fp)
+	{
+		fprintf(fp, "\n%d of %d tests failed\n", failed, theSelfTestCount);
+		fclose(fp);
+	}
+
+	TheGameEngine->setQuitting(TRUE);
+	return failed;
+}
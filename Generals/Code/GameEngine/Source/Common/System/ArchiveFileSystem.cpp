@@ -123,7 +123,78 @@ ArchiveFileSystem::~ArchiveFileSystem()
 	}
 }
 
-void ArchiveFileSystem::loadIntoDirectoryTree(const ArchiveFile *archiveFile, const AsciiString& archiveFilename, Bool overwrite)
+//------------------------------------------------------
+/** Build the index key for filename into key, which must hold _MAX_PATH chars: the path
+	* lowercased, with '\\' between components and empty components dropped. As with the
+	* directory tree this replaces, the file is the last component that contains a '.', so
+	* anything after it is ignored and a path with no '.' at all names no file. */
+//------------------------------------------------------
+Bool ArchiveFileSystem::makePathKey(const Char *filename, Char *key)
+{
+	if (filename == NULL) {
+		return FALSE;
+	}
+
+	Int len = 0;
+	Int fileEnd = 0;
+	Bool inComponent = FALSE;
+	Bool componentHasDot = FALSE;
+
+	for (const Char *c = filename; ; ++c) {
+		if (*c == '\\' || *c == '/' || *c == 0) {
+			if (inComponent && componentHasDot) {
+				fileEnd = len;
+			}
+			inComponent = FALSE;
+			if (*c == 0) {
+				break;
+			}
+			continue;
+		}
+
+		if (!inComponent) {
+			if (len > 0) {
+				if (len + 1 >= _MAX_PATH) {
+					return FALSE;
+				}
+				key[len++] = '\\';
+			}
+			inComponent = TRUE;
+			componentHasDot = FALSE;
+		}
+
+		if (len + 1 >= _MAX_PATH) {
+			return FALSE;
+		}
+		if (*c == '.') {
+			componentHasDot = TRUE;
+		}
+		key[len++] = tolower(*c);
+	}
+
+	if (fileEnd == 0) {
+		return FALSE;
+	}
+	key[fileEnd] = 0;
+	return TRUE;
+}
+
+//------------------------------------------------------
+const ArchivedFileLocation * ArchiveFileSystem::findFileLocation(const Char *filename) const
+{
+	Char key[_MAX_PATH];
+	if (!makePathKey(filename, key)) {
+		return NULL;
+	}
+
+	ArchivedFilePathIndex::const_iterator it = m_pathIndex.find(AsciiString(key));
+	if (it == m_pathIndex.end()) {
+		return NULL;
+	}
+	return &it->second;
+}
+
+void ArchiveFileSystem::loadIntoDirectoryTree(ArchiveFile *archiveFile, const AsciiString& archiveFilename, Bool overwrite)
 {
 
 	FilenameList filenameList;
@@ -132,45 +203,43 @@ void ArchiveFileSystem::loadIntoDirectoryTree(const ArchiveFile *archiveFile, co
 
 	FilenameListIter it = filenameList.begin();
 
+	Char key[_MAX_PATH];
 	while (it != filenameList.end()) {
-		// add this filename to the directory tree.
-		AsciiString path = *it;
-		path.toLower();
-		AsciiString token;
-		AsciiString debugpath;
-
-		ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-		Bool infoInPath;
-		infoInPath = path.nextToken(&token, "\\/");
-
-		while (infoInPath && (!token.find('.') || path.find('.'))) {
-			ArchivedDirectoryInfoMap::iterator tempiter = dirInfo->m_directories.find(token);
-			if (tempiter == dirInfo->m_directories.end()) 
-			{
-				dirInfo->m_directories[token].clear();
-				dirInfo->m_directories[token].m_directoryName = token;
+		// add this filename to the path index.
+		if (makePathKey((*it).str(), key)) {
+			AsciiString path(key);
+			ArchivedFilePathIndex::iterator existing = m_pathIndex.find(path);
+			if (existing == m_pathIndex.end()) {
+				ArchivedFileLocation location;
+				location.m_archiveFilename = archiveFilename;
+				location.m_archiveFile = archiveFile;
+				location.m_fileInfo = archiveFile->getArchivedFileInfo(*it);
+				m_pathIndex.insert(ArchivedFilePathIndex::value_type(path, location));
+			}
+			else if (overwrite
+				|| (existing->second.m_archiveFile == NULL && existing->second.m_archiveFilename == archiveFilename)) {
+				// later archives only take over a file when asked to (mods); a reopened archive gets its own files back
+//				DEBUG_LOG(("ArchiveFileSystem::loadIntoDirectoryTree - adding file %s, archived in %s\n", key, archiveFilename.str()));
+				existing->second.m_archiveFilename = archiveFilename;
+				existing->second.m_archiveFile = archiveFile;
+				existing->second.m_fileInfo = archiveFile->getArchivedFileInfo(*it);
 			}
-
-			dirInfo = &(dirInfo->m_directories[token]);
-			debugpath.concat(token);
-			debugpath.concat('\\');
-			infoInPath = path.nextToken(&token, "\\/");
-		}
-
-		// token is the filename, and dirInfo is the directory that this file is in.
-		if (dirInfo->m_files.find(token) == dirInfo->m_files.end() || overwrite) {
-			AsciiString path2;
-			path2 = debugpath;
-			path2.concat(token);
-//			DEBUG_LOG(("ArchiveFileSystem::loadIntoDirectoryTree - adding file %s, archived in %s\n", path2.str(), archiveFilename.str()));
-			dirInfo->m_files[token] = archiveFilename;
 		}
 
 		it++;
 	}
 }
 
+void ArchiveFileSystem::removeFromPathIndex(const ArchiveFile *archiveFile)
+{
+	for (ArchivedFilePathIndex::iterator it = m_pathIndex.begin(); it != m_pathIndex.end(); ++it) {
+		if (it->second.m_archiveFile == archiveFile) {
+			it->second.m_archiveFile = NULL;
+			it->second.m_fileInfo = NULL;
+		}
+	}
+}
+
 void ArchiveFileSystem::loadMods() {
 	if (TheGlobalData->m_modBIG.isNotEmpty())
 	{
@@ -200,46 +269,18 @@ void ArchiveFileSystem::loadMods() {
 
 Bool ArchiveFileSystem::doesFileExist(const Char *filename) const
 {
-	AsciiString path = filename;
-	path.toLower();
-	AsciiString token;
-
-	const ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-	path.nextToken(&token, "\\/");
-
-	while (!token.find('.') || path.find('.')) 
-	{
-		ArchivedDirectoryInfoMap::const_iterator tempiter = dirInfo->m_directories.find(token);
-		if (tempiter != dirInfo->m_directories.end()) 
-		{
-			dirInfo = &tempiter->second;
-			path.nextToken(&token, "\\/");
-		}
-		else
-		{
-			// the directory doesn't exist, so return false
-			return FALSE;
-		}
-	}
-
-	// token is the filename, and dirInfo is the directory that this file is in.
-	if (dirInfo->m_files.find(token) == dirInfo->m_files.end()) {
-		return FALSE;
-	}
-	return TRUE;
+	return findFileLocation(filename) != NULL;
 }
 
 File * ArchiveFileSystem::openFile(const Char *filename, Int access /* = 0 */) 
 {
-	AsciiString archiveFilename;
-	archiveFilename = getArchiveFilenameForFile(AsciiString(filename));
+	const ArchivedFileLocation *location = findFileLocation(filename);
 
-	if (archiveFilename.getLength() == 0) {
+	if (location == NULL || location->m_archiveFile == NULL || location->m_fileInfo == NULL) {
 		return NULL;
 	}
 
-	return m_archiveFileMap[archiveFilename]->openFile(filename, access);
+	return location->m_archiveFile->openArchivedFile(location->m_fileInfo, filename, access);
 }
 
 Bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileInfo) const
@@ -252,11 +293,10 @@ Bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileI
 		return FALSE;
 	}
 
-	AsciiString archiveFilename = getArchiveFilenameForFile(filename);
-	ArchiveFileMap::const_iterator it = m_archiveFileMap.find(archiveFilename);
-	if (it != m_archiveFileMap.end())
+	const ArchivedFileLocation *location = findFileLocation(filename.str());
+	if (location != NULL && location->m_archiveFile != NULL)
 	{
-		return it->second->getFileInfo(filename, fileInfo);
+		return location->m_archiveFile->getFileInfo(filename, fileInfo);
 	}
 	else
 	{
@@ -266,49 +306,10 @@ Bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileI
 
 AsciiString ArchiveFileSystem::getArchiveFilenameForFile(const AsciiString& filename) const
 {
-	AsciiString path;
-	path = filename;
-	path.toLower();
-	AsciiString token;
-	AsciiString debugpath;
-
-	const ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-	path.nextToken(&token, "\\/");
-
-	while (!token.find('.') || path.find('.')) {
-
-		ArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.find(token);
-		if (it != dirInfo->m_directories.end())
-		{
-			dirInfo = &it->second;
-		}
-		else
-		{
-			// the directory doesn't exist, so return NULL
-
-			// dump the directories;
-			//DEBUG_LOG(("directory %s not found in %s in archive file system\n", token.str(), debugpath.str()));
-			//DEBUG_LOG(("directories in %s in archive file system are:\n", debugpath.str()));
-			//ArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.begin();
-			//while (it != dirInfo->m_directories.end()) {
-			//	DEBUG_LOG(("\t%s\n", it->second.m_directoryName.str()));
-			//	it++;
-			//}
-			//DEBUG_LOG(("end of directory list.\n"));
-			return AsciiString::TheEmptyString;
-		}
-
-		debugpath.concat(token);
-		debugpath.concat('\\');
-
-		path.nextToken(&token, "\\/");
-	}
-
-	ArchivedFileLocationMap::const_iterator it = dirInfo->m_files.find(token);
-	if (it != dirInfo->m_files.end())
+	const ArchivedFileLocation *location = findFileLocation(filename.str());
+	if (location != NULL)
 	{
-		return it->second;
+		return location->m_archiveFilename;
 	}
 	else
 	{
@@ -38,16 +38,13 @@
 // If verbose, lots of debug logging.
 #define not_VERBOSE
 
-CachedFileInputStream::CachedFileInputStream(void):m_buffer(NULL),m_size(0)
+CachedFileInputStream::CachedFileInputStream(void):m_buffer(NULL),m_data(NULL),m_file(NULL),m_size(0),m_pos(0)
 {
 }
 
 CachedFileInputStream::~CachedFileInputStream(void)
 {
-	if (m_buffer) {
-		delete[] m_buffer;
-		m_buffer=NULL;
-	}
+	close();
 }
 
 Bool CachedFileInputStream::open(AsciiString path)
@@ -58,28 +55,36 @@ Bool CachedFileInputStream::open(AsciiString path)
 	if (file) {
 		m_size=file->size();
 		if (m_size) {
-			m_buffer = file->readEntireAndClose();
+			// if the file is already in memory (e.g. a view of a mapped BIG file) read it in place.
+			m_data = file->peekData();
+			if (m_data) {
+				m_file = file;
+			} else {
+				m_buffer = file->readEntireAndClose();
+				m_data = m_buffer;
+			}
 			file = NULL;
 		}
 		m_pos=0;
 	}
 
-	if (CompressionManager::isDataCompressed(m_buffer, m_size) == 0)
+	if (CompressionManager::isDataCompressed(m_data, m_size) == 0)
 	{
 		//DEBUG_LOG(("CachedFileInputStream::open() - file %s is uncompressed at %d bytes!\n", path.str(), m_size));
 	}
 	else
 	{
-		Int uncompLen = CompressionManager::getUncompressedSize(m_buffer, m_size);
+		Int uncompLen = CompressionManager::getUncompressedSize(m_data, m_size);
 		//DEBUG_LOG(("CachedFileInputStream::open() - file %s is compressed!  It should go from %d to %d\n", path.str(),
 		//	m_size, uncompLen));
 		char *uncompBuffer = NEW char[uncompLen];
-		Int actualLen = CompressionManager::decompressData(m_buffer, m_size, uncompBuffer, uncompLen);
+		Int actualLen = CompressionManager::decompressData(const_cast<char *>(m_data), m_size, uncompBuffer, uncompLen);
 		if (actualLen == uncompLen)
 		{
 			//DEBUG_LOG(("Using uncompressed data\n"));
-			delete[] m_buffer;
+			releaseSource();
 			m_buffer = uncompBuffer;
+			m_data = m_buffer;
 			m_size = uncompLen;
 		}
 		else
@@ -91,8 +96,8 @@ Bool CachedFileInputStream::open(AsciiString path)
 	}
 	//if (m_size >= 4)
 	//{
-	//	DEBUG_LOG(("File starts as '%c%c%c%c'\n", m_buffer[0], m_buffer[1],
-	//		m_buffer[2], m_buffer[3]));
+	//	DEBUG_LOG(("File starts as '%c%c%c%c'\n", m_data[0], m_data[1],
+	//		m_data[2], m_data[3]));
 	//}
 
 	if (file)
@@ -102,24 +107,34 @@ Bool CachedFileInputStream::open(AsciiString path)
 	return m_size != 0;
 }
 
-void CachedFileInputStream::close(void)
+void CachedFileInputStream::releaseSource(void)
 {
 	if (m_buffer) {
 		delete[] m_buffer;
 		m_buffer=NULL;
 	}
+	if (m_file) {
+		m_file->close();
+		m_file=NULL;
+	}
+	m_data=NULL;
+}
+
+void CachedFileInputStream::close(void)
+{
+	releaseSource();
 	m_pos=0;
 	m_size=0;
 }
 
 Int CachedFileInputStream::read(void *pData, Int numBytes)
 {
-	if (m_buffer) {
+	if (m_data) {
 		if ((numBytes+m_pos)>m_size) {
 			numBytes=m_size-m_pos;
 		}
 		if (numBytes) {
-			memcpy(pData,m_buffer+m_pos,numBytes);
+			memcpy(pData,m_data+m_pos,numBytes);
 			m_pos+=numBytes;
 		}
 		return(numBytes);
@@ -225,6 +225,15 @@ Int File::position( void )
 	return seek(0, CURRENT);
 }
 
+//============================================================================
+// File::peekData
+//============================================================================
+
+const Char* File::peekData( void )
+{
+	return NULL;
+}
+
 //============================================================================
 // File::print
 //============================================================================
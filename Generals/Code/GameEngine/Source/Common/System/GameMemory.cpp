@@ -1528,8 +1528,13 @@ MemoryPool::MemoryPool() :
 	m_peakUsedBlocksInPool(0),
 	m_firstBlob(NULL),
 	m_lastBlob(NULL),
-	m_firstBlobWithFreeBlocks(NULL)
+	m_firstBlobWithFreeBlocks(NULL),
+	m_lockedAllocs(0),
+	m_lockedFrees(0)
 {
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	memset(m_magazines, 0, sizeof(m_magazines));
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -1550,6 +1555,11 @@ void MemoryPool::init(MemoryPoolFactory *factory, const char *poolName, Int allo
 	m_firstBlob = NULL;
 	m_lastBlob = NULL;
 	m_firstBlobWithFreeBlocks = NULL;
+	m_lockedAllocs = 0;
+	m_lockedFrees = 0;
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	memset(m_magazines, 0, sizeof(m_magazines));
+#endif
 
 	// go ahead and init the initial block here (will throw on failure)
 	createBlob(m_initialAllocationCount);
@@ -1643,14 +1653,12 @@ Int MemoryPool::freeBlob(MemoryPoolBlob* blob)
 
 //-----------------------------------------------------------------------------
 /**
-	allocate a block from this pool and return it, but don't bother zeroing
-	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
-	function will never return null.
+	take a block from the first blob that has one, growing the pool if necessary.
+	if unable to allocate, throw ERROR_OUT_OF_MEMORY. the caller must hold
+	TheMemoryPoolCriticalSection.
 */
-void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+MemoryPoolSingleBlock *MemoryPool::allocateBlockFromBlobs(DECLARE_LITERALSTRING_ARG1)
 {
-	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
-
 	if (m_firstBlobWithFreeBlocks != NULL && !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks()) 
 	{
 		// hmm... the current 'free' blob has nothing available. look and see if there
@@ -1708,34 +1716,15 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 	#endif
 #endif
 
-	return block->getUserData();
-}
-
-//-----------------------------------------------------------------------------
-/**
-	allocate a block from this pool and return it, and zero out the contents
-	of the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
-	function will never return null.
-*/
-void* MemoryPool::allocateBlockImplementation(DECLARE_LITERALSTRING_ARG1)
-{
-	void* p = allocateBlockDoNotZeroImplementation(PASS_LITERALSTRING_ARG1);	// throws on failure
-	memset(p, 0, getAllocationSize());
-	return p;
+	return block;
 }
 
 //-----------------------------------------------------------------------------
 /**
-	free a block allocated by this pool. it's ok to pass null.
+	give a block back to its blob. the caller must hold TheMemoryPoolCriticalSection.
 */
-void MemoryPool::freeBlock(void* pBlockPtr)
+void MemoryPool::freeBlockToBlobs(MemoryPoolSingleBlock *block)
 {
-	if (!pBlockPtr)
-		return;	// my, that was easy
-
-	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
-
-	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
 	MemoryPoolBlob *blob = block->getOwningBlob();
 #ifdef MEMORYPOOL_DEBUG
 	const char* tagString = block->debugGetLiteralTagString();
@@ -1772,6 +1761,229 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 #endif
 }
 
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+// each thread that touches a pool gets a magazine slot the first time it does so.
+// 0 means "not assigned yet", -1 means "no slot was free", otherwise it is the slot plus one.
+// each slot remembers a handle to its owning thread, so that a slot whose thread has
+// exited can be drained and handed to someone else once all of them are in use.
+static __declspec(thread) Int theThreadMagazineSlot = 0;
+static HANDLE theMagazineSlotOwners[MAX_MEMORYPOOL_MAGAZINE_THREADS];
+
+//-----------------------------------------------------------------------------
+/**
+	find a magazine slot for the calling thread (reclaiming one from an exited thread if
+	need be) and record it in the thread's TLS. returns the new TLS value.
+*/
+static Int claimThreadMagazineSlot()
+{
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	Int slot = -1;
+	Int i;
+	for (i = 0; i < MAX_MEMORYPOOL_MAGAZINE_THREADS && slot < 0; ++i)
+	{
+		if (theMagazineSlotOwners[i] == NULL)
+			slot = i;
+	}
+	for (i = 0; i < MAX_MEMORYPOOL_MAGAZINE_THREADS && slot < 0; ++i)
+	{
+		if (WaitForSingleObject(theMagazineSlotOwners[i], 0) == WAIT_OBJECT_0)
+		{
+			// the owner is gone without releasing its slot; nobody else can be using the
+			// magazine, so give its blocks back before reusing it.
+			if (TheMemoryPoolFactory)
+				TheMemoryPoolFactory->drainThreadMagazines(i);
+			CloseHandle(theMagazineSlotOwners[i]);
+			theMagazineSlotOwners[i] = NULL;
+			slot = i;
+		}
+	}
+
+	if (slot >= 0)
+	{
+		HANDLE owner = NULL;
+		if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &owner, SYNCHRONIZE, FALSE, 0))
+			slot = -1;
+		else
+			theMagazineSlotOwners[slot] = owner;
+	}
+
+	theThreadMagazineSlot = (slot >= 0) ? slot + 1 : -1;
+	return theThreadMagazineSlot;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return the magazine index for the calling thread, or -1 if it doesn't have one.
+*/
+static inline Int getThreadMagazineSlot()
+{
+	Int slot = theThreadMagazineSlot;
+	if (slot == 0)
+		slot = claimThreadMagazineSlot();
+	return (slot > 0) ? slot - 1 : -1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return the blocks parked in the given slot's magazine to the blobs. the caller must
+	hold the pool lock, and the slot's owner must not be using it.
+*/
+void MemoryPool::drainMagazine(Int slot)
+{
+	MemoryPoolMagazine& mag = m_magazines[slot];
+	while (mag.m_count > 0)
+		freeBlockToBlobs(mag.m_blocks[--mag.m_count]);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+void releaseThreadMemoryPoolMagazines()
+{
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	Int slot = theThreadMagazineSlot;
+	theThreadMagazineSlot = 0;
+	if (slot <= 0)
+		return;
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+	if (TheMemoryPoolFactory)
+		TheMemoryPoolFactory->drainThreadMagazines(slot - 1);
+	if (theMagazineSlotOwners[slot - 1] != NULL)
+	{
+		CloseHandle(theMagazineSlotOwners[slot - 1]);
+		theMagazineSlotOwners[slot - 1] = NULL;
+	}
+#endif
+}
+
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+
+//-----------------------------------------------------------------------------
+/**
+	forget everything parked in the magazines. only valid when the blobs themselves
+	are about to be thrown away, since the parked blocks are never returned to them.
+*/
+void MemoryPool::discardMagazines()
+{
+	for (Int i = 0; i < MAX_MEMORYPOOL_MAGAZINE_THREADS; ++i)
+		m_magazines[i].m_count = 0;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+	allocate a block from this pool and return it, but don't bother zeroing
+	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
+	function will never return null.
+*/
+void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+{
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	Int slot = getThreadMagazineSlot();
+	if (slot >= 0)
+	{
+		MemoryPoolMagazine& mag = m_magazines[slot];
+		if (mag.m_count > 0)
+		{
+			++mag.m_allocs;
+		}
+		else
+		{
+			ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+			++m_lockedAllocs;
+
+			// the first block may grow the pool (or throw) just like an unbatched alloc; the
+			// rest of the batch only comes out of the current free blob, so a refill never
+			// grows a pool that wouldn't otherwise have grown.
+			mag.m_blocks[mag.m_count++] = allocateBlockFromBlobs(PASS_LITERALSTRING_ARG1);
+			while (mag.m_count < MEMORYPOOL_MAGAZINE_BATCH 
+						&& m_firstBlobWithFreeBlocks != NULL 
+						&& m_firstBlobWithFreeBlocks->hasAnyFreeBlocks())
+			{
+				mag.m_blocks[mag.m_count++] = allocateBlockFromBlobs(PASS_LITERALSTRING_ARG1);
+			}
+		}
+		return mag.m_blocks[--mag.m_count]->getUserData();
+	}
+#endif
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+	++m_lockedAllocs;
+
+	return allocateBlockFromBlobs(PASS_LITERALSTRING_ARG1)->getUserData();
+}
+
+//-----------------------------------------------------------------------------
+/**
+	allocate a block from this pool and return it, and zero out the contents
+	of the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
+	function will never return null.
+*/
+void* MemoryPool::allocateBlockImplementation(DECLARE_LITERALSTRING_ARG1)
+{
+	void* p = allocateBlockDoNotZeroImplementation(PASS_LITERALSTRING_ARG1);	// throws on failure
+	memset(p, 0, getAllocationSize());
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	free a block allocated by this pool. it's ok to pass null.
+*/
+void MemoryPool::freeBlock(void* pBlockPtr)
+{
+	if (!pBlockPtr)
+		return;	// my, that was easy
+
+	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	Int slot = getThreadMagazineSlot();
+	if (slot >= 0)
+	{
+		DEBUG_ASSERTCRASH(block->getOwningBlob() && block->getOwningBlob()->getOwningPool() == this, ("block does not belong to this pool"));
+		MemoryPoolMagazine& mag = m_magazines[slot];
+		if (mag.m_count < MEMORYPOOL_MAGAZINE_SIZE)
+		{
+			++mag.m_frees;
+		}
+		else
+		{
+			ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+			++m_lockedFrees;
+			while (mag.m_count > MEMORYPOOL_MAGAZINE_SIZE - MEMORYPOOL_MAGAZINE_BATCH)
+				freeBlockToBlobs(mag.m_blocks[--mag.m_count]);
+		}
+		mag.m_blocks[mag.m_count++] = block;
+		return;
+	}
+#endif
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+	++m_lockedFrees;
+
+	freeBlockToBlobs(block);
+}
+
+//-----------------------------------------------------------------------------
+/**
+	add this pool's counters to stats. the magazine counters belong to other threads
+	and are read without locking, so they are only approximate while those threads run.
+*/
+void MemoryPool::getLockStats(MemoryPoolLockStats& stats)
+{
+	stats.lockedAllocs += m_lockedAllocs;
+	stats.lockedFrees += m_lockedFrees;
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	for (Int i = 0; i < MAX_MEMORYPOOL_MAGAZINE_THREADS; ++i)
+	{
+		stats.magazineAllocs += m_magazines[i].m_allocs;
+		stats.magazineFrees += m_magazines[i].m_frees;
+	}
+#endif
+}
+
 //-----------------------------------------------------------------------------
 Int MemoryPool::countBlobsInPool()
 {
@@ -1815,6 +2027,11 @@ void MemoryPool::reset()
 {
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	// the blobs are going away, and the parked blocks with them.
+	discardMagazines();
+#endif
+
 	// toss everything. we could do this slightly more efficiently,
 	// but not really worth the extra code to do so.
 	while (m_firstBlob) 
@@ -2026,6 +2243,7 @@ DynamicMemoryAllocator::DynamicMemoryAllocator() :
 	m_nextDmaInFactory(NULL),
 	m_numPools(0),
 	m_usedBlocksInDma(0),
+	m_dmaLocks(0),
 	m_rawBlocks(NULL)
 {
 	for (Int i = 0; i < MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS; i++)
@@ -2179,7 +2397,20 @@ void DynamicMemoryAllocator::debugIgnoreLeaksForThisBlock(void* pBlockPtr)
 */
 void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes DECLARE_LITERALSTRING_ARG2)
 {
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	// pooled sizes are fully protected by the subpool itself (which has its own magazines);
+	// the dma lock is only needed for the raw block list.
+	MemoryPool *subPool = findPoolForSize(numBytes);
+	if (subPool != NULL)
+	{
+		void *pooledResult = subPool->allocateBlockDoNotZeroImplementation(PASS_LITERALSTRING_ARG1);
+		InterlockedIncrement((LONG *)&m_usedBlocksInDma);
+		return pooledResult;
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+	++m_dmaLocks;
 
 	void *result = NULL;
 
@@ -2253,7 +2484,11 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 }
 #endif MEMORYPOOL_DEBUG
 
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	InterlockedIncrement((LONG *)&m_usedBlocksInDma);
+#else
 	++m_usedBlocksInDma;
+#endif
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 #ifdef MEMORYPOOL_DEBUG
 	#ifdef USE_FILLER_VALUE
@@ -2288,7 +2523,21 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;
 
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	// see allocateBytesDoNotZeroImplementation: pooled blocks don't need the dma lock.
+	{
+		MemoryPoolSingleBlock *pooledBlock = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+		if (pooledBlock->getOwningBlob()) 
+		{
+			pooledBlock->getOwningBlob()->getOwningPool()->freeBlock(pBlockPtr);
+			InterlockedDecrement((LONG *)&m_usedBlocksInDma);
+			return;
+		}
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+	++m_dmaLocks;
 
 #ifdef MEMORYPOOL_CHECK_BLOCK_OWNERSHIP
 	DEBUG_ASSERTCRASH(debugIsBlockInDma(pBlockPtr), ("block is not in this dma"));
@@ -2352,7 +2601,11 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 		::sysFree((void *)block);
 
 	}
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	InterlockedDecrement((LONG *)&m_usedBlocksInDma);
+#else
 	--m_usedBlocksInDma;
+#endif
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 
 #ifdef INTENSE_DMA_BOOKKEEPING
@@ -2971,6 +3224,40 @@ void MemoryPoolFactory::debugResetCheckpoints()
 }
 #endif
 
+//-----------------------------------------------------------------------------
+/**
+	sum the lock/magazine counters of all our pools and dmas (dma subpools are in our
+	pool list, so they are only counted once).
+*/
+void MemoryPoolFactory::getLockStats(MemoryPoolLockStats& stats)
+{
+	stats.clear();
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		pool->getLockStats(stats);
+	}
+	for (DynamicMemoryAllocator *dma = m_firstDmaInFactory; dma; dma = dma->getNextDmaInList())
+	{
+		stats.dmaLocks += dma->getDmaLockCount();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return the blocks parked in the given magazine slot to every pool (dma subpools are
+	in our pool list too). the caller must hold the pool lock.
+*/
+void MemoryPoolFactory::drainThreadMagazines(Int slot)
+{
+#ifdef MEMORYPOOL_THREAD_MAGAZINES
+	DEBUG_ASSERTCRASH(slot >= 0 && slot < MAX_MEMORYPOOL_MAGAZINE_THREADS, ("bad magazine slot %d", slot));
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		pool->drainMagazine(slot);
+	}
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void MemoryPoolFactory::memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead )
 {
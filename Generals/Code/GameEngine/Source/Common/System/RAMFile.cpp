@@ -108,8 +108,9 @@ RAMFile::RAMFile()
 	m_data(NULL),
 //Added By Sadullah Nader
 //Initializtion(s) inserted
-	m_pos(0)
+	m_pos(0),
 //
+	m_ownsData(TRUE)
 {
 
 }
@@ -126,9 +127,7 @@ RAMFile::RAMFile()
 
 RAMFile::~RAMFile()
 {
-	if (m_data != NULL) {
-		delete [] m_data;
-	}
+	freeData();
 
 	File::close();
 
@@ -184,6 +183,7 @@ Bool RAMFile::open( File *file )
 	// read whole file in to memory
 	m_size = file->size();
 	m_data = MSGNEW("RAMFILE") char [ m_size ];	// pool[]ify
+	m_ownsData = TRUE;
 
 	if ( m_data == NULL )
 	{
@@ -218,11 +218,9 @@ Bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 		return FALSE;
 	}
 
-	if (m_data != NULL) {
-		delete[] m_data;
-		m_data = NULL;
-	}
+	freeData();
 	m_data = MSGNEW("RAMFILE") Char [size];	// pool[]ify
+	m_ownsData = TRUE;
 	m_size = size;
 
 	if (archiveFile->seek(offset, File::START) != offset) {
@@ -236,6 +234,45 @@ Bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 	return TRUE;
 }
 
+//============================================================================
+// RAMFile::openFromMemory
+//============================================================================
+
+Bool RAMFile::openFromMemory(const Char *data, const AsciiString& filename, Int size) 
+{
+	if (data == NULL) {
+		return FALSE;
+	}
+
+	if (File::open(filename.str(), File::READ | File::BINARY) == FALSE) {
+		return FALSE;
+	}
+
+	freeData();
+
+	// we never write through m_data, so handing out a view of read only memory is safe
+	m_data = const_cast<Char *>(data);
+	m_ownsData = FALSE;
+	m_size = size;
+	m_pos = 0;
+
+	m_nameStr = filename;
+	return TRUE;
+}
+
+//============================================================================
+// RAMFile::freeData
+//============================================================================
+
+void RAMFile::freeData( void )
+{
+	if (m_data != NULL && m_ownsData) {
+		delete [] m_data;
+	}
+	m_data = NULL;
+	m_ownsData = TRUE;
+}
+
 //=================================================================
 // RAMFile::close 	
 //=================================================================
@@ -247,11 +284,7 @@ Bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 
 void RAMFile::close( void )
 {
-	if ( m_data )
-	{
-		delete [] m_data;
-		m_data = NULL;
-	}
+	freeData();
 
 	File::close();
 }
@@ -500,9 +533,25 @@ char* RAMFile::readEntireAndClose()
 	}
 
 	char* tmp = m_data;
+	if (!m_ownsData)
+	{
+		// a view of someone else's memory; the caller expects to delete[] what we return
+		tmp = MSGNEW("RAMFILE") char [ m_size ];
+		memcpy(tmp, m_data, m_size);
+	}
 	m_data = NULL;	// will belong to our caller!
+	m_ownsData = TRUE;
 
 	close();
 
 	return tmp;
 }
+
+//=================================================================
+// RAMFile::peekData
+//=================================================================
+
+const Char* RAMFile::peekData( void )
+{
+	return m_data;
+}
@@ -93,28 +93,39 @@ void XferCRC::endBlock( void )
 
 }  // end endBlock
 
+//-------------------------------------------------------------------------------------------------
+/** Same as htonl() on our little endian targets, but without a call into winsock for every word */
+//-------------------------------------------------------------------------------------------------
+static inline UnsignedInt swapBytes( UnsignedInt val )
+{
+	return (val >> 24) | ((val >> 8) & 0x0000ff00) | ((val << 8) & 0x00ff0000) | (val << 24);
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void XferCRC::addCRC( UnsignedInt val )
 {
-	int hibit;
 
-	val = htonl(val);
+	addCRCWords( &val, 1 );
 
-	if (m_crc & 0x80000000)
-	{
-		hibit = 1;
-	}
-	else
-	{
-		hibit = 0;
-	}
+}  // end addCRC
 
-	m_crc <<= 1;
-	m_crc += val;
-	m_crc += hibit;
+//-------------------------------------------------------------------------------------------------
+/** Shifting left and adding the old high bit back in is a rotate, so each block is just
+	* crc = rotl( crc, 1 ) + htonl( block ).  Keep the running value in a register for the run. */
+//-------------------------------------------------------------------------------------------------
+void XferCRC::addCRCWords( const UnsignedInt *words, Int count )
+{
 
-}  // end addCRC
+	if( count <= 0 )
+		return;
+
+	UnsignedInt crc = m_crc;
+	for( Int i = 0; i < count; ++i )
+		crc = ((crc << 1) | (crc >> 31)) + swapBytes( words[ i ] );
+	m_crc = crc;
+
+}  // end addCRCWords
 
 // ------------------------------------------------------------------------------------------------
 /** Entry point for xfering a snapshot */
@@ -147,10 +158,8 @@ void XferCRC::xferImplementation( void *data, Int dataSize )
 
 	const UnsignedInt *uintPtr = (const UnsignedInt *) (data);
 
-	for (Int i=0 ; i<dataSize/4 ; i++)
-	{
-		addCRC (*uintPtr++);
-	}
+	addCRCWords (uintPtr, dataSize/4);
+	uintPtr += dataSize/4;
 
 	int leftover = dataSize & 3;
 	if (leftover)
@@ -161,7 +170,7 @@ void XferCRC::xferImplementation( void *data, Int dataSize )
 		{
 			val += (c[i] << (i*8));
 		}
-		val = htonl(val);
+		val = swapBytes(val);
 		addCRC (val);
 	}
 	
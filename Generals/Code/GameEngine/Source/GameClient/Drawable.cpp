@@ -326,6 +326,10 @@ Drawable::Drawable( const ThingTemplate *thingTemplate, DrawableStatus statusBit
 	m_nextDrawable = NULL;
 	m_prevDrawable = NULL;
 	//
+	m_nextGridDrawable = NULL;
+	m_prevGridDrawable = NULL;
+	m_gridBucket = -1;
+	m_listOrder = 0;
 
 	// register drawable with the GameClient ... do this first before we start doing anything
 	// complex that uses any of the drawable data so that we have and ID!!  It's ok to initialize
@@ -572,6 +576,47 @@ Bool Drawable::isVisible()
 	return FALSE;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Drawables that are off camera, have nothing in progress and whose client update modules are
+	* all asleep can skip updateDrawable() this frame.  Anything that updateDrawable() would
+	* advance or react to keeps us awake. */
+//-------------------------------------------------------------------------------------------------
+Bool Drawable::needsClientUpdate( void )
+{
+	UnsignedInt now = TheGameLogic->getFrame();
+
+	if (m_fadeMode != FADING_NONE || m_flashCount > 0 || m_prevTintStatus != m_tintStatus)
+		return TRUE;
+
+	if (m_expirationDate != 0 && now >= m_expirationDate)
+		return TRUE;
+
+	if (getTerrainDecalType() != TERRAIN_DECAL_NONE ? m_decalOpacityFadeRate != 0.0f : m_decalOpacity != 0.0f)
+		return TRUE;
+
+	if ((m_colorTintEnvelope && !m_colorTintEnvelope->isResting()) ||
+			(m_selectionFlashEnvelope && !m_selectionFlashEnvelope->isResting()))
+		return TRUE;
+
+	const Object *obj = getObject();
+	if (obj && !obj->isEffectivelyDead() && testTintStatus( TINT_STATUS_IRRADIATED ))
+		return TRUE;
+
+	if( m_ambientSound && m_ambientSoundEnabled && !m_ambientSound->m_event.getEventName().isEmpty() && !m_ambientSound->m_event.isCurrentlyPlaying() ) 
+		return TRUE;
+
+	if (isVisible())
+		return TRUE;
+
+	for (ClientUpdateModule** cu = getClientUpdateModules(); cu && *cu; ++cu)
+	{
+		if ((*cu)->getOffscreenWakeFrame() <= now)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
 //-------------------------------------------------------------------------------------------------
 Bool Drawable::getShouldAnimate( Bool considerPower ) const
 {
@@ -3698,6 +3743,10 @@ void Drawable::setPosition(const Coord3D *pos)
 //-------------------------------------------------------------------------------------------------
 void Drawable::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle)
 {
+	// keep the client's spatial grid current so region queries find us where we are now
+	if (m_gridBucket != -1)
+		TheGameClient->updateDrawableInGrid( this );
+
 	for (DrawModule** dm = getDrawModules(); *dm; ++dm)
 	{
 		(*dm)->reactToTransformChange(oldMtx, oldPos, oldAngle);
@@ -3993,6 +4042,39 @@ void Drawable::removeFromList(Drawable **pListHead)
 		*pListHead = m_nextDrawable;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** add self to a bucket of the client drawable grid */
+//-------------------------------------------------------------------------------------------------
+void Drawable::prependToGridList(Drawable **pListHead, Int bucket)
+{
+	DEBUG_ASSERTCRASH( m_gridBucket == -1, ("Drawable is already in grid bucket %d\n", m_gridBucket) );
+
+	m_prevGridDrawable = NULL;
+	m_nextGridDrawable = *pListHead;
+	if (*pListHead)
+		(*pListHead)->m_prevGridDrawable = this;
+	*pListHead = this;
+	m_gridBucket = bucket;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** remove self from its bucket of the client drawable grid */
+//-------------------------------------------------------------------------------------------------
+void Drawable::removeFromGridList(Drawable **pListHead)
+{
+	if (m_nextGridDrawable)
+		m_nextGridDrawable->m_prevGridDrawable = m_prevGridDrawable;
+
+	if (m_prevGridDrawable)
+		m_prevGridDrawable->m_nextGridDrawable = m_nextGridDrawable;
+	else
+		*pListHead = m_nextGridDrawable;
+
+	m_nextGridDrawable = NULL;
+	m_prevGridDrawable = NULL;
+	m_gridBucket = -1;
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void Drawable::updateHiddenStatus()
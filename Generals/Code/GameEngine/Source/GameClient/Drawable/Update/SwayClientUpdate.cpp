@@ -141,6 +141,17 @@ void SwayClientUpdate::clientUpdate( void )
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Off camera we only run to pick up a change in the breeze. */
+//-------------------------------------------------------------------------------------------------
+UnsignedInt SwayClientUpdate::getOffscreenWakeFrame() const
+{
+	if( m_swaying && TheScriptEngine->getBreezeInfo().m_breezeVersion != m_curVersion )
+		return 0;
+
+	return FOREVER;
+}
+
 // ------------------------------------------------------------------------------------------------
 /** CRC */
 // ------------------------------------------------------------------------------------------------
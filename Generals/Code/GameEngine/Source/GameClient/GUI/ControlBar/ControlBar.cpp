@@ -1294,8 +1294,8 @@ void ControlBar::update( void )
 		{
 			if (m_animateWindowManager->isFinished() && m_animateWindowManager->isReversed())
 			{
-				Int id = (Int)TheNameKeyGenerator->nameToKey(AsciiString("ControlBar.wnd:ControlBarParent"));
-				GameWindow *window = TheWindowManager->winGetWindowFromId(NULL, id);
+				static GameWindowHandle controlBarParent("ControlBar.wnd:ControlBarParent");
+				GameWindow *window = TheWindowManager->winGetWindowFromHandle(controlBarParent);
 				if (window && !window->winIsHidden())
 					window->winHide(TRUE);
 			}
@@ -1409,8 +1409,8 @@ void ControlBar::update( void )
 		Int count;
 		const ThingTemplate *thing = TheThingFactory->findTemplate( ThePlayerList->getLocalPlayer()->getPlayerTemplate()->getBeaconTemplate() );
 		ThePlayerList->getLocalPlayer()->countObjectsByThingTemplate( 1, &thing, false, &count );
-		static NameKeyType beaconPlacementButtonID = NAMEKEY("ControlBar.wnd:ButtonPlaceBeacon");
-		GameWindow *win = TheWindowManager->winGetWindowFromId(NULL, beaconPlacementButtonID);
+		static GameWindowHandle beaconPlacementButton("ControlBar.wnd:ButtonPlaceBeacon");
+		GameWindow *win = TheWindowManager->winGetWindowFromHandle(beaconPlacementButton);
 		if (win)
 		{
 			if (count < TheMultiplayerSettings->getMaxBeaconsPerPlayer())
@@ -1545,7 +1545,8 @@ const Image *ControlBar::getStarImage(void )
 	else
 		m_lastFlashedAtPointValue = ThePlayerList->getLocalPlayer()->getSciencePurchasePoints();
 	
-	GameWindow *win= TheWindowManager->winGetWindowFromId( NULL, TheNameKeyGenerator->nameToKey( "ControlBar.wnd:ButtonGeneral" ) );
+	static GameWindowHandle generalButton( "ControlBar.wnd:ButtonGeneral" );
+	GameWindow *win= TheWindowManager->winGetWindowFromHandle( generalButton );
 	if(!win)
 		return NULL;
 	if(!m_genStarFlash)
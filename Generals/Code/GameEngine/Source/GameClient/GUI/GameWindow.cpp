@@ -115,6 +115,8 @@ GameWindow::GameWindow( void )
 	m_parent = NULL;
 	m_child = NULL;
 
+	m_idIndexSlot = -1;
+
 	m_nextLayout = NULL;
 	m_prevLayout = NULL;
 	m_layout = NULL;
@@ -128,6 +130,10 @@ GameWindow::GameWindow( void )
 GameWindow::~GameWindow( void )
 {
 
+	// windows are normally taken out of the id index when destroyed, but be sure
+	if( TheWindowManager )
+		TheWindowManager->removeWindowFromIdIndex( this, winGetWindowId() );
+
 	if(	m_inputData )
 		delete m_inputData;
 	m_inputData = NULL;
@@ -1009,6 +1015,7 @@ Color GameWindow::winGetHiliteTextBorderColor( void )
 Int GameWindow::winSetInstanceData( WinInstanceData *data )
 {
 	DisplayString *text, *tooltipText;
+	Int oldId = m_instData.m_id;
 
 	// save our own instance of text and tooltip text display strings
 	text = m_instData.m_text;
@@ -1032,6 +1039,10 @@ Int GameWindow::winSetInstanceData( WinInstanceData *data )
 	if( data->getTooltipTextLength() )
 		m_instData.setTooltipText( data->getTooltipText() );
 
+	// the window manager finds us by id
+	if( m_instData.m_id != oldId )
+		TheWindowManager->windowIdChanged( this, oldId );
+
 	return WIN_ERR_OK;
 
 }  // end WinSetInstanceData
@@ -1081,9 +1092,14 @@ void GameWindow::winSetTooltip( UnicodeString tip )
 //=============================================================================
 Int GameWindow::winSetWindowId( Int id )
 {
+	Int oldId = m_instData.m_id;
 
 	m_instData.m_id = id;
 
+	// the window manager finds us by id
+	if( id != oldId )
+		TheWindowManager->windowIdChanged( this, oldId );
+
 	return WIN_ERR_OK;
 
 }  // end WinSetWindowId
@@ -188,6 +188,8 @@ GameWindowManager::GameWindowManager( void )
 
 	m_destroyList = NULL;			// list of windows to destroy
 
+	m_windowTreeGeneration = 1;		// handles start at 0, so they all look the first time
+
 	m_currMouseRgn = NULL;		// window that mouse is over
 	m_mouseCaptor = NULL;			// window that captured mouse
 	m_keyboardFocus = NULL;		// window that has input focus
@@ -254,6 +256,8 @@ void GameWindowManager::update( void )
 //-------------------------------------------------------------------------------------------------
 void GameWindowManager::linkWindow( GameWindow *window )
 {
+	++m_windowTreeGeneration;
+
 	GameWindow *lastModalWindow = NULL;
 	GameWindow *tmp = m_windowList;
 	while (tmp)
@@ -314,6 +318,8 @@ void GameWindowManager::insertWindowAheadOf( GameWindow *window,
 	if( window == NULL )
 		return;
 
+	++m_windowTreeGeneration;
+
 	// we'll say that an aheadOf window means at the head of the list
 	if( aheadOf == NULL )	
 	{
@@ -369,6 +375,8 @@ void GameWindowManager::insertWindowAheadOf( GameWindow *window,
 void GameWindowManager::unlinkWindow( GameWindow *window )
 {
 
+	++m_windowTreeGeneration;
+
 	if( window->m_next )
 		window->m_next->m_prev = window->m_prev;
 	else 
@@ -390,6 +398,8 @@ void GameWindowManager::unlinkWindow( GameWindow *window )
 void GameWindowManager::unlinkChildWindow( GameWindow *window )
 {
 
+	++m_windowTreeGeneration;
+
 	if( window->m_prev ) 
 	{
 
@@ -491,6 +501,8 @@ void GameWindowManager::addWindowToParent( GameWindow *window,
 	if( parent ) 
 	{
 
+		++m_windowTreeGeneration;
+
 		// add to parent's list of children
 		window->m_prev = NULL;
 		window->m_next = parent->m_child;
@@ -517,6 +529,8 @@ void GameWindowManager::addWindowToParentAtEnd( GameWindow *window,
 	if( parent )
 	{
 
+		++m_windowTreeGeneration;
+
 		window->m_prev = NULL;
 		window->m_next = NULL;
 		if( parent->m_child )
@@ -653,9 +667,109 @@ GameWindow *GameWindowManager::winGetCapture( void )
 }  // end WinGetCapture
 
 //-------------------------------------------------------------------------------------------------
-/** Gets the window pointer from its id */
+/** Add a newly created window to the id index, under whatever id it has right now */
 //-------------------------------------------------------------------------------------------------
-GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
+void GameWindowManager::addWindowToIdIndex( GameWindow *window )
+{
+
+	DEBUG_ASSERTCRASH( window->m_idIndexSlot == -1, ("addWindowToIdIndex: window is already indexed\n") );
+
+	GameWindowVector &bucket = m_windowIdIndex[ window->winGetWindowId() ];
+	window->m_idIndexSlot = bucket.size();
+	bucket.push_back( window );
+
+	++m_windowTreeGeneration;
+
+}  // end addWindowToIdIndex
+
+//-------------------------------------------------------------------------------------------------
+/** Take a window out of the id index bucket for 'id'.  Windows that were never indexed
+	* (the editor makes a few of those) are left alone */
+//-------------------------------------------------------------------------------------------------
+void GameWindowManager::removeWindowFromIdIndex( GameWindow *window, Int id )
+{
+
+	if( window->m_idIndexSlot == -1 )
+		return;
+
+	GameWindowIdMap::iterator it = m_windowIdIndex.find( id );
+	if( it == m_windowIdIndex.end() )
+	{
+		DEBUG_CRASH(( "removeWindowFromIdIndex: no bucket for id %d\n", id ));
+		return;
+	}
+
+	// order within a bucket doesn't matter, so fill the hole with the last one
+	GameWindowVector &bucket = it->second;
+	Int slot = window->m_idIndexSlot;
+	DEBUG_ASSERTCRASH( slot < bucket.size() && bucket[ slot ] == window, 
+										 ("removeWindowFromIdIndex: window is not where it thinks it is\n") );
+
+	GameWindow *last = bucket.back();
+	bucket[ slot ] = last;
+	last->m_idIndexSlot = slot;
+	bucket.pop_back();
+	window->m_idIndexSlot = -1;
+
+	if( bucket.empty() )
+		m_windowIdIndex.erase( it );
+
+	++m_windowTreeGeneration;
+
+}  // end removeWindowFromIdIndex
+
+//-------------------------------------------------------------------------------------------------
+/** A window's id changed, file it under the new one */
+//-------------------------------------------------------------------------------------------------
+void GameWindowManager::windowIdChanged( GameWindow *window, Int oldId )
+{
+
+	if( window->m_idIndexSlot == -1 )
+		return;
+
+	removeWindowFromIdIndex( window, oldId );
+	addWindowToIdIndex( window );
+
+}  // end windowIdChanged
+
+//-------------------------------------------------------------------------------------------------
+/** Would a search that starts at 'first' (which walks 'first', the siblings after it, and all
+	* of their children) reach 'window'?  A NULL 'first' means the whole window list */
+//-------------------------------------------------------------------------------------------------
+Bool GameWindowManager::isWindowInSearch( GameWindow *window, GameWindow *first )
+{
+
+	if( first == NULL )
+		first = m_windowList;
+
+	if( first == NULL )
+		return FALSE;
+
+	// climb to the ancestor of window that lives in the same sibling list as 'first'
+	GameWindow *level = first->m_parent;
+	while( window && window != first && window->m_parent != level )
+		window = window->m_parent;
+
+	if( window == NULL )
+		return FALSE;
+
+	// and make sure it's really in that list, at or after 'first'
+	for( GameWindow *sibling = first; sibling; sibling = sibling->m_next )
+	{
+
+		if( sibling == window )
+			return TRUE;
+
+	}  // end for
+
+	return FALSE;
+
+}  // end isWindowInSearch
+
+//-------------------------------------------------------------------------------------------------
+/** Depth first search of the window tree from 'window' for the first window with this id */
+//-------------------------------------------------------------------------------------------------
+GameWindow *GameWindowManager::searchWindowTreeForId( GameWindow *window, Int id )
 {
 
 	if( window == NULL )
@@ -668,7 +782,7 @@ GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
 			return window;
 		else if( window->m_child ) 
 		{
-			GameWindow *child = winGetWindowFromId( window->m_child, id );
+			GameWindow *child = searchWindowTreeForId( window->m_child, id );
 
 			if( child )
 				return child;
@@ -679,8 +793,67 @@ GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
 
 	return NULL;
 
+}  // end searchWindowTreeForId
+
+//-------------------------------------------------------------------------------------------------
+/** Gets the window pointer from its id */
+//-------------------------------------------------------------------------------------------------
+GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
+{
+
+	GameWindowIdMap::const_iterator it = m_windowIdIndex.find( id );
+	if( it == m_windowIdIndex.end() )
+		return NULL;
+
+	//
+	// look at just the windows with this id and see which of them the search would reach.
+	// ids are almost always unique, but if more than one is reachable we have to search
+	// the tree to find out which one the search reaches first
+	//
+	const GameWindowVector &bucket = it->second;
+	GameWindow *found = NULL;
+	for( GameWindowVector::const_iterator w = bucket.begin(); w != bucket.end(); ++w )
+	{
+
+		if( isWindowInSearch( *w, window ) )
+		{
+
+			if( found )
+				return searchWindowTreeForId( window, id );
+
+			found = *w;
+
+		}  // end if
+
+	}  // end for
+
+	return found;
+
 }  // end WinGetWindowFromId
 
+//-------------------------------------------------------------------------------------------------
+/** Gets the window a handle names, only searching again when the window tree has changed
+	* since the last time */
+//-------------------------------------------------------------------------------------------------
+GameWindow *GameWindowManager::winGetWindowFromHandle( GameWindowHandle &handle, GameWindow *window )
+{
+
+	if( handle.m_id == NAMEKEY_INVALID )
+		handle.m_id = TheNameKeyGenerator->nameToKey( handle.m_name );
+
+	if( handle.m_treeGeneration != m_windowTreeGeneration || handle.m_parent != window )
+	{
+
+		handle.m_window = winGetWindowFromId( window, handle.m_id );
+		handle.m_parent = window;
+		handle.m_treeGeneration = m_windowTreeGeneration;
+
+	}  // end if
+
+	return handle.m_window;
+
+}  // end winGetWindowFromHandle
+
 //-------------------------------------------------------------------------------------------------
 /** Gets the Window List Pointer */
 //-------------------------------------------------------------------------------------------------
@@ -1424,6 +1597,9 @@ GameWindow *GameWindowManager::winCreate( GameWindow *parent,
 	else
 		linkWindow( window );
 
+	// and make it findable by id (this follows any id it's given from here on)
+	addWindowToIdIndex( window );
+
 	window->m_status = status;
 	window->m_size.x = width;
 	window->m_size.y = height;
@@ -1481,6 +1657,9 @@ Int GameWindowManager::winDestroy( GameWindow *window )
 	BitSet( window->m_status, WIN_STATUS_DESTROYED );
 	window->freeImages();
 
+	// nobody can find it by id anymore
+	removeWindowFromIdIndex( window, window->winGetWindowId() );
+
 	if( m_mouseCaptor == window )
 		winRelease( window );
 
@@ -87,7 +87,8 @@
 //#pragma MESSAGE("************************************** WARNING, optimization disabled for debugging purposes")
 #endif
 
-#define DRAWABLE_HASH_SIZE	8192
+/// world size of one cell of the drawable grid
+static const Real DRAWABLE_GRID_CELL_SIZE = 100.0f;
 
 /// The GameClient singleton instance
 GameClient *TheGameClient = NULL;
@@ -111,6 +112,13 @@ GameClient::GameClient()
 	m_frame = 0;
 
 	m_drawableList = NULL;
+	clearDrawableGrid();
+	m_regionIterationDepth = 0;
+	m_nextDrawableListOrder = 0;
+
+	m_renderedObjectCount = 0;
+	m_updatedDrawableCount = 0;
+	m_skippedDrawableCount = 0;
 	
 	m_nextDrawableID = (DrawableID)1;
 	TheDrawGroupInfo = new DrawGroupInfo;
@@ -431,7 +439,6 @@ void GameClient::reset( void )
 {
 	Drawable *draw, *nextDraw;
 	m_drawableHash.clear();
-	m_drawableHash.resize(DRAWABLE_HASH_SIZE);
 	
 	// need to reset the in game UI to clear drawables before they are destroyed
 	TheInGameUI->reset();
@@ -443,6 +450,7 @@ void GameClient::reset( void )
 		destroyDrawable( draw );
 	}
 	m_drawableList = NULL;
+	clearDrawableGrid();
 
 	TheDisplay->reset();
 	TheTerrainVisual->reset();
@@ -476,8 +484,12 @@ void GameClient::registerDrawable( Drawable *draw )
 	draw->setID( allocDrawableID() );
 
 	// add the drawable to the master list
+	draw->setListOrder( m_nextDrawableListOrder++ );
 	draw->prependToList( &m_drawableList );
 
+	// and to the spatial grid, it will follow its own position changes from here on
+	addDrawableToGrid( draw );
+
 }  // end registerDrawable
 
 /** -----------------------------------------------------------------------------------------------
@@ -639,7 +651,9 @@ void GameClient::update( void )
 		}
 
 
-		// call the update for all client drawables
+		// call the update for all client drawables that have something to do
+		m_updatedDrawableCount = 0;
+		m_skippedDrawableCount = 0;
 		Drawable* draw = firstDrawable();
 		while (draw)
 		{	// update() could free the Drawable, so go ahead and grab 'next'
@@ -676,7 +690,15 @@ void GameClient::update( void )
 					draw->setFullyObscuredByShroud(ss >= OBJECTSHROUD_FOGGED);
 				}
 			}
-			draw->updateDrawable();
+			if (draw->needsClientUpdate())
+			{
+				draw->updateDrawable();
+				++m_updatedDrawableCount;
+			}
+			else
+			{
+				++m_skippedDrawableCount;
+			}
 			draw = next;
 		}
 	}
@@ -734,25 +756,190 @@ void GameClient::update( void )
 }  // end update
 
 /** -----------------------------------------------------------------------------------------------
- * Call the given callback function for each object contained within the given region.
+ * Sorts region query results into the order of the master drawable list, newest first.
+ */
+Bool GameClient::isEarlierInDrawableList( const RegionDrawable &a, const RegionDrawable &b )
+{
+	return a.listOrder > b.listOrder;
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Call the given callback function for each object contained within the given region.  Drawables
+ * are visited in the same order as the master list, and exactly once each, even if a callback
+ * moves a drawable into another bucket.
  */
 void GameClient::iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr userFunc, void *userData )
 {
 	Drawable *draw, *nextDrawable;
 
-	for( draw = m_drawableList; draw; draw=nextDrawable )
+	// no region means everything, just walk the master list
+	if( region == NULL )
 	{
-		nextDrawable = draw->getNextDrawable();
-
-		Coord3D pos = *draw->getPosition();
-		if( region == NULL ||
-			  (pos.x >= region->lo.x && pos.x <= region->hi.x &&
-			   pos.y >= region->lo.y && pos.y <= region->hi.y &&
-				 pos.z >= region->lo.z && pos.z <= region->hi.z) )
+		for( draw = m_drawableList; draw; draw=nextDrawable )
 		{
+			nextDrawable = draw->getNextDrawable();
 			(*userFunc)( draw, userData );
 		}
+		return;
+	}
+
+	// the outermost query reuses our scratch, a query made from inside a callback gets its own
+	RegionDrawableVector nestedDrawables;
+	RegionDrawableVector &found = (m_regionIterationDepth == 0) ? m_regionDrawables : nestedDrawables;
+	found.clear();
+
+	// collect from only the grid buckets the region overlaps
+	Int loX, hiX, loY, hiY;
+	getDrawableGridCellRange( region->lo.x, region->hi.x, &loX, &hiX );
+	getDrawableGridCellRange( region->lo.y, region->hi.y, &loY, &hiY );
+
+	for( Int y = loY; y <= hiY; ++y )
+	{
+		for( Int x = loX; x <= hiX; ++x )
+		{
+			Int bucket = (x & DRAWABLE_GRID_MASK) | ((y & DRAWABLE_GRID_MASK) << DRAWABLE_GRID_SHIFT);
+
+			for( draw = m_drawableGrid[ bucket ]; draw; draw = draw->getNextGridDrawable() )
+			{
+				// buckets are shared by every cell that wraps onto them, so the test is still needed
+				const Coord3D *pos = draw->getPosition();
+				if( pos->x >= region->lo.x && pos->x <= region->hi.x &&
+						pos->y >= region->lo.y && pos->y <= region->hi.y &&
+						pos->z >= region->lo.z && pos->z <= region->hi.z )
+				{
+					RegionDrawable entry;
+					entry.listOrder = draw->getListOrder();
+					entry.id = draw->getID();
+					found.push_back( entry );
+				}
+			}
+
+		}  // end for x
+
+	}  // end for y
+
+	// selection and the like pick the first hit, so keep the master list's order
+	std::sort( found.begin(), found.end(), isEarlierInDrawableList );
+
+	// nothing is called until every bucket has been walked, so re-bucketing can't make us see a
+	// drawable twice, and anything destroyed along the way just isn't found any more
+	++m_regionIterationDepth;
+	for( RegionDrawableVector::const_iterator it = found.begin(); it != found.end(); ++it )
+	{
+		draw = findDrawableByID( it->id );
+		if( draw )
+			(*userFunc)( draw, userData );
+	}
+	--m_regionIterationDepth;
+
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Return the grid bucket that a world position falls in.
+ */
+Int GameClient::getDrawableGridBucket( const Coord3D *pos )
+{
+	Int x = REAL_TO_INT_FLOOR( pos->x / DRAWABLE_GRID_CELL_SIZE );
+	Int y = REAL_TO_INT_FLOOR( pos->y / DRAWABLE_GRID_CELL_SIZE );
+
+	return (x & DRAWABLE_GRID_MASK) | ((y & DRAWABLE_GRID_MASK) << DRAWABLE_GRID_SHIFT);
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Convert a world interval along one axis into the range of grid cells to visit.  Intervals
+ * wide enough to wrap onto themselves are clamped to one trip around the grid so that no
+ * bucket is visited twice.
+ */
+void GameClient::getDrawableGridCellRange( Real lo, Real hi, Int *cellLo, Int *cellHi )
+{
+	if( hi < lo )
+	{
+		*cellLo = 1;
+		*cellHi = 0;
+		return;
 	}
+
+	if( hi - lo >= DRAWABLE_GRID_CELL_SIZE * (DRAWABLE_GRID_DIM - 1) )
+	{
+		*cellLo = 0;
+		*cellHi = DRAWABLE_GRID_MASK;
+		return;
+	}
+
+	*cellLo = REAL_TO_INT_FLOOR( lo / DRAWABLE_GRID_CELL_SIZE );
+	*cellHi = REAL_TO_INT_FLOOR( hi / DRAWABLE_GRID_CELL_SIZE );
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Link a newly registered drawable into the grid at its current position.
+ */
+void GameClient::addDrawableToGrid( Drawable *draw )
+{
+	const Coord3D *pos = draw->getPosition();
+
+	if( pos->z < m_drawableGridLoZ )
+		m_drawableGridLoZ = pos->z;
+	if( pos->z > m_drawableGridHiZ )
+		m_drawableGridHiZ = pos->z;
+
+	Int bucket = getDrawableGridBucket( pos );
+	draw->prependToGridList( &m_drawableGrid[ bucket ], bucket );
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Unlink a drawable from the grid.
+ */
+void GameClient::removeDrawableFromGrid( Drawable *draw )
+{
+	Int bucket = draw->getGridBucket();
+	if( bucket == -1 )
+		return;
+
+	draw->removeFromGridList( &m_drawableGrid[ bucket ] );
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * A drawable has moved, make sure it is in the bucket for where it is now.
+ */
+void GameClient::updateDrawableInGrid( Drawable *draw )
+{
+	const Coord3D *pos = draw->getPosition();
+
+	if( pos->z < m_drawableGridLoZ )
+		m_drawableGridLoZ = pos->z;
+	if( pos->z > m_drawableGridHiZ )
+		m_drawableGridHiZ = pos->z;
+
+	Int bucket = getDrawableGridBucket( pos );
+	Int oldBucket = draw->getGridBucket();
+	if( bucket == oldBucket )
+		return;
+
+	if( oldBucket != -1 )
+		draw->removeFromGridList( &m_drawableGrid[ oldBucket ] );
+	draw->prependToGridList( &m_drawableGrid[ bucket ], bucket );
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Return the lowest and highest z that any drawable has been at since the grid was last
+ * cleared.  The range only ever grows, so it is a safe bound for culling by height.
+ */
+void GameClient::getDrawableHeightRange( Real *loZ, Real *hiZ ) const
+{
+	*loZ = m_drawableGridLoZ;
+	*hiZ = m_drawableGridHiZ;
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Empty every grid bucket, the drawables themselves must already be gone.
+ */
+void GameClient::clearDrawableGrid( void )
+{
+	for( Int i = 0; i < DRAWABLE_GRID_BUCKETS; ++i )
+		m_drawableGrid[ i ] = NULL;
+
+	m_drawableGridLoZ = 0.0f;
+	m_drawableGridHiZ = 0.0f;
 }
 
 /** -----------------------------------------------------------------------------------------------
@@ -763,13 +950,7 @@ void GameClient::iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr u
  */
 Drawable* GameClient::findDrawableByID( const DrawableID id )
 {
-	DrawablePtrHashIt it = m_drawableHash.find(id);
-	if (it == m_drawableHash.end()) {
-		// no such drawable	
-		return NULL;
-	}
-
-	return (*it).second;
+	return m_drawableHash.find(id);
 }
 
 /** -----------------------------------------------------------------------------------------------
@@ -786,6 +967,7 @@ void GameClient::destroyDrawable( Drawable *draw )
 
 	// remove from the master list
 	draw->removeFromList(&m_drawableList);
+	removeDrawableFromGrid( draw );
 
 	//
 	// because drawables and objects are tightly coupled, not only MUST we maintain
@@ -820,7 +1002,7 @@ void GameClient::addDrawableToLookupTable(Drawable *draw )
 		return;
 
 	// add to lookup
-	m_drawableHash[ draw->getID() ] = draw;
+	m_drawableHash.insert( draw->getID(), draw );
 
 }  // end addDrawableToLookupTable
 
@@ -835,7 +1017,7 @@ void GameClient::removeDrawableFromLookupTable( Drawable *draw )
 		return;
 
 	// remove from table
-	m_drawableHash.erase( draw->getID() );
+	m_drawableHash.remove( draw->getID() );
 
 }  // end removeDrawableFromLookupTable
 
@@ -49,6 +49,14 @@
 #include "GameLogic/Object.h"
 #include "GameLogic/TerrainLogic.h"
 
+// Define PARTICLE_STREAM_SSE to step particle streams with SSE on processors that have it.  This
+// needs a compiler that knows the SSE intrinsics (VC6 needs the Processor Pack).
+#ifdef PARTICLE_STREAM_SSE
+#include <xmmintrin.h>
+#include "Common/SelfTest.h"
+#include "WWLib/cpudetect.h"
+#endif
+
 #ifdef _INTERNAL
 // for occasional debugging...
 //#pragma optimize("", off)
@@ -274,12 +282,51 @@ void Particle::computeColorRate( void )
 	m_colorRate.blue = delta/time;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Return the client frame at which we reach our next alpha or color key, or 0xffffffff if 
+	* there are no more keys to reach */
+// ------------------------------------------------------------------------------------------------
+UnsignedInt Particle::getNextKeyframeTime( void ) const
+{
+	UnsignedInt next = 0xffffffff;
+
+	if (m_alphaTargetKey < MAX_KEYFRAMES && m_alphaKey[ m_alphaTargetKey ].frame)
+		next = m_createTimestamp + m_alphaKey[ m_alphaTargetKey ].frame;
+
+	if (m_colorTargetKey < MAX_KEYFRAMES && m_colorKey[ m_colorTargetKey ].frame)
+	{
+		UnsignedInt colorTime = m_createTimestamp + m_colorKey[ m_colorTargetKey ].frame;
+		if (colorTime < next)
+			next = colorTime;
+	}
+
+	return next;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Return true if there are no more color keys to move towards */
+// ------------------------------------------------------------------------------------------------
+Bool Particle::areColorKeysDone( void ) const
+{
+	return m_colorTargetKey >= MAX_KEYFRAMES || m_colorKey[ m_colorTargetKey ].frame == 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Our system steps us in its particle stream; bring all of our members up to date from it.
+	* Only saving needs this - the accessors read single fields out of the stream. */
+// ------------------------------------------------------------------------------------------------
+void Particle::syncFromStream( void )
+{
+	m_system->friend_syncParticleFromStream( this );
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Construct a particle from a particle template */
 // ------------------------------------------------------------------------------------------------
 Particle::Particle( ParticleSystem *system, const ParticleInfo *info )
 {
 	m_system = system;
+	m_drawable = NULL;
 
 	m_isCulled = FALSE;
 	m_accel.x = 0.0f;
@@ -350,6 +397,7 @@ Particle::Particle( ParticleSystem *system, const ParticleInfo *info )
 
 	m_inSystemList = m_inOverallList = FALSE;
 	m_systemPrev = m_systemNext = m_overallPrev = m_overallNext = NULL;
+	m_streamIndex = -1;
 
 	// add this particle to the global list, retaining particle creation order
 	TheParticleSystemManager->addParticle(this, system->getPriority() );
@@ -655,6 +703,9 @@ Bool Particle::isInvisible( void )
 	if (m_drawable)
 		return false;
 
+	if (m_streamIndex >= 0)
+		return m_system->friend_isStreamSlotInvisible( m_streamIndex );
+
 	switch (m_system->getShaderType())
 	{
 		case ParticleSystemInfo::ADDITIVE:
@@ -715,6 +766,10 @@ void Particle::xfer( Xfer *xfer )
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
+	// make sure we're saving what the stream has been doing with us
+	if( m_streamIndex >= 0 && xfer->getXferMode() != XFER_LOAD )
+		syncFromStream();
+
 	// base class particle info
 	ParticleInfo::xfer( xfer );
 
@@ -782,6 +837,10 @@ void Particle::xfer( Xfer *xfer )
 	ParticleSystemID systemUnderControlID = m_systemUnderControl ? m_systemUnderControl->getSystemID() : INVALID_PARTICLE_SYSTEM_ID;
 	xfer->xferUser( &systemUnderControlID, sizeof( ParticleSystemID ) );
 
+	// the stream slot was filled when we were created, before any of this was loaded
+	if( m_streamIndex >= 0 && xfer->getXferMode() == XFER_LOAD )
+		m_system->friend_syncStreamFromParticle( this );
+
 }  // end xfer
 
 // ------------------------------------------------------------------------------------------------
@@ -1122,6 +1181,152 @@ void ParticleSystemInfo::loadPostProcess( void )
 
 }  // end loadPostProcess
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ParticleStream /////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ------------------------------------------------------------------------------------------------
+/** Reallocate an array to a new capacity, keeping the first count entries */
+// ------------------------------------------------------------------------------------------------
+template <class T>
+static void growStreamArray( T *&array, Int count, Int newCapacity )
+{
+	T *newArray = NEW T[ newCapacity ];
+	if( count )
+		memcpy( newArray, array, count * sizeof( T ) );
+	delete [] array;
+	array = newArray;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+ParticleStream::ParticleStream( void ) :
+	m_particle( NULL ),
+	m_lifetimeLeft( NULL ),
+	m_nextKeyframeTime( NULL ),
+	m_personality( NULL ),
+	m_colorKeysDone( NULL ),
+	m_reals( NULL ),
+	m_count( 0 ),
+	m_holes( 0 ),
+	m_capacity( 0 )
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+ParticleStream::~ParticleStream()
+{
+	clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Forget all slots and release our storage */
+// ------------------------------------------------------------------------------------------------
+void ParticleStream::clear( void )
+{
+	delete [] m_particle;
+	delete [] m_lifetimeLeft;
+	delete [] m_nextKeyframeTime;
+	delete [] m_personality;
+	delete [] m_colorKeysDone;
+	delete [] m_reals;
+
+	m_particle = NULL;
+	m_lifetimeLeft = NULL;
+	m_nextKeyframeTime = NULL;
+	m_personality = NULL;
+	m_colorKeysDone = NULL;
+	m_reals = NULL;
+
+	m_count = 0;
+	m_holes = 0;
+	m_capacity = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Double our capacity */
+// ------------------------------------------------------------------------------------------------
+void ParticleStream::grow( void )
+{
+	Int newCapacity = m_capacity ? m_capacity * 2 : 16;
+
+	Real *reals = NEW Real[ REAL_FIELD_COUNT * newCapacity ];
+	if( m_count )
+	{
+		for( Int field = 0; field < REAL_FIELD_COUNT; ++field )
+			memcpy( reals + field * newCapacity, m_reals + field * m_capacity, m_count * sizeof( Real ) );
+	}
+	delete [] m_reals;
+	m_reals = reals;
+
+	growStreamArray( m_particle, m_count, newCapacity );
+	growStreamArray( m_lifetimeLeft, m_count, newCapacity );
+	growStreamArray( m_nextKeyframeTime, m_count, newCapacity );
+	growStreamArray( m_personality, m_count, newCapacity );
+	growStreamArray( m_colorKeysDone, m_count, newCapacity );
+
+	m_capacity = newCapacity;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Take a slot at the end of the stream for this particle.  The caller fills in the data. */
+// ------------------------------------------------------------------------------------------------
+Int ParticleStream::add( Particle *p )
+{
+	if( m_count == m_capacity )
+		grow();
+
+	Int slot = m_count++;
+	m_particle[ slot ] = p;
+	return slot;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Free a slot.  The data stays where it is until the next compact(). */
+// ------------------------------------------------------------------------------------------------
+void ParticleStream::remove( Int slot )
+{
+	DEBUG_ASSERTCRASH( slot >= 0 && slot < m_count && m_particle[ slot ], ("ParticleStream::remove - bad slot %d\n", slot) );
+
+	m_particle[ slot ] = NULL;
+	++m_holes;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Squeeze the holes out of the stream, keeping the particles in creation order */
+// ------------------------------------------------------------------------------------------------
+void ParticleStream::compact( void )
+{
+	Int dst = 0;
+	for( Int src = 0; src < m_count; ++src )
+	{
+		Particle *p = m_particle[ src ];
+		if( p == NULL )
+			continue;
+
+		if( dst != src )
+		{
+			for( Int field = 0; field < REAL_FIELD_COUNT; ++field )
+			{
+				Real *values = m_reals + field * m_capacity;
+				values[ dst ] = values[ src ];
+			}
+			m_particle[ dst ] = p;
+			m_lifetimeLeft[ dst ] = m_lifetimeLeft[ src ];
+			m_nextKeyframeTime[ dst ] = m_nextKeyframeTime[ src ];
+			m_personality[ dst ] = m_personality[ src ];
+			m_colorKeysDone[ dst ] = m_colorKeysDone[ src ];
+			p->m_streamIndex = dst;
+		}
+		++dst;
+	}
+
+	m_count = dst;
+	m_holes = 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // ParticleSystem /////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1278,6 +1483,7 @@ ParticleSystem::ParticleSystem( const ParticleSystemTemplate *sysTemplate,
 	m_particleCount = 0;
 	m_personalityStore = 0;
 	m_controlParticle = NULL;
+	m_useStream = canUseParticleStream();
 
 	TheParticleSystemManager->friend_addParticleSystem(this);
 
@@ -1314,6 +1520,7 @@ ParticleSystem::~ParticleSystem()
 	// destroy all particles "in the air"
 	while (m_systemParticlesHead)
 		m_systemParticlesHead->deleteInstance();
+	m_stream.clear();
 
 	m_attachedToDrawableID = INVALID_DRAWABLE_ID;
 	m_attachedToObjectID = INVALID_ID;
@@ -2138,13 +2345,21 @@ Bool ParticleSystem::update( Int localPlayerIndex  )
 	} // end if is destroyed
 
 	//
-	// Update all particles in the system
+	// Update all particles in the system that aren't in the stream
 	//
-	Particle *p = m_systemParticlesHead;
+	Particle *p = NULL;
+	if (m_particleCount > getStreamParticleCount())
+		p = m_systemParticlesHead;
 	Particle *oldParticle;
 	while (p)
 	{
 
+		if (p->m_streamIndex >= 0)
+		{
+			p = p->m_systemNext;
+			continue;
+		}
+
 		// apply 'gravity' force
 		if (m_gravity != 0.0f)
 		{
@@ -2165,6 +2380,10 @@ Bool ParticleSystem::update( Int localPlayerIndex  )
 		}
 	}
 
+	// and the ones that are
+	if (m_useStream)
+		updateParticleStream();
+
 	//
 	// If we have been "destroyed", wait for all of our particles to die off,
 	// then destroy ourselves (return false).
@@ -2192,6 +2411,482 @@ Bool ParticleSystem::update( Int localPlayerIndex  )
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Return true if the particle in this stream slot can't be seen.  This is Particle::isInvisible()
+	* working from the stream. */
+// ------------------------------------------------------------------------------------------------
+static Bool isStreamSlotInvisible( ParticleStream &stream, Int slot, ParticleSystemInfo::ParticleShaderType shaderType )
+{
+	switch (shaderType)
+	{
+		case ParticleSystemInfo::ADDITIVE:
+			// black, and not on the way to another color
+			return stream.m_colorKeysDone[ slot ] && 
+						 stream.get( ParticleStream::RED )[ slot ] < 0.01f &&
+						 stream.get( ParticleStream::GREEN )[ slot ] < 0.01f &&
+						 stream.get( ParticleStream::BLUE )[ slot ] < 0.01f;
+
+		case ParticleSystemInfo::ALPHA:
+			return stream.get( ParticleStream::ALPHA )[ slot ] < 0.01f;
+
+		case ParticleSystemInfo::ALPHA_TEST:
+			return false;
+
+		case ParticleSystemInfo::MULTIPLY:
+			// white, and not on the way to another color
+			return stream.m_colorKeysDone[ slot ] && 
+						 stream.get( ParticleStream::RED )[ slot ] > 0.99f &&
+						 stream.get( ParticleStream::GREEN )[ slot ] > 0.99f &&
+						 stream.get( ParticleStream::BLUE )[ slot ] > 0.99f;
+	}
+
+	// should never get here - if we do, data is incorrect
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Return true if the particle in this stream slot can't be seen */
+// ------------------------------------------------------------------------------------------------
+Bool ParticleSystem::friend_isStreamSlotInvisible( Int slot )
+{
+	return isStreamSlotInvisible( m_stream, slot, m_shaderType );
+}
+
+// ------------------------------------------------------------------------------------------------
+/** The fields of a particle stream that the per-frame step touches, looked up once per update. */
+// ------------------------------------------------------------------------------------------------
+struct ParticleStreamFields
+{
+	ParticleStreamFields( ParticleStream &stream, Real systemGravity, const Coord3D &drift )
+	{
+		posX = stream.get( ParticleStream::POS_X );
+		posY = stream.get( ParticleStream::POS_Y );
+		posZ = stream.get( ParticleStream::POS_Z );
+		velX = stream.get( ParticleStream::VEL_X );
+		velY = stream.get( ParticleStream::VEL_Y );
+		velZ = stream.get( ParticleStream::VEL_Z );
+		velDamping = stream.get( ParticleStream::VEL_DAMPING );
+		angleX = stream.get( ParticleStream::ANGLE_X );
+		angleY = stream.get( ParticleStream::ANGLE_Y );
+		angleZ = stream.get( ParticleStream::ANGLE_Z );
+		angularRateX = stream.get( ParticleStream::ANGULAR_RATE_X );
+		angularRateY = stream.get( ParticleStream::ANGULAR_RATE_Y );
+		angularRateZ = stream.get( ParticleStream::ANGULAR_RATE_Z );
+		angularDamping = stream.get( ParticleStream::ANGULAR_DAMPING );
+		size = stream.get( ParticleStream::SIZE );
+		sizeRate = stream.get( ParticleStream::SIZE_RATE );
+		sizeRateDamping = stream.get( ParticleStream::SIZE_RATE_DAMPING );
+		alpha = stream.get( ParticleStream::ALPHA );
+		alphaRate = stream.get( ParticleStream::ALPHA_RATE );
+		red = stream.get( ParticleStream::RED );
+		green = stream.get( ParticleStream::GREEN );
+		blue = stream.get( ParticleStream::BLUE );
+		redRate = stream.get( ParticleStream::RED_RATE );
+		greenRate = stream.get( ParticleStream::GREEN_RATE );
+		blueRate = stream.get( ParticleStream::BLUE_RATE );
+		colorScale = stream.get( ParticleStream::COLOR_SCALE );
+		gravity = systemGravity;
+		driftX = drift.x;
+		driftY = drift.y;
+		driftZ = drift.z;
+	}
+
+	Real *posX, *posY, *posZ;
+	Real *velX, *velY, *velZ, *velDamping;
+	Real *angleX, *angleY, *angleZ;
+	Real *angularRateX, *angularRateY, *angularRateZ, *angularDamping;
+	Real *size, *sizeRate, *sizeRateDamping;
+	Real *alpha, *alphaRate;
+	Real *red, *green, *blue;
+	Real *redRate, *greenRate, *blueRate;
+	Real *colorScale;
+	Real gravity;
+	Real driftX, driftY, driftZ;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Integrate velocity (with gravity), position (with drift), orientation, size, alpha and color 
+	* of one stream slot.  No branches, so four slots in a row can be overlapped. */
+// ------------------------------------------------------------------------------------------------
+inline static void stepStreamSlot( const ParticleStreamFields &f, Int i )
+{
+	f.velX[ i ] *= f.velDamping[ i ];
+	f.velY[ i ] *= f.velDamping[ i ];
+	f.velZ[ i ] = (f.velZ[ i ] + f.gravity) * f.velDamping[ i ];
+	f.posX[ i ] += f.velX[ i ] + f.driftX;
+	f.posY[ i ] += f.velY[ i ] + f.driftY;
+	f.posZ[ i ] += f.velZ[ i ] + f.driftZ;
+
+	f.angleX[ i ] += f.angularRateX[ i ];
+	f.angleY[ i ] += f.angularRateY[ i ];
+	f.angleZ[ i ] += f.angularRateZ[ i ];
+	f.angularRateX[ i ] *= f.angularDamping[ i ];
+	f.angularRateY[ i ] *= f.angularDamping[ i ];
+	f.angularRateZ[ i ] *= f.angularDamping[ i ];
+
+	f.size[ i ] += f.sizeRate[ i ];
+	f.sizeRate[ i ] *= f.sizeRateDamping[ i ];
+
+	f.alpha[ i ] += f.alphaRate[ i ];
+	f.red[ i ] += f.redRate[ i ];
+	f.green[ i ] += f.greenRate[ i ];
+	f.blue[ i ] += f.blueRate[ i ];
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Apply the color scale to one stream slot and clamp its alpha and color to [0,1].  Green is only 
+	* clamped from above, which is what Particle::update() ends up doing. */
+// ------------------------------------------------------------------------------------------------
+inline static void clampStreamSlotColor( const ParticleStreamFields &f, Int i )
+{
+	Real a = f.alpha[ i ];
+	Real r = f.red[ i ] + f.colorScale[ i ];
+	Real g = f.green[ i ] + f.colorScale[ i ];
+	Real b = f.blue[ i ] + f.colorScale[ i ];
+
+	a = (a < 0.0f) ? 0.0f : a;
+	r = (r < 0.0f) ? 0.0f : r;
+	b = (b < 0.0f) ? 0.0f : b;
+
+	f.alpha[ i ] = (a > 1.0f) ? 1.0f : a;
+	f.red[ i ] = (r > 1.0f) ? 1.0f : r;
+	f.green[ i ] = (g > 1.0f) ? 1.0f : g;
+	f.blue[ i ] = (b > 1.0f) ? 1.0f : b;
+}
+
+#ifdef PARTICLE_STREAM_SSE
+
+// ------------------------------------------------------------------------------------------------
+/** True if the processor we're running on can do the SSE stream passes */
+// ------------------------------------------------------------------------------------------------
+static Bool canUseStreamSSE( void )
+{
+	static Bool s_hasSSE = CPUDetectClass::Has_SSE_Instruction_Set();
+	return s_hasSSE;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** stepStreamSlot() for four slots at a time.  Returns the first slot it didn't do. */
+// ------------------------------------------------------------------------------------------------
+static Int stepStreamSlotsSSE( const ParticleStreamFields &f, Int count )
+{
+	__m128 gravity = _mm_set1_ps( f.gravity );
+	__m128 driftX = _mm_set1_ps( f.driftX );
+	__m128 driftY = _mm_set1_ps( f.driftY );
+	__m128 driftZ = _mm_set1_ps( f.driftZ );
+
+	Int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 damping = _mm_loadu_ps( f.velDamping + i );
+		__m128 velX = _mm_mul_ps( _mm_loadu_ps( f.velX + i ), damping );
+		__m128 velY = _mm_mul_ps( _mm_loadu_ps( f.velY + i ), damping );
+		__m128 velZ = _mm_mul_ps( _mm_add_ps( _mm_loadu_ps( f.velZ + i ), gravity ), damping );
+		_mm_storeu_ps( f.velX + i, velX );
+		_mm_storeu_ps( f.velY + i, velY );
+		_mm_storeu_ps( f.velZ + i, velZ );
+		_mm_storeu_ps( f.posX + i, _mm_add_ps( _mm_loadu_ps( f.posX + i ), _mm_add_ps( velX, driftX ) ) );
+		_mm_storeu_ps( f.posY + i, _mm_add_ps( _mm_loadu_ps( f.posY + i ), _mm_add_ps( velY, driftY ) ) );
+		_mm_storeu_ps( f.posZ + i, _mm_add_ps( _mm_loadu_ps( f.posZ + i ), _mm_add_ps( velZ, driftZ ) ) );
+
+		__m128 rateX = _mm_loadu_ps( f.angularRateX + i );
+		__m128 rateY = _mm_loadu_ps( f.angularRateY + i );
+		__m128 rateZ = _mm_loadu_ps( f.angularRateZ + i );
+		__m128 angularDamping = _mm_loadu_ps( f.angularDamping + i );
+		_mm_storeu_ps( f.angleX + i, _mm_add_ps( _mm_loadu_ps( f.angleX + i ), rateX ) );
+		_mm_storeu_ps( f.angleY + i, _mm_add_ps( _mm_loadu_ps( f.angleY + i ), rateY ) );
+		_mm_storeu_ps( f.angleZ + i, _mm_add_ps( _mm_loadu_ps( f.angleZ + i ), rateZ ) );
+		_mm_storeu_ps( f.angularRateX + i, _mm_mul_ps( rateX, angularDamping ) );
+		_mm_storeu_ps( f.angularRateY + i, _mm_mul_ps( rateY, angularDamping ) );
+		_mm_storeu_ps( f.angularRateZ + i, _mm_mul_ps( rateZ, angularDamping ) );
+
+		__m128 sizeRate = _mm_loadu_ps( f.sizeRate + i );
+		_mm_storeu_ps( f.size + i, _mm_add_ps( _mm_loadu_ps( f.size + i ), sizeRate ) );
+		_mm_storeu_ps( f.sizeRate + i, _mm_mul_ps( sizeRate, _mm_loadu_ps( f.sizeRateDamping + i ) ) );
+
+		_mm_storeu_ps( f.alpha + i, _mm_add_ps( _mm_loadu_ps( f.alpha + i ), _mm_loadu_ps( f.alphaRate + i ) ) );
+		_mm_storeu_ps( f.red + i, _mm_add_ps( _mm_loadu_ps( f.red + i ), _mm_loadu_ps( f.redRate + i ) ) );
+		_mm_storeu_ps( f.green + i, _mm_add_ps( _mm_loadu_ps( f.green + i ), _mm_loadu_ps( f.greenRate + i ) ) );
+		_mm_storeu_ps( f.blue + i, _mm_add_ps( _mm_loadu_ps( f.blue + i ), _mm_loadu_ps( f.blueRate + i ) ) );
+	}
+
+	return i;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** clampStreamSlotColor() for four slots at a time.  Returns the first slot it didn't do. */
+// ------------------------------------------------------------------------------------------------
+static Int clampStreamSlotColorsSSE( const ParticleStreamFields &f, Int count )
+{
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps( 1.0f );
+
+	Int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 scale = _mm_loadu_ps( f.colorScale + i );
+		__m128 a = _mm_loadu_ps( f.alpha + i );
+		__m128 r = _mm_add_ps( _mm_loadu_ps( f.red + i ), scale );
+		__m128 g = _mm_add_ps( _mm_loadu_ps( f.green + i ), scale );
+		__m128 b = _mm_add_ps( _mm_loadu_ps( f.blue + i ), scale );
+
+		_mm_storeu_ps( f.alpha + i, _mm_min_ps( _mm_max_ps( a, zero ), one ) );
+		_mm_storeu_ps( f.red + i, _mm_min_ps( _mm_max_ps( r, zero ), one ) );
+		_mm_storeu_ps( f.green + i, _mm_min_ps( g, one ) );
+		_mm_storeu_ps( f.blue + i, _mm_min_ps( _mm_max_ps( b, zero ), one ) );
+	}
+
+	return i;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Step and clamp the same made-up particles with and without SSE and check they agree */
+// ------------------------------------------------------------------------------------------------
+static Bool particleStreamSSESelfTest( AsciiString *failure )
+{
+	if (!canUseStreamSSE())
+		return true;	// nothing to compare against
+
+	const Int SLOTS = 11;	// two SSE batches and a scalar tail
+	ParticleStream scalarStream, sseStream;
+	Int i, field;
+	for( i = 0; i < SLOTS; ++i )
+	{
+		scalarStream.add( NULL );
+		sseStream.add( NULL );
+		for( field = 0; field < ParticleStream::REAL_FIELD_COUNT; ++field )
+		{
+			// spread the colors either side of [0,1] so the clamps get exercised
+			Real value = (Real)((i * 7 + field * 3) % 23) * 0.1f - 0.5f;
+			scalarStream.get( (ParticleStream::RealField)field )[ i ] = value;
+			sseStream.get( (ParticleStream::RealField)field )[ i ] = value;
+		}
+	}
+
+	Coord3D drift;
+	drift.x = 0.25f;
+	drift.y = -0.5f;
+	drift.z = 0.125f;
+	ParticleStreamFields scalarFields( scalarStream, -0.3f, drift );
+	ParticleStreamFields sseFields( sseStream, -0.3f, drift );
+
+	for( i = 0; i < SLOTS; ++i )
+		stepStreamSlot( scalarFields, i );
+	for( i = stepStreamSlotsSSE( sseFields, SLOTS ); i < SLOTS; ++i )
+		stepStreamSlot( sseFields, i );
+
+	for( i = 0; i < SLOTS; ++i )
+		clampStreamSlotColor( scalarFields, i );
+	for( i = clampStreamSlotColorsSSE( sseFields, SLOTS ); i < SLOTS; ++i )
+		clampStreamSlotColor( sseFields, i );
+
+	for( field = 0; field < ParticleStream::REAL_FIELD_COUNT; ++field )
+	{
+		const Real *want = scalarStream.get( (ParticleStream::RealField)field );
+		const Real *got = sseStream.get( (ParticleStream::RealField)field );
+		for( i = 0; i < SLOTS; ++i )
+		{
+			if (fabs( want[ i ] - got[ i ] ) > 0.0001f)
+			{
+				failure->format( "field %d slot %d: scalar %f, SSE %f", field, i, want[ i ], got[ i ] );
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+static SelfTestRegistration theParticleStreamSSESelfTest( "ParticleStreamSSE", particleStreamSSESelfTest );
+
+#endif // PARTICLE_STREAM_SSE
+
+// ------------------------------------------------------------------------------------------------
+/** Step every particle in the stream by one frame.  This does exactly what Particle::update() 
+	* does for a particle with no drawable, no wind and no emitter tracking, but a field at a time
+	* across the whole system instead of a particle at a time. */
+// ------------------------------------------------------------------------------------------------
+void ParticleSystem::updateParticleStream( void )
+{
+	if (m_stream.hasHoles())
+		m_stream.compact();
+
+	Int count = m_stream.getSlotCount();
+	if (count == 0)
+		return;
+
+	ParticleStreamFields fields( m_stream, m_gravity, m_driftVelocity );
+
+	Int i = 0;
+
+	//
+	// Integrate velocity (with gravity), position (with drift), orientation, size, alpha and color
+	//
+#ifdef PARTICLE_STREAM_SSE
+	if (canUseStreamSSE())
+		i = stepStreamSlotsSSE( fields, count );
+#endif
+	for( ; i + 4 <= count; i += 4 )
+	{
+		stepStreamSlot( fields, i + 0 );
+		stepStreamSlot( fields, i + 1 );
+		stepStreamSlot( fields, i + 2 );
+		stepStreamSlot( fields, i + 3 );
+	}
+	for( ; i < count; ++i )
+		stepStreamSlot( fields, i );
+
+	//
+	// Particles that have reached an alpha or color key pick up the new rates
+	//
+	UnsignedInt now = TheGameClient->getFrame();
+	for( i = 0; i < count; ++i )
+	{
+		if (m_stream.m_nextKeyframeTime[ i ] <= now)
+			updateStreamKeyframes( i, now );
+	}
+
+	//
+	// Apply the color scale and clamp alpha and color
+	//
+	i = 0;
+#ifdef PARTICLE_STREAM_SSE
+	if (canUseStreamSSE())
+		i = clampStreamSlotColorsSSE( fields, count );
+#endif
+	for( ; i + 4 <= count; i += 4 )
+	{
+		clampStreamSlotColor( fields, i + 0 );
+		clampStreamSlotColor( fields, i + 1 );
+		clampStreamSlotColor( fields, i + 2 );
+		clampStreamSlotColor( fields, i + 3 );
+	}
+	for( ; i < count; ++i )
+		clampStreamSlotColor( fields, i );
+
+	//
+	// Monitor lifetime, and get rid of anything that has run out or gone totally invisible
+	//
+	for( i = 0; i < count; ++i )
+	{
+		Particle *p = m_stream.m_particle[ i ];
+		if (p == NULL)
+			continue;
+
+		UnsignedInt &lifetimeLeft = m_stream.m_lifetimeLeft[ i ];
+		if (lifetimeLeft && --lifetimeLeft == 0)
+		{
+			p->deleteInstance();
+			continue;
+		}
+
+		DEBUG_ASSERTCRASH( lifetimeLeft, ( "A particle has an infinite lifetime..." ));
+
+		if (isStreamSlotInvisible( m_stream, i, m_shaderType ))
+			p->deleteInstance();
+	}
+
+	if (m_stream.hasHoles())
+		m_stream.compact();
+}
+
+// ------------------------------------------------------------------------------------------------
+/** The particle in this stream slot has reached an alpha and/or color key: do the key handling
+	* from Particle::update() and pick up the new rates */
+// ------------------------------------------------------------------------------------------------
+void ParticleSystem::updateStreamKeyframes( Int slot, UnsignedInt now )
+{
+	Particle *p = m_stream.m_particle[ slot ];
+	if (p == NULL)
+		return;
+
+	Int key = p->m_alphaTargetKey;
+	if (key < MAX_KEYFRAMES && p->m_alphaKey[ key ].frame && now - p->m_createTimestamp >= p->m_alphaKey[ key ].frame)
+	{
+		m_stream.get( ParticleStream::ALPHA )[ slot ] = p->m_alphaKey[ key ].value;
+		p->m_alphaTargetKey++;
+		if (p->m_alphaTargetKey < MAX_KEYFRAMES)
+			p->computeAlphaRate();
+		else
+			p->m_alphaRate = 0.0f;
+		m_stream.get( ParticleStream::ALPHA_RATE )[ slot ] = p->m_alphaRate;
+	}
+
+	key = p->m_colorTargetKey;
+	if (key < MAX_KEYFRAMES && p->m_colorKey[ key ].frame && now - p->m_createTimestamp >= p->m_colorKey[ key ].frame)
+	{
+		// can't set the color, because of colorscale
+		p->m_colorTargetKey++;
+		if (p->m_colorTargetKey < MAX_KEYFRAMES)
+			p->computeColorRate();
+		else
+			p->m_colorRate.red = p->m_colorRate.green = p->m_colorRate.blue = 0.0f;
+		m_stream.get( ParticleStream::RED_RATE )[ slot ] = p->m_colorRate.red;
+		m_stream.get( ParticleStream::GREEN_RATE )[ slot ] = p->m_colorRate.green;
+		m_stream.get( ParticleStream::BLUE_RATE )[ slot ] = p->m_colorRate.blue;
+	}
+
+	m_stream.m_nextKeyframeTime[ slot ] = p->getNextKeyframeTime();
+	m_stream.m_colorKeysDone[ slot ] = p->areColorKeysDone();
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Write the visible stream particles that fall inside the given box into the renderer's 
+	* buffers.  Positions are written as xyz triples and colors as rgba quads. */
+// ------------------------------------------------------------------------------------------------
+Int ParticleSystem::fillRenderBuffers( Real *pos, Real *rgba, Real *size, UnsignedByte *angle, UnsignedInt *personality,
+																			 Int maxCount, const Coord3D *boxCenter, const Coord3D *boxExtent )
+{
+	Int slots = m_stream.getSlotCount();
+	const Real *posX = m_stream.get( ParticleStream::POS_X );
+	const Real *posY = m_stream.get( ParticleStream::POS_Y );
+	const Real *posZ = m_stream.get( ParticleStream::POS_Z );
+	const Real *sizes = m_stream.get( ParticleStream::SIZE );
+	const Real *angleZ = m_stream.get( ParticleStream::ANGLE_Z );
+	const Real *alpha = m_stream.get( ParticleStream::ALPHA );
+	const Real *red = m_stream.get( ParticleStream::RED );
+	const Real *green = m_stream.get( ParticleStream::GREEN );
+	const Real *blue = m_stream.get( ParticleStream::BLUE );
+
+	Int count = 0;
+	for( Int i = 0; i < slots && count < maxCount; ++i )
+	{
+		if (m_stream.m_particle[ i ] == NULL)
+			continue;
+
+		// do not attempt to render totally invisible particles
+		if (isStreamSlotInvisible( m_stream, i, m_shaderType ))
+			continue;
+
+		// cull to the box
+		Real s = sizes[ i ];
+		if (fabs( posX[ i ] - boxCenter->x ) > boxExtent->x + s)
+			continue;
+		if (fabs( posY[ i ] - boxCenter->y ) > boxExtent->y + s)
+			continue;
+		if (fabs( posZ[ i ] - boxCenter->z ) > boxExtent->z + s)
+			continue;
+
+		pos[ 0 ] = posX[ i ];
+		pos[ 1 ] = posY[ i ];
+		pos[ 2 ] = posZ[ i ];
+		pos += 3;
+
+		rgba[ 0 ] = red[ i ];
+		rgba[ 1 ] = green[ i ];
+		rgba[ 2 ] = blue[ i ];
+		rgba[ 3 ] = alpha[ i ];
+		rgba += 4;
+
+		*size++ = s;
+		*angle++ = (UnsignedByte)(angleZ[ i ] * 255.0f / (2.0f * PI));
+		*personality++ = m_stream.m_personality[ i ];
+
+		++count;
+	}
+
+	return count;
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Update the wind motion */
 // ------------------------------------------------------------------------------------------------
@@ -2357,6 +3052,13 @@ void ParticleSystem::addParticle( Particle *particleToAdd )
 
 	particleToAdd->setPersonality( m_personalityStore++ ); 
 
+	// point particles are stepped by the system, in the stream
+	if (m_useStream && particleToAdd->m_drawable == NULL && !particleToAdd->m_particleUpTowardsEmitter)
+	{
+		particleToAdd->m_streamIndex = m_stream.add( particleToAdd );
+		friend_syncStreamFromParticle( particleToAdd );
+	}
+
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2382,6 +3084,122 @@ void ParticleSystem::removeParticle( Particle *particleToRemove )
 	particleToRemove->m_systemNext = particleToRemove->m_systemPrev = NULL;
 	particleToRemove->m_inSystemList = FALSE;
 	--m_particleCount;
+
+	if (particleToRemove->m_streamIndex >= 0)
+	{
+		// leave our state in the particle, in case anyone looks at it on the way out
+		friend_syncParticleFromStream( particleToRemove );
+		m_stream.remove( particleToRemove->m_streamIndex );
+		particleToRemove->m_streamIndex = -1;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Particles of this system can be kept in a particle stream unless they need per-particle work
+	* the stream doesn't do: drawables, wind, and pointing up towards the emitter */
+// ------------------------------------------------------------------------------------------------
+Bool ParticleSystem::canUseParticleStream( void ) const
+{
+	if (m_particleType == DRAWABLE)
+		return false;
+
+	if (m_windMotion != ParticleSystemInfo::WIND_MOTION_NOT_USED)
+		return false;
+
+	if (m_isParticleUpTowardsEmitter)
+		return false;
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Copy a stream particle's state back into the Particle */
+// ------------------------------------------------------------------------------------------------
+void ParticleSystem::friend_syncParticleFromStream( Particle *p )
+{
+	Int slot = p->m_streamIndex;
+	if (slot < 0)
+		return;
+
+	p->m_pos.x = m_stream.get( ParticleStream::POS_X )[ slot ];
+	p->m_pos.y = m_stream.get( ParticleStream::POS_Y )[ slot ];
+	p->m_pos.z = m_stream.get( ParticleStream::POS_Z )[ slot ];
+	p->m_vel.x = m_stream.get( ParticleStream::VEL_X )[ slot ];
+	p->m_vel.y = m_stream.get( ParticleStream::VEL_Y )[ slot ];
+	p->m_vel.z = m_stream.get( ParticleStream::VEL_Z )[ slot ];
+
+	p->m_angleX = m_stream.get( ParticleStream::ANGLE_X )[ slot ];
+	p->m_angleY = m_stream.get( ParticleStream::ANGLE_Y )[ slot ];
+	p->m_angleZ = m_stream.get( ParticleStream::ANGLE_Z )[ slot ];
+	p->m_angularRateX = m_stream.get( ParticleStream::ANGULAR_RATE_X )[ slot ];
+	p->m_angularRateY = m_stream.get( ParticleStream::ANGULAR_RATE_Y )[ slot ];
+	p->m_angularRateZ = m_stream.get( ParticleStream::ANGULAR_RATE_Z )[ slot ];
+
+	p->m_size = m_stream.get( ParticleStream::SIZE )[ slot ];
+	p->m_sizeRate = m_stream.get( ParticleStream::SIZE_RATE )[ slot ];
+
+	p->m_alpha = m_stream.get( ParticleStream::ALPHA )[ slot ];
+	p->m_alphaRate = m_stream.get( ParticleStream::ALPHA_RATE )[ slot ];
+
+	p->m_color.red = m_stream.get( ParticleStream::RED )[ slot ];
+	p->m_color.green = m_stream.get( ParticleStream::GREEN )[ slot ];
+	p->m_color.blue = m_stream.get( ParticleStream::BLUE )[ slot ];
+	p->m_colorRate.red = m_stream.get( ParticleStream::RED_RATE )[ slot ];
+	p->m_colorRate.green = m_stream.get( ParticleStream::GREEN_RATE )[ slot ];
+	p->m_colorRate.blue = m_stream.get( ParticleStream::BLUE_RATE )[ slot ];
+
+	p->m_lifetimeLeft = m_stream.m_lifetimeLeft[ slot ];
+
+	// the stream folds gravity straight into the velocity, so there is never any left over
+	p->m_accel.x = 0.0f;
+	p->m_accel.y = 0.0f;
+	p->m_accel.z = 0.0f;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Copy a Particle's state into its stream slot */
+// ------------------------------------------------------------------------------------------------
+void ParticleSystem::friend_syncStreamFromParticle( Particle *p )
+{
+	Int slot = p->m_streamIndex;
+	if (slot < 0)
+		return;
+
+	m_stream.get( ParticleStream::POS_X )[ slot ] = p->m_pos.x;
+	m_stream.get( ParticleStream::POS_Y )[ slot ] = p->m_pos.y;
+	m_stream.get( ParticleStream::POS_Z )[ slot ] = p->m_pos.z;
+	m_stream.get( ParticleStream::VEL_X )[ slot ] = p->m_vel.x;
+	m_stream.get( ParticleStream::VEL_Y )[ slot ] = p->m_vel.y;
+	m_stream.get( ParticleStream::VEL_Z )[ slot ] = p->m_vel.z;
+	m_stream.get( ParticleStream::VEL_DAMPING )[ slot ] = p->m_velDamping;
+
+	m_stream.get( ParticleStream::ANGLE_X )[ slot ] = p->m_angleX;
+	m_stream.get( ParticleStream::ANGLE_Y )[ slot ] = p->m_angleY;
+	m_stream.get( ParticleStream::ANGLE_Z )[ slot ] = p->m_angleZ;
+	m_stream.get( ParticleStream::ANGULAR_RATE_X )[ slot ] = p->m_angularRateX;
+	m_stream.get( ParticleStream::ANGULAR_RATE_Y )[ slot ] = p->m_angularRateY;
+	m_stream.get( ParticleStream::ANGULAR_RATE_Z )[ slot ] = p->m_angularRateZ;
+	m_stream.get( ParticleStream::ANGULAR_DAMPING )[ slot ] = p->m_angularDamping;
+
+	m_stream.get( ParticleStream::SIZE )[ slot ] = p->m_size;
+	m_stream.get( ParticleStream::SIZE_RATE )[ slot ] = p->m_sizeRate;
+	m_stream.get( ParticleStream::SIZE_RATE_DAMPING )[ slot ] = p->m_sizeRateDamping;
+
+	m_stream.get( ParticleStream::ALPHA )[ slot ] = p->m_alpha;
+	m_stream.get( ParticleStream::ALPHA_RATE )[ slot ] = p->m_alphaRate;
+
+	m_stream.get( ParticleStream::RED )[ slot ] = p->m_color.red;
+	m_stream.get( ParticleStream::GREEN )[ slot ] = p->m_color.green;
+	m_stream.get( ParticleStream::BLUE )[ slot ] = p->m_color.blue;
+	m_stream.get( ParticleStream::RED_RATE )[ slot ] = p->m_colorRate.red;
+	m_stream.get( ParticleStream::GREEN_RATE )[ slot ] = p->m_colorRate.green;
+	m_stream.get( ParticleStream::BLUE_RATE )[ slot ] = p->m_colorRate.blue;
+	m_stream.get( ParticleStream::COLOR_SCALE )[ slot ] = p->m_colorScale;
+
+	m_stream.m_lifetimeLeft[ slot ] = p->m_lifetimeLeft;
+	m_stream.m_nextKeyframeTime[ slot ] = p->getNextKeyframeTime();
+	m_stream.m_personality[ slot ] = p->getPersonality();
+	m_stream.m_colorKeysDone[ slot ] = p->areColorKeysDone();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -500,6 +500,7 @@ FormationID AI::getNextFormationID(void )
 }
 
 //-----------------------------------------------------------------------------
+/// only for use with PartitionManager::getClosestEnemy and friends, which only offer us enemies.
 class PartitionFilterLiveMapEnemies : public PartitionFilter
 {
 private:
@@ -517,10 +518,8 @@ public:
 		if (objOther->isOffMap() != m_obj->isOffMap())
 			return false;
 
-		Relationship r = m_obj->getRelationship(objOther);
-		if (r != ENEMIES)
-			return false;
-
+		// the relationship test used to be here; the partition manager does it for us now,
+		// from per-player lists of the enemies in each cell.
 		return true;
 	}
 
@@ -597,6 +596,7 @@ Object *AI::findClosestEnemy( const Object *me, Real range, UnsignedInt qualifie
 	// only consider live, on-map enemies.
 	// since this gets called a ton, I made a special custom filter to
 	// combine several canned ones, in the name of speed (srj)
+	// (the enemies part is handled by getClosestEnemy/iterateEnemiesInRange below)
 	PartitionFilterLiveMapEnemies filterObvious(me);
 
 	PartitionFilterWithinAttackRange filterWithinAttackRange(me);
@@ -672,14 +672,14 @@ Object *AI::findClosestEnemy( const Object *me, Real range, UnsignedInt qualifie
 	if (info == NULL || info == TheScriptEngine->getDefaultAttackInfo()) 
 	{
 		// No additional attack info, so just return the closest one.
-		Object* o = ThePartitionManager->getClosestObject( me, range, FROM_BOUNDINGSPHERE_2D, filters );
+		Object* o = ThePartitionManager->getClosestEnemy( me, range, FROM_BOUNDINGSPHERE_2D, filters );
 		return o;
 	}
 
 	Object *bestEnemy = NULL;
 	Int			effectivePriority=0;
 	Int			actualPriority=0;
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange(me, range, FROM_BOUNDINGSPHERE_2D, filters, ITER_SORTED_NEAR_TO_FAR);
+	ObjectIterator *iter = ThePartitionManager->iterateEnemiesInRange(me, range, FROM_BOUNDINGSPHERE_2D, filters, ITER_SORTED_NEAR_TO_FAR);
 	MemoryPoolObjectHolder holder(iter);
 	for (Object *theEnemy = iter->first(); theEnemy; theEnemy = iter->next()) 
 	{
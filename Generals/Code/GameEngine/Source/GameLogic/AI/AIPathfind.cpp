@@ -28,6 +28,7 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
 
 #include "GameLogic/AIPathfind.h"
+#include "GameLogic/AIPathfindWorkers.h"
 
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
@@ -1225,7 +1226,7 @@ Bool PathfindCell::startPathfind( PathfindCell *goalCell  )
 	if (goalCell) {
 		m_info->m_totalCost = costToGoal( goalCell );
 	}
-	m_info->m_open = TRUE;
+	m_info->m_open = FALSE;	// caller puts the start cell on the open list.
 	m_info->m_closed = FALSE;
 	return true;
 }
@@ -1488,100 +1489,166 @@ void PathfindCell::removeObstacle( Object *obstacle )
 	}
 }
 
-/// put self on "open" list in ascending cost order, return new list
-PathfindCell *PathfindCell::putOnSortedOpenList( PathfindCell *list )
+//----------------------- PathfindOpenList ---------------------------------------
+
+PathfindOpenList::PathfindOpenList(void) :
+	m_heap(NULL),
+	m_count(0),
+	m_capacity(0),
+	m_nextSequence(0)
 {
-	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
-	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==FALSE, ("Serious error - Invalid flags. jba"));
-	if (list == NULL)
-	{
-		list = this;
-		m_info->m_prevOpen = NULL;
-		m_info->m_nextOpen = NULL;
+}
+
+PathfindOpenList::~PathfindOpenList(void)
+{
+	release();
+}
+
+/**
+ * Allocate the heap.  Every cell on the open list owns a PathfindCellInfo, so the
+ * cell info pool size is an upper bound on the heap size.
+ */
+void PathfindOpenList::allocate(Int capacity)
+{
+	release();
+	m_heap = MSGNEW("PathfindOpenList") PathfindCellInfo *[capacity];
+	m_capacity = capacity;
+	m_count = 0;
+	m_nextSequence = 0;
+}
+
+void PathfindOpenList::release(void)
+{
+	if (m_heap) {
+		delete [] m_heap;
 	}
-	else
-	{
-		// insertion sort
-		PathfindCell *c, *lastCell = NULL;
-		for( c = list; c; c = c->getNextOpen() )
-		{
-			if (c->m_info->m_totalCost > m_info->m_totalCost)
-				break;
+	m_heap = NULL;
+	m_capacity = 0;
+	m_count = 0;
+}
 
-			lastCell = c;
-		}
+PathfindCell *PathfindOpenList::getHead(void) const
+{
+	if (m_count==0) return NULL;
+	return m_heap[0]->m_cell;
+}
 
-		if (c)
-		{
-			// insert just before "c"
-			if (c->m_info->m_prevOpen)
-				c->m_info->m_prevOpen->m_nextOpen = this->m_info;
-			else
-				list = this;
+PathfindCell *PathfindOpenList::getNth(Int i) const
+{
+	DEBUG_ASSERTCRASH(i>=0 && i<m_count, ("Bad open list index."));
+	return m_heap[i]->m_cell;
+}
 
-			m_info->m_prevOpen = c->m_info->m_prevOpen;
-			c->m_info->m_prevOpen = this->m_info;
-				
-			m_info->m_nextOpen = c->m_info;
+void PathfindOpenList::siftUp(Int ndx)
+{
+	PathfindCellInfo *info = m_heap[ndx];
+	while (ndx>0) {
+		Int parent = (ndx-1)>>1;
+		if (!isBefore(info, m_heap[parent])) break;
+		m_heap[ndx] = m_heap[parent];
+		m_heap[ndx]->m_openIndex = ndx;
+		ndx = parent;
+	}
+	m_heap[ndx] = info;
+	info->m_openIndex = ndx;
+}
 
+void PathfindOpenList::siftDown(Int ndx)
+{
+	PathfindCellInfo *info = m_heap[ndx];
+	for (;;) {
+		Int child = 2*ndx+1;
+		if (child >= m_count) break;
+		if (child+1 < m_count && isBefore(m_heap[child+1], m_heap[child])) {
+			child++;
 		}
-		else
-		{
-			// append after "lastCell" - end of list
-			lastCell->m_info->m_nextOpen = this->m_info;
-			m_info->m_prevOpen = lastCell->m_info;
-			m_info->m_nextOpen = NULL;
-		}
+		if (!isBefore(m_heap[child], info)) break;
+		m_heap[ndx] = m_heap[child];
+		m_heap[ndx]->m_openIndex = ndx;
+		ndx = child;
 	}
+	m_heap[ndx] = info;
+	info->m_openIndex = ndx;
+}
+
+void PathfindOpenList::insert(PathfindCellInfo *info)
+{
+	if (m_count >= m_capacity) {
+		DEBUG_CRASH(("Open list overflow."));
+		return;
+	}
+	// Every search starts with an empty list, so restarting the sequence here gives each search 
+	// the same tie order no matter how many searches came before it.
+	if (m_count == 0) {
+		m_nextSequence = 0;
+	}
+	info->m_openSequence = m_nextSequence++;
+	m_heap[m_count] = info;
+	m_count++;
+	siftUp(m_count-1);
+}
+
+void PathfindOpenList::remove(PathfindCellInfo *info)
+{
+	Int ndx = info->m_openIndex;
+	DEBUG_ASSERTCRASH(ndx>=0 && ndx<m_count && m_heap[ndx]==info, ("Cell is not on the open list."));
+	info->m_openIndex = -1;
+	m_count--;
+	if (ndx == m_count) {
+		return;
+	}
+	m_heap[ndx] = m_heap[m_count];
+	m_heap[ndx]->m_openIndex = ndx;
+	if (ndx>0 && isBefore(m_heap[ndx], m_heap[(ndx-1)>>1])) {
+		siftUp(ndx);
+	}	else {
+		siftDown(ndx);
+	}
+}
+
+/// put self on "open" list in ascending cost order
+void PathfindCell::putOnSortedOpenList( PathfindOpenList &list )
+{
+	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
+	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==FALSE, ("Serious error - Invalid flags. jba"));
+	m_info->m_prevOpen = NULL;
+	m_info->m_nextOpen = NULL;
+	list.insert(m_info);
 
 	// mark newCell as being on open list
 	m_info->m_open = true;
 	m_info->m_closed = false;
-
-	return list;
 }
 
 /// remove self from "open" list
-PathfindCell *PathfindCell::removeFromOpenList( PathfindCell *list )
+void PathfindCell::removeFromOpenList( PathfindOpenList &list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
-	if (m_info->m_nextOpen)
-		m_info->m_nextOpen->m_prevOpen = m_info->m_prevOpen;
-	
-	if (m_info->m_prevOpen)
-		m_info->m_prevOpen->m_nextOpen = m_info->m_nextOpen;
-	else
-		list = getNextOpen();
+	list.remove(m_info);
 
 	m_info->m_open = false;
 	m_info->m_nextOpen = NULL;
 	m_info->m_prevOpen = NULL;
-
-	return list;
 }
 
 /// remove all cells from "open" list
-Int PathfindCell::releaseOpenList( PathfindCell *list )
+Int PathfindCell::releaseOpenList( PathfindOpenList &list )
 {
-	Int count = 0;
-	while (list) {
-		count++;
-		DEBUG_ASSERTCRASH(list->m_info, ("Has to have info."));
-		DEBUG_ASSERTCRASH(list->m_info->m_closed==FALSE && list->m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
-		PathfindCell *cur = list;
-		PathfindCellInfo *curInfo = list->m_info;
-		if (curInfo->m_nextOpen) {
-			list = curInfo->m_nextOpen->m_cell;
-		}	else {
-			list = NULL;
-		}
-		DEBUG_ASSERTCRASH(cur == curInfo->m_cell, ("Bad backpointer in PathfindCellInfo"));
+	Int count = list.getCount();
+	Int i;
+	for (i=0; i<count; i++) {
+		PathfindCell *cur = list.getNth(i);
+		DEBUG_ASSERTCRASH(cur->m_info, ("Has to have info."));
+		DEBUG_ASSERTCRASH(cur->m_info->m_closed==FALSE && cur->m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
+		PathfindCellInfo *curInfo = cur->m_info;
 		curInfo->m_nextOpen = NULL;
 		curInfo->m_prevOpen = NULL;
+		curInfo->m_openIndex = -1;
 		curInfo->m_open = FALSE;
 		cur->releaseInfo();
 	}
+	list.clear();
 	return count;
 }
 
@@ -3388,6 +3455,7 @@ Pathfinder::Pathfinder( void ) :m_map(NULL)
 {
 	debugPath = NULL;
 	PathfindCellInfo::allocateCellInfos();
+	m_openList.allocate(CELL_INFOS_TO_ALLOCATE);
 	reset();
 }
 
@@ -3418,7 +3486,7 @@ void Pathfinder::reset( void )
 	// reset the pathfind grid
 	m_extent.lo.x=m_extent.lo.y=m_extent.hi.x=m_extent.hi.y=0;
 	m_logicalExtent.lo.x=m_logicalExtent.lo.y=m_logicalExtent.hi.x=m_logicalExtent.hi.y=0;
-	m_openList = NULL;
+	m_openList.clear();
 	m_closedList = NULL;
 
 	m_ignoreObstacleID = INVALID_ID;
@@ -4222,8 +4290,10 @@ void Pathfinder::debugShowSearch(  Bool pathFound  )
 		addIcon(NULL, 0, 0, color);	 // erase.
 	}
 
-	for( s = m_openList; s; s=s->getNextOpen() )
+	Int i;
+	for( i = 0; i < m_openList.getCount(); i++ )
 	{
+		s = m_openList.getNth(i);
 		// create objects to show path - they decay
 		RGBColor color;
 		color.red = color.green = 0;
@@ -4324,9 +4394,8 @@ Bool Pathfinder::validMovementTerrain( PathfindLayerEnum layer, const Locomotor*
 //
 void Pathfinder::cleanOpenAndClosedLists(void) {
 	Int count = 0;
-	if (m_openList) {
+	if (!m_openList.isEmpty()) {
 		count += PathfindCell::releaseOpenList(m_openList);
-		m_openList = NULL;
 	}		 
 	if (m_closedList) {
 		count += PathfindCell::releaseClosedList(m_closedList);
@@ -5451,6 +5520,175 @@ void Pathfinder::processPathfindQueue(void)
 
 }
 
+//-----------------------------------------------------------------------------
+/** 
+ * Pick a cell from the logical extent with a private random sequence, so the
+ * logic random seed is left alone.
+ */
+static void stressBenchmarkPoint(UnsignedInt *seed, const IRegion2D &extent, Coord3D *pos)
+{
+	*seed = *seed * 1664525 + 1013904223;
+	Int x = extent.lo.x + (Int)((*seed >> 8) % (UnsignedInt)(extent.hi.x - extent.lo.x + 1));
+	*seed = *seed * 1664525 + 1013904223;
+	Int y = extent.lo.y + (Int)((*seed >> 8) % (UnsignedInt)(extent.hi.y - extent.lo.y + 1));
+	pos->x = (x + 0.5f) * PATHFIND_CELL_SIZE_F;
+	pos->y = (y + 0.5f) * PATHFIND_CELL_SIZE_F;
+	pos->z = TheTerrainLogic->getGroundHeight(pos->x, pos->y);
+}
+
+//-----------------------------------------------------------------------------
+/** 
+ * Copy the ground layer into a snapshot that searches on other threads can share: which cells
+ * findGroundPath would step into, how wide a path of pathDiameter fits in each, and each 
+ * cell's effective ground zone.
+ */
+void Pathfinder::buildMapSnapshot(PathfindMapSnapshot *snapshot, Int pathDiameter)
+{
+	Int width = m_extent.hi.x - m_extent.lo.x + 1;
+	Int height = m_extent.hi.y - m_extent.lo.y + 1;
+	snapshot->init(width, height);
+
+	Int x, y;
+	for (y=0; y<height; y++) {
+		for (x=0; x<width; x++) {
+			Int cellX = x + m_extent.lo.x;
+			Int cellY = y + m_extent.lo.y;
+			PathfindCell *cell = getCell(LAYER_GROUND, cellX, cellY);
+			if (cell == NULL) {
+				continue;
+			}
+			UnsignedByte flags = 0;
+			Int clearDiameter = 0;
+			if (cell->getPinched()) {
+				flags |= PathfindMapSnapshot::CELL_PINCHED;
+			} else if (cell->getType() == PathfindCell::CELL_CLEAR) {
+				flags |= PathfindMapSnapshot::CELL_ENTERABLE;
+				clearDiameter = clearCellForDiameter(false, cellX, cellY, LAYER_GROUND, pathDiameter);
+			}
+			UnsignedShort zone = m_zoneManager.getEffectiveZone(LOCOMOTORSURFACE_GROUND, false, cell->getZone());
+			snapshot->setCell(x, y, flags, clearDiameter, zone);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** 
+ * Time numPaths ground paths between the same pseudo-random points every run, and
+ * checksum the paths, so a change to the search can be checked for both speed and
+ * identical results.  The paths are thrown away, so the map is left as it was.
+ * findGroundPath runs the searches one after another, the way processPathfindQueue 
+ * runs them, since it keeps its open and closed lists in the cells themselves.  Then the 
+ * same searches are run on a snapshot of the ground layer by 1..maxThreads workers 
+ * (maxThreads <= 0 means one per processor), each with its own open and closed lists.
+ */
+void Pathfinder::runStressBenchmark(Int numPaths, Int maxThreads, PathfindBenchmarkResult *result)
+{
+	static const Int BENCHMARK_PATH_DIAMETER = 2;
+
+	result->m_paths = 0;
+	result->m_pathsFound = 0;
+	result->m_cells = 0;
+	result->m_elapsedMS = 0;
+	result->m_checksum = 0;
+	result->m_snapshotMS = 0;
+	result->m_snapshotPathsFound = 0;
+	result->m_snapshotCells = 0;
+	result->m_threadRuns = 0;
+
+	if (!m_isMapReady) {
+		return;
+	}
+	if (m_zoneManager.needToCalculateZones()) {
+		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+	}
+	if (m_logicalExtent.hi.x <= m_logicalExtent.lo.x || m_logicalExtent.hi.y <= m_logicalExtent.lo.y) {
+		return;
+	}
+
+	Int savedCells = m_cumulativeCellsAllocated;
+	m_cumulativeCellsAllocated = 0;
+	UnsignedInt seed = 0x1234567;
+	UnsignedInt checksum = 0;
+	std::vector<PathfindSnapshotJob> jobs(numPaths);
+	UnsignedInt startTime = timeGetTime();
+	Int i;
+	for (i=0; i<numPaths; i++) {
+		Coord3D from, to;
+		stressBenchmarkPoint(&seed, m_logicalExtent, &from);
+		stressBenchmarkPoint(&seed, m_logicalExtent, &to);
+		worldToCell(&from, &jobs[i].m_from);
+		worldToCell(&to, &jobs[i].m_to);
+		jobs[i].m_from.x -= m_extent.lo.x;
+		jobs[i].m_from.y -= m_extent.lo.y;
+		jobs[i].m_to.x -= m_extent.lo.x;
+		jobs[i].m_to.y -= m_extent.lo.y;
+		Path *path = findGroundPath(&from, &to, BENCHMARK_PATH_DIAMETER, false);
+		result->m_paths++;
+		if (path) {
+			result->m_pathsFound++;
+			for (const PathNode *node = path->getFirstNode(); node; node = node->getNext()) {
+				checksum = checksum*31 + REAL_TO_INT_FLOOR(node->getPosition()->x);
+				checksum = checksum*31 + REAL_TO_INT_FLOOR(node->getPosition()->y);
+			}
+			path->deleteInstance();
+		}
+	}
+	result->m_elapsedMS = timeGetTime() - startTime;
+	result->m_cells = m_cumulativeCellsAllocated;
+	result->m_checksum = checksum;
+	m_cumulativeCellsAllocated = savedCells;
+
+	if (numPaths <= 0) {
+		return;
+	}
+
+	// now the same searches on the snapshot, with more and more workers
+	if (maxThreads <= 0) {
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		maxThreads = systemInfo.dwNumberOfProcessors;
+	}
+	if (maxThreads > PathfindBenchmarkResult::MAX_THREAD_RUNS) {
+		maxThreads = PathfindBenchmarkResult::MAX_THREAD_RUNS;
+	}
+	if (maxThreads > PathfindWorkerPool::MAX_WORKERS) {
+		maxThreads = PathfindWorkerPool::MAX_WORKERS;
+	}
+
+	startTime = timeGetTime();
+	PathfindMapSnapshot snapshot;
+	buildMapSnapshot(&snapshot, BENCHMARK_PATH_DIAMETER);
+	result->m_snapshotMS = timeGetTime() - startTime;
+
+	std::vector<PathfindSnapshotResult> results(numPaths);
+	for (Int threads=1; threads<=maxThreads; threads++) {
+		PathfindWorkerPool pool(threads);
+		if (pool.getWorkerCount() != threads) {
+			break;	// couldn't start them all
+		}
+		startTime = timeGetTime();
+		pool.run(snapshot, &jobs[0], &results[0], numPaths, BENCHMARK_PATH_DIAMETER);
+		result->m_threadElapsedMS[threads-1] = timeGetTime() - startTime;
+
+		// commit in queue order
+		checksum = 0;
+		Int found = 0;
+		Int cells = 0;
+		for (i=0; i<numPaths; i++) {
+			if (results[i].m_found) {
+				found++;
+				checksum = checksum*31 + results[i].m_checksum;
+			}
+			cells += results[i].m_cells;
+		}
+		result->m_threadChecksum[threads-1] = checksum;
+		result->m_snapshotPathsFound = found;
+		result->m_snapshotCells = cells;
+		result->m_threadRuns = threads;
+		DEBUG_ASSERTCRASH(checksum == result->m_threadChecksum[0], ("Snapshot paths with %d workers differ from 1 worker\n", threads));
+	}
+}
+
 
 void Pathfinder::checkChangeLayers(PathfindCell *parentCell)
 {
@@ -5487,7 +5725,7 @@ void Pathfinder::checkChangeLayers(PathfindCell *parentCell)
 					newCell->setCostSoFar(parentCell->getCostSoFar()); // same as parent cost
 					newCell->setTotalCost(parentCell->getTotalCost()) ;
 					// insert newCell in open list such that open list is sorted, smallest total path cost first
-					m_openList = newCell->putOnSortedOpenList( m_openList );
+					newCell->putOnSortedOpenList( m_openList );
 
 				}
 			}
@@ -5595,10 +5833,10 @@ struct ExamineCellsStruct
 
 			// if the to was already on the open list, remove it so it can be re-inserted in order
 			if (to->getOpen())
-				d->thePathfinder->m_openList = to->removeFromOpenList( d->thePathfinder->m_openList );
+				to->removeFromOpenList( d->thePathfinder->m_openList );
 
 			// insert to in open list such that open list is sorted, smallest total path cost first
-			d->thePathfinder->m_openList = to->putOnSortedOpenList( d->thePathfinder->m_openList );
+			to->putOnSortedOpenList( d->thePathfinder->m_openList );
 	}
 
 	return 0;	// keep going
@@ -5857,10 +6095,10 @@ Int Pathfinder::examineNeighboringCells(PathfindCell *parentCell, PathfindCell *
 
 			// if the newCell was already on the open list, remove it so it can be re-inserted in order
 			if (newCell->getOpen())
-				m_openList = newCell->removeFromOpenList( m_openList );
+				newCell->removeFromOpenList( m_openList );
 
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = newCell->putOnSortedOpenList( m_openList );
+			newCell->putOnSortedOpenList( m_openList );
 		}
 	return cellCount;
 }
@@ -5970,7 +6208,7 @@ Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSe
 		DEBUG_LOG(("Attempting pathfind to 0,0, generally a bug.\n"));
 		return NULL;
 	}
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	if (m_isMapReady == false) {
 		return NULL;
 	}
@@ -6084,7 +6322,7 @@ Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSe
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -6095,11 +6333,11 @@ Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSe
 	// Continue search until "open" list is empty, or
 	// until goal is found.
 	//
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		if (parentCell == goalCell)
 		{
@@ -6450,7 +6688,7 @@ struct GroundCellsStruct
 			to->setTotalCost(to->getCostSoFar() + costRemaining) ;
 
 			// insert to in open list such that open list is sorted, smallest total path cost first
-			d->thePathfinder->m_openList = to->putOnSortedOpenList( d->thePathfinder->m_openList );
+			to->putOnSortedOpenList( d->thePathfinder->m_openList );
 	}
 
 	return 0;	// keep going
@@ -6486,7 +6724,7 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
 		DEBUG_LOG(("Attempting pathfind to 0,0, generally a bug.\n"));
 		return NULL;
 	}
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	if (m_isMapReady == false) {
 		return NULL;
 	}
@@ -6573,7 +6811,7 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -6583,11 +6821,11 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
 	// until goal is found.
 	//
 	Int cellCount = 0;
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		if (parentCell == goalCell)
 		{
@@ -6740,10 +6978,10 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
 
 			// if the newCell was already on the open list, remove it so it can be re-inserted in order
 			if (newCell->getOpen())
-				m_openList = newCell->removeFromOpenList( m_openList );
+				newCell->removeFromOpenList( m_openList );
 
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = newCell->putOnSortedOpenList( m_openList );
+			newCell->putOnSortedOpenList( m_openList );
 		}
 
 
@@ -6867,7 +7105,7 @@ void Pathfinder::processHierarchicalCell( const ICoord2D &scanCell, const ICoord
 		adjNewCell->setTotalCost(adjNewCell->getCostSoFar()+remCost);
 		adjNewCell->setParentCellHierarchical(parentCell);
 		// insert newCell in open list such that open list is sorted, smallest total path cost first
-		m_openList = adjNewCell->putOnSortedOpenList( m_openList );
+		adjNewCell->putOnSortedOpenList( m_openList );
 
 	}
 }
@@ -6912,7 +7150,7 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 		DEBUG_LOG(("Attempting pathfind to 0,0, generally a bug.\n"));
 		return NULL;
 	}
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	if (m_isMapReady == false) {
 		return NULL;
 	}
@@ -6987,9 +7225,9 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 
 	if (parentCell->getLayer()==LAYER_GROUND) {
 		// initialize "open" list to contain start cell
-		m_openList = parentCell;
+		parentCell->putOnSortedOpenList( m_openList );
 	}	else {
-		m_openList = parentCell;
+		parentCell->putOnSortedOpenList( m_openList );
 		PathfindLayerEnum layer = parentCell->getLayer();
 		// We're starting on a bridge, so link to land at the bridge end points.
 		ICoord2D ndx;
@@ -7000,7 +7238,7 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 		PathfindCell *startCell = getCell(LAYER_GROUND, ndx.x, ndx.y);
 		if (cell && startCell) {
 			// Close parent cell;
-			m_openList = parentCell->removeFromOpenList(m_openList);
+			parentCell->removeFromOpenList( m_openList );
 			m_closedList = parentCell->putOnClosedList(m_closedList);
 			startCell->allocateInfo(ndx);
 			startCell->setParentCellHierarchical(parentCell);
@@ -7011,7 +7249,7 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 			startCell->setTotalCost(remCost);
 			startCell->setParentCellHierarchical(parentCell);
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = startCell->putOnSortedOpenList( m_openList );
+			startCell->putOnSortedOpenList( m_openList );
 
 			cellCount++;
 			cell->allocateInfo(toNdx);
@@ -7021,7 +7259,7 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 			cell->setTotalCost(remCost);
 			cell->setParentCellHierarchical(parentCell);
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = cell->putOnSortedOpenList( m_openList );
+			cell->putOnSortedOpenList( m_openList );
 		}
 	}
 
@@ -7032,11 +7270,11 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 	// Continue search until "open" list is empty, or
 	// until goal is found.
 	//
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		UnsignedShort parentZone;
 		if (parentCell->getLayer()==LAYER_GROUND) {
@@ -7115,7 +7353,7 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 					cell->setTotalCost(cell->getCostSoFar()+remCost);
 					cell->setParentCellHierarchical(startCell);
 					// insert newCell in open list such that open list is sorted, smallest total path cost first
-					m_openList = cell->putOnSortedOpenList( m_openList );
+					cell->putOnSortedOpenList( m_openList );
 
 				}
 			}
@@ -7571,7 +7809,7 @@ Bool Pathfinder::pathDestination( 	Object *obj, const LocomotorSet& locomotorSet
 
 	Coord3D adjustTo = *groupDest;
 	Coord3D *to = &adjustTo;
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	// create unique "mark" values for open and closed cells for this pathfind invocation
 
 	Bool isCrusher = obj ? obj->getCrusherLevel() > 0 : false;
@@ -7630,7 +7868,7 @@ Bool Pathfinder::pathDestination( 	Object *obj, const LocomotorSet& locomotorSet
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -7639,11 +7877,11 @@ Bool Pathfinder::pathDestination( 	Object *obj, const LocomotorSet& locomotorSet
 	// Continue search until "open" list is empty, or
 	// until goal is found.
 	//
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		Coord3D pos;
 		// put parent cell onto closed list - its evaluation is finished
@@ -7766,10 +8004,10 @@ Bool Pathfinder::pathDestination( 	Object *obj, const LocomotorSet& locomotorSet
 
 			// if the newCell was already on the open list, remove it so it can be re-inserted in order
 			if (newCell->getOpen())
-				m_openList = newCell->removeFromOpenList( m_openList );
+				newCell->removeFromOpenList( m_openList );
 
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = newCell->putOnSortedOpenList( m_openList );
+			newCell->putOnSortedOpenList( m_openList );
 		}
 	}
 
@@ -7849,7 +8087,7 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 
 	Coord3D adjustTo = *rawTo;
 	Coord3D *to = &adjustTo;
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	// create unique "mark" values for open and closed cells for this pathfind invocation
 
 	Bool isCrusher = obj ? obj->getCrusherLevel() > 0 : false;
@@ -7894,7 +8132,7 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -7903,11 +8141,11 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 	// Continue search until "open" list is empty, or
 	// until goal is found.
 	//
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		// put parent cell onto closed list - its evaluation is finished
 		m_closedList = parentCell->putOnClosedList( m_closedList );
@@ -8019,10 +8257,10 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 
 			// if the newCell was already on the open list, remove it so it can be re-inserted in order
 			if (newCell->getOpen())
-				m_openList = newCell->removeFromOpenList( m_openList );
+				newCell->removeFromOpenList( m_openList );
 
 			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = newCell->putOnSortedOpenList( m_openList );
+			newCell->putOnSortedOpenList( m_openList );
 		}
 	}
 
@@ -8078,7 +8316,7 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 		adjustTo.x += PATHFIND_CELL_SIZE_F/2;
 		adjustTo.y += PATHFIND_CELL_SIZE_F/2;
 	}
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	// create unique "mark" values for open and closed cells for this pathfind invocation
 
 	Bool isCrusher = obj ? obj->getCrusherLevel() > 0 : false;
@@ -8177,7 +8415,7 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 	Real closestDistScreenSqr = FLT_MAX;
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -8186,14 +8424,14 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 	// Continue search until "open" list is empty, or
 	// until goal is found.
 	//
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		Real dx;
 		Real dy;
 		Real distSqr;
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		if (parentCell == goalCell)
 		{
@@ -9573,7 +9811,7 @@ Path *Pathfinder::getMoveAwayFromPath(Object* obj, Object *otherObj,
 	Int radius;
 	getRadiusAndCenter(obj, radius, centerInCell);
 
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 
 	// determine start cell
 	ICoord2D startCellNdx;
@@ -9613,7 +9851,7 @@ Path *Pathfinder::getMoveAwayFromPath(Object* obj, Object *otherObj,
 	parentCell->startPathfind(NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -9628,11 +9866,11 @@ Path *Pathfinder::getMoveAwayFromPath(Object* obj, Object *otherObj,
 	boxHalfWidth += otherRadius*PATHFIND_CELL_SIZE_F;
 	if (otherCenter) boxHalfWidth+=PATHFIND_CELL_SIZE_F/2;
 
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		Region2D bounds;
 		Coord3D cellCenter;
@@ -9741,7 +9979,7 @@ Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet
 
 	m_zoneManager.setAllPassable();
 
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 
 	enum {CELL_LIMIT = 2000}; // max cells to examine.
 	Int cellCount = 0;
@@ -9772,7 +10010,7 @@ Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet
 	parentCell->startPathfind( NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -9842,11 +10080,11 @@ Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet
 		return NULL;
 	}
 
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		Coord3D cellCenter;
 		adjustCoordToCell(parentCell->getXIndex(), parentCell->getYIndex(), centerInCell, cellCenter, parentCell->getLayer());
@@ -10010,7 +10248,7 @@ Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomot
 
 	Int cellCount = 0;
 
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 
 	Int attackDistance = weapon->getAttackDistance(obj, victim, victimPos);
 	attackDistance += 3*PATHFIND_CELL_SIZE;
@@ -10051,7 +10289,7 @@ Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomot
 	}
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -10071,11 +10309,11 @@ Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomot
 		checkLOS = true;
 	}
 	
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		Coord3D cellCenter;
 		adjustCoordToCell(parentCell->getXIndex(), parentCell->getYIndex(), centerInCell, cellCenter, parentCell->getLayer());
@@ -10227,7 +10465,7 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 		isHuman = false; // computer gets to cheat.
 	}
 
-	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
+	DEBUG_ASSERTCRASH(m_openList.isEmpty() && m_closedList == NULL, ("Dangling lists."));
 	// create unique "mark" values for open and closed cells for this pathfind invocation
 
 	m_zoneManager.setAllPassable();
@@ -10246,7 +10484,7 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 	parentCell->startPathfind( NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -10258,11 +10496,11 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 
 	Real farthestDistanceSqr = 0;
 
-	while( m_openList != NULL )
+	while( !m_openList.isEmpty() )
 	{
 		// take head cell off of open list - it has lowest estimated total path cost
-		parentCell = m_openList;
-		m_openList = parentCell->removeFromOpenList(m_openList);
+		parentCell = m_openList.getHead();
+		parentCell->removeFromOpenList( m_openList );
 
 		Coord3D cellCenter;
 		adjustCoordToCell(parentCell->getXIndex(), parentCell->getYIndex(), centerInCell, cellCenter, parentCell->getLayer());
@@ -10281,7 +10519,7 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 		if (distSqr>repulsorDistSqr) {
 			ok = true;
 		}
-		if (m_openList == NULL && cellCount>0) {
+		if (m_openList.isEmpty() && cellCount>0) {
 			ok = true; // exhausted the search space, just take the last cell.
 		}
 		if (distSqr > farthestDistanceSqr) {
@@ -0,0 +1,520 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// FILE: AIPathfindWorkers.cpp ////////////////////////////////////////////////
+// Ground path searches against a read-only copy of the pathfind map, so that
+// many can run at once on worker threads.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+
+#include "Common/SelfTest.h"
+#include "GameLogic/AIPathfindWorkers.h"
+
+// the same step costs findGroundPath uses
+static const Int SNAPSHOT_COST_ORTHOGONAL = 10;
+static const Int SNAPSHOT_COST_DIAGONAL = 14;
+
+//-------------------------------------------------------------------------------------------------
+/** PathfindCell::costToGoal, on snapshot cells */
+//-------------------------------------------------------------------------------------------------
+inline static UnsignedInt snapshotCostToGoal( Int x, Int y, Int goalX, Int goalY )
+{
+	Int dx = x - goalX;
+	Int dy = y - goalY;
+	if (dx<0) dx = -dx;
+	if (dy<0) dy = -dy;
+	if (dx>dy) {
+		return SNAPSHOT_COST_ORTHOGONAL*dx + (SNAPSHOT_COST_ORTHOGONAL*dy)/2;
+	}
+	return SNAPSHOT_COST_ORTHOGONAL*dy + (SNAPSHOT_COST_ORTHOGONAL*dx)/2;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PathfindMapSnapshot
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+PathfindMapSnapshot::PathfindMapSnapshot( void ) :
+	m_width( 0 ),
+	m_height( 0 )
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindMapSnapshot::init( Int width, Int height )
+{
+	m_width = width;
+	m_height = height;
+	m_cells.assign( width * height, 0 );
+	m_zones.assign( width * height, 0 );
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindMapSnapshot::setCell( Int x, Int y, UnsignedByte flags, Int clearDiameter, UnsignedShort zone )
+{
+	DEBUG_ASSERTCRASH( x >= 0 && x < m_width && y >= 0 && y < m_height, ("PathfindMapSnapshot - cell %d,%d is off the map\n", x, y) );
+	if (clearDiameter > 3) {
+		clearDiameter = 3;
+	}
+	Int index = y * m_width + x;
+	m_cells[ index ] = (UnsignedByte)(flags | (clearDiameter << CELL_DIAMETER_SHIFT));
+	m_zones[ index ] = zone;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PathfindSearchScratch
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+PathfindSearchScratch::PathfindSearchScratch( void ) :
+	m_generation( 0 )
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool PathfindSearchScratch::isCostlier( const OpenEntry &a, const OpenEntry &b )
+{
+	if (a.m_totalCost != b.m_totalCost) {
+		return a.m_totalCost > b.m_totalCost;
+	}
+	// ties go to the lower cell, so a search always expands cells in the same order
+	return a.m_cell > b.m_cell;
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindSearchScratch::reserve( const PathfindMapSnapshot &map )
+{
+	Int count = map.getCellCount();
+	if ((Int)m_visited.size() != count) {
+		m_visited.assign( count, 0 );
+		m_costSoFar.assign( count, 0 );
+		m_parent.assign( count, -1 );
+		m_generation = 0;
+	}
+	m_open.reserve( count/4 + 64 );
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindSearchScratch::beginSearch( void )
+{
+	m_open.clear();
+	++m_generation;
+	if (m_generation >= 0x7fffffff) {
+		// the stamp is about to run into the closed bit, start over
+		std::fill( m_visited.begin(), m_visited.end(), 0 );
+		m_generation = 1;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindSearchScratch::pushOpen( Int cell, UnsignedInt totalCost )
+{
+	OpenEntry entry;
+	entry.m_totalCost = totalCost;
+	entry.m_cell = cell;
+	m_open.push_back( entry );
+	std::push_heap( m_open.begin(), m_open.end(), isCostlier );
+}
+
+//-------------------------------------------------------------------------------------------------
+/** 
+ * A* over the snapshot, following findGroundPath's rules on the ground layer: only 
+ * enterable cells may be stepped into (the goal always may), a diagonal step needs one of 
+ * its orthogonal neighbors to have been enterable, and the cost of a step is 
+ * PathfindCell::costSoFar's - straight or diagonal, plus turns - plus findGroundPath's 
+ * penalty for cells narrower than the path diameter.
+ */
+void PathfindSearchScratch::search( const PathfindMapSnapshot &map, const PathfindSnapshotJob &job, Int pathDiameter, 
+																		PathfindSnapshotResult *result )
+{
+	result->m_found = FALSE;
+	result->m_cells = 0;
+	result->m_length = 0;
+	result->m_checksum = 0;
+
+	Int width = map.getWidth();
+	Int height = map.getHeight();
+	if (job.m_from.x < 0 || job.m_from.x >= width || job.m_from.y < 0 || job.m_from.y >= height) {
+		return;
+	}
+	if (job.m_to.x < 0 || job.m_to.x >= width || job.m_to.y < 0 || job.m_to.y >= height) {
+		return;
+	}
+	DEBUG_ASSERTCRASH( (Int)m_visited.size() == map.getCellCount(), ("PathfindSearchScratch - reserve() wasn't called for this map\n") );
+
+	Int start = job.m_from.y * width + job.m_from.x;
+	Int goal = job.m_to.y * width + job.m_to.x;
+
+	// like findGroundPath, don't even try if the zones say it can't be done
+	if (map.getZone( start ) != map.getZone( goal )) {
+		return;
+	}
+
+	beginSearch();
+	const UnsignedInt open = m_generation << 1;
+	const UnsignedInt closed = open | 1;
+
+	m_visited[ start ] = open;
+	m_costSoFar[ start ] = 0;
+	m_parent[ start ] = -1;
+	pushOpen( start, snapshotCostToGoal( job.m_from.x, job.m_from.y, job.m_to.x, job.m_to.y ) );
+
+	static const Int deltaX[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const Int deltaY[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const Int numNeighbors = 8;
+	const Int firstDiagonal = 4;
+	const Int adjacent[5] = {0, 1, 2, 3, 0};
+
+	while (!m_open.empty())
+	{
+		std::pop_heap( m_open.begin(), m_open.end(), isCostlier );
+		OpenEntry entry = m_open.back();
+		m_open.pop_back();
+
+		Int cell = entry.m_cell;
+		Int cellY = cell / width;
+		Int cellX = cell - cellY * width;
+
+		// a cell that has been closed, or reopened at a lower cost, leaves entries behind
+		if (m_visited[ cell ] != open) {
+			continue;
+		}
+		if (entry.m_totalCost != m_costSoFar[ cell ] + snapshotCostToGoal( cellX, cellY, job.m_to.x, job.m_to.y )) {
+			continue;
+		}
+
+		if (cell == goal)
+		{
+			result->m_found = TRUE;
+			for (Int c = goal; c != -1; c = m_parent[ c ]) {
+				result->m_length++;
+				result->m_checksum = result->m_checksum*31 + (UnsignedInt)c;
+			}
+			return;
+		}
+
+		m_visited[ cell ] = closed;
+
+		// direction we arrived from, for the turn cost
+		Int parent = m_parent[ cell ];
+		Int dirX = 0, dirY = 0;
+		if (parent != -1) {
+			Int parentY = parent / width;
+			dirX = (parent - parentY * width) - cellX;
+			dirY = parentY - cellY;
+		}
+
+		Bool neighborFlags[8] = {false, false, false, false, false, false, false, false};
+		for (Int i=0; i<numNeighbors; i++)
+		{
+			Int x = cellX + deltaX[i];
+			Int y = cellY + deltaY[i];
+			if (x < 0 || x >= width || y < 0 || y >= height) {
+				continue;
+			}
+			Int newCell = y * width + x;
+			UnsignedByte flags = map.getFlags( newCell );
+
+			UnsignedInt newCostSoFar = m_costSoFar[ cell ] + (i < firstDiagonal ? SNAPSHOT_COST_ORTHOGONAL : SNAPSHOT_COST_DIAGONAL);
+			if (newCell != goal) {
+				if (i>=firstDiagonal) {
+					// make sure one of the adjacent sides is open.
+					if (!neighborFlags[adjacent[i-4]] && !neighborFlags[adjacent[i-3]]) {
+						continue;
+					}
+				}
+				if (!(flags & PathfindMapSnapshot::CELL_ENTERABLE)) {
+					continue;
+				}
+				neighborFlags[i] = true;
+
+				Int clearDiameter = map.getClearDiameter( newCell );
+				if (clearDiameter < pathDiameter) {
+					newCostSoFar += (UnsignedInt)(0.6f*((pathDiameter-clearDiameter)*SNAPSHOT_COST_ORTHOGONAL));
+				}
+			}
+			if (flags & PathfindMapSnapshot::CELL_PINCHED) {
+				newCostSoFar += SNAPSHOT_COST_DIAGONAL;
+			}
+			result->m_cells++;
+
+			// turns cost extra, the sharper the more
+			if (parent != -1) {
+				Int prevDirX = -deltaX[i];
+				Int prevDirY = -deltaY[i];
+				if (dirX != prevDirX || dirY != prevDirY) {
+					Int dot = dirX * prevDirX + dirY * prevDirY;
+					if (dot > 0) {
+						newCostSoFar += 4;
+					} else if (dot == 0) {
+						newCostSoFar += 8;
+					} else {
+						newCostSoFar += 16;
+					}
+				}
+			}
+
+			// already on a list - if existing costSoFar is less, the new cell is on a longer path
+			if ((m_visited[ newCell ] >> 1) == m_generation && m_costSoFar[ newCell ] <= newCostSoFar) {
+				continue;
+			}
+
+			m_visited[ newCell ] = open;
+			m_costSoFar[ newCell ] = newCostSoFar;
+			m_parent[ newCell ] = cell;
+			pushOpen( newCell, newCostSoFar + snapshotCostToGoal( x, y, job.m_to.x, job.m_to.y ) );
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PathfindWorkerPool
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+PathfindWorkerPool::PathfindWorkerPool( Int numWorkers ) :
+	m_numWorkers( 0 ),
+	m_nextJob( 0 ),
+	m_shouldExit( FALSE ),
+	m_map( NULL ),
+	m_jobs( NULL ),
+	m_results( NULL ),
+	m_numJobs( 0 ),
+	m_pathDiameter( 0 )
+{
+	if (numWorkers < 1) {
+		numWorkers = 1;
+	}
+	if (numWorkers > MAX_WORKERS) {
+		numWorkers = MAX_WORKERS;
+	}
+
+	for (Int i=0; i<numWorkers; i++)
+	{
+		Worker *worker = &m_workers[ m_numWorkers ];
+		worker->m_pool = this;
+		worker->m_startEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+		worker->m_doneEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+		worker->m_thread = NULL;
+		if (worker->m_startEvent && worker->m_doneEvent) {
+			worker->m_thread = CreateThread( NULL, 0, workerThreadProc, worker, 0, NULL );
+		}
+		if (worker->m_thread == NULL)
+		{
+			DEBUG_CRASH(( "PathfindWorkerPool - could not start worker %d\n", i ));
+			if (worker->m_startEvent) {
+				CloseHandle( worker->m_startEvent );
+			}
+			if (worker->m_doneEvent) {
+				CloseHandle( worker->m_doneEvent );
+			}
+			break;
+		}
+		m_numWorkers++;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+PathfindWorkerPool::~PathfindWorkerPool()
+{
+	m_shouldExit = TRUE;
+	Int i;
+	for (i=0; i<m_numWorkers; i++) {
+		SetEvent( m_workers[ i ].m_startEvent );
+	}
+	for (i=0; i<m_numWorkers; i++)
+	{
+		WaitForSingleObject( m_workers[ i ].m_thread, INFINITE );
+		CloseHandle( m_workers[ i ].m_thread );
+		CloseHandle( m_workers[ i ].m_startEvent );
+		CloseHandle( m_workers[ i ].m_doneEvent );
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindWorkerPool::run( const PathfindMapSnapshot &map, const PathfindSnapshotJob *jobs, PathfindSnapshotResult *results, 
+															Int numJobs, Int pathDiameter )
+{
+	m_map = &map;
+	m_jobs = jobs;
+	m_results = results;
+	m_numJobs = numJobs;
+	m_pathDiameter = pathDiameter;
+	m_nextJob = 0;
+
+	if (m_numWorkers == 0)
+	{
+		// no threads, so do it all here
+		PathfindSearchScratch scratch;
+		scratch.reserve( map );
+		for (Int j=0; j<numJobs; j++) {
+			scratch.search( map, jobs[ j ], pathDiameter, &results[ j ] );
+		}
+		return;
+	}
+
+	// size the scratch here, so the workers don't have to allocate
+	HANDLE done[ MAX_WORKERS ];
+	Int i;
+	for (i=0; i<m_numWorkers; i++)
+	{
+		m_workers[ i ].m_scratch.reserve( map );
+		done[ i ] = m_workers[ i ].m_doneEvent;
+	}
+
+	for (i=0; i<m_numWorkers; i++) {
+		SetEvent( m_workers[ i ].m_startEvent );
+	}
+	WaitForMultipleObjects( m_numWorkers, done, TRUE, INFINITE );
+
+	m_map = NULL;
+	m_jobs = NULL;
+	m_results = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI PathfindWorkerPool::workerThreadProc( LPVOID param )
+{
+	Worker *worker = (Worker *)param;
+	worker->m_pool->workerMain( worker );
+	releaseThreadMemoryPoolMagazines();
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindWorkerPool::workerMain( Worker *worker )
+{
+	for (;;)
+	{
+		WaitForSingleObject( worker->m_startEvent, INFINITE );
+		if (m_shouldExit) {
+			return;
+		}
+
+		// take jobs until there are none left; each result goes in its own job's slot
+		for (;;)
+		{
+			Int job = InterlockedIncrement( &m_nextJob ) - 1;
+			if (job >= m_numJobs) {
+				break;
+			}
+			worker->m_scratch.search( *m_map, m_jobs[ job ], m_pathDiameter, &m_results[ job ] );
+		}
+
+		SetEvent( worker->m_doneEvent );
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Self test
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+static Bool sameSnapshotResult( const PathfindSnapshotResult &a, const PathfindSnapshotResult &b )
+{
+	return a.m_found == b.m_found && a.m_cells == b.m_cells && a.m_length == b.m_length && a.m_checksum == b.m_checksum;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** 
+ * On a made-up map with a wall across it: a straight path is straight, the wall is walked 
+ * around, a different zone isn't searched, and a batch run by the pool gives the same results,
+ * in the same slots, as running it here, whatever the number of workers.
+ */
+static Bool pathfindWorkersSelfTest( AsciiString *failure )
+{
+	const Int SIZE = 48;
+	const Int WALL_X = 24;
+	const Int GAP_Y = 40;
+	PathfindMapSnapshot map;
+	map.init( SIZE, SIZE );
+	Int x, y;
+	for (y=0; y<SIZE; y++) {
+		for (x=0; x<SIZE; x++) {
+			Bool wall = (x == WALL_X && y < GAP_Y);
+			map.setCell( x, y, wall ? 0 : PathfindMapSnapshot::CELL_ENTERABLE, 3, 1 );
+		}
+	}
+	// a corner off in its own zone
+	map.setCell( SIZE-1, SIZE-1, PathfindMapSnapshot::CELL_ENTERABLE, 3, 2 );
+
+	PathfindSearchScratch scratch;
+	scratch.reserve( map );
+	PathfindSnapshotJob job;
+	PathfindSnapshotResult result;
+
+	job.m_from.x = 2; job.m_from.y = 2;
+	job.m_to.x = 12; job.m_to.y = 2;
+	scratch.search( map, job, 2, &result );
+	if (!result.m_found || result.m_length != 11) {
+		failure->format( "straight path: found %d, length %d (expected 11)", result.m_found, result.m_length );
+		return false;
+	}
+
+	job.m_from.x = WALL_X-4; job.m_from.y = 5;
+	job.m_to.x = WALL_X+4; job.m_to.y = 5;
+	scratch.search( map, job, 2, &result );
+	if (!result.m_found || result.m_length < 2*(GAP_Y-5)) {
+		failure->format( "path around the wall: found %d, length %d", result.m_found, result.m_length );
+		return false;
+	}
+
+	job.m_to.x = SIZE-1; job.m_to.y = SIZE-1;
+	scratch.search( map, job, 2, &result );
+	if (result.m_found || result.m_cells != 0) {
+		failure->format( "path into another zone: found %d, %d cells examined", result.m_found, result.m_cells );
+		return false;
+	}
+
+	const Int NUM_JOBS = 64;
+	PathfindSnapshotJob jobs[ NUM_JOBS ];
+	PathfindSnapshotResult serial[ NUM_JOBS ];
+	PathfindSnapshotResult pooled[ NUM_JOBS ];
+	UnsignedInt seed = 0x1234567;
+	Int i;
+	for (i=0; i<NUM_JOBS; i++)
+	{
+		seed = seed * 1664525 + 1013904223;	jobs[ i ].m_from.x = (seed >> 8) % SIZE;
+		seed = seed * 1664525 + 1013904223;	jobs[ i ].m_from.y = (seed >> 8) % SIZE;
+		seed = seed * 1664525 + 1013904223;	jobs[ i ].m_to.x = (seed >> 8) % SIZE;
+		seed = seed * 1664525 + 1013904223;	jobs[ i ].m_to.y = (seed >> 8) % SIZE;
+		scratch.search( map, jobs[ i ], 2, &serial[ i ] );
+	}
+
+	static const Int workerCounts[] = { 1, 3, PathfindWorkerPool::MAX_WORKERS };
+	for (Int w=0; w<3; w++)
+	{
+		memset( pooled, 0, sizeof( pooled ) );
+		PathfindWorkerPool pool( workerCounts[ w ] );
+		pool.run( map, jobs, pooled, NUM_JOBS, 2 );
+		for (i=0; i<NUM_JOBS; i++)
+		{
+			if (!sameSnapshotResult( serial[ i ], pooled[ i ] ))
+			{
+				failure->format( "job %d differs with %d workers", i, pool.getWorkerCount() );
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+static SelfTestRegistration thePathfindWorkersSelfTest( "PathfindWorkers", pathfindWorkersSelfTest );
@@ -985,6 +985,15 @@ TerrainLogic::TerrainLogic()
 	m_bridgeDamageStatesChanged = FALSE;
 	m_mapDX = 0;
 	m_mapDY = 0;
+	m_mapBorderSize = 0;
+	m_mapMinHeight = 0;
+	m_mapMaxHeight = 0;
+	for( i = 0; i < HEIGHT_PYRAMID_LEVELS; ++i )
+	{
+		m_heightPyramid[ i ] = NULL;
+		m_heightPyramidDX[ i ] = 0;
+		m_heightPyramidDY[ i ] = 0;
+	}
 
 
 }  // end TerrainLogic
@@ -1016,6 +1025,7 @@ void TerrainLogic::reset( void )
 	deleteBridges();
 	PolygonTrigger::deleteTriggers();
 	m_numWaterToUpdate = 0;
+	freeMapHeights();
 
 }  // end reset
 
@@ -1423,24 +1433,585 @@ void TerrainLogic::deleteWaypoints(void)
 	m_waypointListHead = NULL;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Take a copy of the map's height samples.  The logic answers height and line of sight queries 
+	* from this copy, so it doesn't need a terrain render object to do it. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::initMapHeights( const UnsignedByte *heights, Int dx, Int dy, Int borderSize )
+{
+	freeMapHeights();
+
+	m_mapDX = dx;
+	m_mapDY = dy;
+	m_mapBorderSize = borderSize;
+	if( dx < 2 || dy < 2 )
+		return;
+
+	m_mapData = MSGNEW("TerrainLogic_MapData") UnsignedByte[ dx * dy ];
+	memcpy( m_mapData, heights, dx * dy );
+
+	// there is one fewer cell than samples each way
+	Int cellsX = dx - 1;
+	Int cellsY = dy - 1;
+	for( Int level = 0; level < HEIGHT_PYRAMID_LEVELS; ++level )
+	{
+		Int shift = HEIGHT_PYRAMID_BASE_SHIFT + level;
+		m_heightPyramidDX[ level ] = ((cellsX - 1) >> shift) + 1;
+		m_heightPyramidDY[ level ] = ((cellsY - 1) >> shift) + 1;
+		m_heightPyramid[ level ] = MSGNEW("TerrainLogic_HeightPyramid") HeightRange[ m_heightPyramidDX[ level ] * m_heightPyramidDY[ level ] ];
+	}
+
+	buildHeightPyramid();
+
+}  // end initMapHeights
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::freeMapHeights( void )
+{
+
+	delete [] m_mapData;
+	m_mapData = NULL;
+	for( Int level = 0; level < HEIGHT_PYRAMID_LEVELS; ++level )
+	{
+		delete [] m_heightPyramid[ level ];
+		m_heightPyramid[ level ] = NULL;
+		m_heightPyramidDX[ level ] = 0;
+		m_heightPyramidDY[ level ] = 0;
+	}
+	m_mapDX = 0;
+	m_mapDY = 0;
+	m_mapBorderSize = 0;
+	m_mapMinHeight = 0;
+	m_mapMaxHeight = 0;
+
+}  // end freeMapHeights
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::buildHeightPyramid( void )
+{
+	Int level, blockX, blockY;
+	for( level = 0; level < HEIGHT_PYRAMID_LEVELS; ++level )
+	{
+		for( blockY = 0; blockY < m_heightPyramidDY[ level ]; ++blockY )
+		{
+			for( blockX = 0; blockX < m_heightPyramidDX[ level ]; ++blockX )
+				updateHeightPyramidBlock( level, blockX, blockY );
+		}
+	}
+
+	// and the whole map from the top level
+	const HeightRange *top = m_heightPyramid[ HEIGHT_PYRAMID_LEVELS - 1 ];
+	Int topCount = m_heightPyramidDX[ HEIGHT_PYRAMID_LEVELS - 1 ] * m_heightPyramidDY[ HEIGHT_PYRAMID_LEVELS - 1 ];
+	m_mapMinHeight = top[ 0 ].lo;
+	m_mapMaxHeight = top[ 0 ].hi;
+	for( Int i = 1; i < topCount; ++i )
+	{
+		if( top[ i ].lo < m_mapMinHeight )
+			m_mapMinHeight = top[ i ].lo;
+		if( top[ i ].hi > m_mapMaxHeight )
+			m_mapMaxHeight = top[ i ].hi;
+	}
+
+}  // end buildHeightPyramid
+
+//-------------------------------------------------------------------------------------------------
+/** Redo the blocks above a changed sample.  The sample is a corner of the four cells around it, 
+	* which can be in up to four blocks at each level. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::updateHeightPyramid( Int sampleX, Int sampleY )
+{
+	Int cellX0 = sampleX > 0 ? sampleX - 1 : 0;
+	Int cellY0 = sampleY > 0 ? sampleY - 1 : 0;
+	Int cellX1 = sampleX < m_mapDX - 2 ? sampleX : m_mapDX - 2;
+	Int cellY1 = sampleY < m_mapDY - 2 ? sampleY : m_mapDY - 2;
+
+	for( Int level = 0; level < HEIGHT_PYRAMID_LEVELS; ++level )
+	{
+		Int shift = HEIGHT_PYRAMID_BASE_SHIFT + level;
+		for( Int blockY = cellY0 >> shift; blockY <= (cellY1 >> shift); ++blockY )
+		{
+			for( Int blockX = cellX0 >> shift; blockX <= (cellX1 >> shift); ++blockX )
+				updateHeightPyramidBlock( level, blockX, blockY );
+		}
+	}
+
+}  // end updateHeightPyramid
+
+//-------------------------------------------------------------------------------------------------
+/** Level 0 blocks take the range of the samples under their cells, which reach one sample into 
+	* the next block.  Higher blocks take the range of the (up to) four blocks below them. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::updateHeightPyramidBlock( Int level, Int blockX, Int blockY )
+{
+	HeightRange range;
+	Int i, j;
+	if( level == 0 )
+	{
+		Int xStart = blockX << HEIGHT_PYRAMID_BASE_SHIFT;
+		Int yStart = blockY << HEIGHT_PYRAMID_BASE_SHIFT;
+		Int xEnd = xStart + HEIGHT_PYRAMID_BASE_SIZE;
+		Int yEnd = yStart + HEIGHT_PYRAMID_BASE_SIZE;
+		if( xEnd > m_mapDX - 1 )
+			xEnd = m_mapDX - 1;
+		if( yEnd > m_mapDY - 1 )
+			yEnd = m_mapDY - 1;
+
+		range.lo = range.hi = m_mapData[ xStart + yStart * m_mapDX ];
+		for( j = yStart; j <= yEnd; ++j )
+		{
+			const UnsignedByte *row = m_mapData + j * m_mapDX;
+			for( i = xStart; i <= xEnd; ++i )
+			{
+				if( row[ i ] < range.lo )
+					range.lo = row[ i ];
+				if( row[ i ] > range.hi )
+					range.hi = row[ i ];
+			}
+		}
+	}
+	else
+	{
+		const HeightRange *below = m_heightPyramid[ level - 1 ];
+		Int belowDX = m_heightPyramidDX[ level - 1 ];
+		Int xStart = blockX * 2;
+		Int yStart = blockY * 2;
+		Int xEnd = xStart + 1;
+		Int yEnd = yStart + 1;
+		if( xEnd > belowDX - 1 )
+			xEnd = belowDX - 1;
+		if( yEnd > m_heightPyramidDY[ level - 1 ] - 1 )
+			yEnd = m_heightPyramidDY[ level - 1 ] - 1;
+
+		range = below[ xStart + yStart * belowDX ];
+		for( j = yStart; j <= yEnd; ++j )
+		{
+			for( i = xStart; i <= xEnd; ++i )
+			{
+				const HeightRange &child = below[ i + j * belowDX ];
+				if( child.lo < range.lo )
+					range.lo = child.lo;
+				if( child.hi > range.hi )
+					range.hi = child.hi;
+			}
+		}
+	}
+
+	m_heightPyramid[ level ][ blockX + blockY * m_heightPyramidDX[ level ] ] = range;
+
+}  // end updateHeightPyramidBlock
+
+//-------------------------------------------------------------------------------------------------
+/** Lower one height sample.  Heights under buildings only ever go down, so that neighbouring
+	* roads and buildings don't get scissored. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::setRawMapHeight( const ICoord2D *gridPos, Int height )
+{
+	if( m_mapData == NULL )
+		return;
+
+	Int x = gridPos->x + m_mapBorderSize;
+	Int y = gridPos->y + m_mapBorderSize;
+	if( x < 0 || y < 0 || x >= m_mapDX || y >= m_mapDY )
+		return;
+
+	UnsignedByte *sample = m_mapData + x + y * m_mapDX;
+	if( *sample <= height )
+		return;
+
+	*sample = (UnsignedByte)height;
+	updateHeightPyramid( x, y );
+	if( *sample < m_mapMinHeight )
+		m_mapMinHeight = *sample;
+
+	if( TheTerrainVisual )
+		TheTerrainVisual->setRawMapHeight( gridPos, height );
+
+}  // end setRawMapHeight
+
+//-------------------------------------------------------------------------------------------------
+/** Replace all the height samples, which have to be for the map that is loaded. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::setRawMapHeights( const UnsignedByte *heights, Int count )
+{
+	if( m_mapData == NULL )
+		return;
+
+	if( count != m_mapDX * m_mapDY )
+	{
+		DEBUG_CRASH(( "TerrainLogic::setRawMapHeights - %d heights for a %dx%d map\n", count, m_mapDX, m_mapDY ));
+		if( count > m_mapDX * m_mapDY )
+			count = m_mapDX * m_mapDY;
+	}
+
+	if( heights != m_mapData )
+		memcpy( m_mapData, heights, count );
+	buildHeightPyramid();
+
+	if( TheTerrainVisual )
+		TheTerrainVisual->setRawMapHeights( m_mapData, m_mapDX * m_mapDY );
+
+}  // end setRawMapHeights
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+UnsignedByte TerrainLogic::getClipHeight( Int x, Int y ) const
+{
+	if( x < 0 )
+		x = 0;
+	else if( x > m_mapDX - 1 )
+		x = m_mapDX - 1;
+
+	if( y < 0 )
+		y = 0;
+	else if( y > m_mapDY - 1 )
+		y = m_mapDY - 1;
+
+	return m_mapData[ x + y * m_mapDX ];
+
+}  // end getClipHeight
+
+//-------------------------------------------------------------------------------------------------
+/** Steps a Bresenham walk can take before it leaves the span lo..hi of one axis.  The axis moves 
+	* everyStep each step, or onOverflow each time num passes den. */
+//-------------------------------------------------------------------------------------------------
+static Int stepsInsideSpan( Int coord, Int lo, Int hi, Int everyStep, Int onOverflow, Int num, Int den, Int numadd )
+{
+	if( everyStep != 0 )
+		return everyStep > 0 ? hi - coord + 1 : coord - lo + 1;
+
+	if( numadd == 0 )
+		return INT_MAX;
+
+	Int overflows = onOverflow > 0 ? hi - coord + 1 : coord - lo + 1;
+	return (overflows * den - num + numadd - 1) / numadd;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Walks the cells under the ray as Bresenham would, and fails at the first cell with a corner
+	* above the ray.  While the ray is clear of the highest sample in a block of the height pyramid 
+	* for as long as it stays in that block, the walk jumps straight to where the ray leaves it. */
 //-------------------------------------------------------------------------------------------------
 Bool TerrainLogic::isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const
 {
-	DEBUG_CRASH(("implement ME"));
-	return false;
+	if( m_mapData == NULL )
+		return false;
+
+	/*
+		this is WAY faster, though not quite as accurate... however, the inaccuracy
+		is pretty minimal, so we really should force other code to live with it. (srj)
+	*/
+	const Real MAP_XY_FACTOR_INV = 1.0f / MAP_XY_FACTOR;
+
+	Int start_x = REAL_TO_INT_FLOOR(pos.x * MAP_XY_FACTOR_INV) + m_mapBorderSize;
+	Int start_y = REAL_TO_INT_FLOOR(pos.y * MAP_XY_FACTOR_INV) + m_mapBorderSize;
+	Int end_x = REAL_TO_INT_FLOOR(posOther.x * MAP_XY_FACTOR_INV) + m_mapBorderSize;
+	Int end_y = REAL_TO_INT_FLOOR(posOther.y * MAP_XY_FACTOR_INV) + m_mapBorderSize;
+	Int delta_x = abs(end_x - start_x);			// The difference between the x's
+	Int delta_y = abs(end_y - start_y);			// The difference between the y's
+	Int x = start_x;												// Start x off at the first pixel
+	Int y = start_y;												// Start y off at the first pixel
+
+	Int xinc1, xinc2;
+	if (end_x >= start_x)								// The x-values are increasing
+	{
+		xinc1 = 1;
+		xinc2 = 1;
+	}
+	else																// The x-values are decreasing
+	{
+		xinc1 = -1;
+		xinc2 = -1;
+	}
+
+	Int yinc1, yinc2;
+	if (end_y >= start_y)               // The y-values are increasing
+	{
+		yinc1 = 1;
+		yinc2 = 1;
+	}
+	else																// The y-values are decreasing
+	{
+		yinc1 = -1;
+		yinc2 = -1;
+	}
+
+	Int den, num, numadd, numpixels;
+	if (delta_x >= delta_y)							// There is at least one x-value for every y-value
+	{
+		xinc1 = 0;												// Don't change the x when numerator >= denominator
+		yinc2 = 0;												// Don't change the y for every iteration
+		den = delta_x;
+		num = delta_x / 2;
+		numadd = delta_y;
+		numpixels = delta_x;							// There are more x-values than y-values
+	}
+	else																// There is at least one y-value for every x-value
+	{
+		xinc2 = 0;												// Don't change the x for every iteration
+		yinc1 = 0;												// Don't change the y when numerator >= denominator
+		den = delta_y;
+		num = delta_y / 2;
+		numadd = delta_x;
+		numpixels = delta_y;							// There are more y-values than x-values
+	}
+
+	// the ray height at each step is worked out from the start, rather than added up, so that it
+	// comes out the same whether a block is stepped over or walked through.
+	Real nsInv = 1.0f / numpixels;
+	Real dz = posOther.z - pos.z;
+	Real zinc = dz * nsInv;
+
+	// add a little fudge to account for slop.
+	const Real LOS_FUDGE = 0.5f;
+	const Real maxHeight = m_mapMaxHeight * MAP_HEIGHT_SCALE;
+	const Int lastCellX = m_mapDX - 2;
+	const Int lastCellY = m_mapDY - 2;
+
+	Int curpixel = 0;
+	while (curpixel < numpixels)
+	{
+		if (x < 0 || 
+				y < 0 ||
+				x > lastCellX ||
+				y > lastCellY)
+		{
+			// once we go off the map, we're done
+			break;
+		}
+
+		Real z = pos.z + curpixel * zinc;
+
+		// Find the biggest block around us that the ray is clear of until it leaves the block.  The ray 
+		// height only goes one way, so its lowest point in the block is where it enters or leaves.
+		Int skip = 0;
+		for (Int level = 0; level < HEIGHT_PYRAMID_LEVELS; ++level)
+		{
+			Int shift = HEIGHT_PYRAMID_BASE_SHIFT + level;
+			Int blockX = x >> shift;
+			Int blockY = y >> shift;
+			Real blockHeight = m_heightPyramid[ level ][ blockX + blockY * m_heightPyramidDX[ level ] ].hi;
+			blockHeight *= MAP_HEIGHT_SCALE;
+			if (blockHeight > z + LOS_FUDGE)
+				break;
+
+			Int loX = blockX << shift;
+			Int loY = blockY << shift;
+			Int hiX = min( loX + (1 << shift) - 1, lastCellX );
+			Int hiY = min( loY + (1 << shift) - 1, lastCellY );
+			Int steps = numpixels - curpixel;
+			Int stepsX = stepsInsideSpan( x, loX, hiX, xinc2, xinc1, num, den, numadd );
+			Int stepsY = stepsInsideSpan( y, loY, hiY, yinc2, yinc1, num, den, numadd );
+			steps = min( steps, min( stepsX, stepsY ) );
+
+			Real zLeave = pos.z + (curpixel + steps - 1) * zinc;
+			if (blockHeight > zLeave + LOS_FUDGE)
+				break;
+
+			skip = steps;
+		}
+
+		if (skip > 0)
+		{
+			Int total = num + skip * numadd;
+			Int overflows = total / den;
+			num = total - overflows * den;
+			x += overflows * xinc1 + skip * xinc2;
+			y += overflows * yinc1 + skip * yinc2;
+			curpixel += skip;
+			continue;
+		}
+
+		Int idx = x + y*m_mapDX;
+		float height = m_mapData[idx];
+		height = __max(height, m_mapData[idx + 1]);
+		height = __max(height, m_mapData[idx + m_mapDX]);
+		height = __max(height, m_mapData[idx + m_mapDX + 1]);
+		height *= MAP_HEIGHT_SCALE;
+
+		// if terrainHeight > z, we can't see, so punt.
+		if (height > z + LOS_FUDGE)
+			return false;
+
+		// we're above the max height of the terrain and still looking up, so we're done.
+		// (don't bother for reverse test, since that doesn't generally happen)
+		if (z >= maxHeight && zinc > 0.0f)
+			break;
+
+		// continue with the maintenance.
+		num += numadd;										// Increase the numerator by the top of the fraction
+		if (num >= den)										// Check if numerator >= denominator
+		{
+			num -= den;											// Calculate the new numerator value
+			x += xinc1;											// Change the x as appropriate
+			y += yinc1;											// Change the y as appropriate
+		}
+		x += xinc2;												// Change the x as appropriate
+		y += yinc2;												// Change the y as appropriate
+		++curpixel;
+	}
+	
+	return true;
 }
 
 //-------------------------------------------------------------------------------------------------
-/** default get height for terrain logic */
+/** Height of the terrain triangle under (x, y), as the terrain is drawn.  Also where in its cell the
+	* point is, for working out the normal.  Points off the height data get the height at the edge, 
+	* and return FALSE. */
+//-------------------------------------------------------------------------------------------------
+inline Bool TerrainLogic::interpolateHeight( Real x, Real y, Real *height, Int *idx, Real *fx, Real *fy ) const
+{
+	//	3-----2
+	//  |    /|
+	//  |  /  |
+	//	|/    |
+	//  0-----1
+	//Find surrounding grid points
+	
+	const Real MAP_XY_FACTOR_INV = 1.0f / MAP_XY_FACTOR;
+
+	float xdiv = x * MAP_XY_FACTOR_INV;
+	float ydiv = y * MAP_XY_FACTOR_INV;
+
+	float ixf = floorf(xdiv);
+	float iyf = floorf(ydiv);
+
+	*fx = xdiv - ixf; //get fraction
+	*fy = ydiv - iyf; //get fraction
+
+	// since ixf & iyf are already floor'ed, we can use the fastest f->i conversion we have...
+	Int	ix = REAL_TO_INT_FLOOR(ixf) + m_mapBorderSize;
+	Int	iy = REAL_TO_INT_FLOOR(iyf) + m_mapBorderSize;
+
+	// Check for extent-3, not extent-1: we go into the next row/column of data for smoothed triangle points, so extent-1
+	// goes off the end...
+	if (ix > (m_mapDX-3) || iy > (m_mapDY-3) || iy < 1 || ix < 1)
+	{
+		// sample point is not on the heightmap
+		*height = getClipHeight(ix, iy) * MAP_HEIGHT_SCALE;
+		return FALSE;
+	}
+
+	*idx = ix + iy*m_mapDX;
+	const UnsignedByte *data = m_mapData + *idx;
+	float p0 = data[0];
+	float p2 = data[m_mapDX + 1];
+	if (*fy > *fx) // test if we are in the upper triangle
+	{	
+		float p3 = data[m_mapDX];
+		*height = (p3 + (1.0f-*fy)*(p0-p3) + *fx*(p2-p3)) * MAP_HEIGHT_SCALE;
+	}
+	else
+	{	
+		// we are in the lower triangle
+		float p1 = data[1];
+		*height = (p1 + *fy*(p2-p1) + (1.0f-*fx)*(p0-p1)) * MAP_HEIGHT_SCALE;
+	}
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Height and smoothed normal of the terrain at a point */
 //-------------------------------------------------------------------------------------------------
 Real TerrainLogic::getGroundHeight( Real x, Real y, Coord3D* normal ) const
 {
-	if( normal )
-		normal->zero();
+	Real height = 0.0f;
+	Int idx0;
+	Real fx, fy;
+	if( m_mapData == NULL || !interpolateHeight( x, y, &height, &idx0, &fx, &fy ) )
+	{
+		if (normal)
+		{	
+			// return a default normal pointing up
+			normal->x = 0.0f;
+			normal->y = 0.0f;
+			normal->z = 1.0f;
+		}
+		return height;
+	}
 
-	return 0;
+	if (normal) {
+		//		9		  8
+		//
+		//10	3-----2		7
+		//	  |    /|
+		//	  |  /  |
+		//		|/    |
+		//11	0-----1		6
+		//
+		//		4			5
+		//Find surrounding grid points for smoothed normals.
+		const UnsignedByte *data = m_mapData;
+		Int xExtent = m_mapDX;
+ 		int idx4 = idx0 - xExtent;
+ 		int idx3 = idx0 + xExtent;
+		int idx9 = idx0 + 2*xExtent;
+		UnsignedByte d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, d10, d11;
+		d0 = data[idx0];
+		d1 = data[idx0+1];
+		d2 = data[idx3+1];
+		d3 = data[idx3];
+		d4 = data[idx4];
+		d5 = data[idx4+1];
+		d6 = data[idx0+2];
+		d7 = data[idx3+2];
+		d8 = data[idx9+1];
+		d9 = data[idx9];
+		d10 = data[idx3-1];
+		d11 = data[idx0-1];
+
+		Real deltaZ_X0 = d1-d11;
+		Real deltaZ_X1 = d6-d0;
+		Real deltaZ_X2 = d7-d3;
+		Real deltaZ_X3 = d6-d0;
+
+		Real deltaZ_Y0 = d3-d4;
+		Real deltaZ_Y1 = d2-d5;
+		Real deltaZ_Y2 = d8-d1;
+		Real deltaZ_Y3 = d9-d0;
+
+		// Interpolate to get the smoothed valued.
+		Real deltaZ_X_Left = deltaZ_X0*(1.0f-fx) + fx*deltaZ_X3;
+		Real deltaZ_X_Right = deltaZ_X1*(1.0f-fx) + fx*deltaZ_X2;
+		Real deltaZ_X = deltaZ_X_Left*(1.0-fy) + fy*deltaZ_X_Right;
+
+		Real deltaZ_Y_Left = deltaZ_Y0*(1.0f-fx) + fx*deltaZ_Y3;
+		Real deltaZ_Y_Right = deltaZ_Y1*(1.0f-fx) + fx*deltaZ_Y2;
+		Real deltaZ_Y = deltaZ_Y_Left*(1.0-fy) + fy*deltaZ_Y_Right;
+
+		Vector3 l2r, n2f, normalAtTexel;
+		l2r.Set(2*MAP_XY_FACTOR/MAP_HEIGHT_SCALE, 0, deltaZ_X);
+		n2f.Set(0, 2*MAP_XY_FACTOR/MAP_HEIGHT_SCALE, deltaZ_Y);
+		Vector3::Normalized_Cross_Product(l2r,n2f, &normalAtTexel);
+		normal->x = normalAtTexel.X;
+		normal->y = normalAtTexel.Y;
+		normal->z = normalAtTexel.Z;
+	}
+
+	return height;
 
-}  // end getHight
+}  // end getGroundHeight
+
+//-------------------------------------------------------------------------------------------------
+/** Batched getGroundHeight, for code that wants the heights under a lot of points */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::getGroundHeights( Coord3D *points, Int count ) const
+{
+	Int i;
+	if( m_mapData == NULL )
+	{
+		for( i = 0; i < count; ++i )
+			points[ i ].z = 0.0f;
+		return;
+	}
+
+	Int idx;
+	Real fx, fy;
+	for( i = 0; i < count; ++i )
+		interpolateHeight( points[ i ].x, points[ i ].y, &points[ i ].z, &idx, &fx, &fy );
+
+}  // end getGroundHeights
 
 //-------------------------------------------------------------------------------------------------
 /** default get height for terrain logic */
@@ -2727,33 +3298,33 @@ void TerrainLogic::flattenTerrain(Object *obj)
 						ICoord2D gridPos;
 						gridPos.x = i;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 						//Added the corners so it does a whole 3X3 square... ML
 						gridPos.x = i-1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 					}
 				}
@@ -2808,33 +3379,33 @@ void TerrainLogic::flattenTerrain(Object *obj)
 						ICoord2D gridPos;
 						gridPos.x = i;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 						//Added the corners so it does a whole 3X3 square... ML
 						gridPos.x = i-1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 
 					}
@@ -2860,13 +3431,14 @@ void TerrainLogic::crc( Xfer *xfer )
 	* Version Info:
 	* 1: Initial version
 	* 2: Added water updates over time (CBD)
+	* 3: Terrain heights, which used to be saved with the terrain visual
 	*/
 // ------------------------------------------------------------------------------------------------
 void TerrainLogic::xfer( Xfer *xfer )
 {
 
 	// version
-	const XferVersion currentVersion = 2;	
+	const XferVersion currentVersion = 3;	
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
@@ -2946,6 +3518,29 @@ void TerrainLogic::xfer( Xfer *xfer )
 
 	}  // end if
 
+	// terrain heights, flattening under buildings changes them
+	if( version >= 3 )
+	{
+		Int mapSamples = m_mapData ? m_mapDX * m_mapDY : 0;
+		Int xferSamples = mapSamples;
+		xfer->xferInt( &xferSamples );
+		if( xferSamples != mapSamples )
+		{
+
+			DEBUG_CRASH(( "TerrainLogic::xfer - %d terrain heights saved, map has %d\n", xferSamples, mapSamples ));
+			throw SC_INVALID_DATA;
+
+		}  // end if
+
+		if( mapSamples > 0 )
+		{
+			xfer->xferUser( m_mapData, mapSamples );
+			if( xfer->getXferMode() == XFER_LOAD )
+				setRawMapHeights( m_mapData, mapSamples );
+		}
+
+	}  // end if
+
 }  // end xfer
 
 // ------------------------------------------------------------------------------------------------
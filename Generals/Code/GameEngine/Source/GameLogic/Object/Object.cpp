@@ -189,6 +189,7 @@ Object::Object( const ThingTemplate *tt, ObjectStatusBits statusBits, Team *team
 	m_next(NULL),
 	m_prev(NULL),
 	m_team(NULL),
+	m_countedPlayer(NULL),
 	m_experienceTracker(NULL),
 	m_firingTracker(NULL),
 	m_repulsorHelper(NULL),
@@ -201,6 +202,7 @@ Object::Object( const ThingTemplate *tt, ObjectStatusBits statusBits, Team *team
 	m_partitionLastValue(NULL),
 	m_smcUntil(NEVER),
 	m_privateStatus(0),
+	m_countedState(0),
 	m_formationID(NO_FORMATION_ID),
 	m_isReceivingDifficultyBonus(FALSE)
 {
@@ -731,6 +733,10 @@ void Object::friend_setUndetectedDefector( Bool status )
 		m_privateStatus |= UNDETECTED_DEFECTOR;
 	else
 		m_privateStatus &= ~UNDETECTED_DEFECTOR;
+
+	// undetected defectors are nobody's enemy
+	if (ThePartitionManager)
+		ThePartitionManager->notifyRelationshipsChanged();
 }
 
 //=============================================================================
@@ -785,6 +791,14 @@ void Object::setOrRestoreTeam( Team* team, Bool restoring )
 		return;
 
 	Team* oldTeam = m_team;
+	if (TheScriptEngine)
+		TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
+
+	// Other players only see this object through the enemy lists of the cells it is in, so only 
+	// those go stale. Getting a first team at creation or dropping it at teardown doesn't count: 
+	// the object isn't registered yet, or is about to be unregistered, which bumps the cells anyway.
+	if (oldTeam != NULL && team != NULL && m_partitionData != NULL)
+		m_partitionData->touchedCellsChanged();
 
 	// Before Switch //////////////////////////
 	if (m_team)
@@ -798,6 +812,7 @@ void Object::setOrRestoreTeam( Team* team, Bool restoring )
 		
 	// Switch //////////////////////////
 	m_team = team;
+	updatePlayerObjectCount();
 
 	// After Switch //////////////////////////
 	if (m_team)
@@ -877,6 +892,9 @@ void Object::setStatus( ObjectStatusBits bits, Bool set )
 			m_repulsorHelper->sleepUntil(TheGameLogic->getFrame() + 2*LOGICFRAMES_PER_SECOND);
 		}
 
+		if ((m_status ^ oldStatus) & (OBJECT_STATUS_UNDER_CONSTRUCTION | OBJECT_STATUS_DESTROYED))
+			updatePlayerObjectCount();
+
 		// when an object's construction status changes, it needs to have its partition data updated,
 		// in order to maintain the shroud correctly.
 		if ((m_status & OBJECT_STATUS_UNDER_CONSTRUCTION) != (oldStatus & OBJECT_STATUS_UNDER_CONSTRUCTION))
@@ -1783,6 +1801,9 @@ void Object::setEffectivelyDead(Bool dead)
 		BitSet(m_privateStatus, EFFECTIVELY_DEAD);
 	else
 		BitClear(m_privateStatus, EFFECTIVELY_DEAD);
+	updatePlayerObjectCount();
+	if (TheScriptEngine)
+		TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 
 	if (dead)
 	{
@@ -1791,6 +1812,36 @@ void Object::setEffectivelyDead(Bool dead)
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Our controlling player keeps counts of its objects by template and state, so that it
+	doesn't have to walk all of its teams to answer questions like "how many of these do I have".
+	This moves us between those counts whenever our team, death, destruction or construction
+	state changes, and does nothing if none of them did. */
+void Object::updatePlayerObjectCount()
+{
+	Player *player = m_team ? m_team->getControllingPlayer() : NULL;
+
+	UnsignedByte state = 0;
+	if (isEffectivelyDead())
+		state |= Player::OBJECT_COUNT_DEAD;
+	if (isDestroyed())
+		state |= Player::OBJECT_COUNT_DESTROYED;
+	if (testStatus(OBJECT_STATUS_UNDER_CONSTRUCTION))
+		state |= Player::OBJECT_COUNT_UNDER_CONSTRUCTION;
+
+	if (player == m_countedPlayer && state == m_countedState)
+		return;
+
+	if (m_countedPlayer)
+		m_countedPlayer->friend_adjustObjectCount(getTemplate(), m_countedState, -1);
+
+	m_countedPlayer = player;
+	m_countedState = state;
+
+	if (m_countedPlayer)
+		m_countedPlayer->friend_adjustObjectCount(getTemplate(), m_countedState, 1);
+}
+
 //-------------------------------------------------------------------------------------------------
 void Object::setCaptured(Bool isCaptured)
 {
@@ -3876,6 +3927,9 @@ void Object::xfer( Xfer *xfer )
 //-------------------------------------------------------------------------------------------------
 void Object::loadPostProcess()
 {
+	// our status bits were loaded directly, so make sure we're counted under the right state
+	updatePlayerObjectCount();
+
 	if( m_xferContainedByID != INVALID_ID )
 		m_containedBy = TheGameLogic->findObjectByID(m_xferContainedByID);
 	else
@@ -4183,15 +4237,13 @@ void Object::handlePartitionCellMaintenance()
 //-------------------------------------------------------------------------------------------------
 void Object::handleShroud()
 {
-	// Undo last looking
-	unlook();
-	// and shrouding
+	// Undo and redo shrouding
 	unshroud();
-
-	// redo shrouding
 	shroud();
-	// Redo looking
-	look();
+
+	// Undo last looking and redo it.  The unlook part is only queued, so doing it after the 
+	// shrouding instead of before changes nothing.
+	relook();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -4323,47 +4375,19 @@ void Object::look()
 		return;
 	}
 
-	Player* controller = getControllingPlayer();
-	if ( controller )
+	PlayerMaskType lookingMask;
+	if( calcLookingMask( &lookingMask ) )
 	{
-		// I removed the check for objects under construction by request of designers since
-		// they want constructing objects to have a reduced sight range now. -MW
-		// dead or blind things don't reveal shroud
-		if( ( ! isDestroyed() )// Some things get Destroyed directly without hitting Death.
-				&& ( ! isEffectivelyDead() )
-				&& ( getShroudClearingRange() > 0.0f )
-			)
-		{
-			PlayerMaskType lookingMask = 0;
-
-			for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-			{
-				const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-
-				// Build mask of of allies who can see me. 
-				// This is the Object-centric game level that cares
-				if( getControllingPlayer()->getRelationship( currentPlayer->getDefaultTeam() ) == ALLIES )
-				{
-					lookingMask |= currentPlayer->getPlayerMask();
-				}
-			}
-			
-			// Other players can also be looking through our eyes.
-			lookingMask |= controller->getVisionSpiedMask();
-
-			if ( isKindOf(KINDOF_REVEAL_TO_ALL) )
-				lookingMask = PLAYERMASK_ALL;
-
-			Coord3D pos = *getPosition();
-			ThePartitionManager->doShroudReveal(pos.x, 
-																					pos.y, 
-																					getShroudClearingRange(), 
-																					lookingMask
-																					);
+		Coord3D pos = *getPosition();
+		ThePartitionManager->doShroudReveal(pos.x, 
+																				pos.y, 
+																				getShroudClearingRange(), 
+																				lookingMask
+																				);
 
-			m_partitionLastLook->m_where = pos;
-			m_partitionLastLook->m_forWhom = lookingMask;
-			m_partitionLastLook->m_howFar = getShroudClearingRange();
+		m_partitionLastLook->m_where = pos;
+		m_partitionLastLook->m_forWhom = lookingMask;
+		m_partitionLastLook->m_howFar = getShroudClearingRange();
 
 //			DEBUG_LOG(( "A %s looks at %f, %f for %x at range %f\n",
 //									getTemplate()->getName().str(),
@@ -4372,8 +4396,67 @@ void Object::look()
 //									lookingMask,
 //									getShroudClearingRange()
 //									));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Work out who sees through our eyes.  Returns FALSE if we don't reveal any shroud right now. */
+Bool Object::calcLookingMask( PlayerMaskType *lookingMask )
+{
+	*lookingMask = 0;
+
+	Player* controller = getControllingPlayer();
+	if ( controller == NULL )
+		return FALSE;
+
+	// I removed the check for objects under construction by request of designers since
+	// they want constructing objects to have a reduced sight range now. -MW
+	// dead or blind things don't reveal shroud
+	if( isDestroyed() // Some things get Destroyed directly without hitting Death.
+			|| isEffectivelyDead()
+			|| getShroudClearingRange() <= 0.0f
+		)
+		return FALSE;
+
+	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
+	{
+		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
+
+		// Build mask of of allies who can see me. 
+		// This is the Object-centric game level that cares
+		if( controller->getRelationship( currentPlayer->getDefaultTeam() ) == ALLIES )
+		{
+			*lookingMask |= currentPlayer->getPlayerMask();
 		}
 	}
+	
+	// Other players can also be looking through our eyes.
+	*lookingMask |= controller->getVisionSpiedMask();
+
+	if ( isKindOf(KINDOF_REVEAL_TO_ALL) )
+		*lookingMask = PLAYERMASK_ALL;
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Same as an unlook followed by a look, but when the same players are looking the partition
+	* manager only has to touch the cells entering or leaving our sight. */
+void Object::relook()
+{
+	PlayerMaskType lookingMask;
+	if( ! calcLookingMask( &lookingMask ) )
+	{
+		unlook();
+		return;
+	}
+
+	Coord3D pos = *getPosition();
+	ThePartitionManager->moveShroudReveal( m_partitionLastLook, pos.x, pos.y, getShroudClearingRange(), lookingMask );
+
+	m_partitionLastLook->m_where = pos;
+	m_partitionLastLook->m_forWhom = lookingMask;
+	m_partitionLastLook->m_howFar = getShroudClearingRange();
 }
 
 //-------------------------------------------------------------------------------------------------
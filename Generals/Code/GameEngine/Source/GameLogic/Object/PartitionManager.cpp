@@ -59,6 +59,8 @@
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
 #include "Common/Radar.h"
+#include "Common/SelfTest.h"
+#include "Common/Team.h"
 #include "Common/ThingFactory.h"	// for bullet type hack
 #include "Common/ThingTemplate.h"
 #include "Common/Xfer.h"
@@ -147,6 +149,8 @@ struct CellValueProcParms
 };
 
 static int cellValueProc(PartitionCell* cell, void* userData);
+static void hLineAddLooker(Int x1, Int x2, Int y, void *playerIndexVoid);
+static void hLineRemoveLooker(Int x1, Int x2, Int y, void *playerIndexVoid);
 
 /*
 	Notes:
@@ -1224,6 +1228,7 @@ PartitionCell::PartitionCell()
 	//
 	m_firstCoiInCell = NULL;
 	m_coiCount = 0;
+	m_coiSerial = 0;
 #ifdef PM_CACHE_TERRAIN_HEIGHT
 	m_loTerrainZ = HUGE_DIST;		// huge positive
 	m_hiTerrainZ = -HUGE_DIST;	// huge negative
@@ -1460,6 +1465,7 @@ void PartitionCell::friend_addToCellList(CellAndObjectIntersection *coi)
 	{
 		coi->friend_addToCellList(&m_firstCoiInCell);
 		++m_coiCount;
+		++m_coiSerial;
 	}
 }
 
@@ -1470,6 +1476,7 @@ void PartitionCell::friend_removeFromCellList(CellAndObjectIntersection *coi)
 	{
 		coi->friend_removeFromCellList(&m_firstCoiInCell);
 		--m_coiCount;
+		++m_coiSerial;
 	}
 }
 
@@ -1733,6 +1740,22 @@ void PartitionData::removeAllTouchedCells()
 	DEBUG_ASSERTCRASH(m_coiInUseCount == 0, ("hmm, coi count mismatch"));
 }
 
+//-----------------------------------------------------------------------------
+/**
+	Bump the COI serial of every cell this module touches. The per-player enemy lists are
+	built per cell, so when only this object's relationships change, only these cells'
+	lists go stale.
+*/
+void PartitionData::touchedCellsChanged()
+{
+	CellAndObjectIntersection *coi = m_coiArray;
+	for (Int i = m_coiArrayCount; i > 0; --i, ++coi)
+	{
+		if (coi->getModule() && coi->getCell())
+			coi->getCell()->friend_bumpCoiSerial();
+	}
+}
+
 // -----------------------------------------------------------------------------
 void PartitionData::addSubPixToCoverage(PartitionCell *cell)
 {
@@ -2551,6 +2574,12 @@ PartitionManager::PartitionManager()
 #ifdef FASTER_GCO
 	m_maxGcoRadius = 0;
 #endif
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+		m_enemyCellCache[i] = NULL;
+	m_relationshipSerial = 0;
+	m_addLookerFunc = hLineAddLooker;
+	m_removeLookerFunc = hLineRemoveLooker;
+	m_shroudTestFrame = 0;
 } 
 
 //-----------------------------------------------------------------------------
@@ -2573,13 +2602,29 @@ static void calcHeights(const Region3D& world, Real cellSize, Int x, Int y, Real
 	Real step = cellSize / numSteps;
 	loZ = HUGE_DIST;		// huge positive
 	hiZ = -HUGE_DIST;		// huge negative
+
+	// gather a row of sample points at a time and look them all up in one go
+	const Int MAX_ROW_SAMPLES = 64;
+	Coord3D row[MAX_ROW_SAMPLES];
 	for (Real yy = 0; yy <= cellSize; yy += step) 
 	{
+		Int count = 0;
 		for (Real xx = 0; xx <= cellSize; xx += step) 
 		{
-			Real h = TheTerrainLogic->getGroundHeight( xbase + xx, ybase + yy );
-			if (h < loZ) loZ = h;
-			if (h > hiZ) hiZ = h;
+			row[count].x = xbase + xx;
+			row[count].y = ybase + yy;
+			row[count].z = 0;
+			++count;
+			if (count == MAX_ROW_SAMPLES || xx + step > cellSize)
+			{
+				TheTerrainLogic->getGroundHeights( row, count );
+				for (Int i = 0; i < count; ++i)
+				{
+					if (row[i].z < loZ) loZ = row[i].z;
+					if (row[i].z > hiZ) hiZ = row[i].z;
+				}
+				count = 0;
+			}
 		}
 	}
 }
@@ -2696,6 +2741,8 @@ void PartitionManager::shutdown()
 #endif
 
 	resetPendingUndoShroudRevealQueue();
+
+	clearEnemyCellCaches();
 	
 	delete [] m_cells;
 	m_cells = NULL;
@@ -3175,7 +3222,8 @@ Object *PartitionManager::getClosestObjects(
 	PartitionFilter **filters, 
 	SimpleObjectIterator *iterArg,	// if nonnull, append ALL satisfactory objects to the iterator (not just the single closest)
 	Real *closestDistArg,
-	Coord3D *closestVecArg
+	Coord3D *closestVecArg,
+	Bool enemiesOnly
 )
 {
 	//USE_PERF_TIMER(getClosestObjects)
@@ -3201,9 +3249,14 @@ Object *PartitionManager::getClosestObjects(
 #endif
 
 	DEBUG_ASSERTCRASH((obj==NULL) != (pos == NULL), ("either obj or pos must be null"));
+	DEBUG_ASSERTCRASH(!enemiesOnly || obj != NULL, ("enemiesOnly needs an obj"));
 
 	DistCalcProc distProc = theDistCalcProcs[dc];
 
+	// if we only want enemies, see if we can use the per-player lists of them. if not,
+	// we ask each object in the cells for its relationship, just as a filter would.
+	const Player *enemiesOf = enemiesOnly ? getEnemyCellCachePlayer(obj) : NULL;
+
 	const Coord3D *objPos;
 	const Object *objToUse;
 	if (pos) 
@@ -3262,15 +3315,47 @@ Object *PartitionManager::getClosestObjects(
 			if (thisCell == NULL)
 				continue;
 
-			for (CellAndObjectIntersection *thisCoi = thisCell->getFirstCoiInCell(); thisCoi; thisCoi = thisCoi->getNextCoi())
+			// walk either the cell's cached enemies or all of its COIs; both are in COI order
+			PartitionData * const *enemyMods = NULL;
+			Int enemyCount = 0;
+			Int enemyIndex = 0;
+			CellAndObjectIntersection *thisCoi = NULL;
+			if (enemiesOf)
+				enemyMods = getCellEnemies(enemiesOf, thisCell, &enemyCount);
+			else
+				thisCoi = thisCell->getFirstCoiInCell();
+
+			for (;;)
 			{
-				PartitionData *thisMod = thisCoi->getModule();
+				PartitionData *thisMod;
+				if (enemiesOf)
+				{
+					if (enemyIndex >= enemyCount)
+						break;
+					thisMod = enemyMods[enemyIndex++];
+				}
+				else
+				{
+					if (thisCoi == NULL)
+						break;
+					thisMod = thisCoi->getModule();
+					thisCoi = thisCoi->getNextCoi();
+				}
 				Object *thisObj = thisMod->getObject();
 
 				// never compare against ourself.
 				if (thisObj == obj || thisObj == NULL) 
 					continue;
 
+				if (enemiesOf)
+				{
+					DEBUG_ASSERTCRASH(obj->getRelationship(thisObj) == ENEMIES, ("stale enemy cell cache for %s", thisObj->getTemplate()->getName().str()));
+				}
+				else if (enemiesOnly && obj->getRelationship(thisObj) != ENEMIES)
+				{
+					continue;
+				}
+
 				// since an object can exist in multiple COIs, we use this to avoid processing
 				// the same one more than once.
 				if (thisMod->friend_getDoneFlag() == theIterFlag)
@@ -3346,6 +3431,9 @@ Object *PartitionManager::getClosestObjects(
 			if (thisObj == obj) 
 				continue;
 
+			if (enemiesOnly && obj->getRelationship(thisObj) != ENEMIES)
+				continue;
+
 			if (thisMod->friend_getDoneFlag() == theIterFlag)
 				continue;
 
@@ -3599,6 +3687,123 @@ SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+Object *PartitionManager::getClosestEnemy(
+	const Object *obj, 
+	Real maxDist, 
+	DistanceCalculationType dc, 
+	PartitionFilter **filters
+)
+{
+	return getClosestObjects(obj, NULL, maxDist, dc, filters, NULL, NULL, NULL, true);
+}
+
+//-----------------------------------------------------------------------------
+SimpleObjectIterator *PartitionManager::iterateEnemiesInRange(
+	const Object *obj, 
+	Real maxDist, 
+	DistanceCalculationType dc, 
+	PartitionFilter **filters, 
+	IterOrderType order
+)
+{
+	MemoryPoolObjectHolder iterHolder;
+	SimpleObjectIterator *iter = newInstance(SimpleObjectIterator);
+	iterHolder.hold(iter);
+
+	getClosestObjects(obj, NULL, maxDist, dc, filters, iter, NULL, NULL, true);
+
+	iter->sort(order);
+	iterHolder.release();
+	return iter;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	Return the player whose enemy lists can answer "who are obj's enemies", or NULL if obj's
+	relationships aren't simply its player's. That is the case for undetected defectors
+	(who have no enemies) and for teams with their own relationship overrides.
+*/
+const Player *PartitionManager::getEnemyCellCachePlayer( const Object *obj ) const
+{
+	const Team *team = obj->getTeam();
+	if (team == NULL || obj->getIsUndetectedDefector() || team->hasRelationshipOverrides())
+		return NULL;
+
+	return team->getControllingPlayer();
+}
+
+//-----------------------------------------------------------------------------
+/**
+	Return the modules in the cell whose objects are ENEMIES of the player, in COI order,
+	building the list if the cell or any relationship changed since it was last built.
+	The result is only good until the next call.
+*/
+PartitionData * const *PartitionManager::getCellEnemies( const Player *player, PartitionCell *cell, Int *count )
+{
+	// don't let dead lists pile up forever; it's cheap to start over
+	static const Int MAX_CACHED_ENEMIES = 32768;
+
+	Int playerIndex = player->getPlayerIndex();
+	EnemyCellCache *cache = m_enemyCellCache[playerIndex];
+	if (cache == NULL)
+	{
+		cache = NEW EnemyCellCache;
+		cache->m_relationshipSerial = m_relationshipSerial - 1;
+		m_enemyCellCache[playerIndex] = cache;
+	}
+
+	if (cache->m_relationshipSerial != m_relationshipSerial || 
+			(Int)cache->m_cellStamp.size() != m_totalCellCount ||
+			(Int)cache->m_enemies.size() > MAX_CACHED_ENEMIES)
+	{
+		cache->m_relationshipSerial = m_relationshipSerial;
+		cache->m_cellStamp.assign(m_totalCellCount, 0);
+		cache->m_cellFirst.resize(m_totalCellCount);
+		cache->m_cellCount.resize(m_totalCellCount);
+		cache->m_enemies.clear();
+	}
+
+	Int cellIndex = cell - m_cells;
+	UnsignedInt stamp = cell->getCoiSerial() + 1;
+	if (cache->m_cellStamp[cellIndex] != stamp)
+	{
+		Int first = cache->m_enemies.size();
+		for (CellAndObjectIntersection *coi = cell->getFirstCoiInCell(); coi; coi = coi->getNextCoi())
+		{
+			PartitionData *mod = coi->getModule();
+			Object *other = mod->getObject();
+			if (other == NULL)
+				continue;
+
+			// this is Object::getRelationship, for an obj that is on a team with no overrides
+			// and isn't an undetected defector.
+			if (other->getIsUndetectedDefector())
+				continue;
+			if (player->getRelationship(other->getTeam()) != ENEMIES)
+				continue;
+
+			cache->m_enemies.push_back(mod);
+		}
+		cache->m_cellStamp[cellIndex] = stamp;
+		cache->m_cellFirst[cellIndex] = first;
+		cache->m_cellCount[cellIndex] = cache->m_enemies.size() - first;
+	}
+
+	*count = cache->m_cellCount[cellIndex];
+	return *count ? &cache->m_enemies[cache->m_cellFirst[cellIndex]] : NULL;
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::clearEnemyCellCaches( void )
+{
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		delete m_enemyCellCache[i];
+		m_enemyCellCache[i] = NULL;
+	}
+}
+
 //-----------------------------------------------------------------------------
 SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	const Coord3D* pos, 
@@ -3932,9 +4137,9 @@ Bool PartitionManager::findPositionAround( const Coord3D *center,
 void PartitionManager::doShroudReveal(Real centerX, Real centerY, Real radius, PlayerMaskType playerMask) 
 {
 	Int cellCenterX, cellCenterY;
-	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
+	worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
 
-	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	Int cellRadius = worldToCellDist(radius);
 	if (cellRadius < 1) 
 		cellRadius = 1;
 
@@ -3947,11 +4152,17 @@ void PartitionManager::doShroudReveal(Real centerX, Real centerY, Real radius, P
 		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
 		if( BitTest( playerMask, currentPlayer->getPlayerMask() ) )
 		{
-			circle.drawCircle(hLineAddLooker, (void*)currentIndex);
+			circle.drawCircle(m_addLookerFunc, (void*)currentIndex);
 		}
 	}
 }
 	
+//-----------------------------------------------------------------------------
+UnsignedInt PartitionManager::getShroudFrame() const
+{
+	return m_shroudTestFrame != 0 ? m_shroudTestFrame : TheGameLogic->getFrame();
+}
+
 //-----------------------------------------------------------------------------
 void PartitionManager::processPendingUndoShroudRevealQueue( Bool considerTimestamp )
 {
@@ -3959,7 +4170,7 @@ void PartitionManager::processPendingUndoShroudRevealQueue( Bool considerTimesta
 	//Again, you know these are in order, because we control the adding of the Constant in-the-queue time.
 	UnsignedInt compareTime;
 	if(considerTimestamp)
-		compareTime = TheGameLogic->getFrame();
+		compareTime = getShroudFrame();
 	else
 		compareTime = UINT_MAX;
 
@@ -3967,7 +4178,17 @@ void PartitionManager::processPendingUndoShroudRevealQueue( Bool considerTimesta
 	{
 		SightingInfo *thisInfo = m_pendingUndoShroudReveals.front();
 
-		undoShroudReveal( thisInfo->m_where.x, thisInfo->m_where.y, thisInfo->m_howFar, thisInfo->m_forWhom );
+		if( thisInfo->m_exceptHowFar != 0.0f )
+		{
+			// left behind by a moveShroudReveal, the cells still inside the newer look belong to it now
+			drawShroudCircleExcept( thisInfo->m_where.x, thisInfo->m_where.y, thisInfo->m_howFar, 
+															thisInfo->m_exceptWhere.x, thisInfo->m_exceptWhere.y, thisInfo->m_exceptHowFar, 
+															thisInfo->m_forWhom, m_removeLookerFunc );
+		}
+		else
+		{
+			undoShroudReveal( thisInfo->m_where.x, thisInfo->m_where.y, thisInfo->m_howFar, thisInfo->m_forWhom );
+		}
 
 		thisInfo->deleteInstance();
 		m_pendingUndoShroudReveals.pop();
@@ -3999,9 +4220,9 @@ void PartitionManager::resetPendingUndoShroudRevealQueue()
 void PartitionManager::undoShroudReveal(Real centerX, Real centerY, Real radius, PlayerMaskType playerMask) 
 {
 	Int cellCenterX, cellCenterY;
-	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
+	worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
 
-	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	Int cellRadius = worldToCellDist(radius);
 	if (cellRadius < 1) 
 		cellRadius = 1;
 
@@ -4012,7 +4233,7 @@ void PartitionManager::undoShroudReveal(Real centerX, Real centerY, Real radius,
 		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
 		if( BitTest( playerMask, currentPlayer->getPlayerMask() ) )
 		{
-			circle.drawCircle(hLineRemoveLooker, (void*)currentIndex);
+			circle.drawCircle(m_removeLookerFunc, (void*)currentIndex);
 		}
 	}
 }
@@ -4020,7 +4241,7 @@ void PartitionManager::undoShroudReveal(Real centerX, Real centerY, Real radius,
 //-----------------------------------------------------------------------------
 void PartitionManager::queueUndoShroudReveal(Real centerX, Real centerY, Real radius, PlayerMaskType playerMask) 
 {
-	UnsignedInt now = TheGameLogic->getFrame();
+	UnsignedInt now = getShroudFrame();
 	SightingInfo *newInfo = newInstance(SightingInfo);
 
 	newInfo->m_where.x = centerX;
@@ -4031,7 +4252,334 @@ void PartitionManager::queueUndoShroudReveal(Real centerX, Real centerY, Real ra
 
 	m_pendingUndoShroudReveals.push(newInfo);
 }
+
+//-----------------------------------------------------------------------------
+/** 
+	For drawing one circle minus another.  The except circle is rasterized into per row spans first, then 
+	each scanline of the drawn circle is clipped against the span on its row.
+*/
+struct ShroudExceptParms
+{
+	ScanlineDrawFunc	drawFunc;
+	void*							playerIndex;
+	Int								exceptTop;		///< cell row of the first span
+	Int								exceptRows;
+	ICoord2D*					exceptSpans;	///< x is the start of the span on that row, y the end
+};
+
+// -----------------------------------------------------------------------------
+static void hLineRecordExceptSpan(Int x1, Int x2, Int y, void *exceptParms)
+{
+	ShroudExceptParms *parms = (ShroudExceptParms*)exceptParms;
+	Int row = y - parms->exceptTop;
+	if (row < 0 || row >= parms->exceptRows)
+		return;
+
+	parms->exceptSpans[row].x = x1;
+	parms->exceptSpans[row].y = x2;
+}
+
+// -----------------------------------------------------------------------------
+static void hLineDrawExcept(Int x1, Int x2, Int y, void *exceptParms)
+{
+	const ShroudExceptParms *parms = (const ShroudExceptParms*)exceptParms;
+	Int row = y - parms->exceptTop;
+	if (row < 0 || row >= parms->exceptRows || parms->exceptSpans[row].x > parms->exceptSpans[row].y)
+	{
+		(parms->drawFunc)(x1, x2, y, parms->playerIndex);
+		return;
+	}
+
+	Int exceptStart = parms->exceptSpans[row].x;
+	Int exceptEnd = parms->exceptSpans[row].y;
+	if (x1 < exceptStart)
+		(parms->drawFunc)(x1, min(x2, exceptStart - 1), y, parms->playerIndex);
+	if (x2 > exceptEnd)
+		(parms->drawFunc)(max(x1, exceptEnd + 1), x2, y, parms->playerIndex);
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::drawShroudCircleExcept(Real centerX, Real centerY, Real radius, Real exceptX, Real exceptY, Real exceptRadius, 
+																							PlayerMaskType playerMask, void (*drawFunc)(Int, Int, Int, void *))
+{
+	Int cellCenterX, cellCenterY;
+	worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
+	Int cellRadius = worldToCellDist(radius);
+	if (cellRadius < 1) 
+		cellRadius = 1;
+
+	Int exceptCenterX, exceptCenterY;
+	worldToCell(exceptX, exceptY, &exceptCenterX, &exceptCenterY);
+	Int exceptCellRadius = worldToCellDist(exceptRadius);
+	if (exceptCellRadius < 1) 
+		exceptCellRadius = 1;
+
+	ShroudExceptParms parms;
+	parms.drawFunc = drawFunc;
+	parms.playerIndex = NULL;
+	parms.exceptTop = exceptCenterY - exceptCellRadius;
+	parms.exceptRows = 2 * exceptCellRadius + 1;
+
+	// every row starts out empty (start past the end), the circle fills in the ones it covers
+	ICoord2D emptySpan;
+	emptySpan.x = 1;
+	emptySpan.y = 0;
+	m_exceptSpans.assign(parms.exceptRows, emptySpan);
+	parms.exceptSpans = &m_exceptSpans[0];
+
+	DiscreteCircle exceptCircle(exceptCenterX, exceptCenterY, exceptCellRadius);
+	exceptCircle.drawCircle(hLineRecordExceptSpan, &parms);
+
+	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
+	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
+	{
+		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
+		if( BitTest( playerMask, currentPlayer->getPlayerMask() ) )
+		{
+			parms.playerIndex = (void*)currentIndex;
+			circle.drawCircle(hLineDrawExcept, &parms);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// A moving Object unlooks its old position and looks at its new one.  Doing that literally 
+// rasterizes both discs, and the overlap gets a looker added now and removed when the unlook
+// comes due, without ever changing its shroud status.  So when the same players are looking,
+// only add lookers to the cells that are new, and queue the removal for just the cells that are 
+// being left behind.  The overlap keeps the old look's lookers, which the new look then owns.
+// Every cell is clear over exactly the same frames as with the full undo and redo.
+void PartitionManager::moveShroudReveal(const SightingInfo *oldLook, Real centerX, Real centerY, Real radius, PlayerMaskType playerMask) 
+{
+	if( oldLook->isInvalid() || oldLook->m_forWhom != playerMask )
+	{
+		if( ! oldLook->isInvalid() )
+			queueUndoShroudReveal( oldLook->m_where.x, oldLook->m_where.y, oldLook->m_howFar, oldLook->m_forWhom );
+		doShroudReveal( centerX, centerY, radius, playerMask );
+		return;
+	}
+
+	Int oldCellX, oldCellY, newCellX, newCellY;
+	worldToCell( oldLook->m_where.x, oldLook->m_where.y, &oldCellX, &oldCellY );
+	worldToCell( centerX, centerY, &newCellX, &newCellY );
+	Int oldCellRadius = max( worldToCellDist( oldLook->m_howFar ), (Int)1 );
+	Int newCellRadius = max( worldToCellDist( radius ), (Int)1 );
+	if( oldCellX == newCellX && oldCellY == newCellY && oldCellRadius == newCellRadius )
+		return;	// same disc, nothing enters or leaves it
+
+	drawShroudCircleExcept( centerX, centerY, radius, oldLook->m_where.x, oldLook->m_where.y, oldLook->m_howFar, 
+													playerMask, m_addLookerFunc );
+
+	UnsignedInt now = getShroudFrame();
+	SightingInfo *newInfo = newInstance(SightingInfo);
+
+	newInfo->m_where = oldLook->m_where;
+	newInfo->m_howFar = oldLook->m_howFar;
+	newInfo->m_forWhom = playerMask;
+	newInfo->m_data = now + TheGlobalData->m_unlookPersistDuration;
+	newInfo->m_exceptWhere.x = centerX;
+	newInfo->m_exceptWhere.y = centerY;
+	newInfo->m_exceptWhere.z = 0.0f;
+	newInfo->m_exceptHowFar = radius;
+
+	m_pendingUndoShroudReveals.push(newInfo);
+}
 	
+//-----------------------------------------------------------------------------
+// ShroudMove self test.  Two scratch managers count lookers per cell in their own grids rather than
+// touching any PartitionCells.  One moves its looks with queueUndoShroudReveal and doShroudReveal, the 
+// way Object did before moveShroudReveal, and the other with moveShroudReveal.  A cell is clear while
+// its count is above zero, and that has to come out the same in both on every frame.
+//-----------------------------------------------------------------------------
+static const Int SHROUD_TEST_CELLS = 48;
+static const Real SHROUD_TEST_CELL_SIZE = 10.0f;
+static Int s_shroudTestUndoCounts[ SHROUD_TEST_CELLS * SHROUD_TEST_CELLS ];
+static Int s_shroudTestMoveCounts[ SHROUD_TEST_CELLS * SHROUD_TEST_CELLS ];
+static Bool s_shroudTestWentNegative = FALSE;
+
+// -----------------------------------------------------------------------------
+static void shroudTestCount(Int *counts, Int x1, Int x2, Int y, Int delta)
+{
+	if (y < 0 || y >= SHROUD_TEST_CELLS)
+		return;
+
+	x1 = max(x1, (Int)0);
+	x2 = min(x2, SHROUD_TEST_CELLS - 1);
+	for (Int x = x1; x <= x2; ++x)
+	{
+		counts[y * SHROUD_TEST_CELLS + x] += delta;
+		if (counts[y * SHROUD_TEST_CELLS + x] < 0)
+			s_shroudTestWentNegative = TRUE;
+	}
+}
+
+static void hLineAddUndoTestLooker(Int x1, Int x2, Int y, void *) { shroudTestCount(s_shroudTestUndoCounts, x1, x2, y, 1); }
+static void hLineRemoveUndoTestLooker(Int x1, Int x2, Int y, void *) { shroudTestCount(s_shroudTestUndoCounts, x1, x2, y, -1); }
+static void hLineAddMoveTestLooker(Int x1, Int x2, Int y, void *) { shroudTestCount(s_shroudTestMoveCounts, x1, x2, y, 1); }
+static void hLineRemoveMoveTestLooker(Int x1, Int x2, Int y, void *) { shroudTestCount(s_shroudTestMoveCounts, x1, x2, y, -1); }
+
+// -----------------------------------------------------------------------------
+static Real shroudTestRandom(UnsignedInt &seed, Real lo, Real hi)
+{
+	seed = seed * 1664525 + 1013904223;
+	return lo + (hi - lo) * (Real)((seed >> 8) & 0xffff) / 65535.0f;
+}
+
+// -----------------------------------------------------------------------------
+Bool PartitionManager::runShroudMoveSelfTest(AsciiString *failure)
+{
+	if (ThePlayerList == NULL || ThePlayerList->getPlayerCount() < 1 || TheGlobalData == NULL)
+	{
+		*failure = "no player list";
+		return FALSE;
+	}
+	PlayerMaskType mask = ThePlayerList->getNthPlayer(0)->getPlayerMask();
+
+	memset(s_shroudTestUndoCounts, 0, sizeof(s_shroudTestUndoCounts));
+	memset(s_shroudTestMoveCounts, 0, sizeof(s_shroudTestMoveCounts));
+	s_shroudTestWentNegative = FALSE;
+
+	PartitionManager *undoManager = NEW PartitionManager;
+	PartitionManager *moveManager = NEW PartitionManager;
+	PartitionManager *managers[2] = { undoManager, moveManager };
+	Int i;
+	for (i = 0; i < 2; ++i)
+	{
+		managers[i]->m_cellSize = SHROUD_TEST_CELL_SIZE;
+		managers[i]->m_cellSizeInv = 1.0f / SHROUD_TEST_CELL_SIZE;
+		managers[i]->m_worldExtents.lo.zero();
+		managers[i]->m_worldExtents.hi.zero();
+		managers[i]->m_worldExtents.hi.x = SHROUD_TEST_CELLS * SHROUD_TEST_CELL_SIZE;
+		managers[i]->m_worldExtents.hi.y = SHROUD_TEST_CELLS * SHROUD_TEST_CELL_SIZE;
+	}
+	undoManager->m_addLookerFunc = hLineAddUndoTestLooker;
+	undoManager->m_removeLookerFunc = hLineRemoveUndoTestLooker;
+	moveManager->m_addLookerFunc = hLineAddMoveTestLooker;
+	moveManager->m_removeLookerFunc = hLineRemoveMoveTestLooker;
+
+	// a few lookers wandering around, growing and shrinking, jumping, and going blind for a while, 
+	// so the discs left behind overlap each other and the next look in every way
+	const Int NUM_LOOKERS = 6;
+	const Int NUM_FRAMES = 600;
+	const Real WORLD_SIZE = SHROUD_TEST_CELLS * SHROUD_TEST_CELL_SIZE;
+	SightingInfo *looks[ NUM_LOOKERS ];
+	for (i = 0; i < NUM_LOOKERS; ++i)
+		looks[i] = newInstance(SightingInfo);
+
+	Bool passed = TRUE;
+	UnsignedInt seed = 0x51ed2701;
+	for (Int frame = 1; frame <= NUM_FRAMES && passed; ++frame)
+	{
+		undoManager->m_shroudTestFrame = frame;
+		moveManager->m_shroudTestFrame = frame;
+
+		for (i = 0; i < NUM_LOOKERS; ++i)
+		{
+			SightingInfo *look = looks[i];
+			Real what = shroudTestRandom(seed, 0.0f, 1.0f);
+			if (what < 0.3f)
+				continue;		// standing still, no relook
+
+			if (what < 0.35f)
+			{
+				// unlook
+				if (!look->isInvalid())
+				{
+					undoManager->queueUndoShroudReveal(look->m_where.x, look->m_where.y, look->m_howFar, look->m_forWhom);
+					moveManager->queueUndoShroudReveal(look->m_where.x, look->m_where.y, look->m_howFar, look->m_forWhom);
+					look->reset();
+				}
+				continue;
+			}
+
+			Coord3D pos = look->m_where;
+			Real range = look->m_howFar;
+			if (look->isInvalid() || what > 0.97f)
+			{
+				pos.x = shroudTestRandom(seed, 0.0f, WORLD_SIZE);
+				pos.y = shroudTestRandom(seed, 0.0f, WORLD_SIZE);
+			}
+			else
+			{
+				pos.x += shroudTestRandom(seed, -2.5f, 2.5f) * SHROUD_TEST_CELL_SIZE;
+				pos.y += shroudTestRandom(seed, -2.5f, 2.5f) * SHROUD_TEST_CELL_SIZE;
+			}
+			if (look->isInvalid() || what > 0.9f)
+				range = shroudTestRandom(seed, 0.5f, 9.0f) * SHROUD_TEST_CELL_SIZE;
+
+			// what Object::look did after an unlook...
+			if (!look->isInvalid())
+				undoManager->queueUndoShroudReveal(look->m_where.x, look->m_where.y, look->m_howFar, look->m_forWhom);
+			undoManager->doShroudReveal(pos.x, pos.y, range, mask);
+
+			// ...and what Object::relook does now
+			moveManager->moveShroudReveal(look, pos.x, pos.y, range, mask);
+
+			look->m_where = pos;
+			look->m_forWhom = mask;
+			look->m_howFar = range;
+		}
+
+		undoManager->processPendingUndoShroudRevealQueue();
+		moveManager->processPendingUndoShroudRevealQueue();
+
+		for (Int cell = 0; cell < SHROUD_TEST_CELLS * SHROUD_TEST_CELLS; ++cell)
+		{
+			if ((s_shroudTestUndoCounts[cell] > 0) != (s_shroudTestMoveCounts[cell] > 0))
+			{
+				failure->format("cell %d,%d has %d undo lookers but %d move lookers on frame %d",
+					cell % SHROUD_TEST_CELLS, cell / SHROUD_TEST_CELLS, s_shroudTestUndoCounts[cell], s_shroudTestMoveCounts[cell], frame);
+				passed = FALSE;
+				break;
+			}
+		}
+	}
+
+	// everybody unlooks, and once the queues drain nothing may be left looking
+	for (i = 0; i < NUM_LOOKERS; ++i)
+	{
+		SightingInfo *look = looks[i];
+		if (!look->isInvalid())
+		{
+			undoManager->queueUndoShroudReveal(look->m_where.x, look->m_where.y, look->m_howFar, look->m_forWhom);
+			moveManager->queueUndoShroudReveal(look->m_where.x, look->m_where.y, look->m_howFar, look->m_forWhom);
+		}
+		look->deleteInstance();
+	}
+	undoManager->processEntirePendingUndoShroudRevealQueue();
+	moveManager->processEntirePendingUndoShroudRevealQueue();
+
+	if (passed)
+	{
+		for (Int cell = 0; cell < SHROUD_TEST_CELLS * SHROUD_TEST_CELLS; ++cell)
+		{
+			if (s_shroudTestUndoCounts[cell] != 0 || s_shroudTestMoveCounts[cell] != 0)
+			{
+				failure->format("cell %d,%d still has %d undo lookers and %d move lookers after everyone unlooked",
+					cell % SHROUD_TEST_CELLS, cell / SHROUD_TEST_CELLS, s_shroudTestUndoCounts[cell], s_shroudTestMoveCounts[cell]);
+				passed = FALSE;
+				break;
+			}
+		}
+	}
+	if (passed && s_shroudTestWentNegative)
+	{
+		*failure = "a cell lost a looker it never had";
+		passed = FALSE;
+	}
+
+	delete undoManager;
+	delete moveManager;
+	return passed;
+}
+
+// -----------------------------------------------------------------------------
+static Bool shroudMoveSelfTest(AsciiString *failure)
+{
+	return PartitionManager::runShroudMoveSelfTest(failure);
+}
+static SelfTestRegistration theShroudMoveSelfTest( "ShroudMove", shroudMoveSelfTest );
+
 //-----------------------------------------------------------------------------
 void PartitionManager::doShroudCover(Real centerX, Real centerY, Real radius, PlayerMaskType playerMask) 
 {
@@ -4663,6 +5211,9 @@ void PartitionManager::xfer( Xfer *xfer )
 void PartitionManager::loadPostProcess( void )
 {
 
+	// relationships were loaded behind our back
+	notifyRelationshipsChanged();
+
 }  // end loadPostProcess
 
 //-----------------------------------------------------------------------------
@@ -5721,6 +6272,8 @@ void SightingInfo::reset()
 	m_howFar = 0.0f;
 	m_forWhom = 0;
 	m_data = 0;
+	m_exceptWhere.zero();
+	m_exceptHowFar = 0.0f;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -5741,13 +6294,14 @@ void SightingInfo::crc( Xfer *xfer )
 // ------------------------------------------------------------------------------------------------
 /** Xfer Method
 	* Version Info:
-	* 1: Initial version */
+	* 1: Initial version 
+	* 2: Except circle, for undos queued by moveShroudReveal */
 // ------------------------------------------------------------------------------------------------
 void SightingInfo::xfer( Xfer *xfer )
 {
 
 	// version
-	XferVersion currentVersion = 1;
+	XferVersion currentVersion = 2;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
@@ -5763,6 +6317,13 @@ void SightingInfo::xfer( Xfer *xfer )
 	// how much
 	xfer->xferUnsignedInt( &m_data );
 
+	// except where
+	if( version >= 2 )
+	{
+		xfer->xferCoord3D( &m_exceptWhere );
+		xfer->xferReal( &m_exceptHowFar );
+	}
+
 }  // end xfer
 
 // ------------------------------------------------------------------------------------------------
@@ -1048,7 +1048,7 @@ UnsignedInt WeaponTemplate::fireWeaponTemplate
 void WeaponTemplate::trimOldHistoricDamage() const
 {
 	UnsignedInt expirationDate = TheGameLogic->getFrame() - TheGlobalData->m_historicDamageLimit;
-	while (m_historicDamage.size() > 0)
+	while (!m_historicDamage.empty())
 	{
 		HistoricWeaponDamageInfo& h = m_historicDamage.front();
 		if (h.frame <= expirationDate)
@@ -1098,10 +1098,14 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 		Int count = 0;
 		UnsignedInt frameNow = TheGameLogic->getFrame();
 		UnsignedInt oldestThatWillCount = frameNow - m_historicBonusTime; // Anything before this frame is "more than two seconds ago" eg
-		for( HistoricWeaponDamageList::const_iterator it = m_historicDamage.begin(); it != m_historicDamage.end(); ++it )
+		// the history is in chronological order, so walk it newest-first and stop at the first entry
+		// that is too old to count, rather than looking at everything that hasn't been trimmed yet.
+		for( HistoricWeaponDamageList::const_reverse_iterator it = m_historicDamage.rbegin(); it != m_historicDamage.rend(); ++it )
 		{
-			if( it->frame >= oldestThatWillCount && 
-					is2DDistSquaredLessThan( *pos, it->location, radSqr ) )
+			if( it->frame < oldestThatWillCount )
+				break;
+
+			if( is2DDistSquaredLessThan( *pos, it->location, radSqr ) )
 			{
 				// This one is close enough in time and distance, so count it. This is tracked by template since it applies
 				// across units, so don't try to clear historicDamage on success in here.
@@ -1295,6 +1299,9 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 //-------------------------------------------------------------------------------------------------
 WeaponStore::WeaponStore()
 {
+	m_nextDelayedDamageFrame = 0;
+	m_delayedDamageSequence = 0;
+	m_delayedDamageCount = 0;
 } 
 
 //-------------------------------------------------------------------------------------------------
@@ -1397,29 +1404,89 @@ WeaponTemplate *WeaponStore::newOverride(WeaponTemplate *weaponTemplate)
 } 
 
 //-------------------------------------------------------------------------------------------------
-void WeaponStore::update()
+/** Move everything in the bucket that is due by curFrame onto the due list, keeping the rest
+	of the bucket in the order it was scheduled. */
+void WeaponStore::collectDueDelayedDamage(DelayedDamageBucket& bucket, UnsignedInt curFrame)
 {
-	for (std::list<WeaponDelayedDamageInfo>::iterator ddi = m_weaponDDI.begin(); ddi != m_weaponDDI.end(); )
+	Int keep = 0;
+	Int count = bucket.size();
+	for (Int i = 0; i < count; ++i)
 	{
-		UnsignedInt curFrame = TheGameLogic->getFrame();
-		if (curFrame >= ddi->m_delayDamageFrame)
+		if (curFrame >= bucket[i].m_delayDamageFrame)
 		{
-			// we never do projectile-detonation-damage via this code path.
-			const isProjectileDetonation = false;
-			ddi->m_delayedWeapon->dealDamageInternal(ddi->m_delaySourceID, ddi->m_delayIntendedVictimID, &ddi->m_delayDamagePos, ddi->m_bonus, isProjectileDetonation);
-			ddi = m_weaponDDI.erase(ddi);
+			m_dueDelayedDamage.push_back(bucket[i]);
 		}
 		else
 		{
-			++ddi;
+			if (keep != i)
+				bucket[keep] = bucket[i];
+			++keep;
 		}
 	}
+	bucket.resize(keep);
+}
+
+//-------------------------------------------------------------------------------------------------
+void WeaponStore::update()
+{
+	UnsignedInt curFrame = TheGameLogic->getFrame();
+
+	if (m_delayedDamageCount == 0)
+	{
+		m_nextDelayedDamageFrame = curFrame + 1;
+		return;
+	}
+
+	// gather the buckets for every frame that has elapsed since the last update. if we've been away
+	// for a whole turn of the wheel (or the frame went backwards), just look at all of them.
+	m_dueDelayedDamage.clear();
+	if (curFrame < m_nextDelayedDamageFrame || curFrame - m_nextDelayedDamageFrame >= DELAYED_DAMAGE_WHEEL_SIZE)
+	{
+		for (Int i = 0; i < DELAYED_DAMAGE_WHEEL_SIZE; ++i)
+			collectDueDelayedDamage(m_delayedDamageWheel[i], curFrame);
+	}
+	else
+	{
+		for (UnsignedInt frame = m_nextDelayedDamageFrame; frame <= curFrame; ++frame)
+			collectDueDelayedDamage(m_delayedDamageWheel[frame & (DELAYED_DAMAGE_WHEEL_SIZE - 1)], curFrame);
+	}
+
+	// anything scheduled for this frame (or earlier) while we deal damage goes into this frame's
+	// bucket, which we keep re-checking until nothing more is due.
+	m_nextDelayedDamageFrame = curFrame;
+
+	while (!m_dueDelayedDamage.empty())
+	{
+		// deal the damage in the order it was scheduled, just as if it were all in one list.
+		std::sort(m_dueDelayedDamage.begin(), m_dueDelayedDamage.end(), DelayedDamageSequenceLess());
+		m_delayedDamageCount -= m_dueDelayedDamage.size();
+
+		// dealing damage can schedule more delayed damage, but that only ever goes into the wheel
+		Int count = m_dueDelayedDamage.size();
+		for (Int i = 0; i < count; ++i)
+		{
+			const WeaponDelayedDamageInfo& ddi = m_dueDelayedDamage[i];
+			// we never do projectile-detonation-damage via this code path.
+			const isProjectileDetonation = false;
+			ddi.m_delayedWeapon->dealDamageInternal(ddi.m_delaySourceID, ddi.m_delayIntendedVictimID, &ddi.m_delayDamagePos, ddi.m_bonus, isProjectileDetonation);
+		}
+
+		m_dueDelayedDamage.clear();
+		collectDueDelayedDamage(m_delayedDamageWheel[curFrame & (DELAYED_DAMAGE_WHEEL_SIZE - 1)], curFrame);
+	}
+
+	m_nextDelayedDamageFrame = curFrame + 1;
 }
 
 //-------------------------------------------------------------------------------------------------
 void WeaponStore::deleteAllDelayedDamage()
 {
-	m_weaponDDI.clear();
+	for (Int i = 0; i < DELAYED_DAMAGE_WHEEL_SIZE; ++i)
+		m_delayedDamageWheel[i].clear();
+	m_dueDelayedDamage.clear();
+	m_nextDelayedDamageFrame = 0;
+	m_delayedDamageSequence = 0;
+	m_delayedDamageCount = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1463,7 +1530,14 @@ void WeaponStore::setDelayedDamage(const WeaponTemplate *weapon, const Coord3D*
 	wi.m_delaySourceID = sourceID;
 	wi.m_delayIntendedVictimID = victimID;
 	wi.m_bonus = bonus;
-	m_weaponDDI.push_back(wi);
+	wi.m_delaySequence = m_delayedDamageSequence++;
+
+	// damage that is already due goes in the next bucket update will look at
+	UnsignedInt bucketFrame = whichFrame;
+	if (bucketFrame < m_nextDelayedDamageFrame)
+		bucketFrame = m_nextDelayedDamageFrame;
+	m_delayedDamageWheel[bucketFrame & (DELAYED_DAMAGE_WHEEL_SIZE - 1)].push_back(wi);
+	++m_delayedDamageCount;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -38,6 +38,7 @@
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
+#include "Common/SelfTest.h"
 #include "Common/Team.h"
 #include "Common/ThingFactory.h"
 #include "Common/ThingTemplate.h"
@@ -372,6 +373,7 @@ m_skirmishHumanPlayer(NULL),
 m_fade(FADE_NONE),
 m_freezeByScript(FALSE),
 m_frameObjectCountChanged(0),
+m_scriptInputSerial(1),
 //Added By Sadullah Nader
 //Initializations inserted
 m_closeWindowTimer(0),
@@ -395,6 +397,10 @@ m_ChooseVictimAlwaysUsesNormal(false)
 	// By default, difficulty should be normal.
 	setGlobalDifficulty(DIFFICULTY_NORMAL);
 
+	for (Int i=0; i<SCRIPT_INPUT_COUNT; i++) {
+		m_scriptInputChangedAt[i] = m_scriptInputSerial;
+	}
+
 }  // end ScriptEngine
 
 //-------------------------------------------------------------------------------------------------
@@ -4569,6 +4575,8 @@ void ScriptEngine::reset( void )
 	for (i=0; i<MAX_COUNTERS; i++) {
 		m_counters[i].value = 0;
 		m_counters[i].isCountdownTimer = false;
+		m_counters[i].isWatchedValue = false;
+		m_counters[i].isWatchedExpiry = false;
 		m_counters[i].name.clear();
 	}
 	for (i=0; i<MAX_FLAGS; i++) {
@@ -4628,9 +4636,10 @@ void ScriptEngine::reset( void )
 				}
 			}
 			if (maxScript) {
-				DEBUG_LOG(("   SCRIPT %s total time %f seconds,\n        evaluated %d times, avg execution %2.3f msec (Goal less than 0.05)\n",
+				DEBUG_LOG(("   SCRIPT %s total time %f seconds,\n        evaluated %d times, avg execution %2.3f msec (Goal less than 0.05), reused %d times\n",
 					maxScript->getName().str(),
-					maxScript->getConditionTime(), maxScript->getConditionCount(), 1000*maxScript->getConditionTime()/maxScript->getConditionCount()) );
+					maxScript->getConditionTime(), maxScript->getConditionCount(), 1000*maxScript->getConditionTime()/maxScript->getConditionCount(),
+					maxScript->getConditionSkippedCount()) );
 				maxScript->addToConditionTime(-2*maxTime); // reset to negative.
 			}
 
@@ -4688,6 +4697,8 @@ void ScriptEngine::reset( void )
 
 	// clear topple directions
 	m_toppleDirections.clear();
+
+	notifyOfScriptInputChange(~0);
 		
 }  // end reset
 
@@ -4696,11 +4707,14 @@ void ScriptEngine::reset( void )
 //-------------------------------------------------------------------------------------------------
 void ScriptEngine::newMap( void )
 {
+	notifyOfScriptInputChange(~0);
 	m_numCounters = 1;
 	Int i;
 	for (i=0; i<MAX_COUNTERS; i++) {
 		m_counters[i].value = 0;
 		m_counters[i].isCountdownTimer = false;
+		m_counters[i].isWatchedValue = false;
+		m_counters[i].isWatchedExpiry = false;
 		m_counters[i].name.clear();
 	}
 	m_numFlags = 1;
@@ -4828,18 +4842,10 @@ void ScriptEngine::update( void )
 		TheScriptConditions->update();
 	}
 	// Update any countdown timers.
-	Int i;
-	// Note - counters start at 1.  0 means not assigned.
-	for (i=1; i<m_numCounters; i++) {
-		if (m_counters[i].isCountdownTimer) {
-			// If counter has any time left, decrement.  Counters go to -1 and stop.
-			if (m_counters[i].value >= 0) {
-				m_counters[i].value--;
-			}
-		}
-	}
+	updateCountdownTimers();
 
 	// Evaluate the scripts.
+	Int i;
 	for (i=0; i<TheSidesList->getNumSides(); i++) {
 		m_currentPlayer = ThePlayerList->getNthPlayer(i);
 		ScriptList *pSL = TheSidesList->getSideInfo(i)->getScriptList();
@@ -4863,7 +4869,10 @@ void ScriptEngine::update( void )
 	ThePlayerList->updateTeamStates();
 
 	// Clear the UI Interaction flags.
-	m_uiInteractions.clear();
+	if (!m_uiInteractions.empty()) {
+		m_uiInteractions.clear();
+		notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_FLAGS));
+	}
 
 	// update all sequential stuff.
 	evaluateAndProgressAllSequentialScripts();
@@ -5040,6 +5049,7 @@ void ScriptEngine::clearFlag(const AsciiString &name)
 		for (i=1; i<m_numFlags; i++) {
 			if ((modName==m_flags[i].name)) {
 				m_flags[i].value = FALSE;
+				notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_FLAGS));
 			}
 		}
 	}
@@ -5623,6 +5633,7 @@ Bool ScriptEngine::evaluateCounter( Condition *pCondition )
 		counterNdx = allocateCounter(pCondition->getParameter(0)->getString());
 		pCondition->getParameter(0)->friend_setInt(counterNdx);
 	}
+	m_counters[counterNdx].isWatchedValue = true;
 	Int value = pCondition->getParameter(2)->getInt();
 	switch (pCondition->getParameter(1)->getInt()) {
 		case Parameter::LESS_THAN: return m_counters[counterNdx].value < value;
@@ -5648,6 +5659,7 @@ void ScriptEngine::setCounter( ScriptAction *pAction )
 	}
 	Int value = pAction->getParameter(1)->getInt();
 	m_counters[counterNdx].value = value;
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -5716,6 +5728,7 @@ void ScriptEngine::addCounter( ScriptAction *pAction )
 		pAction->getParameter(1)->friend_setInt(counterNdx);
 	}
 	m_counters[counterNdx].value += value;
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -5731,6 +5744,7 @@ void ScriptEngine::subCounter( ScriptAction *pAction )
 		pAction->getParameter(1)->friend_setInt(counterNdx);
 	}
 	m_counters[counterNdx].value -= value;
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -5775,6 +5789,7 @@ void ScriptEngine::setFlag( ScriptAction *pAction )
 	}
 	Bool value = pAction->getParameter(1)->getInt();
 	m_flags[flagNdx].value = value;
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_FLAGS));
 }
 
 
@@ -6002,6 +6017,7 @@ Bool ScriptEngine::evaluateTimer( Condition *pCondition )
 		counterNdx = allocateCounter(pCondition->getParameter(0)->getString());
 		pCondition->getParameter(0)->friend_setInt(counterNdx);
 	}
+	m_counters[counterNdx].isWatchedExpiry = true;
 	if (!m_counters[counterNdx].isCountdownTimer) {
 		return false; // Timer hasn't been started yet.
 	}
@@ -6037,6 +6053,7 @@ void ScriptEngine::setTimer( ScriptAction *pAction, Bool millisecondTimer, Bool
 		m_counters[counterNdx].value = value;
 	}
 	m_counters[counterNdx].isCountdownTimer = true;
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6051,6 +6068,7 @@ void ScriptEngine::pauseTimer( ScriptAction *pAction )
 		pAction->getParameter(0)->friend_setInt(counterNdx);
 	}
 	m_counters[counterNdx].isCountdownTimer = false;
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6066,6 +6084,7 @@ void ScriptEngine::restartTimer( ScriptAction *pAction )
 	}
 	if (m_counters[counterNdx].value > 0) {
 		m_counters[counterNdx].isCountdownTimer = true;
+		notifyOfCounterChange(counterNdx);
 	}
 }
 
@@ -6091,6 +6110,7 @@ void ScriptEngine::adjustTimer( ScriptAction *pAction, Bool millisecondTimer, Bo
 			value = -value;
 		m_counters[counterNdx].value += value;
 	}
+	notifyOfCounterChange(counterNdx);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6379,6 +6399,8 @@ void ScriptEngine::addObjectToCache(Object* pNewObject)
 		return;
 	}
 
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
+
 	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
 		if (it->first == objName) {
 			if (it->second == NULL) {
@@ -6418,6 +6440,7 @@ void ScriptEngine::removeObjectFromCache( Object* pDeadObject )
 	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
 		if (pDeadObject == (it->second)) {
 			it->second = NULL;	// Don't remove it, cause we want to check whether we ever knew a name later
+			notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 			break;
 		}
 	}
@@ -6439,6 +6462,8 @@ void ScriptEngine::transferObjectName( const AsciiString& unitName, Object *pNew
 		return;
 	}
 
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
+
 	//John Ahlquist: When transferring an object name, make sure the new object isn't already in 
 	//							 the vector. If so, remove it, or it'll end up there twice and cause a crash.
 	if( pNewObject->getName().isNotEmpty() ) 
@@ -6544,6 +6569,7 @@ void ScriptEngine::notifyOfAcquiredScience( Int playerIndex, ScienceType science
 void ScriptEngine::signalUIInteract(const AsciiString& hookName)
 {
 	m_uiInteractions.push_front(hookName);
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_FLAGS));
 #ifdef DEBUG_LOGGING
 	AppendDebugMessage(hookName, false); // don't bother in Release
 #endif
@@ -6863,6 +6889,29 @@ Bool ScriptEngine::evaluateConditions( Script *pScript, Team *thisTeam, Player *
 	if (thisTeam) player = thisTeam->getControllingPlayer();
 	if (player==NULL) player=m_currentPlayer;
 	LatchRestore<Player*> latch2(m_currentPlayer, player);
+
+	// A script evaluated with no team or object context, whose conditions only look at inputs we 
+	// track, gets the same answer until one of those inputs changes.
+	Bool useCache = (thisTeam == NULL && m_conditionTeam == NULL && 
+		m_callingObject == NULL && m_conditionObject == NULL);
+	UnsignedInt inputs = 0;
+	if (useCache) {
+		inputs = getScriptConditionInputs(pScript);
+		useCache = !(inputs & SCRIPT_INPUTS_UNTRACKED);
+	}
+	if (useCache && pScript->hasConditionResult(player) && 
+			areScriptInputsUnchanged(inputs, pScript->getConditionResultSerial())) {
+		pScript->incrementConditionSkippedCount();
+#ifdef _DEBUG
+		Bool cachedValue = pScript->getConditionResult();
+		pScript->invalidateConditionResult();
+		DEBUG_ASSERTCRASH(evaluateConditions(pScript, thisTeam, player) == cachedValue, 
+			("Cached condition result for script '%s' is stale", pScript->getName().str()));
+#endif
+		return pScript->getConditionResult();
+	}
+	UnsignedInt64 evaluatedAtSerial = m_scriptInputSerial;
+
 	OrCondition *pConditionHead = pScript->getOrCondition();
 	Bool testValue = false;
 
@@ -6900,6 +6949,10 @@ Bool ScriptEngine::evaluateConditions( Script *pScript, Team *thisTeam, Player *
 	pScript->addToConditionTime(timeToEvaluate);
 #endif
 
+	if (useCache) {
+		pScript->setConditionResult(testValue, player, evaluatedAtSerial);
+	}
+
 	return testValue; // If none of the or's fired, then it is false.
 }
 
@@ -6995,6 +7048,7 @@ const ConditionTemplate * ScriptEngine::getConditionTemplate( Int ndx )
 void ScriptEngine::createNamedCache( void )
 {
 	m_namedObjects.clear();
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 
 	if( !TheGameLogic )
 	{
@@ -7087,12 +7141,218 @@ void ScriptEngine::notifyOfObjectCreationOrDestruction(void)
 	m_frameObjectCountChanged = TheGameLogic->getFrame();
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Something script conditions look at may have changed, so scripts that look at it can't reuse 
+their last result. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::notifyOfScriptInputChange(UnsignedInt inputBits)
+{
+	++m_scriptInputSerial;
+	for (Int i=0; i<SCRIPT_INPUT_COUNT; i++) {
+		if (inputBits & SCRIPT_INPUT_BIT(i)) {
+			m_scriptInputChangedAt[i] = m_scriptInputSerial;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** A counter changed.  Cached results can only depend on counters a condition has read (and marked
+as watched), so changes to any other counter don't throw them away.  A counter that is only read by 
+TIMER_EXPIRED is handled in updateCountdownTimers, where the value alone changes. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::notifyOfCounterChange(Int counterNdx)
+{
+	if (m_counters[counterNdx].isWatchedValue || m_counters[counterNdx].isWatchedExpiry) {
+		notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_COUNTERS));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Count down the running timers.  TIMER_EXPIRED only cares whether a timer is below 1, so a timer
+that nothing compares by value only invalidates cached results on the frame it expires. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::updateCountdownTimers(void)
+{
+	// Note - counters start at 1.  0 means not assigned.
+	for (Int i=1; i<m_numCounters; i++) {
+		TCounter& counter = m_counters[i];
+		if (counter.isCountdownTimer) {
+			// If counter has any time left, decrement.  Counters go to -1 and stop.
+			if (counter.value >= 0) {
+				counter.value--;
+				if (counter.isWatchedValue || (counter.isWatchedExpiry && counter.value == 0)) {
+					notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_COUNTERS));
+				}
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** What a condition type looks at.  Only conditions that are pure functions of tracked inputs (and
+whose inputs notify us when they change) may be listed here; everything else is evaluated every time. */
+//-------------------------------------------------------------------------------------------------
+UnsignedInt ScriptEngine::getConditionInputs(Int conditionType)
+{
+	switch (conditionType) {
+		default:
+			return SCRIPT_INPUTS_UNTRACKED;
+
+		case Condition::CONDITION_FALSE:
+		case Condition::CONDITION_TRUE:
+		case Condition::MISSION_ATTEMPTS:
+		case Condition::SKIRMISH_NAMED_AREA_EXIST:
+			return 0;
+
+		case Condition::COUNTER:
+		case Condition::TIMER_EXPIRED:
+			return SCRIPT_INPUT_BIT(SCRIPT_INPUT_COUNTERS);
+
+		case Condition::FLAG:
+			return SCRIPT_INPUT_BIT(SCRIPT_INPUT_FLAGS);
+
+		case Condition::TEAM_DESTROYED:
+		case Condition::TEAM_HAS_UNITS:
+		case Condition::TEAM_CREATED:
+		case Condition::NAMED_DESTROYED:
+		case Condition::NAMED_NOT_DESTROYED:
+		case Condition::NAMED_CREATED:
+			return SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Union of what all of a script's conditions look at. */
+//-------------------------------------------------------------------------------------------------
+UnsignedInt ScriptEngine::getScriptConditionInputs(Script *pScript)
+{
+	UnsignedInt inputs = pScript->getConditionInputs();
+	if (inputs != SCRIPT_INPUTS_UNKNOWN) {
+		return inputs;
+	}
+
+	inputs = 0;
+	for (OrCondition *pOr = pScript->getOrCondition(); pOr; pOr = pOr->getNextOrCondition()) {
+		for (Condition *pCondition = pOr->getFirstAndCondition(); pCondition; pCondition = pCondition->getNext()) {
+			inputs |= getConditionInputs(pCondition->getConditionType());
+		}
+	}
+	pScript->setConditionInputs(inputs);
+	return inputs;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** True if none of the inputs have changed since the given serial. */
+//-------------------------------------------------------------------------------------------------
+Bool ScriptEngine::areScriptInputsUnchanged(UnsignedInt inputs, UnsignedInt64 sinceSerial) const
+{
+	if (inputs & SCRIPT_INPUTS_UNTRACKED) {
+		return false;
+	}
+	for (Int i=0; i<SCRIPT_INPUT_COUNT; i++) {
+		if ((inputs & SCRIPT_INPUT_BIT(i)) && m_scriptInputChangedAt[i] > sinceSerial) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** -selfTest: changes to a counter only throw away cached condition results once a condition has
+read it, a timer read only by TIMER_EXPIRED only does so when it expires, and the serial doesn't
+misbehave past 32 bits. */
+//-------------------------------------------------------------------------------------------------
+Bool ScriptEngine::selfTestScriptInputs(AsciiString *failure)
+{
+	const UnsignedInt counters = SCRIPT_INPUT_BIT(SCRIPT_INPUT_COUNTERS);
+	Bool passed = true;
+
+	Int unwatched = allocateCounter("SelfTestUnwatchedCounter");
+	UnsignedInt64 since = m_scriptInputSerial;
+	m_counters[unwatched].value += 3;
+	notifyOfCounterChange(unwatched);
+	if (!areScriptInputsUnchanged(counters, since)) {
+		*failure = "a counter no condition reads invalidated the cache";
+		passed = false;
+	}
+
+	Condition *counterCondition = newInstance(Condition)(Condition::COUNTER);
+	counterCondition->getParameter(0)->friend_setString("SelfTestWatchedCounter");
+	counterCondition->getParameter(1)->friend_setInt(Parameter::GREATER_EQUAL);
+	counterCondition->getParameter(2)->friend_setInt(5);
+	if (passed && evaluateCounter(counterCondition)) {
+		*failure = "a new counter was already >= 5";
+		passed = false;
+	}
+	Int watched = counterCondition->getParameter(0)->getInt();
+	since = m_scriptInputSerial;
+	m_counters[watched].value = 5;
+	notifyOfCounterChange(watched);
+	if (passed && areScriptInputsUnchanged(counters, since)) {
+		*failure = "a counter a COUNTER condition reads did not invalidate the cache";
+		passed = false;
+	}
+	if (passed && !evaluateCounter(counterCondition)) {
+		*failure = "the watched counter did not read back as >= 5";
+		passed = false;
+	}
+	counterCondition->deleteInstance();
+
+	Condition *timerCondition = newInstance(Condition)(Condition::TIMER_EXPIRED);
+	timerCondition->getParameter(0)->friend_setString("SelfTestTimer");
+	evaluateTimer(timerCondition);
+	Int timer = timerCondition->getParameter(0)->getInt();
+	m_counters[timer].value = 2;
+	m_counters[timer].isCountdownTimer = true;
+	since = m_scriptInputSerial;
+	updateCountdownTimers();		// 2 -> 1, still running
+	if (passed && !areScriptInputsUnchanged(counters, since)) {
+		*failure = "a timer that has not expired invalidated the cache";
+		passed = false;
+	}
+	updateCountdownTimers();		// 1 -> 0, expired
+	if (passed && (areScriptInputsUnchanged(counters, since) || !evaluateTimer(timerCondition))) {
+		*failure = "an expiring timer did not invalidate the cache";
+		passed = false;
+	}
+	m_counters[timer].isCountdownTimer = false;
+	timerCondition->deleteInstance();
+
+	// a result cached just before the serial passes 2^32 must not look newer than what follows.
+	// (the serial only ever moves forward, so jumping it ahead is safe.)
+	if (m_scriptInputSerial < 0xffffffff) {
+		m_scriptInputSerial = 0xffffffff;
+	}
+	since = m_scriptInputSerial;
+	notifyOfScriptInputChange(counters);
+	if (passed && areScriptInputsUnchanged(counters, since)) {
+		*failure = "a change after the serial passed 2^32 was missed";
+		passed = false;
+	}
+	notifyOfScriptInputChange(~0);
+
+	return passed;
+}
+
+//-------------------------------------------------------------------------------------------------
+static Bool scriptInputsSelfTest(AsciiString *failure)
+{
+	if (TheScriptEngine == NULL) {
+		*failure = "no script engine";
+		return false;
+	}
+	return TheScriptEngine->selfTestScriptInputs(failure);
+}
+static SelfTestRegistration theScriptInputsSelfTest("ScriptInputs", scriptInputsSelfTest);
+
 void ScriptEngine::notifyOfTeamDestruction(Team *teamDestroyed)
 {
 	if (!teamDestroyed) {
 		return;		
 	}
 
+	notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
+
 	VecSequentialScriptPtrIt it;
 	for (it = m_sequentialScripts.begin(); it != m_sequentialScripts.end(); /* empty */) {
 		SequentialScript *seqScript = (*it);
@@ -8594,6 +8854,9 @@ void ScriptEngine::xfer( Xfer *xfer )
 void ScriptEngine::loadPostProcess( void )
 {
 
+	// everything the conditions look at was just loaded.
+	notifyOfScriptInputChange(~0);
+
 	// Now that we've loaded everything, go through and set them all back in sync with what we
 	// currently think they should be.
 	TheScriptActions->doEnableOrDisableObjectDifficultyBonuses(m_objectsShouldReceiveDifficultyBonus);
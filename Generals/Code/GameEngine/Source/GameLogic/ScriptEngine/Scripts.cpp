@@ -909,6 +909,12 @@ m_hard(true),
 m_delayEvaluationSeconds(0),
 m_conditionTime(0),
 m_conditionExecutedCount(0),
+m_conditionSkippedCount(0),
+m_conditionInputs(SCRIPT_INPUTS_UNKNOWN),
+m_conditionResultSerial(0),
+m_conditionResultPlayer(NULL),
+m_conditionResultValid(false),
+m_conditionResult(false),
 m_frameToEvaluateAt(0),
 m_isSubroutine(false),
 m_hasWarnings(false),
@@ -1098,6 +1104,9 @@ void Script::updateFrom(Script *pSrc)
 	}
 	this->m_actionFalse = pSrc->m_actionFalse;
 	pSrc->m_actionFalse = NULL;
+	// new conditions, so whatever we knew about the old ones is useless.
+	this->m_conditionInputs = SCRIPT_INPUTS_UNKNOWN;
+	this->m_conditionResultValid = false;
 }
 
 /**
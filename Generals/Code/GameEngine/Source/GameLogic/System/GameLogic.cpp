@@ -129,9 +129,6 @@ FILE *g_UT_commaLog=NULL;
 //#pragma MESSAGE("************************************** WARNING, optimization disabled for debugging purposes")
 #endif
 
-// I'm making this larger now that we know how big our maps are going to be. 
-enum { OBJ_HASH_SIZE	= 8192 };
-
 /// The GameLogic singleton instance
 GameLogic *TheGameLogic = NULL;
 
@@ -426,9 +423,8 @@ void GameLogic::reset( void )
 	m_thingTemplateBuildableOverrides.clear();
 	m_controlBarOverrides.clear();
 
-	// set the hash to be rather large. We need to optimize this value later.
+	// the table sizes itself to the number of live objects
 	m_objHash.clear();
-	m_objHash.resize(OBJ_HASH_SIZE);
 	m_gamePaused = FALSE;
 	m_inputEnabledMemory = TRUE;
 	m_mouseVisibleMemory = TRUE;
@@ -3366,7 +3362,7 @@ void GameLogic::addObjectToLookupTable( Object *obj )
 		return;
 
 	// add to lookup
-	m_objHash[ obj->getID() ] = obj;
+	m_objHash.insert( obj->getID(), obj );
 
 }  // end addObjectToLookupTable
 
@@ -3381,7 +3377,7 @@ void GameLogic::removeObjectFromLookupTable( Object *obj )
 		return;
 
 	// remove from lookup table
-	m_objHash.erase( obj->getID() );
+	m_objHash.remove( obj->getID() );
 
 }  // end removeObjectFromLookupTable
 
@@ -3478,6 +3474,8 @@ void GameLogic::destroyObject( Object *obj )
 
 	// mark object as destroyed
 	obj->setStatus( OBJECT_STATUS_DESTROYED );
+	if (TheScriptEngine)
+		TheScriptEngine->notifyOfScriptInputChange(SCRIPT_INPUT_BIT(SCRIPT_INPUT_OBJECTS));
 
 	// We desperately need to stop here, or else the destructor of the statemachine will try to do
 	// stopping logic, which uses virtual functions and deleted modules, which will crash us.
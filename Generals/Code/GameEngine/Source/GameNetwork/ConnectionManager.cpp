@@ -1617,7 +1617,10 @@ NetCommandList *ConnectionManager::getFrameCommandList(UnsignedInt frame)
 
 	for (Int i = 0; i < MAX_SLOTS; ++i) {
 		if (m_frameData[i] != NULL) {
-			retlist->appendList(m_frameData[i]->getFrameCommandList(frame));
+			Int numCommands = m_frameData[i]->getNumFrameCommands(frame);
+			for (Int c = 0; c < numCommands; ++c) {
+				retlist->addMessage(m_frameData[i]->getFrameCommand(frame, c));
+			}
 			if (frame > FRAMES_TO_KEEP) {
 				m_frameData[i]->resetFrame(frame - FRAMES_TO_KEEP);	// After getting the commands for that frame from this
 													// FrameDataManager object, we need to tell it that we're
@@ -2399,14 +2402,11 @@ void ConnectionManager::sendSingleFrameToPlayer(UnsignedInt playerID, UnsignedIn
 	DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("ConnectionManager::sendFrameDataToPlayer - sending data for frame %d\n", frame));
 	for (Int i = 0; i < MAX_SLOTS; ++i) {
 		if ((m_frameData[i] != NULL) && (i != playerID)) { // no need to send his own commands to him.
-			NetCommandList *list = m_frameData[i]->getFrameCommandList(frame);
-			if (list != NULL) {
-				NetCommandRef *ref = list->getFirstMessage();
-				while (ref != NULL) {
-					DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("ConnectionManager::sendFrameDataToPlayer - sending command %d from player %d to player %d using relay 0x%x\n", ref->getCommand()->getID(), i, playerID, relay));
-					sendLocalCommandDirect(ref->getCommand(), relay);
-					ref = ref->getNext();
-				}
+			Int numCommands = m_frameData[i]->getNumFrameCommands(frame);
+			for (Int c = 0; c < numCommands; ++c) {
+				NetCommandMsg *cmd = m_frameData[i]->getFrameCommand(frame, c);
+				DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("ConnectionManager::sendFrameDataToPlayer - sending command %d from player %d to player %d using relay 0x%x\n", cmd->getID(), i, playerID, relay));
+				sendLocalCommandDirect(cmd, relay);
 			}
 			UnsignedInt frameCommandCount = m_frameData[i]->getFrameCommandCount(frame);
 			NetFrameCommandMsg *msg = newInstance(NetFrameCommandMsg);
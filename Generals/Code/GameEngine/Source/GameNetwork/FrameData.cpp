@@ -34,7 +34,6 @@
 FrameData::FrameData() 
 {
 	m_frame = 0;
-	m_commandList = NULL;
 	m_commandCount = 0;
 	m_frameCommandCount = -1;
 	//Added By Sadullah Nader
@@ -49,10 +48,7 @@ FrameData::FrameData()
  */
 FrameData::~FrameData() 
 {
-	if (m_commandList != NULL) {
-		m_commandList->deleteInstance();
-		m_commandList = NULL;
-	}
+	clearCommands();
 }
 
 /**
@@ -61,11 +57,7 @@ FrameData::~FrameData()
 void FrameData::init() 
 {
 	m_frame = 0;
-	if (m_commandList == NULL) {
-		m_commandList = newInstance(NetCommandList);
-		m_commandList->init();
-	}
-	m_commandList->reset();
+	clearCommands();
 
 	m_frameCommandCount = -1;
 	//DEBUG_LOG(("FrameData::init\n"));
@@ -121,15 +113,14 @@ FrameDataReturnType FrameData::allCommandsReady(Bool debugSpewage) {
 
 	if (m_commandCount > m_frameCommandCount) {
 		DEBUG_LOG(("FrameData::allCommandsReady - There are more commands than there should be (%d, should be %d).  Commands in command list are...\n", m_commandCount, m_frameCommandCount));
-		NetCommandRef *ref = m_commandList->getFirstMessage();
-		while (ref != NULL) {
-			DEBUG_LOG(("%s, frame = %d, id = %d\n", GetAsciiNetCommandType(ref->getCommand()->getNetCommandType()).str(), ref->getCommand()->getExecutionFrame(), ref->getCommand()->getID()));
-			ref = ref->getNext();
+		for (Int i = 0; i < (Int)m_commands.size(); ++i) {
+			NetCommandMsg *cmd = m_commands[i].m_msg;
+			DEBUG_LOG(("%s, frame = %d, id = %d\n", GetAsciiNetCommandType(cmd->getNetCommandType()).str(), cmd->getExecutionFrame(), cmd->getID()));
 		}
 		DEBUG_LOG(("FrameData::allCommandsReady - End of command list.\n"));
 		DEBUG_LOG(("FrameData::allCommandsReady - about to clear the command list\n"));
 		reset();
-		DEBUG_LOG(("FrameData::allCommandsReady - command list cleared. command list length = %d, command count = %d, frame command count = %d\n", m_commandList->length(), m_commandCount, m_frameCommandCount));
+		DEBUG_LOG(("FrameData::allCommandsReady - command list cleared. command list length = %d, command count = %d, frame command count = %d\n", (Int)m_commands.size(), m_commandCount, m_frameCommandCount));
 		return FRAMEDATA_RESEND;
 	}
 	return FRAMEDATA_NOTREADY;
@@ -161,27 +152,80 @@ UnsignedInt FrameData::getCommandCount() {
  * Add a command to this frame
  */
 void FrameData::addCommand(NetCommandMsg *msg) {
-	// need to add the message in order of command ID
-	if (m_commandList == NULL) {
-		init();
+	// We don't want to add the same command twice. Commands with command IDs are the same
+	// command only if the player and ID match (see NetCommandList::isEqualCommandMsg), so
+	// look those up in the sorted keys rather than walking the whole frame.
+	if (DoesCommandRequireACommandID(msg->getNetCommandType())) {
+		UnsignedInt key = (msg->getPlayerID() << 16) | msg->getID();
+		std::vector<UnsignedInt>::iterator it = std::lower_bound(m_commandIDKeys.begin(), m_commandIDKeys.end(), key);
+		if (it != m_commandIDKeys.end() && *it == key) {
+			return;
+		}
+		m_commandIDKeys.insert(it, key);
+	} else {
+		for (Int i = 0; i < (Int)m_commands.size(); ++i) {
+			if (NetCommandList::isEqualCommandMsg(m_commands[i].m_msg, msg)) {
+				return;
+			}
+		}
 	}
 
-	// We don't need to worry about setting the relay since its not getting sent anywhere.
-	if (m_commandList->findMessage(msg) != NULL) {
-		// We don't want to add the same command twice.
-		return;
+	// Put the command where NetCommandList::addMessage would have: by type, then player, then sort
+	// number, and in front of any command it ties with. Commands nearly always arrive in order, so
+	// this is almost always an append.
+	FrameCommand cmd;
+	cmd.m_type = msg->getNetCommandType();
+	cmd.m_playerID = msg->getPlayerID();
+	cmd.m_sortNumber = msg->getSortNumber();
+	cmd.m_msg = msg;
+	msg->attach();
+
+	if (m_commands.empty() || isFrameCommandBefore(m_commands.back(), cmd)) {
+		m_commands.push_back(cmd);
+	} else {
+		m_commands.insert(std::lower_bound(m_commands.begin(), m_commands.end(), cmd, isFrameCommandBefore), cmd);
 	}
-	m_commandList->addMessage(msg);
 
 	++m_commandCount;
 	//DEBUG_LOG(("added command %d, type = %d(%s), command count = %d, frame command count = %d\n", msg->getID(), msg->getNetCommandType(), GetAsciiNetCommandType(msg->getNetCommandType()).str(), m_commandCount, m_frameCommandCount));
 }
 
 /**
- * Return the list of commands for this frame
+ * Return the number of commands held for this frame.
  */
-NetCommandList * FrameData::getCommandList() {
-	return m_commandList;
+Int FrameData::getNumCommands() {
+	return (Int)m_commands.size();
+}
+
+/**
+ * Return one of the commands for this frame, in the order a NetCommandList would hold them.
+ */
+NetCommandMsg * FrameData::getCommand(Int index) {
+	return m_commands[index].m_msg;
+}
+
+/**
+ * Returns true if a goes before b in a NetCommandList.
+ */
+Bool FrameData::isFrameCommandBefore(const FrameCommand &a, const FrameCommand &b) {
+	if (a.m_type != b.m_type) {
+		return a.m_type < b.m_type;
+	}
+	if (a.m_playerID != b.m_playerID) {
+		return a.m_playerID < b.m_playerID;
+	}
+	return a.m_sortNumber < b.m_sortNumber;
+}
+
+/**
+ * Let go of all the commands, keeping the storage for the next frame that uses this one.
+ */
+void FrameData::clearCommands() {
+	for (Int i = 0; i < (Int)m_commands.size(); ++i) {
+		m_commands[i].m_msg->detach();
+	}
+	m_commands.clear();
+	m_commandIDKeys.clear();
 }
 
 /**
@@ -196,10 +240,6 @@ void FrameData::zeroFrame() {
  * destroy all the commands in this frame.
  */
 void FrameData::destroyGameMessages() {
-	if (m_commandList == NULL) {
-		return;
-	}
-
-	m_commandList->reset();
+	clearCommands();
 	m_commandCount = 0;
 }
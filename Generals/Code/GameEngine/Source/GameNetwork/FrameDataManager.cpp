@@ -109,11 +109,19 @@ FrameDataReturnType FrameDataManager::allCommandsReady(UnsignedInt frame, Bool d
 }
 
 /**
- * Returns the command list for the given frame.
+ * Returns the number of commands held for the given frame.
  */
-NetCommandList * FrameDataManager::getFrameCommandList(UnsignedInt frame) {
+Int FrameDataManager::getNumFrameCommands(UnsignedInt frame) {
 	UnsignedInt frameindex = frame % FRAME_DATA_LENGTH;
-	return m_frameData[frameindex].getCommandList();
+	return m_frameData[frameindex].getNumCommands();
+}
+
+/**
+ * Returns one of the commands for the given frame, in command list order.
+ */
+NetCommandMsg * FrameDataManager::getFrameCommand(UnsignedInt frame, Int index) {
+	UnsignedInt frameindex = frame % FRAME_DATA_LENGTH;
+	return m_frameData[frameindex].getCommand(index);
 }
 
 /**
@@ -205,3 +213,163 @@ UnsignedInt FrameDataManager::getQuitFrame() {
 Bool FrameDataManager::getIsQuitting() {
 	return m_isQuitting;
 }
+
+//-------------------------------------------------------------------------------------------------
+// Stress benchmark
+//-------------------------------------------------------------------------------------------------
+
+static UnsignedInt benchmarkRandom(UnsignedInt &seed, UnsignedInt range) {
+	seed = seed * 1664525 + 1013904223;
+	return (seed >> 8) % range;
+}
+
+static UnsignedInt checksumFrameCommands(UnsignedInt checksum, NetCommandList *list) {
+	for (NetCommandRef *ref = list->getFirstMessage(); ref != NULL; ref = ref->getNext()) {
+		NetCommandMsg *cmd = ref->getCommand();
+		checksum = checksum * 31 + ((cmd->getNetCommandType() << 24) ^ (cmd->getPlayerID() << 16) ^ cmd->getID());
+	}
+	return checksum;
+}
+
+/**
+ * Every frame, each of 8 players sends a burst of 0 to 2*commandsPerFrame game commands and the
+ * frame info that counts them. Packets from different players interleave, a player's own commands
+ * now and then arrive out of order, and about one in ten is a resend. The commands are added to
+ * one FrameDataManager per player, the frame is checked for readiness and merged into one command
+ * list the way ConnectionManager::getFrameCommandList does, and the frame is reset. Only that is
+ * timed, not making the commands. The same arrivals are then run through a NetCommandList per
+ * player, with the findMessage check FrameData used to do, as the baseline.
+ */
+void FrameDataManager::runStressBenchmark(Int commandsPerFrame, FrameDataBenchmarkResult *result) {
+	enum { NUM_PLAYERS = 8, NUM_FRAMES = 3000 };
+
+	result->m_frames = NUM_FRAMES;
+	result->m_players = NUM_PLAYERS;
+	result->m_commands = 0;
+	result->m_deliveries = 0;
+	result->m_elapsedMS = 0;
+	result->m_checksum = 0;
+	result->m_listElapsedMS = 0;
+	result->m_listChecksum = 0;
+
+	FrameDataManager *managers[NUM_PLAYERS];
+	NetCommandList *lists[NUM_PLAYERS];
+	std::vector<NetCommandMsg *> sent[NUM_PLAYERS];	// this frame's commands from each player
+	std::vector<NetCommandMsg *> arrivals;					// all of them in the order they arrive, with resends
+	UnsignedShort nextID[NUM_PLAYERS];
+	Int next[NUM_PLAYERS];
+	Int p;
+
+	for (p = 0; p < NUM_PLAYERS; ++p) {
+		managers[p] = newInstance(FrameDataManager)(FALSE);
+		managers[p]->init();
+		lists[p] = newInstance(NetCommandList);
+		lists[p]->init();
+		nextID[p] = 0;
+	}
+
+	__int64 freq64, startTime64, endTime64;
+	__int64 frameDataTicks = 0;
+	__int64 listTicks = 0;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
+
+	UnsignedInt seed = 1;
+	for (UnsignedInt frame = 1; frame <= NUM_FRAMES; ++frame) {
+		Int remaining = 0;
+		for (p = 0; p < NUM_PLAYERS; ++p) {
+			sent[p].clear();
+			Int numCommands = benchmarkRandom(seed, 2 * commandsPerFrame + 1);
+			for (Int c = 0; c < numCommands; ++c) {
+				NetGameCommandMsg *msg = newInstance(NetGameCommandMsg);
+				msg->setExecutionFrame(frame);
+				msg->setPlayerID(p);
+				msg->setID(nextID[p]++);
+				sent[p].push_back(msg);
+			}
+			NetFrameCommandMsg *info = newInstance(NetFrameCommandMsg);
+			info->setExecutionFrame(frame);
+			info->setPlayerID(p);
+			info->setID(nextID[p]++);
+			info->setCommandCount(numCommands);
+			sent[p].push_back(info);
+
+			next[p] = 0;
+			remaining += sent[p].size();
+		}
+		result->m_commands += remaining;
+
+		arrivals.clear();
+		while (remaining > 0) {
+			p = benchmarkRandom(seed, NUM_PLAYERS);
+			Int c = next[p];
+			if (c >= (Int)sent[p].size()) {
+				continue;
+			}
+			if (c + 1 < (Int)sent[p].size() && benchmarkRandom(seed, 8) == 0) {
+				std::swap(sent[p][c], sent[p][c + 1]);
+			}
+			arrivals.push_back(sent[p][c]);
+			++next[p];
+			--remaining;
+			if (benchmarkRandom(seed, 10) == 0) {
+				arrivals.push_back(arrivals[benchmarkRandom(seed, arrivals.size())]);
+			}
+		}
+		result->m_deliveries += arrivals.size();
+
+		Int i;
+		NetCommandList *merged = newInstance(NetCommandList);
+		merged->init();
+		QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
+		for (i = 0; i < (Int)arrivals.size(); ++i) {
+			managers[arrivals[i]->getPlayerID()]->addNetCommandMsg(arrivals[i]);
+		}
+		for (p = 0; p < NUM_PLAYERS; ++p) {
+			managers[p]->setFrameCommandCount(frame, sent[p].size());
+			FrameDataReturnType ready = managers[p]->allCommandsReady(frame, FALSE);
+			DEBUG_ASSERTCRASH(ready == FRAMEDATA_READY, ("FrameDataManager::runStressBenchmark - frame %d isn't ready", frame));
+			Int numCommands = managers[p]->getNumFrameCommands(frame);
+			for (Int c = 0; c < numCommands; ++c) {
+				merged->addMessage(managers[p]->getFrameCommand(frame, c));
+			}
+			managers[p]->resetFrame(frame);
+		}
+		QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
+		frameDataTicks += endTime64 - startTime64;
+		result->m_checksum = checksumFrameCommands(result->m_checksum, merged);
+		merged->deleteInstance();
+
+		merged = newInstance(NetCommandList);
+		merged->init();
+		QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
+		for (i = 0; i < (Int)arrivals.size(); ++i) {
+			NetCommandList *list = lists[arrivals[i]->getPlayerID()];
+			if (list->findMessage(arrivals[i]) == NULL) {
+				list->addMessage(arrivals[i]);
+			}
+		}
+		for (p = 0; p < NUM_PLAYERS; ++p) {
+			merged->appendList(lists[p]);
+			lists[p]->reset();
+		}
+		QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
+		listTicks += endTime64 - startTime64;
+		result->m_listChecksum = checksumFrameCommands(result->m_listChecksum, merged);
+		merged->deleteInstance();
+
+		for (p = 0; p < NUM_PLAYERS; ++p) {
+			for (i = 0; i < (Int)sent[p].size(); ++i) {
+				sent[p][i]->detach();
+			}
+		}
+	}
+
+	for (p = 0; p < NUM_PLAYERS; ++p) {
+		managers[p]->deleteInstance();
+		lists[p]->deleteInstance();
+	}
+
+	result->m_elapsedMS = (UnsignedInt)(frameDataTicks * 1000 / freq64);
+	result->m_listElapsedMS = (UnsignedInt)(listTicks * 1000 / freq64);
+	DEBUG_ASSERTCRASH(result->m_checksum == result->m_listChecksum, ("FrameDataManager::runStressBenchmark - frame data put the commands in a different order than NetCommandList"));
+}
@@ -390,6 +390,8 @@ void BuddyThreadClass::Thread_Function()
 	} catch ( ... ) {
 		DEBUG_CRASH(("Exception in buddy thread!"));
 	}
+
+	releaseThreadMemoryPoolMagazines();
 }
 
 void BuddyThreadClass::errorCallback( GPConnection *con, GPErrorArg *arg )
@@ -286,6 +286,8 @@ void GameResultsThreadClass::Thread_Function()
 	} catch ( ... ) {
 		DEBUG_CRASH(("Exception in results thread!"));
 	}
+
+	releaseThreadMemoryPoolMagazines();
 }
 
 //-------------------------------------------------------------------------
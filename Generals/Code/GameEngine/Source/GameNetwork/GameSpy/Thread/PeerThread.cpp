@@ -1770,6 +1770,8 @@ void PeerThreadClass::Thread_Function()
 		{
 		}
 	}
+
+	releaseThreadMemoryPoolMagazines();
 }
 
 static void qmProfileIDCallback( PEER peer, PEERBool success, const char *nick, int profileID, void *param )
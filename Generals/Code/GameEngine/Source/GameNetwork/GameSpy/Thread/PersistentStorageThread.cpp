@@ -1101,6 +1101,8 @@ void PSThreadClass::Thread_Function()
 	} catch ( ... ) {
 		DEBUG_CRASH(("Exception in storage thread!"));
 	}
+
+	releaseThreadMemoryPoolMagazines();
 }
 
 //-------------------------------------------------------------------------
@@ -326,6 +326,8 @@ void PingThreadClass::Thread_Function()
 	} catch ( ... ) {
 		DEBUG_CRASH(("Exception in ping thread!"));
 	}
+
+	releaseThreadMemoryPoolMagazines();
 }
 
 //-------------------------------------------------------------------------
@@ -66,7 +66,7 @@ void NetCommandMsg::attach() {
 void NetCommandMsg::detach() {
 	--m_referenceCount;
 	if (m_referenceCount == 0) {
-		deleteInstance();
+		releaseInstance();
 		return;
 	}
 	DEBUG_ASSERTCRASH(m_referenceCount > 0, ("Invalid reference count for NetCommandMsg")); // Just to make sure...
@@ -75,6 +75,13 @@ void NetCommandMsg::detach() {
 	}
 }
 
+/**
+ * Gets rid of a message nobody refers to any more.
+ */
+void NetCommandMsg::releaseInstance() {
+	deleteInstance();
+}
+
 /**
  * Returns the value by which this type of message should be sorted.
  */
@@ -86,6 +93,14 @@ Int NetCommandMsg::getSortNumber() {
 // NetGameCommandMsg
 //-------------------------------
 
+// Every game command that comes in over the network is decoded into a NetGameCommandMsg and let
+// go of a few frames later, so released ones are kept, argument storage and all, for the next
+// packets to decode into.
+enum { MAX_REUSABLE_GAME_COMMANDS = 256 };
+
+NetGameCommandMsg *NetGameCommandMsg::s_reusableList = NULL;
+Int NetGameCommandMsg::s_reusableCount = 0;
+
 /**
  * Constructor with no argument, sets everything to default values.
  */
@@ -100,6 +115,8 @@ NetGameCommandMsg::NetGameCommandMsg() : NetCommandMsg() {
 	m_commandType = NETCOMMANDTYPE_GAMECOMMAND;
 	m_argList = NULL;
 	m_argTail = NULL;
+	m_spareArgs = NULL;
+	m_nextReusable = NULL;
 }
 
 /**
@@ -107,6 +124,13 @@ NetGameCommandMsg::NetGameCommandMsg() : NetCommandMsg() {
  * Also copies all the arguments.
  */
 NetGameCommandMsg::NetGameCommandMsg(GameMessage *msg) : NetCommandMsg() {
+	m_argSize = 0;
+	m_numArgs = 0;
+	m_argList = NULL;
+	m_argTail = NULL;
+	m_spareArgs = NULL;
+	m_nextReusable = NULL;
+
 	m_commandType = NETCOMMANDTYPE_GAMECOMMAND;
 
 	m_type = msg->getType();
@@ -120,12 +144,76 @@ NetGameCommandMsg::NetGameCommandMsg(GameMessage *msg) : NetCommandMsg() {
  * Destructor
  */
 NetGameCommandMsg::~NetGameCommandMsg() {
-	GameMessageArgument *arg = m_argList;
+	clearArguments();
+	GameMessageArgument *arg = m_spareArgs;
 	while (arg != NULL) {
-		m_argList = m_argList->m_next;
+		m_spareArgs = m_spareArgs->m_next;
 		arg->deleteInstance();
-		arg = m_argList;
+		arg = m_spareArgs;
+	}
+}
+
+/**
+ * Returns a message with no arguments, as newInstance(NetGameCommandMsg) would, but takes it
+ * from the released messages if there are any.
+ */
+NetGameCommandMsg *NetGameCommandMsg::newReusableInstance() {
+	NetGameCommandMsg *msg = s_reusableList;
+	if (msg == NULL) {
+		return newInstance(NetGameCommandMsg);
+	}
+	s_reusableList = msg->m_nextReusable;
+	--s_reusableCount;
+
+	msg->m_nextReusable = NULL;
+	msg->m_timestamp = 0;
+	msg->m_executionFrame = 0;
+	msg->m_playerID = 0;
+	msg->m_id = 0;
+	msg->m_referenceCount = 1;
+	msg->m_commandType = NETCOMMANDTYPE_GAMECOMMAND;
+	msg->m_type = (GameMessage::Type)0;
+	return msg;
+}
+
+/**
+ * Deletes the released messages that are waiting to be reused.
+ */
+void NetGameCommandMsg::freeReusableInstances() {
+	while (s_reusableList != NULL) {
+		NetGameCommandMsg *msg = s_reusableList;
+		s_reusableList = msg->m_nextReusable;
+		msg->deleteInstance();
+	}
+	s_reusableCount = 0;
+}
+
+/**
+ * Keep the message for newReusableInstance, unless enough are kept already.
+ */
+void NetGameCommandMsg::releaseInstance() {
+	if (s_reusableCount >= MAX_REUSABLE_GAME_COMMANDS) {
+		deleteInstance();
+		return;
+	}
+	clearArguments();
+	m_nextReusable = s_reusableList;
+	s_reusableList = this;
+	++s_reusableCount;
+}
+
+/**
+ * Empties the argument list, keeping the arguments for addArgument to fill in again.
+ */
+void NetGameCommandMsg::clearArguments() {
+	if (m_argTail != NULL) {
+		m_argTail->m_next = m_spareArgs;
+		m_spareArgs = m_argList;
 	}
+	m_argList = NULL;
+	m_argTail = NULL;
+	m_numArgs = 0;
+	m_argSize = 0;
 }
 
 /**
@@ -133,20 +221,21 @@ NetGameCommandMsg::~NetGameCommandMsg() {
  */
 void NetGameCommandMsg::addArgument(const GameMessageArgumentDataType type, GameMessageArgumentType arg) 
 {
-	if (m_argTail == NULL) {
-		m_argList = newInstance(GameMessageArgument);	
-		m_argTail = m_argList;
-		m_argList->m_data = arg;
-		m_argList->m_type = type;
-		m_argList->m_next = NULL;
-		return;
+	GameMessageArgument *newArg = m_spareArgs;
+	if (newArg != NULL) {
+		m_spareArgs = newArg->m_next;
+	} else {
+		newArg = newInstance(GameMessageArgument);
 	}
-
-	GameMessageArgument *newArg = newInstance(GameMessageArgument);
 	newArg->m_data = arg;
 	newArg->m_type = type;
 	newArg->m_next = NULL;
-	m_argTail->m_next = newArg;
+
+	if (m_argTail == NULL) {
+		m_argList = newArg;
+	} else {
+		m_argTail->m_next = newArg;
+	}
 	m_argTail = newArg;
 }
 
@@ -216,6 +305,20 @@ void NetGameCommandMsg::setGameMessageType(GameMessage::Type type) {
 	m_type = type;
 }
 
+/**
+ * Returns the type of game message
+ */
+GameMessage::Type NetGameCommandMsg::getGameMessageType() {
+	return m_type;
+}
+
+/**
+ * Returns the head of the argument list, for walking the arguments without building a GameMessage.
+ */
+GameMessageArgument *NetGameCommandMsg::getFirstArgument() {
+	return m_argList;
+}
+
 AsciiString NetGameCommandMsg::getContentsAsAsciiString(void)
 {
 	AsciiString ret;
@@ -30,7 +30,23 @@
 #include "GameNetwork/NetCommandMsg.h"
 #include "GameNetwork/NetworkDefs.h"
 #include "GameNetwork/NetworkUtil.h"
-#include "GameNetwork/GameMessageParser.h"
+
+// Size on the wire of a single game message argument of each type, indexed by GameMessageArgumentDataType.
+// Arguments of unknown type can't be sent; the encoder asserts and drops them.
+static const UnsignedByte s_gameMessageArgumentSize[ARGUMENTDATATYPE_UNKNOWN] =
+{
+	sizeof(Int),					// ARGUMENTDATATYPE_INTEGER
+	sizeof(Real),					// ARGUMENTDATATYPE_REAL
+	sizeof(Bool),					// ARGUMENTDATATYPE_BOOLEAN
+	sizeof(ObjectID),			// ARGUMENTDATATYPE_OBJECTID
+	sizeof(DrawableID),		// ARGUMENTDATATYPE_DRAWABLEID
+	sizeof(UnsignedInt),	// ARGUMENTDATATYPE_TEAMID
+	sizeof(Coord3D),			// ARGUMENTDATATYPE_LOCATION
+	sizeof(ICoord2D),			// ARGUMENTDATATYPE_PIXEL
+	sizeof(IRegion2D),		// ARGUMENTDATATYPE_PIXELREGION
+	sizeof(UnsignedInt),	// ARGUMENTDATATYPE_TIMESTAMP
+	sizeof(WideChar)			// ARGUMENTDATATYPE_WIDECHAR
+};
 
 #ifdef _INTERNAL
 // for occasional debugging...
@@ -310,51 +326,87 @@ UnsignedInt NetPacket::GetGameCommandSize(NetCommandMsg *msg) {
 	msglen += sizeof(UnsignedShort) + sizeof(UnsignedByte); // command ID
 	msglen += sizeof(UnsignedByte); // the 'D' for the data section.
 
-	GameMessage *gmsg = cmdMsg->constructGameMessage();
-	GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
-
 	msglen += sizeof(GameMessage::Type);
-	msglen += sizeof(UnsignedByte);
-//	Int numTypes = parser->getNumTypes();
-	GameMessageParserArgumentType *arg = parser->getFirstArgumentType();
-	while (arg != NULL) {
-		msglen += 2 * sizeof(UnsignedByte); // for the type and number of args of that type declaration.
-		GameMessageArgumentDataType type = arg->getType();
-		if (type == ARGUMENTDATATYPE_INTEGER) {
-			msglen += arg->getArgCount() * sizeof(Int);
-		} else if (type == ARGUMENTDATATYPE_REAL) {
-			msglen += arg->getArgCount() * sizeof(Real);
-		} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
-			msglen += arg->getArgCount() * sizeof(Bool);
-		} else if (type == ARGUMENTDATATYPE_OBJECTID) {
-			msglen += arg->getArgCount() * sizeof(ObjectID);
-		} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
-			msglen += arg->getArgCount() * sizeof(DrawableID);
-		} else if (type == ARGUMENTDATATYPE_TEAMID) {
-			msglen += arg->getArgCount() * sizeof(UnsignedInt);
-		} else if (type == ARGUMENTDATATYPE_LOCATION) {
-			msglen += arg->getArgCount() * sizeof(Coord3D);
-		} else if (type == ARGUMENTDATATYPE_PIXEL) {
-			msglen += arg->getArgCount() * sizeof(ICoord2D);
-		} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
-			msglen += arg->getArgCount() * sizeof(IRegion2D);
-		} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
-			msglen += arg->getArgCount() * sizeof(UnsignedInt);
-		} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
-			msglen += arg->getArgCount() * sizeof(WideChar);
-		}
-		arg = arg->getNext();
-	}
-
-	parser->deleteInstance();
-	parser = NULL;
-
-	gmsg->deleteInstance();
-	gmsg = NULL;
+	msglen += GetGameMessageArgumentsSize(cmdMsg);
+
+	return msglen;
+}
+
+/**
+ * Returns the number of bytes the argument section of a game message takes up in a packet.
+ * This is the argument type count, the (type, count) declaration for each run of
+ * same-typed arguments, and the argument data itself.
+ */
+UnsignedInt NetPacket::GetGameMessageArgumentsSize(NetGameCommandMsg *msg) {
+	UnsignedInt msglen = sizeof(UnsignedByte); // for the number of argument types.
+
+	GameMessageArgumentDataType lasttype = ARGUMENTDATATYPE_UNKNOWN;
+	for (GameMessageArgument *arg = msg->getFirstArgument(); arg != NULL; arg = arg->m_next) {
+		GameMessageArgumentDataType type = arg->m_type;
+		if ((type < 0) || (type >= ARGUMENTDATATYPE_UNKNOWN)) {
+			DEBUG_CRASH(("Game message argument of unknown type %d can't be sent", (Int)type));
+			continue;
+		}
+		if (type != lasttype) {
+			msglen += 2 * sizeof(UnsignedByte); // for the type and number of args of that type declaration.
+			lasttype = type;
+		}
+		msglen += s_gameMessageArgumentSize[type];
+	}
 
 	return msglen;
 }
 
+/**
+ * Writes the argument section of a game message straight from the argument list of the
+ * NetGameCommandMsg into the buffer, returns the number of bytes written.
+ * Consecutive arguments of the same type are declared as a single (type, count) pair,
+ * exactly as GameMessageParser groups them.
+ */
+UnsignedInt NetPacket::FillBufferWithGameMessageArguments(UnsignedByte *buffer, NetGameCommandMsg *msg) {
+	UnsignedInt offset = 0;
+
+	// The number of argument types isn't known until the declarations are written, so patch it in afterwards.
+	UnsignedByte *numTypes = buffer + offset;
+	*numTypes = 0;
+	offset += sizeof(UnsignedByte);
+
+	GameMessageArgumentDataType lasttype = ARGUMENTDATATYPE_UNKNOWN;
+	UnsignedByte *argTypeCount = NULL;
+	GameMessageArgument *arg = msg->getFirstArgument();
+	for (; arg != NULL; arg = arg->m_next) {
+		GameMessageArgumentDataType type = arg->m_type;
+		if ((type < 0) || (type >= ARGUMENTDATATYPE_UNKNOWN)) {
+			DEBUG_CRASH(("Game message argument of unknown type %d can't be sent", (Int)type));
+			continue;
+		}
+		if (type != lasttype) {
+			buffer[offset] = (UnsignedByte)type;
+			offset += sizeof(UnsignedByte);
+
+			argTypeCount = buffer + offset;
+			*argTypeCount = 0;
+			offset += sizeof(UnsignedByte);
+
+			++(*numTypes);
+			lasttype = type;
+		}
+		++(*argTypeCount);
+	}
+
+	for (arg = msg->getFirstArgument(); arg != NULL; arg = arg->m_next) {
+		GameMessageArgumentDataType type = arg->m_type;
+		if ((type < 0) || (type >= ARGUMENTDATATYPE_UNKNOWN)) {
+			continue;
+		}
+		// every member of the argument union starts at the beginning of the union.
+		memcpy(buffer + offset, &(arg->m_data), s_gameMessageArgumentSize[type]);
+		offset += s_gameMessageArgumentSize[type];
+	}
+
+	return offset;
+}
+
 UnsignedInt NetPacket::GetAckCommandSize(NetCommandMsg *msg) {
 	Int msglen = 0;
 	++msglen;
@@ -824,8 +876,6 @@ void NetPacket::FillBufferWithCommand(UnsignedByte *buffer, NetCommandRef *ref)
 void NetPacket::FillBufferWithGameCommand(UnsignedByte *buffer, NetCommandRef *msg) {
 	NetGameCommandMsg *cmdMsg = (NetGameCommandMsg *)(msg->getCommand());
 	UnsignedShort offset = 0;
-	// get the game message from the NetCommandMsg
-	GameMessage *gmsg = cmdMsg->constructGameMessage();
 
 	//DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("NetPacket::FillBufferWithGameCommand for command ID %d\n", cmdMsg->getID()));
 
@@ -866,79 +916,11 @@ void NetPacket::FillBufferWithGameCommand(UnsignedByte *buffer, NetCommandRef *m
 	++offset;
 
 	// Now copy the GameMessage type into the packet.
-	GameMessage::Type newType = gmsg->getType();
+	GameMessage::Type newType = cmdMsg->getGameMessageType();
 	memcpy(buffer + offset, &newType, sizeof(GameMessage::Type));
 	offset += sizeof(GameMessage::Type);
 
-
-	GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
-	UnsignedByte numTypes = parser->getNumTypes();
-	memcpy(buffer + offset, &numTypes, sizeof(numTypes));
-	offset += sizeof(numTypes);
-
-	GameMessageParserArgumentType *argType = parser->getFirstArgumentType();
-	while (argType != NULL) {
-		UnsignedByte type = (UnsignedByte)(argType->getType());
-		memcpy(buffer + offset, &type, sizeof(type));
-		offset += sizeof(type);
-
-		UnsignedByte argTypeCount = argType->getArgCount();
-		memcpy(buffer + offset, &argTypeCount, sizeof(argTypeCount));
-		offset += sizeof(argTypeCount);
-
-		argType = argType->getNext();
-	}
-
-	Int numArgs = gmsg->getArgumentCount();
-	for (Int i = 0; i < numArgs; ++i) {
-		GameMessageArgumentDataType type = gmsg->getArgumentDataType(i);
-		GameMessageArgumentType arg = *(gmsg->getArgument(i));
-//		writeGameMessageArgumentToPacket(type, arg);
-
-		if (type == ARGUMENTDATATYPE_INTEGER) {
-			memcpy(buffer + offset, &(arg.integer), sizeof(arg.integer));
-			offset += sizeof(arg.integer);
-		} else if (type == ARGUMENTDATATYPE_REAL) {
-			memcpy(buffer + offset, &(arg.real), sizeof(arg.real));
-			offset += sizeof(arg.real);
-		} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
-			memcpy(buffer + offset, &(arg.boolean), sizeof(arg.boolean));
-			offset += sizeof(arg.boolean);
-		} else if (type == ARGUMENTDATATYPE_OBJECTID) {
-			memcpy(buffer + offset, &(arg.objectID), sizeof(arg.objectID));
-			offset += sizeof(arg.objectID);
-		} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
-			memcpy(buffer + offset, &(arg.drawableID), sizeof(arg.drawableID));
-			offset += sizeof(arg.drawableID);
-		} else if (type == ARGUMENTDATATYPE_TEAMID) {
-			memcpy(buffer + offset, &(arg.teamID), sizeof(arg.teamID));
-			offset += sizeof(arg.teamID);
-		} else if (type == ARGUMENTDATATYPE_LOCATION) {
-			memcpy(buffer + offset, &(arg.location), sizeof(arg.location));
-			offset += sizeof(arg.location);
-		} else if (type == ARGUMENTDATATYPE_PIXEL) {
-			memcpy(buffer + offset, &(arg.pixel), sizeof(arg.pixel));
-			offset += sizeof(arg.pixel);
-		} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
-			memcpy(buffer + offset, &(arg.pixelRegion), sizeof(arg.pixelRegion));
-			offset += sizeof(arg.pixelRegion);
-		} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
-			memcpy(buffer + offset, &(arg.timestamp), sizeof(arg.timestamp));
-			offset += sizeof(arg.timestamp);
-		} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
-			memcpy(buffer + offset, &(arg.wChar), sizeof(arg.wChar));
-			offset += sizeof(arg.wChar);
-		}
-	}
-
-	parser->deleteInstance();
-	parser = NULL;
-
-//		DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("NetPacket::addGameMessage - added game message, frame %d, player %d, command ID %d\n", m_lastFrame, m_lastPlayerID, m_lastCommandID));
-
-	if (gmsg)
-		gmsg->deleteInstance();
-	gmsg = NULL;
+	offset += FillBufferWithGameMessageArguments(buffer + offset, cmdMsg);
 }
 
 void NetPacket::FillBufferWithAckCommand(UnsignedByte *buffer, NetCommandRef *msg) {
@@ -4695,12 +4677,10 @@ Bool NetPacket::isAckStage2Repeat(NetCommandRef *msg) {
 Bool NetPacket::addGameCommand(NetCommandRef *msg) {
 	Bool retval = FALSE;
 	NetGameCommandMsg *cmdMsg = (NetGameCommandMsg *)(msg->getCommand());
-	// get the game message from the NetCommandMsg
-	GameMessage *gmsg = cmdMsg->constructGameMessage();
 
 //	DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("NetPacket::addGameCommand for command ID %d\n", cmdMsg->getID()));
 
-	if (isRoomForGameMessage(msg, gmsg)) {
+	if (isRoomForGameMessage(msg)) {
 		// Now we know there is enough room, put the new game message into the packet.
 
 		Bool needNewCommandID = FALSE; // this is to allow us to force the starting command ID to be respecified with this command.
@@ -4763,38 +4743,11 @@ Bool NetPacket::addGameCommand(NetCommandRef *msg) {
 		++m_packetLen;
 
 		// Now copy the GameMessage type into the packet.
-		GameMessage::Type newType = gmsg->getType();
+		GameMessage::Type newType = cmdMsg->getGameMessageType();
 		memcpy(m_packet + m_packetLen, &newType, sizeof(GameMessage::Type));
 		m_packetLen += sizeof(GameMessage::Type);
 
-
-		GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
-		UnsignedByte numTypes = parser->getNumTypes();
-		memcpy(m_packet + m_packetLen, &numTypes, sizeof(numTypes));
-		m_packetLen += sizeof(numTypes);
-
-		GameMessageParserArgumentType *argType = parser->getFirstArgumentType();
-		while (argType != NULL) {
-			UnsignedByte type = (UnsignedByte)(argType->getType());
-			memcpy(m_packet + m_packetLen, &type, sizeof(type));
-			m_packetLen += sizeof(type);
-
-			UnsignedByte argTypeCount = argType->getArgCount();
-			memcpy(m_packet + m_packetLen, &argTypeCount, sizeof(argTypeCount));
-			m_packetLen += sizeof(argTypeCount);
-
-			argType = argType->getNext();
-		}
-
-		Int numArgs = gmsg->getArgumentCount();
-		for (Int i = 0; i < numArgs; ++i) {
-			GameMessageArgumentDataType type = gmsg->getArgumentDataType(i);
-			GameMessageArgumentType arg = *(gmsg->getArgument(i));
-			writeGameMessageArgumentToPacket(type, arg);
-		}
-
-		parser->deleteInstance();
-		parser = NULL;
+		m_packetLen += FillBufferWithGameMessageArguments(m_packet + m_packetLen, cmdMsg);
 
 //		DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("NetPacket::addGameMessage - added game message, frame %d, player %d, command ID %d\n", m_lastFrame, m_lastPlayerID, m_lastCommandID));
 
@@ -4810,55 +4763,13 @@ Bool NetPacket::addGameCommand(NetCommandRef *msg) {
 		retval = TRUE;
 	}
 
-	if (gmsg) {
-		gmsg->deleteInstance();
-		gmsg = NULL;
-	}
-
 	return retval;
 }
 
-void NetPacket::writeGameMessageArgumentToPacket(GameMessageArgumentDataType type, GameMessageArgumentType arg) {
-	if (type == ARGUMENTDATATYPE_INTEGER) {
-		memcpy(m_packet + m_packetLen, &(arg.integer), sizeof(arg.integer));
-		m_packetLen += sizeof(arg.integer);
-	} else if (type == ARGUMENTDATATYPE_REAL) {
-		memcpy(m_packet + m_packetLen, &(arg.real), sizeof(arg.real));
-		m_packetLen += sizeof(arg.real);
-	} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
-		memcpy(m_packet + m_packetLen, &(arg.boolean), sizeof(arg.boolean));
-		m_packetLen += sizeof(arg.boolean);
-	} else if (type == ARGUMENTDATATYPE_OBJECTID) {
-		memcpy(m_packet + m_packetLen, &(arg.objectID), sizeof(arg.objectID));
-		m_packetLen += sizeof(arg.objectID);
-	} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
-		memcpy(m_packet + m_packetLen, &(arg.drawableID), sizeof(arg.drawableID));
-		m_packetLen += sizeof(arg.drawableID);
-	} else if (type == ARGUMENTDATATYPE_TEAMID) {
-		memcpy(m_packet + m_packetLen, &(arg.teamID), sizeof(arg.teamID));
-		m_packetLen += sizeof(arg.teamID);
-	} else if (type == ARGUMENTDATATYPE_LOCATION) {
-		memcpy(m_packet + m_packetLen, &(arg.location), sizeof(arg.location));
-		m_packetLen += sizeof(arg.location);
-	} else if (type == ARGUMENTDATATYPE_PIXEL) {
-		memcpy(m_packet + m_packetLen, &(arg.pixel), sizeof(arg.pixel));
-		m_packetLen += sizeof(arg.pixel);
-	} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
-		memcpy(m_packet + m_packetLen, &(arg.pixelRegion), sizeof(arg.pixelRegion));
-		m_packetLen += sizeof(arg.pixelRegion);
-	} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
-		memcpy(m_packet + m_packetLen, &(arg.timestamp), sizeof(arg.timestamp));
-		m_packetLen += sizeof(arg.timestamp);
-	} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
-		memcpy(m_packet + m_packetLen, &(arg.wChar), sizeof(arg.wChar));
-		m_packetLen += sizeof(arg.wChar);
-	}
-}
-
 /**
  * Returns true if there is enough room in this packet for this message.
  */
-Bool NetPacket::isRoomForGameMessage(NetCommandRef *msg, GameMessage *gmsg) {
+Bool NetPacket::isRoomForGameMessage(NetCommandRef *msg) {
 	// Calculate how much space the NetCommandMsg will take in this packet.
 	Int msglen = 0;
 
@@ -4883,44 +4794,9 @@ Bool NetPacket::isRoomForGameMessage(NetCommandRef *msg, GameMessage *gmsg) {
 		msglen += sizeof(UnsignedShort) + sizeof(UnsignedByte);
 	}
 
-	GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
-
 	++msglen; // for 'D'
 	msglen += sizeof(GameMessage::Type);
-	msglen += sizeof(UnsignedByte);
-//	Int numTypes = parser->getNumTypes();
-	GameMessageParserArgumentType *arg = parser->getFirstArgumentType();
-	while (arg != NULL) {
-		msglen += 2 * sizeof(UnsignedByte); // for the type and number of args of that type declaration.
-		GameMessageArgumentDataType type = arg->getType();
-		if (type == ARGUMENTDATATYPE_INTEGER) {
-			msglen += arg->getArgCount() * sizeof(Int);
-		} else if (type == ARGUMENTDATATYPE_REAL) {
-			msglen += arg->getArgCount() * sizeof(Real);
-		} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
-			msglen += arg->getArgCount() * sizeof(Bool);
-		} else if (type == ARGUMENTDATATYPE_OBJECTID) {
-			msglen += arg->getArgCount() * sizeof(ObjectID);
-		} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
-			msglen += arg->getArgCount() * sizeof(DrawableID);
-		} else if (type == ARGUMENTDATATYPE_TEAMID) {
-			msglen += arg->getArgCount() * sizeof(UnsignedInt);
-		} else if (type == ARGUMENTDATATYPE_LOCATION) {
-			msglen += arg->getArgCount() * sizeof(Coord3D);
-		} else if (type == ARGUMENTDATATYPE_PIXEL) {
-			msglen += arg->getArgCount() * sizeof(ICoord2D);
-		} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
-			msglen += arg->getArgCount() * sizeof(IRegion2D);
-		} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
-			msglen += arg->getArgCount() * sizeof(UnsignedInt);
-		} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
-			msglen += arg->getArgCount() * sizeof(WideChar);
-		}
-		arg = arg->getNext();
-	}
-
-	parser->deleteInstance();
-	parser = NULL;
+	msglen += GetGameMessageArgumentsSize(cmdMsg);
 
 	// Is there enough room in the packet for this message?
 	if (msglen > (MAX_PACKET_SIZE - m_packetLen)) {
@@ -5201,7 +5077,7 @@ NetCommandList * NetPacket::getCommandList() {
  */
 NetCommandMsg * NetPacket::readGameMessage(UnsignedByte *data, Int &i) 
 {
-	NetGameCommandMsg *msg = newInstance(NetGameCommandMsg);
+	NetGameCommandMsg *msg = NetGameCommandMsg::newReusableInstance();
 
 //	DEBUG_LOG_LEVEL(DEBUG_LEVEL_NET, ("NetPacket::readGameMessage\n"));
 
@@ -5216,133 +5092,39 @@ NetCommandMsg * NetPacket::readGameMessage(UnsignedByte *data, Int &i)
 	memcpy(&numArgTypes, data + i, sizeof(numArgTypes));
 	i += sizeof(numArgTypes);
 
-	// Get the types and the number of arguments of those types.
-	Int totalArgCount = 0;
-	GameMessageParser *parser = newInstance(GameMessageParser)();
-	for (Int j = 0; j < numArgTypes; ++j) {
-		UnsignedByte type = (UnsignedByte)ARGUMENTDATATYPE_UNKNOWN;
-		memcpy(&type, data + i, sizeof(type));
-		i += sizeof(type);
+	// Get the types and the number of arguments of those types, then read the arguments
+	// for each declaration in turn.  The declarations all come before the argument data.
+	UnsignedByte argTypes[256];
+	UnsignedByte argCounts[256];
+	Int j = 0;
+	for (j = 0; j < numArgTypes; ++j) {
+		memcpy(&(argTypes[j]), data + i, sizeof(UnsignedByte));
+		i += sizeof(UnsignedByte);
 
-		UnsignedByte argCount = 0;
-		memcpy(&argCount, data + i, sizeof(argCount));
-		i += sizeof(argCount);
-
-		parser->addArgType((GameMessageArgumentDataType)type, argCount);
-		totalArgCount += argCount;
+		memcpy(&(argCounts[j]), data + i, sizeof(UnsignedByte));
+		i += sizeof(UnsignedByte);
 	}
 
-	GameMessageParserArgumentType *parserArgType = parser->getFirstArgumentType();
-	GameMessageArgumentDataType lasttype = ARGUMENTDATATYPE_UNKNOWN;
-	Int argsLeftForType = 0;
-	if (parserArgType != NULL) {
-		lasttype = parserArgType->getType();
-		argsLeftForType = parserArgType->getArgCount();
-	}
-	for (j = 0; j < totalArgCount; ++j) {
-		readGameMessageArgumentFromPacket(lasttype, msg, data, i);
-
-		--argsLeftForType;
-		if (argsLeftForType == 0) {
-			DEBUG_ASSERTCRASH(parserArgType != NULL, ("parserArgType was NULL when it shouldn't have been."));
-			if (parserArgType == NULL) {
-				return NULL;
-			}
-
-			parserArgType = parserArgType->getNext();
-			// parserArgType is allowed to be NULL here
-			if (parserArgType != NULL) {
-				argsLeftForType = parserArgType->getArgCount();
-				lasttype = parserArgType->getType();
-			}
+	for (j = 0; j < numArgTypes; ++j) {
+		GameMessageArgumentDataType type = (GameMessageArgumentDataType)argTypes[j];
+		for (Int k = 0; k < argCounts[j]; ++k) {
+			readGameMessageArgumentFromPacket(type, msg, data, i);
 		}
 	}
 
-	parser->deleteInstance();
-	parser = NULL;
-
 	return (NetCommandMsg *)msg;
 }
 
 void NetPacket::readGameMessageArgumentFromPacket(GameMessageArgumentDataType type, NetGameCommandMsg *msg, UnsignedByte *data, Int &i) {
-	if (type == ARGUMENTDATATYPE_INTEGER) {
-		GameMessageArgumentType arg;
-		Int theint;
-		memcpy(&theint, data + i, sizeof(theint));
-		i += sizeof(theint);
-		arg.integer = theint;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_REAL) {
-		GameMessageArgumentType arg;
-		Real thereal;
-		memcpy(&thereal, data + i, sizeof(thereal));
-		i += sizeof(thereal);
-		arg.real = thereal;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
-		GameMessageArgumentType arg;
-		Bool thebool;
-		memcpy(&thebool, data + i, sizeof(thebool));
-		i += sizeof(thebool);
-		arg.boolean = thebool;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_OBJECTID) {
-		GameMessageArgumentType arg;
-		ObjectID theint;
-		memcpy(&theint, data + i, sizeof(theint));
-		i += sizeof(theint);
-		arg.objectID = theint;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
-		GameMessageArgumentType arg;
-		DrawableID theint;
-		memcpy(&theint, data + i, sizeof(theint));
-		i += sizeof(theint);
-		arg.drawableID = theint;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_TEAMID) {
-		GameMessageArgumentType arg;
-		UnsignedInt theint;
-		memcpy(&theint, data + i, sizeof(theint));
-		i += sizeof(theint);
-		arg.teamID = theint;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_LOCATION) {
-		GameMessageArgumentType arg;
-		Coord3D coord;
-		memcpy(&coord, data + i, sizeof(coord));
-		i += sizeof(coord);
-		arg.location = coord;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_PIXEL) {
-		GameMessageArgumentType arg;
-		ICoord2D pixel;
-		memcpy(&pixel, data + i, sizeof(pixel));
-		i += sizeof(pixel);
-		arg.pixel = pixel;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
-		GameMessageArgumentType arg;
-		IRegion2D reg;
-		memcpy(&reg, data + i, sizeof(reg));
-		i += sizeof(reg);
-		arg.pixelRegion = reg;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
-		GameMessageArgumentType arg;
-		UnsignedInt stamp;
-		memcpy(&stamp, data + i, sizeof(stamp));
-		i += sizeof(stamp);
-		arg.timestamp = stamp;
-		msg->addArgument(type, arg);
-	} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
-		GameMessageArgumentType arg;
-		WideChar c;
-		memcpy(&c, data + i, sizeof(c));
-		i += sizeof(c);
-		arg.wChar = c;
-		msg->addArgument(type, arg);
+	if ((type < 0) || (type >= ARGUMENTDATATYPE_UNKNOWN)) {
+		return;
 	}
+
+	// every member of the argument union starts at the beginning of the union.
+	GameMessageArgumentType arg;
+	memcpy(&arg, data + i, s_gameMessageArgumentSize[type]);
+	i += s_gameMessageArgumentSize[type];
+	msg->addArgument(type, arg);
 }
 
 /**
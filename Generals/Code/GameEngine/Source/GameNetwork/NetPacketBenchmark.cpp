@@ -0,0 +1,507 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//																																						//
+//  (c) 2001-2003 Electronic Arts Inc.																				//
+//																																						//
+////////////////////////////////////////////////////////////////////////////////
+
+////////// NetPacketBenchmark.cpp ///////////////////////////
+// The game command round trip self test and codec benchmark for NetPacket. Both check the
+// encoder against the GameMessage/GameMessageParser encoding NetPacket used to have, which
+// lives on here as the baseline.
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+
+#include "Common/SelfTest.h"
+#include "GameNetwork/GameMessageParser.h"
+#include "GameNetwork/NetCommandMsg.h"
+#include "GameNetwork/NetCommandRef.h"
+#include "GameNetwork/NetPacket.h"
+
+/**
+ * A small deterministic random number generator, so every run makes the same commands.
+ */
+static Int benchmarkRandom(UnsignedInt &seed, Int range) {
+	seed = seed * 1664525 + 1013904223;
+	return (Int)((seed >> 8) % (UnsignedInt)range);
+}
+
+/**
+ * The size of an argument in a packet, the way the old encoder worked it out.
+ */
+static UnsignedInt baselineArgumentSize(GameMessageArgumentDataType type) {
+	if (type == ARGUMENTDATATYPE_INTEGER) {
+		return sizeof(Int);
+	} else if (type == ARGUMENTDATATYPE_REAL) {
+		return sizeof(Real);
+	} else if (type == ARGUMENTDATATYPE_BOOLEAN) {
+		return sizeof(Bool);
+	} else if (type == ARGUMENTDATATYPE_OBJECTID) {
+		return sizeof(ObjectID);
+	} else if (type == ARGUMENTDATATYPE_DRAWABLEID) {
+		return sizeof(DrawableID);
+	} else if (type == ARGUMENTDATATYPE_TEAMID) {
+		return sizeof(UnsignedInt);
+	} else if (type == ARGUMENTDATATYPE_LOCATION) {
+		return sizeof(Coord3D);
+	} else if (type == ARGUMENTDATATYPE_PIXEL) {
+		return sizeof(ICoord2D);
+	} else if (type == ARGUMENTDATATYPE_PIXELREGION) {
+		return sizeof(IRegion2D);
+	} else if (type == ARGUMENTDATATYPE_TIMESTAMP) {
+		return sizeof(UnsignedInt);
+	} else if (type == ARGUMENTDATATYPE_WIDECHAR) {
+		return sizeof(WideChar);
+	}
+	return 0;
+}
+
+/**
+ * Builds the GameMessage the old encoder built for every command it sized or wrote. The old
+ * code also looked the player up by name, which is left out here.
+ */
+static GameMessage *baselineGameMessage(NetGameCommandMsg *msg) {
+	GameMessage *gmsg = newInstance(GameMessage)(msg->getGameMessageType());
+	for (GameMessageArgument *arg = msg->getFirstArgument(); arg != NULL; arg = arg->m_next) {
+		if (arg->m_type == ARGUMENTDATATYPE_INTEGER) {
+			gmsg->appendIntegerArgument(arg->m_data.integer);
+		} else if (arg->m_type == ARGUMENTDATATYPE_REAL) {
+			gmsg->appendRealArgument(arg->m_data.real);
+		} else if (arg->m_type == ARGUMENTDATATYPE_BOOLEAN) {
+			gmsg->appendBooleanArgument(arg->m_data.boolean);
+		} else if (arg->m_type == ARGUMENTDATATYPE_OBJECTID) {
+			gmsg->appendObjectIDArgument(arg->m_data.objectID);
+		} else if (arg->m_type == ARGUMENTDATATYPE_DRAWABLEID) {
+			gmsg->appendDrawableIDArgument(arg->m_data.drawableID);
+		} else if (arg->m_type == ARGUMENTDATATYPE_TEAMID) {
+			gmsg->appendTeamIDArgument(arg->m_data.teamID);
+		} else if (arg->m_type == ARGUMENTDATATYPE_LOCATION) {
+			gmsg->appendLocationArgument(arg->m_data.location);
+		} else if (arg->m_type == ARGUMENTDATATYPE_PIXEL) {
+			gmsg->appendPixelArgument(arg->m_data.pixel);
+		} else if (arg->m_type == ARGUMENTDATATYPE_PIXELREGION) {
+			gmsg->appendPixelRegionArgument(arg->m_data.pixelRegion);
+		} else if (arg->m_type == ARGUMENTDATATYPE_TIMESTAMP) {
+			gmsg->appendTimestampArgument(arg->m_data.timestamp);
+		} else if (arg->m_type == ARGUMENTDATATYPE_WIDECHAR) {
+			gmsg->appendWideCharArgument(arg->m_data.wChar);
+		}
+	}
+	return gmsg;
+}
+
+/**
+ * The size of a game command with all of its header fields, as the old GetGameCommandSize had it.
+ */
+static UnsignedInt baselineGetGameCommandSize(NetGameCommandMsg *msg) {
+	UnsignedInt msglen = 0;
+	msglen += sizeof(UnsignedInt) + sizeof(UnsignedByte); // frame number
+	msglen += sizeof(UnsignedByte) + sizeof(UnsignedByte); // player ID
+	msglen += sizeof(UnsignedByte) + sizeof(UnsignedByte); // relay
+	msglen += sizeof(UnsignedByte) + sizeof(UnsignedByte); // command type
+	msglen += sizeof(UnsignedShort) + sizeof(UnsignedByte); // command ID
+	msglen += sizeof(UnsignedByte); // the 'D' for the data section.
+
+	GameMessage *gmsg = baselineGameMessage(msg);
+	GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
+
+	msglen += sizeof(GameMessage::Type);
+	msglen += sizeof(UnsignedByte);
+	for (GameMessageParserArgumentType *arg = parser->getFirstArgumentType(); arg != NULL; arg = arg->getNext()) {
+		msglen += 2 * sizeof(UnsignedByte); // for the type and number of args of that type declaration.
+		msglen += arg->getArgCount() * baselineArgumentSize(arg->getType());
+	}
+
+	parser->deleteInstance();
+	gmsg->deleteInstance();
+	return msglen;
+}
+
+/**
+ * Writes a game command with all of its header fields the way the old FillBufferWithGameCommand
+ * did, returns the number of bytes written.
+ */
+static UnsignedInt baselineFillBufferWithGameCommand(UnsignedByte *buffer, NetGameCommandMsg *msg, UnsignedByte relay) {
+	UnsignedInt offset = 0;
+	GameMessage *gmsg = baselineGameMessage(msg);
+
+	buffer[offset++] = 'T';
+	buffer[offset] = msg->getNetCommandType();
+	offset += sizeof(UnsignedByte);
+
+	buffer[offset++] = 'F';
+	UnsignedInt frame = msg->getExecutionFrame();
+	memcpy(buffer + offset, &frame, sizeof(UnsignedInt));
+	offset += sizeof(UnsignedInt);
+
+	buffer[offset++] = 'R';
+	buffer[offset] = relay;
+	offset += sizeof(UnsignedByte);
+
+	buffer[offset++] = 'P';
+	buffer[offset] = msg->getPlayerID();
+	offset += sizeof(UnsignedByte);
+
+	buffer[offset++] = 'C';
+	UnsignedShort id = msg->getID();
+	memcpy(buffer + offset, &id, sizeof(UnsignedShort));
+	offset += sizeof(UnsignedShort);
+
+	buffer[offset++] = 'D';
+	GameMessage::Type type = gmsg->getType();
+	memcpy(buffer + offset, &type, sizeof(GameMessage::Type));
+	offset += sizeof(GameMessage::Type);
+
+	GameMessageParser *parser = newInstance(GameMessageParser)(gmsg);
+	buffer[offset] = (UnsignedByte)parser->getNumTypes();
+	offset += sizeof(UnsignedByte);
+	for (GameMessageParserArgumentType *argType = parser->getFirstArgumentType(); argType != NULL; argType = argType->getNext()) {
+		buffer[offset] = (UnsignedByte)argType->getType();
+		offset += sizeof(UnsignedByte);
+		buffer[offset] = (UnsignedByte)argType->getArgCount();
+		offset += sizeof(UnsignedByte);
+	}
+
+	// the old encoder fetched each argument by index, walking the list from the start every time
+	Int numArgs = gmsg->getArgumentCount();
+	for (Int i = 0; i < numArgs; ++i) {
+		UnsignedInt size = baselineArgumentSize(gmsg->getArgumentDataType(i));
+		memcpy(buffer + offset, gmsg->getArgument(i), size);
+		offset += size;
+	}
+
+	parser->deleteInstance();
+	gmsg->deleteInstance();
+	return offset;
+}
+
+/**
+ * Reads back a command written by baselineFillBufferWithGameCommand the way the old
+ * ConstructNetCommandMsgFromRawData and readGameMessage did: a new message and a new argument
+ * for everything, and a GameMessageParser to hold the argument declarations.
+ */
+static NetGameCommandMsg *baselineReadGameCommand(UnsignedByte *data, UnsignedInt dataLength, UnsignedByte *relay) {
+	UnsignedInt frame = 0;
+	UnsignedByte playerID = 0;
+	UnsignedShort commandID = 0;
+	UnsignedInt i = 0;
+
+	while (i < dataLength) {
+		UnsignedByte field = data[i++];
+		if (field == 'T') {
+			i += sizeof(UnsignedByte);
+		} else if (field == 'R') {
+			*relay = data[i];
+			i += sizeof(UnsignedByte);
+		} else if (field == 'P') {
+			playerID = data[i];
+			i += sizeof(UnsignedByte);
+		} else if (field == 'C') {
+			memcpy(&commandID, data + i, sizeof(UnsignedShort));
+			i += sizeof(UnsignedShort);
+		} else if (field == 'F') {
+			memcpy(&frame, data + i, sizeof(UnsignedInt));
+			i += sizeof(UnsignedInt);
+		} else if (field == 'D') {
+			break;
+		}
+	}
+
+	NetGameCommandMsg *msg = newInstance(NetGameCommandMsg);
+	msg->setExecutionFrame(frame);
+	msg->setPlayerID(playerID);
+	msg->setID(commandID);
+
+	GameMessage::Type type;
+	memcpy(&type, data + i, sizeof(GameMessage::Type));
+	i += sizeof(GameMessage::Type);
+	msg->setGameMessageType(type);
+
+	UnsignedByte numArgTypes = data[i];
+	i += sizeof(UnsignedByte);
+
+	GameMessageParser *parser = newInstance(GameMessageParser)();
+	Int j;
+	for (j = 0; j < numArgTypes; ++j) {
+		parser->addArgType((GameMessageArgumentDataType)data[i], data[i + 1]);
+		i += 2 * sizeof(UnsignedByte);
+	}
+	for (GameMessageParserArgumentType *argType = parser->getFirstArgumentType(); argType != NULL; argType = argType->getNext()) {
+		UnsignedInt size = baselineArgumentSize(argType->getType());
+		for (j = 0; j < argType->getArgCount(); ++j) {
+			GameMessageArgumentType arg;
+			memcpy(&arg, data + i, size);
+			i += size;
+			msg->addArgument(argType->getType(), arg);
+		}
+	}
+	parser->deleteInstance();
+
+	return msg;
+}
+
+/**
+ * Makes a game command with a random argument list. Arguments come in runs of one type, like
+ * real commands, so the run-length declarations get exercised.
+ */
+static NetGameCommandMsg *makeRandomGameCommand(UnsignedInt &seed, Int maxArgs) {
+	NetGameCommandMsg *msg = newInstance(NetGameCommandMsg);
+	msg->setGameMessageType((GameMessage::Type)(GameMessage::MSG_BEGIN_NETWORK_MESSAGES + benchmarkRandom(seed, 64)));
+
+	Int numArgs = benchmarkRandom(seed, maxArgs + 1);
+	while (numArgs > 0) {
+		GameMessageArgumentDataType type = (GameMessageArgumentDataType)benchmarkRandom(seed, ARGUMENTDATATYPE_UNKNOWN);
+		Int run = 1 + benchmarkRandom(seed, 4);
+		for (; run > 0 && numArgs > 0; --run, --numArgs) {
+			GameMessageArgumentType arg;
+			UnsignedByte *bytes = (UnsignedByte *)&arg;
+			for (Int b = 0; b < (Int)sizeof(arg); ++b) {
+				bytes[b] = (UnsignedByte)benchmarkRandom(seed, 256);
+			}
+			if (type == ARGUMENTDATATYPE_BOOLEAN) {
+				arg.boolean = (arg.integer & 1) ? TRUE : FALSE;
+			}
+			msg->addArgument(type, arg);
+		}
+	}
+	return msg;
+}
+
+/**
+ * Returns true if the two game commands have the same header fields and arguments.
+ */
+static Bool isSameGameCommand(NetGameCommandMsg *a, NetGameCommandMsg *b) {
+	if (a->getExecutionFrame() != b->getExecutionFrame() || a->getPlayerID() != b->getPlayerID() ||
+			a->getID() != b->getID() || a->getGameMessageType() != b->getGameMessageType()) {
+		return FALSE;
+	}
+	GameMessageArgument *argA = a->getFirstArgument();
+	GameMessageArgument *argB = b->getFirstArgument();
+	for (; argA != NULL && argB != NULL; argA = argA->m_next, argB = argB->m_next) {
+		if (argA->m_type != argB->m_type || memcmp(&argA->m_data, &argB->m_data, baselineArgumentSize(argA->m_type)) != 0) {
+			return FALSE;
+		}
+	}
+	return (argA == NULL && argB == NULL);
+}
+
+/**
+ * Folds a decoded game command into a checksum.
+ */
+static UnsignedInt checksumGameCommand(UnsignedInt checksum, NetGameCommandMsg *msg, UnsignedByte relay) {
+	checksum = checksum * 31 + msg->getExecutionFrame();
+	checksum = checksum * 31 + ((msg->getPlayerID() << 24) | (relay << 16) | msg->getID());
+	checksum = checksum * 31 + msg->getGameMessageType();
+	for (GameMessageArgument *arg = msg->getFirstArgument(); arg != NULL; arg = arg->m_next) {
+		checksum = checksum * 31 + arg->m_type;
+		UnsignedByte *bytes = (UnsignedByte *)&arg->m_data;
+		UnsignedInt size = baselineArgumentSize(arg->m_type);
+		for (UnsignedInt b = 0; b < size; ++b) {
+			checksum = checksum * 31 + bytes[b];
+		}
+	}
+	return checksum;
+}
+
+/**
+ * Random game commands go through the whole packet path: into a NetPacket with addCommand,
+ * with the header fields it leaves out when they repeat, and back out with getCommandList.
+ * Each command is also written on its own, and must come out byte for byte the same as the
+ * GameMessageParser encoding and decode back to the same command. Decoded commands are let go
+ * as soon as they're checked, so later packets decode into reused messages.
+ */
+Bool NetPacket::runRoundTripSelfTest(AsciiString *failure) {
+	enum { NUM_PACKETS = 500, MAX_ARGS = 40 };
+
+	UnsignedInt seed = 1;
+	// a command with a lot of arguments can be bigger than a packet; those get wrapped when they're sent
+	UnsignedByte buffer[MAX_MESSAGE_LEN];
+	UnsignedByte baseline[MAX_MESSAGE_LEN];
+	UnsignedShort nextID[MAX_SLOTS];
+	UnsignedInt frame = 1;
+	Bool passed = TRUE;
+	Int i;
+
+	for (i = 0; i < MAX_SLOTS; ++i) {
+		nextID[i] = 1;
+	}
+
+	for (Int p = 0; p < NUM_PACKETS && passed; ++p) {
+		NetPacket *packet = newInstance(NetPacket);
+		std::vector<NetCommandRef *> sent;
+
+		for (;;) {
+			if (benchmarkRandom(seed, 4) == 0) {
+				frame += 1 + benchmarkRandom(seed, 3);
+			}
+			Int player = benchmarkRandom(seed, MAX_SLOTS);
+			if (benchmarkRandom(seed, 8) == 0) {
+				nextID[player] += 1 + benchmarkRandom(seed, 100);
+			}
+
+			NetGameCommandMsg *msg = makeRandomGameCommand(seed, MAX_ARGS);
+			msg->setExecutionFrame(frame);
+			msg->setPlayerID(player);
+			msg->setID(nextID[player]);
+			NetCommandRef *ref = NEW_NETCOMMANDREF(msg);
+			ref->setRelay((UnsignedByte)benchmarkRandom(seed, 256));
+			msg->detach();
+
+			// on its own, against the old encoding
+			UnsignedInt length = GetBufferSizeNeededForCommand(msg);
+			UnsignedInt baselineLength = baselineGetGameCommandSize(msg);
+			FillBufferWithCommand(buffer, ref);
+			UnsignedInt written = baselineFillBufferWithGameCommand(baseline, msg, ref->getRelay());
+			if (length != baselineLength || length != written || memcmp(buffer, baseline, length) != 0) {
+				failure->format("packet %d: command %d from player %d doesn't encode the way GameMessageParser did", p, msg->getID(), player);
+				passed = FALSE;
+			}
+			NetCommandRef *decoded = ConstructNetCommandMsgFromRawData(buffer, (UnsignedShort)length);
+			if (passed && (decoded == NULL || decoded->getRelay() != ref->getRelay() ||
+					!isSameGameCommand((NetGameCommandMsg *)decoded->getCommand(), msg))) {
+				failure->format("packet %d: command %d from player %d doesn't decode back to itself", p, msg->getID(), player);
+				passed = FALSE;
+			}
+			if (decoded != NULL) {
+				decoded->deleteInstance();
+			}
+
+			if (!passed || !packet->addCommand(ref)) {
+				ref->deleteInstance();
+				break;
+			}
+			++nextID[player];
+			sent.push_back(ref);
+		}
+
+		// and back out of the packet
+		NetCommandList *list = packet->getCommandList();
+		if (passed && list->length() != (Int)sent.size()) {
+			failure->format("packet %d: %d commands went in, %d came out", p, (Int)sent.size(), list->length());
+			passed = FALSE;
+		}
+		for (NetCommandRef *ref = list->getFirstMessage(); ref != NULL && passed; ref = ref->getNext()) {
+			NetGameCommandMsg *msg = (NetGameCommandMsg *)ref->getCommand();
+			for (i = 0; i < (Int)sent.size(); ++i) {
+				NetGameCommandMsg *original = (NetGameCommandMsg *)sent[i]->getCommand();
+				if (original->getPlayerID() == msg->getPlayerID() && original->getID() == msg->getID()) {
+					break;
+				}
+			}
+			if (i == (Int)sent.size() || sent[i]->getRelay() != ref->getRelay() ||
+					!isSameGameCommand(msg, (NetGameCommandMsg *)sent[i]->getCommand())) {
+				failure->format("packet %d: command %d from player %d came out of the packet different", p, msg->getID(), msg->getPlayerID());
+				passed = FALSE;
+			}
+		}
+		list->deleteInstance();
+
+		for (i = 0; i < (Int)sent.size(); ++i) {
+			sent[i]->deleteInstance();
+		}
+		packet->deleteInstance();
+	}
+
+	NetGameCommandMsg::freeReusableInstances();
+	return passed;
+}
+
+/**
+ * Encodes and decodes the given number of game commands one at a time, the way
+ * FillBufferWithCommand and ConstructNetCommandMsgFromRawData handle them, and then does the
+ * same with the GameMessage/GameMessageParser encoding NetPacket used before. The commands
+ * come from a fixed set of 1024 random ones with up to 12 arguments; making them isn't timed.
+ */
+void NetPacket::runCodecBenchmark(Int commands, NetPacketBenchmarkResult *result) {
+	enum { NUM_COMMANDS = 1024, MAX_ARGS = 12 };
+
+	result->m_commands = commands;
+	result->m_arguments = 0;
+	result->m_bytes = 0;
+	result->m_elapsedMS = 0;
+	result->m_checksum = 0;
+	result->m_baselineElapsedMS = 0;
+	result->m_baselineChecksum = 0;
+
+	NetCommandRef *refs[NUM_COMMANDS];
+	UnsignedInt seed = 1;
+	Int i;
+	for (i = 0; i < NUM_COMMANDS; ++i) {
+		NetGameCommandMsg *msg = makeRandomGameCommand(seed, MAX_ARGS);
+		msg->setExecutionFrame(1 + i / 8);
+		msg->setPlayerID(i % 8);
+		msg->setID(i);
+		refs[i] = NEW_NETCOMMANDREF(msg);
+		refs[i]->setRelay((UnsignedByte)benchmarkRandom(seed, 256));
+		msg->detach();
+	}
+
+	UnsignedByte buffer[MAX_MESSAGE_LEN];
+	__int64 freq64, startTime64, endTime64;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
+
+	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
+	for (i = 0; i < commands; ++i) {
+		NetCommandRef *ref = refs[i % NUM_COMMANDS];
+		UnsignedInt length = GetBufferSizeNeededForCommand(ref->getCommand());
+		FillBufferWithCommand(buffer, ref);
+		NetCommandRef *decoded = ConstructNetCommandMsgFromRawData(buffer, (UnsignedShort)length);
+		result->m_checksum = checksumGameCommand(result->m_checksum, (NetGameCommandMsg *)decoded->getCommand(), decoded->getRelay());
+		decoded->deleteInstance();
+		result->m_bytes += length;
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
+	result->m_elapsedMS = (UnsignedInt)((endTime64 - startTime64) * 1000 / freq64);
+
+	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
+	for (i = 0; i < commands; ++i) {
+		NetCommandRef *ref = refs[i % NUM_COMMANDS];
+		NetGameCommandMsg *msg = (NetGameCommandMsg *)ref->getCommand();
+		UnsignedInt length = baselineGetGameCommandSize(msg);
+		baselineFillBufferWithGameCommand(buffer, msg, ref->getRelay());
+		UnsignedByte relay = 0;
+		NetGameCommandMsg *decoded = baselineReadGameCommand(buffer, length, &relay);
+		result->m_baselineChecksum = checksumGameCommand(result->m_baselineChecksum, decoded, relay);
+		decoded->deleteInstance();
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
+	result->m_baselineElapsedMS = (UnsignedInt)((endTime64 - startTime64) * 1000 / freq64);
+
+	for (i = 0; i < commands; ++i) {
+		for (GameMessageArgument *arg = ((NetGameCommandMsg *)refs[i % NUM_COMMANDS]->getCommand())->getFirstArgument(); arg != NULL; arg = arg->m_next) {
+			++result->m_arguments;
+		}
+	}
+	for (i = 0; i < NUM_COMMANDS; ++i) {
+		refs[i]->deleteInstance();
+	}
+	NetGameCommandMsg::freeReusableInstances();
+
+	DEBUG_ASSERTCRASH(result->m_checksum == result->m_baselineChecksum, ("NetPacket::runCodecBenchmark - the game commands didn't decode the same as with GameMessageParser"));
+}
+
+//-------------------------------------------------------------------------------------------------
+static Bool netPacketRoundTripSelfTest( AsciiString *failure )
+{
+	return NetPacket::runRoundTripSelfTest(failure);
+}
+static SelfTestRegistration theNetPacketRoundTripSelfTest( "NetPacketRoundTrip", netPacketRoundTripSelfTest );
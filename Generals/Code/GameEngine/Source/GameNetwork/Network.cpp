@@ -303,6 +303,7 @@ Bool Network::deinit( void )
 		delete m_conMgr;
 		m_conMgr = NULL;
 	}
+	NetGameCommandMsg::freeReusableInstances();
 	if (m_messageWindow) {
 		TheWindowManager->winDestroy(m_messageWindow);
 		m_messageWindow = NULL;
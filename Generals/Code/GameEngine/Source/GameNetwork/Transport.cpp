@@ -76,6 +76,8 @@ Transport::Transport(void)
 {
 	m_winsockInit = false;
 	m_udpsock = NULL;
+	m_outHead = 0;
+	m_outCount = 0;
 }
 
 Transport::~Transport(void)
@@ -139,6 +141,8 @@ Bool Transport::init( UnsignedInt ip, UnsignedShort port )
 		m_delayedInBuffer[i].message.length = 0;
 #endif
 	}
+	m_outHead = 0;
+	m_outCount = 0;
 	for (i=0; i<MAX_TRANSPORT_STATISTICS_SECONDS; ++i)
 	{
 		m_incomingBytes[i] = 0;
@@ -218,35 +222,52 @@ Bool Transport::doSend() {
 		m_unknownBytes[m_statisticsSlot] = 0;
 	}
 
-	// Send all messages
+	// Send all messages, oldest first.  Anything that couldn't be written stays queued, in order,
+	// at the front of the ring.
 	int i;
-	for (i=0; i<MAX_MESSAGES; ++i)
+	Int sendCount = m_outCount;
+	Int keptCount = 0;
+	for (Int n=0; n<sendCount; ++n)
 	{
-		if (m_outBuffer[i].length != 0)
+		i = (m_outHead + n) % MAX_MESSAGES;
+
+		int bytesSent = 0;
+		// Send this message
+		if ((bytesSent = m_udpsock->Write((unsigned char *)(&m_outBuffer[i]), m_outBuffer[i].length + sizeof(TransportMessageHeader), m_outBuffer[i].addr, m_outBuffer[i].port)) > 0)
 		{
-			int bytesSent = 0;
-			// Send this message
-			if ((bytesSent = m_udpsock->Write((unsigned char *)(&m_outBuffer[i]), m_outBuffer[i].length + sizeof(TransportMessageHeader), m_outBuffer[i].addr, m_outBuffer[i].port)) > 0)
-			{
-				//DEBUG_LOG(("Sending %d bytes to %d:%d\n", m_outBuffer[i].length + sizeof(TransportMessageHeader), m_outBuffer[i].addr, m_outBuffer[i].port));
-				m_outgoingPackets[m_statisticsSlot]++;
-				m_outgoingBytes[m_statisticsSlot] += m_outBuffer[i].length + sizeof(TransportMessageHeader);
-				m_outBuffer[i].length = 0;  // Remove from queue
-//				DEBUG_LOG(("Transport::doSend - sent %d butes to %d.%d.%d.%d:%d\n", bytesSent,
-//					(m_outBuffer[i].addr >> 24) & 0xff,
-//					(m_outBuffer[i].addr >> 16) & 0xff,
-//					(m_outBuffer[i].addr >> 8) & 0xff,
-//					m_outBuffer[i].addr & 0xff,
-//					m_outBuffer[i].port));
-			}
-			else
+			//DEBUG_LOG(("Sending %d bytes to %d:%d\n", m_outBuffer[i].length + sizeof(TransportMessageHeader), m_outBuffer[i].addr, m_outBuffer[i].port));
+			m_outgoingPackets[m_statisticsSlot]++;
+			m_outgoingBytes[m_statisticsSlot] += m_outBuffer[i].length + sizeof(TransportMessageHeader);
+			m_outBuffer[i].length = 0;  // Remove from queue
+//			DEBUG_LOG(("Transport::doSend - sent %d butes to %d.%d.%d.%d:%d\n", bytesSent,
+//				(m_outBuffer[i].addr >> 24) & 0xff,
+//				(m_outBuffer[i].addr >> 16) & 0xff,
+//				(m_outBuffer[i].addr >> 8) & 0xff,
+//				m_outBuffer[i].addr & 0xff,
+//				m_outBuffer[i].port));
+		}
+		else
+		{
+			//DEBUG_LOG(("Could not write to socket!!!  Not discarding message!\n"));
+			retval = FALSE;
+			//DEBUG_LOG(("Transport::doSend returning FALSE\n"));
+
+			// keep it, packed up behind the other unsent ones
+			Int keep = (m_outHead + keptCount) % MAX_MESSAGES;
+			if (keep != i)
 			{
-				//DEBUG_LOG(("Could not write to socket!!!  Not discarding message!\n"));
-				retval = FALSE;
-				//DEBUG_LOG(("Transport::doSend returning FALSE\n"));
+				memcpy(&m_outBuffer[keep], &m_outBuffer[i], sizeof(TransportMessageHeader) + m_outBuffer[i].length);
+				m_outBuffer[keep].length = m_outBuffer[i].length;
+				m_outBuffer[keep].addr = m_outBuffer[i].addr;
+				m_outBuffer[keep].port = m_outBuffer[i].port;
+				m_outBuffer[i].length = 0;
 			}
+			++keptCount;
 		}
-	} // for (i=0; i<MAX_MESSAGES; ++i)
+	}
+	m_outCount = keptCount;
+	if (m_outCount == 0)
+		m_outHead = 0;
 
 #if defined(_DEBUG) || defined(_INTERNAL)
 	// Latency simulation - deliver anything we're holding on to that is ready
@@ -289,8 +310,12 @@ Bool Transport::doRecv()
 	UnsignedInt now = timeGetTime();
 #endif
 
-	TransportMessage incomingMessage;
-	unsigned char *buf = (unsigned char *)&incomingMessage;
+	// Packets are read straight into the slot they'll be handed out from.  If there's no room 
+	// they still have to come off the socket, so they go into a scratch message and are dropped.
+	TransportMessage scratchMessage;
+	Int incomingSlot = getFreeIncomingSlot( 0 );
+	TransportMessage *incoming = getIncomingSlotMessage( incomingSlot, &scratchMessage );
+	unsigned char *buf = (unsigned char *)incoming;
 	int len = MAX_MESSAGE_LEN;
 //	DEBUG_LOG(("Transport::doRecv - checking\n"));
 	while ( (len=m_udpsock->Read(buf, MAX_MESSAGE_LEN, &from)) > 0 )
@@ -315,57 +340,48 @@ Bool Transport::doRecv()
 //		DEBUG_LOG(("\n"));
 		decryptBuf(buf, len);
 
-		incomingMessage.length = len - sizeof(TransportMessageHeader);
+		// the slot stays free (length 0) until the packet has passed inspection
+		Int length = len - sizeof(TransportMessageHeader);
+		incoming->length = length;
+		Bool isValid = (len > sizeof(TransportMessageHeader) && isGeneralsPacket( incoming ));
+		incoming->length = 0;
 
-		if (len <= sizeof(TransportMessageHeader) || !isGeneralsPacket( &incomingMessage ))
+		if (!isValid)
 		{
 			m_unknownPackets[m_statisticsSlot]++;
 			m_unknownBytes[m_statisticsSlot] += len;
 			continue;
 		}
 
-		// Something there; stick it somewhere
+		// Something there; it's already in place, so just claim the slot
 //		DEBUG_LOG(("Saw %d bytes from %d:%d\n", len, ntohl(from.sin_addr.S_un.S_addr), ntohs(from.sin_port)));
 		m_incomingPackets[m_statisticsSlot]++;
 		m_incomingBytes[m_statisticsSlot] += len;
 
-		for (int i=0; i<MAX_MESSAGES; ++i)
+		if (incomingSlot < 0)
 		{
+			//DEBUG_CRASH(("Message lost!"));
+			continue;
+		}
+
 #if defined(_DEBUG) || defined(_INTERNAL)
-			// Latency simulation
-			if (m_useLatency)
-			{
-				if (m_delayedInBuffer[i].message.length == 0)
-				{
-					// Empty slot; use it
-					m_delayedInBuffer[i].deliveryTime =
-						now + TheGlobalData->m_latencyAverage +
-						(Int)(TheGlobalData->m_latencyAmplitude * sin(now * TheGlobalData->m_latencyPeriod)) +
-						GameClientRandomValue(-TheGlobalData->m_latencyNoise, TheGlobalData->m_latencyNoise);
-					m_delayedInBuffer[i].message.length = incomingMessage.length;
-					m_delayedInBuffer[i].message.addr = ntohl(from.sin_addr.S_un.S_addr);
-					m_delayedInBuffer[i].message.port = ntohs(from.sin_port);
-					memcpy(&m_delayedInBuffer[i].message, buf, len);
-					break;
-				}
-			}
-			else
-			{
-#endif
-				if (m_inBuffer[i].length == 0)
-				{
-					// Empty slot; use it
-					m_inBuffer[i].length = incomingMessage.length;
-					m_inBuffer[i].addr = ntohl(from.sin_addr.S_un.S_addr);
-					m_inBuffer[i].port = ntohs(from.sin_port);
-					memcpy(&m_inBuffer[i], buf, len);
-					break;
-				}
-#if defined(_DEBUG) || defined(_INTERNAL)
-			}
-#endif
+		// Latency simulation
+		if (m_useLatency)
+		{
+			m_delayedInBuffer[incomingSlot].deliveryTime =
+				now + TheGlobalData->m_latencyAverage +
+				(Int)(TheGlobalData->m_latencyAmplitude * sin(now * TheGlobalData->m_latencyPeriod)) +
+				GameClientRandomValue(-TheGlobalData->m_latencyNoise, TheGlobalData->m_latencyNoise);
 		}
-		//DEBUG_ASSERTCRASH(i<MAX_MESSAGES, ("Message lost!"));
+#endif
+		incoming->length = length;
+		incoming->addr = ntohl(from.sin_addr.S_un.S_addr);
+		incoming->port = ntohs(from.sin_port);
+
+		// move on to the next free slot; nothing before this one has come free in the meantime
+		incomingSlot = getFreeIncomingSlot( incomingSlot + 1 );
+		incoming = getIncomingSlotMessage( incomingSlot, &scratchMessage );
+		buf = (unsigned char *)incoming;
 	}
 
 	if (len == -1) {
@@ -387,33 +403,66 @@ Bool Transport::queueSend(UnsignedInt addr, UnsignedShort port, const UnsignedBy
 		return false;
 	}
 
-	for (i=0; i<MAX_MESSAGES; ++i)
+	if (m_outCount == MAX_MESSAGES)
 	{
-		if (m_outBuffer[i].length == 0)
+		return false;
+	}
+
+	// Insert data at the back of the ring
+	i = (m_outHead + m_outCount) % MAX_MESSAGES;
+	++m_outCount;
+
+	m_outBuffer[i].length = len;
+	memcpy(m_outBuffer[i].data, buf, len);
+	m_outBuffer[i].addr = addr;
+	m_outBuffer[i].port = port;
+//	m_outBuffer[i].header.flags = flags;
+//	m_outBuffer[i].header.id = id;
+	m_outBuffer[i].header.magic = GENERALS_MAGIC_NUMBER;
+
+	CRC crc;
+	crc.computeCRC( (unsigned char *)(&(m_outBuffer[i].header.magic)), m_outBuffer[i].length + sizeof(TransportMessageHeader) - sizeof(UnsignedInt) );
+//	DEBUG_LOG(("About to assign the CRC for the packet\n"));
+	m_outBuffer[i].header.crc = crc.get();
+
+	// Encrypt packet
+//	DEBUG_LOG(("buffer: "));
+	encryptBuf((unsigned char *)&m_outBuffer[i], len + sizeof(TransportMessageHeader));
+//	DEBUG_LOG(("\n"));
+
+	return true;
+}
+
+Int Transport::getFreeIncomingSlot( Int start )
+{
+	for (int i=start; i<MAX_MESSAGES; ++i)
+	{
+#if defined(_DEBUG) || defined(_INTERNAL)
+		// Latency simulation holds packets back first
+		if (m_useLatency)
 		{
-			// Insert data here
-			m_outBuffer[i].length = len;
-			memcpy(m_outBuffer[i].data, buf, len);
-			m_outBuffer[i].addr = addr;
-			m_outBuffer[i].port = port;
-//			m_outBuffer[i].header.flags = flags;
-//			m_outBuffer[i].header.id = id;
-			m_outBuffer[i].header.magic = GENERALS_MAGIC_NUMBER;
-
-			CRC crc;
-			crc.computeCRC( (unsigned char *)(&(m_outBuffer[i].header.magic)), m_outBuffer[i].length + sizeof(TransportMessageHeader) - sizeof(UnsignedInt) );
-//			DEBUG_LOG(("About to assign the CRC for the packet\n"));
-			m_outBuffer[i].header.crc = crc.get();
-
-			// Encrypt packet
-//			DEBUG_LOG(("buffer: "));
-			encryptBuf((unsigned char *)&m_outBuffer[i], len + sizeof(TransportMessageHeader));
-//			DEBUG_LOG(("\n"));
-
-			return true;
+			if (m_delayedInBuffer[i].message.length == 0)
+				return i;
+			continue;
 		}
+#endif
+		if (m_inBuffer[i].length == 0)
+			return i;
 	}
-	return false;
+	return -1;
+}
+
+TransportMessage *Transport::getIncomingSlotMessage( Int slot, TransportMessage *scratch )
+{
+	if (slot < 0)
+		return scratch;
+
+#if defined(_DEBUG) || defined(_INTERNAL)
+	if (m_useLatency)
+		return &m_delayedInBuffer[slot].message;
+#endif
+
+	return &m_inBuffer[slot];
 }
 
 Bool Transport::isGeneralsPacket( TransportMessage *msg )
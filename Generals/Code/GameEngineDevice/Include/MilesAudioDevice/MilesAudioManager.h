@@ -131,7 +131,7 @@ class AudioFileCache
 		const char *m_mutexName;
 };
 
-class MilesAudioManager : public AudioManager
+class MilesAudioManager : public AudioManager, public AudioRequestQueue::Processor
 {
 
 	public:
@@ -212,9 +212,9 @@ class MilesAudioManager : public AudioManager
 		virtual void processFadingList( void );
 		virtual void processStoppedList( void );
 
-		Bool shouldProcessRequestThisFrame( AudioRequest *req ) const;
-		void adjustRequest( AudioRequest *req );
-		Bool checkForSample( AudioRequest *req );
+		virtual Bool shouldProcessRequestThisFrame( AudioRequest *req ) const;
+		virtual void adjustRequest( AudioRequest *req );
+		virtual Bool checkForSample( AudioRequest *req );
 
 		virtual void setHardwareAccelerated(Bool accel);
 		virtual void setSpeakerSurround(Bool surround);
@@ -247,7 +247,7 @@ class MilesAudioManager : public AudioManager
 		void initDelayFilter( void );
 		Bool isValidProvider( void );
 		void initSamplePools( void );
-		void processRequest( AudioRequest *req );
+		virtual void processRequest( AudioRequest *req );
 
 		void playAudioEvent( AudioEventRTS *event );
 		void stopAudioEvent( AudioHandle handle );
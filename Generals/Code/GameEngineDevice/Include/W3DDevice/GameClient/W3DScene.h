@@ -37,12 +37,15 @@
 #define __W3DSCENE_H_
 
 // SYSTEM INCLUDES ////////////////////////////////////////////////////////////
+#include <vector>
+#include <hash_map>
 
 // USER INCLUDES //////////////////////////////////////////////////////////////
 #include "WW3D2/Scene.h"
 #include "WW3D2/RInfo.h"
 #include "WW3D2/Coltest.h"
 #include "WW3D2/lightenvironment.h"
+#include "WWMath/spherearray.h"
 ///////////////////////////////////////////////////////////////////////////////
 // PROTOTYPES /////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -74,6 +77,11 @@ public:
 	virtual void	Visibility_Check(CameraClass * camera);
 	virtual void  Render(RenderInfoClass & rinfo);
 
+	/// we keep our own packed copy of the render list for culling, so we follow what goes in and out
+	virtual void	Add_Render_Object(RenderObjClass * obj);
+	virtual void	Remove_Render_Object(RenderObjClass * obj);
+	virtual void	Remove_All_Render_Objects(void);
+
 	void setCustomPassMode (CustomScenePassModes mode) {m_customPassMode = mode;}
 	CustomScenePassModes getCustomPassMode (void)	{return m_customPassMode;}
 
@@ -108,6 +116,8 @@ protected:
 	void flagOccludedObjects(CameraClass * camera);
 	void flushOccludedObjectsIntoStencil(RenderInfoClass & rinfo);
 	void updatePlayerColorPasses(void);
+	void refreshCullSpheres(Bool skipHidden);
+	void compactCullObjects(void);
 
 protected:
 	RefRenderObjListClass	m_dynamicLightList;
@@ -137,6 +147,23 @@ protected:
 	Int m_numPotentialOccludees;
 	Int m_numNonOccluderOrOccludee;	
 
+	struct hashRenderObjPtr
+	{
+		size_t operator()(const RenderObjClass *p) const
+		{
+			std::hash<UnsignedInt> hasher;
+			return hasher((UnsignedInt)p);
+		}
+	};
+	typedef std::hash_map< const RenderObjClass *, Int, hashRenderObjPtr, std::equal_to<const RenderObjClass *> > CullSlotMap;
+
+	std::vector<RenderObjClass *> m_cullObjects;	///< every top-level render object in the scene, oldest first (RenderList is newest first); NULL where one was removed
+	SphereArrayClass m_cullSpheres;	///< bounding sphere of each of m_cullObjects, overwritten in place each check
+	std::vector<UnsignedByte> m_cullSkip;	///< nonzero if this check settled the object's visibility without a frustum test
+	CullSlotMap m_cullSlots;	///< where each render object is in m_cullObjects
+	Int m_cullHoles;	///< NULLs in m_cullObjects waiting for compactCullObjects
+	std::vector<Int> m_cullVisible;	///< indices into m_cullObjects that survived the frustum test
+
 	CameraClass *m_camera;
 };  // end class RTS3DScene
 
@@ -274,6 +274,7 @@ private:
 	void zoomCameraOneFrame(void);							///< Do one frame of a zoom camera movement.
 	void pitchCameraOneFrame(void);							///< Do one frame of a pitch camera movement.
 	void getAxisAlignedViewRegion(Region3D &axisAlignedRegion);	///< Find 3D Region enclosing all possible drawables.
+	Bool getScreenRegionWorldBounds(const IRegion2D *screenRegion, Region3D *worldRegion);	///< Find 3D Region enclosing all drawables that could project into a screen region.
 	void calcDeltaScroll(Coord2D &screenDelta);
 
 };  // end class W3DView
@@ -56,8 +56,6 @@ public:
 	virtual Bool loadMap( AsciiString filename , Bool query );
 	virtual void newMap( Bool saveGame );	///< Initialize the logic for new map.
 
-	virtual Real getGroundHeight( Real x, Real y, Coord3D* normal = NULL ) const;
-
 	virtual Bool isCliffCell( Real x, Real y) const;			///< is point cliff cell.
 
 	virtual Real getLayerHeight(Real x, Real y, PathfindLayerEnum layer, Coord3D* normal = NULL, Bool clip = true) const;
@@ -68,8 +66,6 @@ public:
 
 	virtual void getExtentIncludingBorder( Region3D *extent ) const;
 
-	virtual Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
-
 protected:
 
 	// snapshot methods
@@ -43,16 +43,26 @@ class Win32BIGFile : public ArchiveFile
 
 		virtual Bool					getFileInfo(const AsciiString& filename, FileInfo *fileInfo) const;	///< fill in the fileInfo struct with info about the requested file.
 		virtual File*					openFile( const Char *filename, Int access = 0 );///< Open the specified file within the BIG file
+		virtual File*					openArchivedFile( const ArchivedFileInfo *fileInfo, const Char *filename, Int access = 0 );	///< Open a file already looked up with getArchivedFileInfo
 		virtual void					closeAllFiles( void );									///< Close all file opened in this BIG file
 		virtual AsciiString		getName( void );												///< Returns the name of the BIG file
 		virtual AsciiString		getPath( void );												///< Returns full path and name of BIG file
 		virtual void					setSearchPriority( Int new_priority );	///< Set this BIG file's search priority
 		virtual void					close( void );													///< Close this BIG file
 
+		Bool									mapIntoMemory( const Char *path );			///< Map the whole BIG file read only so opened files can be views instead of copies
+		void									unmapFromMemory( void );								///< Release the mapping; no file opened from it may still be in use
+		Int										getMappedSize( void ) const { return m_mappedSize; }
+
 	protected:
 
 		AsciiString		m_name;		///< BIG file name
 		AsciiString		m_path;		///< BIG file path
+
+		HANDLE				m_fileHandle;			///< handle the mapping was created from
+		HANDLE				m_mappingHandle;	///< file mapping object
+		const Char		*m_mappedData;		///< base of the mapped view, NULL if not mapped
+		Int						m_mappedSize;			///< size of the mapped view in bytes
 };
 
 #endif // __WIN32BIGFILE_H
\ No newline at end of file
@@ -33,6 +33,11 @@
 
 #include "Common/ArchiveFileSystem.h"
 
+/** BIG archives are mapped read only into the address space when they are opened, so that
+	* files in them can be handed out without a copy. The total mapped size is capped (768MB by
+	* default, or the "MappedArchiveMB" registry value; 0 turns mapping off) to leave room in a
+	* 32 bit process for everything else. Archives that would go over the cap, or that fail
+	* to map, are read through their file handle exactly as they were before mapping existed. */
 class Win32BIGFileSystem : public ArchiveFileSystem
 {
 public:
@@ -55,6 +60,8 @@ public:
 	virtual Bool loadBigFilesFromDirectory(AsciiString dir, AsciiString fileMask, Bool overwrite = FALSE);
 protected:
 
+	Int m_mappedBytes;				///< address space currently given over to mapped BIG files
+	Int m_mappedBytesLimit;		///< m_mappedBytes may not grow past this
 };
 
 #endif // __WIN32BIGFILESYSTEM_H
\ No newline at end of file
@@ -587,18 +587,12 @@ void MilesAudioManager::pauseAudio( AudioAffect which )
 	}
 	
 	//Get rid of PLAY audio requests when pausing audio.
-	std::list<AudioRequest*>::iterator ait;
-	for (ait = m_audioRequests.begin(); ait != m_audioRequests.end(); /* empty */) 
+	for (Int i = 0; i < m_audioRequests.getSlotCount(); ++i) 
 	{
-		AudioRequest *req = (*ait);
+		AudioRequest *req = m_audioRequests.getRequest(i);
 		if( req && req->m_request == AR_Play ) 
 		{
-			req->deleteInstance();
-			ait = m_audioRequests.erase(ait);
-		}
-		else
-		{
-			ait++;
+			m_audioRequests.removeRequest(i);
 		}
 	}
 }
@@ -985,14 +979,12 @@ void MilesAudioManager::stopAudioEvent( AudioHandle handle )
 void MilesAudioManager::killAudioEventImmediately( AudioHandle audioEvent )
 {
 	//First look for it in the request list.
-	std::list<AudioRequest*>::iterator ait;
-	for( ait = m_audioRequests.begin(); ait != m_audioRequests.end(); ait++ ) 
+	for( Int i = 0; i < m_audioRequests.getSlotCount(); ++i ) 
 	{
-		AudioRequest *req = (*ait);
+		AudioRequest *req = m_audioRequests.getRequest(i);
 		if( req && req->m_request == AR_Play && req->m_handleToInteractOn == audioEvent ) 
 		{
-			req->deleteInstance();
-			ait = m_audioRequests.erase(ait);
+			m_audioRequests.removeRequest(i);
 			return;
 		}
 	}
@@ -1411,18 +1403,18 @@ Bool MilesAudioManager::hasMusicTrackCompleted( const AsciiString& trackName, In
 AsciiString MilesAudioManager::getMusicTrackName( void ) const
 {
 	// First check the requests. If there's one there, then report that as the currently playing track.
-	std::list<AudioRequest *>::const_iterator ait;
-	for (ait = m_audioRequests.begin(); ait != m_audioRequests.end(); ++ait) {
-		if ((*ait)->m_request != AR_Play) {
+	for (Int i = 0; i < m_audioRequests.getSlotCount(); ++i) {
+		const AudioRequest *req = m_audioRequests.getRequest(i);
+		if (req == NULL || req->m_request != AR_Play) {
 			continue;
 		}
 
-		if (!(*ait)->m_usePendingEvent) {
+		if (!req->m_usePendingEvent) {
 			continue;
 		}
 
-		if ((*ait)->m_pendingEvent->getAudioEventInfo()->m_soundType == AT_Music) {
-			return (*ait)->m_pendingEvent->getEventName();
+		if (req->m_eventInfo->m_soundType == AT_Music) {
+			return req->m_pendingEvent->getEventName();
 		}
 	}
 
@@ -1513,10 +1505,9 @@ Bool MilesAudioManager::isCurrentlyPlaying( AudioHandle handle )
 	}
 
 	// if something is requested, it is also considered playing
-	std::list<AudioRequest *>::iterator ait;
 	AudioRequest *req = NULL;
-	for (ait = m_audioRequests.begin(); ait != m_audioRequests.end(); ++ait) {
-		req = *ait;
+	for (Int i = 0; i < m_audioRequests.getSlotCount(); ++i) {
+		req = m_audioRequests.getRequest(i);
 		if (req && req->m_usePendingEvent && req->m_pendingEvent->getPlayingHandle() == handle) {
 			return true;
 		}
@@ -1857,21 +1848,8 @@ Bool MilesAudioManager::doesViolateLimit( AudioEventRTS *event ) const
 	}
 	
 	// Also check the request list in case we've requested to play this sound.
-	std::list<AudioRequest*>::const_iterator arIt;
-	for (arIt = m_audioRequests.begin(); arIt != m_audioRequests.end(); ++arIt) {
-		AudioRequest *req = (*arIt);
-		if (req == NULL) {
-			continue;
-		}
-		if( req->m_usePendingEvent ) 
-		{
-			if( req->m_pendingEvent->getEventName() == event->getEventName() ) 
-			{
-				totalRequestCount++;
-				totalCount++;
-			}
-		}
-	}
+	totalRequestCount = m_audioRequests.countRequestsToPlay(event->getAudioEventInfo());
+	totalCount += totalRequestCount;
 
 	//If our event is an interrupting type, then normally we would always add it. The exception is when we have requested
 	//multiple sounds in the same frame and those requests violate the limit. Because we don't have any "old" sounds to
@@ -2239,25 +2217,7 @@ void MilesAudioManager::removeAllDisabledAudio()
 //-------------------------------------------------------------------------------------------------
 void MilesAudioManager::processRequestList( void )
 {
-	std::list<AudioRequest*>::iterator it;
-	for (it = m_audioRequests.begin(); it != m_audioRequests.end(); /* empty */) {
-		AudioRequest *req = (*it);
-		if (req == NULL) {
-			continue;
-		}
-
-		if (!shouldProcessRequestThisFrame(req)) {
-			adjustRequest(req);
-			++it;
-			continue;
-		}
-
-		if (!req->m_requiresCheckForSample || checkForSample(req)) {
-			processRequest(req);
-		}
-		req->deleteInstance();
-		it = m_audioRequests.erase(it);
-	}
+	m_audioRequests.processRequests(this);
 }
 
 //-------------------------------------------------------------------------------------------------
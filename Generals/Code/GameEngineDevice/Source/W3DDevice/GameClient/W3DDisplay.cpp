@@ -217,6 +217,7 @@ void StatDumpClass::dumpStats()
 	UnsignedInt objCount = TheGameLogic->getObjectCount();
 	UnsignedInt objScreenCount = TheGameClient->getRenderedObjectCount();
 	fprintf( m_fp, "Objects: %d in world (%d onscreen)\n", objCount, objScreenCount );
+	fprintf( m_fp, "Drawables: %d updated, %d asleep\n", TheGameClient->getUpdatedDrawableCount(), TheGameClient->getSkippedDrawableCount() );
 
 	//AI stats
 	UnsignedInt numAI, numMoving, numAttacking, numWaitingForPath, overallFailedPathfinds;
@@ -1287,7 +1288,8 @@ void W3DDisplay::gatherDebugStats( void )
 		UnsignedInt objCount = TheGameLogic->getObjectCount();
 		UnsignedInt objScreenCount = TheGameClient->getRenderedObjectCount();
 
-		unibuffer.format(L"Objects: %d in world, %d being displayed", objCount, objScreenCount );
+		unibuffer.format(L"Objects: %d in world, %d being displayed, drawables: %d updated, %d asleep", objCount, objScreenCount,
+			TheGameClient->getUpdatedDrawableCount(), TheGameClient->getSkippedDrawableCount() );
 		m_displayStrings[Objects]->setText( unibuffer );
 
 		// Network incoming bandwidth stats
@@ -162,9 +162,35 @@ void W3DParticleSystemManager::doParticles(RenderInfoClass &rinfo)
 
 
 
+		// particles kept in the system's stream are written straight into our buffers
+		if (sys->isUsingParticleStream())
+		{
+			Coord3D boxCenter, boxExtent;
+			boxCenter.x = bcX;
+			boxCenter.y = bcY;
+			boxCenter.z = bcZ;
+			boxExtent.x = beX;
+			boxExtent.y = beY;
+			boxExtent.z = beZ;
+
+			count = sys->fillRenderBuffers( (Real *)posArray, (Real *)RGBAArray, sizeArray, angleArray, personalities,
+																			MAX_POINTS_PER_GROUP, &boxCenter, &boxExtent );
+
+			if (sys->getPriority() == AREA_EFFECT && sys->m_isGroundAligned != FALSE)
+				m_fieldParticleCount += count;
+		}
+
 		//set-up all the per-particle
-		for (Particle *p = sys->getFirstParticle(); p; p = p->m_systemNext)
+		Particle *firstParticle = NULL;
+		if (count < MAX_POINTS_PER_GROUP && sys->getParticleCount() > sys->getStreamParticleCount())
+			firstParticle = sys->getFirstParticle();
+
+		for (Particle *p = firstParticle; p; p = p->m_systemNext)
 		{
+			// already done above
+			if (p->m_streamIndex >= 0)
+				continue;
+
 			// do not attempt to render totally invisible particles
 			if (p->isInvisible())
 				continue;
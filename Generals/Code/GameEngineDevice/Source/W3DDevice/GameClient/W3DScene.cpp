@@ -40,6 +40,7 @@
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
+#include "Common/SelfTest.h"
 #include "GameLogic/Object.h"
 #include "GameLogic/GameLogic.h"
 #include "GameClient/Drawable.h"
@@ -63,6 +64,8 @@
 #include "WW3D2/shader.h"
 #include "WW3D2/DX8Caps.h"
 #include "WW3D2/colorspace.h"
+#include "WWMath/colmath.h"
+#include "WWMath/frustum.h"
 
 #ifdef _INTERNAL
 // for occasional debugging...
@@ -145,6 +148,7 @@ RTS3DScene::RTS3DScene()
 	m_numPotentialOccludees=0;
 	m_numNonOccluderOrOccludee=0;
 	m_occludedObjectsCount=0;
+	m_cullHoles=0;
 
 	m_potentialOccluders=NULL;
 	m_potentialOccludees=NULL;
@@ -368,6 +372,122 @@ Bool RTS3DScene::castRay(RayCollisionTestClass & raytest, Bool testAll, Int coll
 	return hit;
 }
 
+//=============================================================================
+// RTS3DScene::Add_Render_Object
+//=============================================================================
+/** Give each top-level render object a slot in m_cullObjects, so the per-frame
+  * cull doesn't have to walk RenderList and rebuild its arrays. */
+//=============================================================================
+void RTS3DScene::Add_Render_Object(RenderObjClass * obj)
+{
+	SimpleSceneClass::Add_Render_Object(obj);
+
+	if (m_cullSlots.find(obj) != m_cullSlots.end())
+	{
+		DEBUG_CRASH(("RTS3DScene::Add_Render_Object - render object added to the scene twice"));
+		return;
+	}
+	m_cullSlots[obj] = (Int)m_cullObjects.size();
+	m_cullObjects.push_back(obj);
+}
+
+//=============================================================================
+// RTS3DScene::Remove_Render_Object
+//=============================================================================
+/** Leave a hole where the object was, the next visibility check closes it up. */
+//=============================================================================
+void RTS3DScene::Remove_Render_Object(RenderObjClass * obj)
+{
+	CullSlotMap::iterator it = m_cullSlots.find(obj);
+	if (it != m_cullSlots.end())
+	{
+		m_cullObjects[it->second] = NULL;
+		m_cullSlots.erase(it);
+		++m_cullHoles;
+	}
+
+	// this has to be last, it may release the final reference to obj
+	SimpleSceneClass::Remove_Render_Object(obj);
+}
+
+//=============================================================================
+// RTS3DScene::Remove_All_Render_Objects
+//=============================================================================
+/** */
+//=============================================================================
+void RTS3DScene::Remove_All_Render_Objects(void)
+{
+	m_cullObjects.clear();
+	m_cullSkip.clear();
+	m_cullSlots.clear();
+	m_cullHoles = 0;
+	m_cullSpheres.Reset();
+
+	SimpleSceneClass::Remove_All_Render_Objects();
+}
+
+//=============================================================================
+// RTS3DScene::compactCullObjects
+//=============================================================================
+/** Squeeze the holes left by removed objects out of m_cullObjects, keeping the
+  * rest in the order they were added. */
+//=============================================================================
+void RTS3DScene::compactCullObjects(void)
+{
+	Int count = (Int)m_cullObjects.size();
+	Int kept = 0;
+	for (Int i = 0; i < count; ++i)
+	{
+		RenderObjClass *robj = m_cullObjects[i];
+		if (robj == NULL)
+			continue;
+		if (kept != i)
+		{
+			m_cullObjects[kept] = robj;
+			m_cullSlots[robj] = kept;
+		}
+		++kept;
+	}
+	m_cullObjects.resize(kept);
+	m_cullHoles = 0;
+}
+
+//=============================================================================
+// RTS3DScene::refreshCullSpheres
+//=============================================================================
+/** Bring m_cullSpheres up to date with the objects' current bounding spheres.
+  * Force-visible objects (and hidden ones, if skipHidden) don't need the frustum
+  * test, so they get their visibility set here and are flagged in m_cullSkip. */
+//=============================================================================
+void RTS3DScene::refreshCullSpheres(Bool skipHidden)
+{
+	if (m_cullHoles)
+		compactCullObjects();
+
+	Int count = (Int)m_cullObjects.size();
+	m_cullSpheres.Set_Count(count);
+	if ((Int)m_cullSkip.size() < count)
+		m_cullSkip.resize(count);
+	if ((Int)m_cullVisible.size() < count)
+		m_cullVisible.resize(count);
+
+	for (Int i = 0; i < count; ++i)
+	{
+		RenderObjClass *robj = m_cullObjects[i];
+
+		if (robj->Is_Force_Visible()) {
+			robj->Set_Visible(true);
+			m_cullSkip[i] = 1;
+		} else if (skipHidden && robj->Is_Hidden()) {
+			robj->Set_Visible(false);
+			m_cullSkip[i] = 1;
+		} else {
+			m_cullSpheres.Set(i, robj->Get_Bounding_Sphere());
+			m_cullSkip[i] = 0;
+		}
+	}
+}
+
 //=============================================================================
 // RTS3DScene::Visibility_Check
 //=============================================================================
@@ -380,10 +500,10 @@ void RTS3DScene::Visibility_Check(CameraClass * camera)
 	StDrawableDirtyStuffLocker lockDirtyStuff;
 #endif
 
-	RefRenderObjListIterator it(&RenderList);
 	DrawableInfo *drawInfo = NULL;
 	Drawable	*draw = NULL;
 	RenderObjClass * robj;
+	Int i;
 
 	m_numPotentialOccluders=0;
 	m_numPotentialOccludees=0;
@@ -395,16 +515,32 @@ void RTS3DScene::Visibility_Check(CameraClass * camera)
 	if (currentFrame <= TheGlobalData->m_defaultOcclusionDelay)
 		currentFrame = TheGlobalData->m_defaultOcclusionDelay+1;	//make sure occlusion is enabled when game starts (frame 0).
 
-
-	if (ShaderClass::Is_Backface_Culling_Inverted()) 
+	// Cull the bounding spheres of all top-level RenderObjects in this scene in one batch.  If a
+	// sphere is not in front of all the frustum planes, it is invisible.  Only the survivors
+	// are looked at any further.  The slots are oldest first, so walk them backwards to visit
+	// the objects in RenderList order.  Skipped slots hold a stale sphere, so whatever Cull said
+	// about them is ignored.
+	Bool reflectionPass = ShaderClass::Is_Backface_Culling_Inverted();
+	refreshCullSpheres(!reflectionPass);
+	Int numObjects = m_cullSpheres.Get_Count();
+	Int *visible = numObjects ? &m_cullVisible[0] : NULL;
+	Int numVisible = numObjects ? m_cullSpheres.Cull(camera->Get_Frustum(), visible) : 0;
+	Int nextVisible = numVisible - 1;
+
+	if (reflectionPass) 
 	{	//we are rendering reflections
 		///@todo: Have better flag to detect reflection pass
 
-		// Loop over all top-level RenderObjects in this scene. If the bounding sphere is not in front
-		// of all the frustum planes, it is invisible.
-		for (it.First(); !it.Is_Done(); it.Next()) {
+		for (i = numObjects - 1; i >= 0; i--) {
+
+			bool isVisible = (nextVisible >= 0 && visible[nextVisible] == i);
+			if (isVisible)
+				nextVisible--;
+
+			if (m_cullSkip[i])
+				continue;
 
-			robj = it.Peek_Obj();
+			robj = m_cullObjects[i];
 
 			draw=NULL;
 			drawInfo = (DrawableInfo *)robj->Get_User_Data();
@@ -413,85 +549,76 @@ void RTS3DScene::Visibility_Check(CameraClass * camera)
 
 			if( draw )
 			{
-				if (robj->Is_Force_Visible()) {
-					robj->Set_Visible(true);
-				} else {
-					robj->Set_Visible(draw->getDrawsInMirror() && !camera->Cull_Sphere(robj->Get_Bounding_Sphere()));
-				}
+				robj->Set_Visible(draw->getDrawsInMirror() && isVisible);
 			}
 			else
 			{	//perform normal culling on non-drawables
-				if (robj->Is_Force_Visible()) {
-					robj->Set_Visible(true);
-				} else {
-					robj->Set_Visible(!camera->Cull_Sphere(robj->Get_Bounding_Sphere()));
-				}
+				robj->Set_Visible(isVisible);
 			}
 		}
 	}
 	else
 	{
 
-		// Loop over all top-level RenderObjects in this scene. If the bounding sphere is not in front
-		// of all the frustum planes, it is invisible.
-		for (it.First(); !it.Is_Done(); it.Next()) {
+		for (i = numObjects - 1; i >= 0; i--) {
 
-			robj = it.Peek_Obj();
+			bool isVisible = (nextVisible >= 0 && visible[nextVisible] == i);
+			if (isVisible)
+				nextVisible--;
 
-			if (robj->Is_Force_Visible()) {
-				robj->Set_Visible(true);
-			} else if (robj->Is_Hidden()) {
+			if (m_cullSkip[i])
+				continue;
+
+			robj = m_cullObjects[i];
+
+			if (!isVisible) {
 				robj->Set_Visible(false);
-			} else {
-
-				bool isVisible=!camera->Cull_Sphere(robj->Get_Bounding_Sphere());
-
-				if (isVisible)
-				{	//need to keep track of occluders and ocludees for subsequent code.
-					drawInfo = (DrawableInfo *)robj->Get_User_Data();
-					if (drawInfo && (draw=drawInfo->m_drawable) != NULL)
-					{
-						if (draw->isDrawableEffectivelyHidden() || draw->getFullyObscuredByShroud())
-						{	robj->Set_Visible(false);
-							continue;
-						}
-						//assume normal rendering.
-						drawInfo->m_flags = DrawableInfo::ERF_IS_NORMAL;	//clear any rendering flags that may be in effect.
-
-						if (draw->getEffectiveOpacity() != 1.0f && m_translucentObjectsCount < TheGlobalData->m_maxVisibleTranslucentObjects)
-						{	drawInfo->m_flags = DrawableInfo::ERF_IS_TRANSLUCENT;	//object is translucent
-							m_translucentObjectsBuffer[m_translucentObjectsCount++] = robj;
-						}
-						else
-						if (TheGlobalData->m_enableBehindBuildingMarkers && TheGameLogic->getShowBehindBuildingMarkers())
-						{
-							//visible drawable. Check if it's either an occluder or occludee
-							if (draw->isKindOf(KINDOF_STRUCTURE) && m_numPotentialOccluders < TheGlobalData->m_maxVisibleOccluderObjects)
-							{	//object which could occlude other objects that need to be visible.
-								m_potentialOccluders[m_numPotentialOccluders++]=robj;
-								drawInfo->m_flags |= DrawableInfo::ERF_POTENTIAL_OCCLUDER;
-							}
-							else
-							if (draw->getObject() &&
-									(draw->isKindOf(KINDOF_SCORE) || draw->isKindOf(KINDOF_SCORE_CREATE) || draw->isKindOf(KINDOF_SCORE_DESTROY) || draw->isKindOf(KINDOF_MP_COUNT_FOR_VICTORY)) &&
-									(draw->getObject()->getSafeOcclusionFrame()) <= currentFrame && m_numPotentialOccludees < TheGlobalData->m_maxVisibleOccludeeObjects)
-							{	//object which could be occluded but still needs to be visible.
-								m_potentialOccludees[m_numPotentialOccludees++]=robj;
-								drawInfo->m_flags |= DrawableInfo::ERF_POTENTIAL_OCCLUDEE;
-							}
-							else
-							if (drawInfo->m_flags == DrawableInfo::ERF_IS_NORMAL && m_numNonOccluderOrOccludee < TheGlobalData->m_maxVisibleNonOccluderOrOccludeeObjects)
-							{	//regular object with no custom effects but still needs to be delayed to get the occlusion feature to work correctly.
-								m_nonOccludersOrOccludees[m_numNonOccluderOrOccludee++]=robj;
-								drawInfo->m_flags |= DrawableInfo::ERF_IS_NON_OCCLUDER_OR_OCCLUDEE;
-							}
-						}
-					}
+				continue;
+			}
+
+			//need to keep track of occluders and ocludees for subsequent code.
+			drawInfo = (DrawableInfo *)robj->Get_User_Data();
+			if (drawInfo && (draw=drawInfo->m_drawable) != NULL)
+			{
+				if (draw->isDrawableEffectivelyHidden() || draw->getFullyObscuredByShroud())
+				{	robj->Set_Visible(false);
+					continue;
 				}
+				//assume normal rendering.
+				drawInfo->m_flags = DrawableInfo::ERF_IS_NORMAL;	//clear any rendering flags that may be in effect.
 
-				robj->Set_Visible(isVisible);
+				if (draw->getEffectiveOpacity() != 1.0f && m_translucentObjectsCount < TheGlobalData->m_maxVisibleTranslucentObjects)
+				{	drawInfo->m_flags = DrawableInfo::ERF_IS_TRANSLUCENT;	//object is translucent
+					m_translucentObjectsBuffer[m_translucentObjectsCount++] = robj;
+				}
+				else
+				if (TheGlobalData->m_enableBehindBuildingMarkers && TheGameLogic->getShowBehindBuildingMarkers())
+				{
+					//visible drawable. Check if it's either an occluder or occludee
+					if (draw->isKindOf(KINDOF_STRUCTURE) && m_numPotentialOccluders < TheGlobalData->m_maxVisibleOccluderObjects)
+					{	//object which could occlude other objects that need to be visible.
+						m_potentialOccluders[m_numPotentialOccluders++]=robj;
+						drawInfo->m_flags |= DrawableInfo::ERF_POTENTIAL_OCCLUDER;
+					}
+					else
+					if (draw->getObject() &&
+							(draw->isKindOf(KINDOF_SCORE) || draw->isKindOf(KINDOF_SCORE_CREATE) || draw->isKindOf(KINDOF_SCORE_DESTROY) || draw->isKindOf(KINDOF_MP_COUNT_FOR_VICTORY)) &&
+							(draw->getObject()->getSafeOcclusionFrame()) <= currentFrame && m_numPotentialOccludees < TheGlobalData->m_maxVisibleOccludeeObjects)
+					{	//object which could be occluded but still needs to be visible.
+						m_potentialOccludees[m_numPotentialOccludees++]=robj;
+						drawInfo->m_flags |= DrawableInfo::ERF_POTENTIAL_OCCLUDEE;
+					}
+					else
+					if (drawInfo->m_flags == DrawableInfo::ERF_IS_NORMAL && m_numNonOccluderOrOccludee < TheGlobalData->m_maxVisibleNonOccluderOrOccludeeObjects)
+					{	//regular object with no custom effects but still needs to be delayed to get the occlusion feature to work correctly.
+						m_nonOccludersOrOccludees[m_numNonOccluderOrOccludee++]=robj;
+						drawInfo->m_flags |= DrawableInfo::ERF_IS_NON_OCCLUDER_OR_OCCLUDEE;
+					}
+				}
 			}
 
+			robj->Set_Visible(true);
+
 			///@todo: We're not using LOD yet so I disabled this code. MW
 			// Also, should check how multiple passes (reflections) get along
 			// with the LOD manager - we're rendering double the load it thinks we are.
@@ -505,6 +632,91 @@ void RTS3DScene::Visibility_Check(CameraClass * camera)
    Visibility_Checked = true;
 }
 
+//=============================================================================
+// sphereArrayCullSelfTest
+//=============================================================================
+/** SphereArrayClass::Cull (SSE or not) has to agree with what the plain
+  * CollisionMath frustum test says about each sphere.  Spheres that just graze
+  * a plane are left out of the comparison, since the SSE and x87 sums can
+  * round differently there.  Run with -selfTest. */
+//=============================================================================
+static Real sphereTestRandom(UnsignedInt &seed, Real lo, Real hi)
+{
+	seed = seed * 1664525 + 1013904223;
+	return lo + (hi - lo) * (Real)(seed >> 8) / (Real)(1 << 24);
+}
+
+static Bool sphereArrayCullSelfTest(AsciiString *failure)
+{
+	const Int NUM_SPHERES = 1003;	// not a multiple of four, so the tail gets tested too
+	const Int NUM_VIEWS = 8;
+
+	UnsignedInt seed = 12345;
+	SphereArrayClass spheres;
+	std::vector<SphereClass> source(NUM_SPHERES);
+	std::vector<Int> visible(NUM_SPHERES);
+	Int i;
+
+	spheres.Set_Count(NUM_SPHERES);
+	for (i = 0; i < NUM_SPHERES; ++i)
+	{
+		Vector3 center(sphereTestRandom(seed, -500.0f, 500.0f), sphereTestRandom(seed, -500.0f, 500.0f), sphereTestRandom(seed, -50.0f, 150.0f));
+		source[i] = SphereClass(center, sphereTestRandom(seed, 0.5f, 40.0f));
+		spheres.Set(i, source[i]);
+	}
+
+	// shrinking and growing again must not lose anything
+	spheres.Set_Count(NUM_SPHERES / 2);
+	spheres.Set_Count(NUM_SPHERES);
+
+	for (Int view = 0; view < NUM_VIEWS; ++view)
+	{
+		Matrix3D camera(true);
+		Vector3 eye(sphereTestRandom(seed, -300.0f, 300.0f), sphereTestRandom(seed, -300.0f, 300.0f), sphereTestRandom(seed, 100.0f, 400.0f));
+		Vector3 target(sphereTestRandom(seed, -100.0f, 100.0f), sphereTestRandom(seed, -100.0f, 100.0f), 0.0f);
+		camera.Look_At(eye, target, 0.0f);
+
+		FrustumClass frustum;
+		frustum.Init(camera, Vector2(-0.5f, -0.375f), Vector2(0.5f, 0.375f), 1.0f, sphereTestRandom(seed, 300.0f, 1000.0f));
+
+		Int numVisible = spheres.Cull(frustum, &visible[0]);
+		Int nextVisible = 0;
+		for (i = 0; i < NUM_SPHERES; ++i)
+		{
+			Bool culledVisible = (nextVisible < numVisible && visible[nextVisible] == i);
+			if (culledVisible)
+				++nextVisible;
+
+			Bool grazing = false;
+			for (Int p = 0; p < 6; ++p)
+			{
+				Real dist = Vector3::Dot_Product(source[i].Center, frustum.Planes[p].N) - frustum.Planes[p].D;
+				if (fabs(dist - source[i].Radius) < 0.01f)
+					grazing = true;
+			}
+			if (grazing)
+				continue;
+
+			Bool wantVisible = CollisionMath::Overlap_Test(frustum, source[i]) != CollisionMath::OUTSIDE;
+			if (culledVisible != wantVisible)
+			{
+				failure->format("view %d sphere %d: Cull says %s, Overlap_Test says %s", view, i,
+					culledVisible ? "visible" : "culled", wantVisible ? "visible" : "culled");
+				return false;
+			}
+		}
+
+		if (nextVisible != numVisible)
+		{
+			failure->format("view %d: Cull returned out of order or duplicate indices", view);
+			return false;
+		}
+	}
+
+	return true;
+}
+static SelfTestRegistration theSphereArrayCullSelfTest("SphereArrayCull", sphereArrayCullSelfTest);
+
 //============================================================================
 // RTS3DScene::renderSingleDrawable
 //=============================================================================
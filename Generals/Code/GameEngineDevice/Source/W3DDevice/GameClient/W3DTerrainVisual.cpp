@@ -41,6 +41,7 @@
 #include "Common/Xfer.h"
 #include "GameClient/Drawable.h"
 #include "GameLogic/Object.h"
+#include "GameLogic/TerrainLogic.h"
 #include "W3DDevice/GameClient/W3DScene.h"
 #include "W3DDevice/GameClient/W3DTerrainVisual.h"
 #include "W3DDevice/GameClient/WorldHeightMap.h"
@@ -577,6 +578,20 @@ void W3DTerrainVisual::setRawMapHeight(const ICoord2D *gridPos, Int height)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DTerrainVisual::setRawMapHeights(const UnsignedByte *heights, Int count)
+{
+	if (m_terrainHeightMap) {
+		Int len = m_terrainHeightMap->getXExtent()*m_terrainHeightMap->getYExtent();
+		if (len > count) {
+			len = count;
+		}
+		memcpy(m_terrainHeightMap->getDataPtr(), heights, len);
+		m_terrainRenderObject->staticLightingChanged();
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 void W3DTerrainVisual::addFactionBibDrawable(Drawable *factionBuilding, Bool highlight, Real extra)
@@ -740,13 +755,15 @@ void W3DTerrainVisual::crc( Xfer *xfer )
 // ------------------------------------------------------------------------------------------------
 /** Xfer
 	* Version Info:
-	* 1: Initial version */
+	* 1: Initial version
+	* 2: Terrain heights
+	* 3: Terrain heights moved to TerrainLogic */
 // ------------------------------------------------------------------------------------------------
 void W3DTerrainVisual::xfer( Xfer *xfer )
 {
 
 	// version
-	XferVersion currentVersion = 2;
+	XferVersion currentVersion = 3;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
@@ -798,9 +815,9 @@ void W3DTerrainVisual::xfer( Xfer *xfer )
 	}  // end if
 */
 
-	// Write out the terrain height data.
-	if (version >= 2) {
-		UnsignedByte *data = m_terrainHeightMap->getDataPtr();
+	// The terrain height data, from saves made before the terrain logic saved it.  Only ever 
+	// loaded, and handed to the terrain logic, which gives it back to us with the rest.
+	if (version == 2) {
 		Int len = m_terrainHeightMap->getXExtent()*m_terrainHeightMap->getYExtent();
 		Int xferLen = len;
 		xfer->xferInt(&xferLen);
@@ -810,11 +827,10 @@ void W3DTerrainVisual::xfer( Xfer *xfer )
 				len = xferLen;
 			}
 		}
+		UnsignedByte *data = MSGNEW("W3DTerrainVisual_xfer") UnsignedByte[len];
 		xfer->xferUser(data, len);	
-		if (xfer->getXferMode() == XFER_LOAD)	{	
-			// Update the display height map.
-			m_terrainRenderObject->staticLightingChanged();
-		}
+		TheTerrainLogic->setRawMapHeights(data, len);
+		delete [] data;
 	}
 
 }  // end xfer
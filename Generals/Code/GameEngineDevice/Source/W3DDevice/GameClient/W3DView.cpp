@@ -1103,8 +1103,7 @@ void W3DView::update(void)
 	Region3D axisAlignedRegion;
 	getAxisAlignedViewRegion(axisAlignedRegion);
 
-	// render all of the visible Drawables
-	/// @todo this needs to use a real region partition or something
+	// render all of the visible Drawables, the client's drawable grid limits this to what is nearby
 	if (WW3D::Get_Frame_Time())	//make sure some time actually elapsed
 		TheGameClient->iterateDrawablesInRegion( &axisAlignedRegion, drawDrawable, this );
 }
@@ -1782,119 +1781,182 @@ void W3DView::screenToWorld( const ICoord2D *s, Coord3D *w )
 }  // end screenToWorld
 
 //-------------------------------------------------------------------------------------------------
-/** all the drawables in the view, that fall within the 2D screen region
-	* will call the callback function.  The number of drawables that passed
-	* the test are returned.
-	Screen coordinates assumed in absolute values relative to full display resolution. */
+/** Everything iterateDrawablesInRegion needs to test a drawable handed to it by the game client */
 //-------------------------------------------------------------------------------------------------
-Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
-																			 Bool (*callback)( Drawable *draw, void *userData ),
-																			 void *userData )
+struct ScreenRegionIterateInfo
 {
-	Bool inside = FALSE;
-	Int count = 0;
-	Drawable *draw;
-	Vector3 screen, world;
-	Coord3D pos;
+	CameraClass *camera;
 	Region2D normalizedRegion;
+	Bool (*callback)( Drawable *draw, void *userData );
+	void *userData;
+	Int count;
+};
 
-	/** @todo we need to have partitions of which drawables are in the
-	view so we don't have to march through the whole list */
-
-	//
-	// to do this we are projecting the drawable centers onto the screen,
-	// the W3D camera->project method is used to do this and that method
-	// will return normalized screen coords from (-1,-1) bottom left to 
-	// (1,1) top right, normalize our screen region for comparison
-	//
-	/// @todo use fast int->real type casts here later
-
-	Bool regionIsPoint = FALSE;
+//-------------------------------------------------------------------------------------------------
+/** Project a candidate drawable to the screen and do the user callback if it lands in the region */
+//-------------------------------------------------------------------------------------------------
+static void iterateScreenRegionDrawable( Drawable *draw, void *userData )
+{
+	ScreenRegionIterateInfo *info = (ScreenRegionIterateInfo *)userData;
+	Vector3 screen, world;
 
-	if( screenRegion )
+	// project the center of the drawable to the screen
+	/// @todo use a real 3D position in the drawable
+	const Coord3D *pos = draw->getPosition();
+	world.X = pos->x;
+	world.Y = pos->y;
+	world.Z = pos->z;
+
+	// project the world point to the screen
+	if( info->camera->Project( screen, world ) == CameraClass::INSIDE_FRUSTUM &&
+			screen.X >= info->normalizedRegion.lo.x && 
+			screen.X <= info->normalizedRegion.hi.x &&
+			screen.Y >= info->normalizedRegion.lo.y && 
+			screen.Y <= info->normalizedRegion.hi.y )
 	{
-		if (screenRegion->height() == 0 && screenRegion->width() == 0)
-		{
-			regionIsPoint = TRUE;
-		} 
 
-		normalizedRegion.lo.x = ((Real)(screenRegion->lo.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
-		normalizedRegion.lo.y = -(((Real)(screenRegion->hi.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
-		normalizedRegion.hi.x = ((Real)(screenRegion->hi.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
-		normalizedRegion.hi.y = -(((Real)(screenRegion->lo.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
+		if( info->callback( draw, info->userData ) )
+			++info->count;
 
 	}  // end if
 
+}  // end iterateScreenRegionDrawable
 
-	Drawable *onlyDrawableToTest = NULL;
-	if (regionIsPoint)
-	{
-		// Allow all drawables to be picked.
-		onlyDrawableToTest = pickDrawable(&screenRegion->lo, TRUE, (PickType) getPickTypesForContext(TheInGameUI->isInForceAttackMode()));
-		if (onlyDrawableToTest == NULL) {
-			return 0;
-		}
-	}
+//-------------------------------------------------------------------------------------------------
+/** Find the world box that holds everything that could project into the screen region.  The
+	* part of the view frustum behind the screen region, cut by the lowest and highest z any
+	* drawable has been at, is the hull of the corner pick rays hitting those two heights.
+	* Returns FALSE if some corner ray never reaches one of the heights, in which case the
+	* caller has to consider every drawable. */
+//-------------------------------------------------------------------------------------------------
+Bool W3DView::getScreenRegionWorldBounds( const IRegion2D *screenRegion, Region3D *worldRegion )
+{
+	Real height[ 2 ];
+	TheGameClient->getDrawableHeightRange( &height[ 0 ], &height[ 1 ] );
+
+	ICoord2D corner[ 4 ];
+	corner[ 0 ].x = screenRegion->lo.x;  corner[ 0 ].y = screenRegion->lo.y;
+	corner[ 1 ].x = screenRegion->hi.x;  corner[ 1 ].y = screenRegion->lo.y;
+	corner[ 2 ].x = screenRegion->hi.x;  corner[ 2 ].y = screenRegion->hi.y;
+	corner[ 3 ].x = screenRegion->lo.x;  corner[ 3 ].y = screenRegion->hi.y;
 
-	for( draw = TheGameClient->firstDrawable();
-			 draw;
-			 draw = draw->getNextDrawable() )
+	Bool first = TRUE;
+	for( Int i = 0; i < 4; ++i )
 	{
-		if (onlyDrawableToTest)
-		{
-		 draw = onlyDrawableToTest;
-		 inside = TRUE;
-		}
-		else
-		{
+		Vector3 rayStart, rayEnd;
+		getPickRay( &corner[ i ], &rayStart, &rayEnd );
+
+		Real dz = rayEnd.Z - rayStart.Z;
+		if( fabs( dz ) < 0.0001f )
+			return FALSE;
 
-			// not inside	
-			inside = FALSE;
+		for( Int j = 0; j < 2; ++j )
+		{
+			Real t = (height[ j ] - rayStart.Z) / dz;
+			if( t < 0.0f )
+				return FALSE;
 
-			// no screen region, means all drawbles
-			if( screenRegion == NULL )
-				inside = TRUE;
+			Real x = rayStart.X + t * (rayEnd.X - rayStart.X);
+			Real y = rayStart.Y + t * (rayEnd.Y - rayStart.Y);
+			if( first )
+			{
+				worldRegion->lo.x = worldRegion->hi.x = x;
+				worldRegion->lo.y = worldRegion->hi.y = y;
+				first = FALSE;
+			}
 			else
 			{
+				if( x < worldRegion->lo.x )
+					worldRegion->lo.x = x;
+				if( y < worldRegion->lo.y )
+					worldRegion->lo.y = y;
+				if( x > worldRegion->hi.x )
+					worldRegion->hi.x = x;
+				if( y > worldRegion->hi.y )
+					worldRegion->hi.y = y;
+			}
 
-				// project the center of the drawable to the screen
-				/// @todo use a real 3D position in the drawable
-				pos = *draw->getPosition();
-				world.X = pos.x;
-				world.Y = pos.y;
-				world.Z = pos.z;
-
-				// project the world point to the screen
-				if( m_3DCamera->Project( screen, world ) == CameraClass::INSIDE_FRUSTUM &&
-						screen.X >= normalizedRegion.lo.x && 
-						screen.X <= normalizedRegion.hi.x &&
-						screen.Y >= normalizedRegion.lo.y && 
-						screen.Y <= normalizedRegion.hi.y )
-				{
+		}  // end for j
 
-					inside = TRUE;
+	}  // end for i
 
-				}  // end if
-			}
-	
-		}  //end else
+	// a little slop so float error at the edges can't lose anything
+	const Real slop = 1.0f;
+	worldRegion->lo.x -= slop;
+	worldRegion->lo.y -= slop;
+	worldRegion->lo.z = height[ 0 ] - slop;
+	worldRegion->hi.x += slop;
+	worldRegion->hi.y += slop;
+	worldRegion->hi.z = height[ 1 ] + slop;
 
-		// if inside do the callback and count up
-		if( inside )
-		{
-			
+	return TRUE;
+
+}  // end getScreenRegionWorldBounds
+
+//-------------------------------------------------------------------------------------------------
+/** all the drawables in the view, that fall within the 2D screen region
+	* will call the callback function.  The number of drawables that passed
+	* the test are returned.
+	Screen coordinates assumed in absolute values relative to full display resolution. */
+//-------------------------------------------------------------------------------------------------
+Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
+																			 Bool (*callback)( Drawable *draw, void *userData ),
+																			 void *userData )
+{
+	Int count = 0;
+	Drawable *draw;
+
+	// no screen region, means all drawbles
+	if( screenRegion == NULL )
+	{
+
+		for( draw = TheGameClient->firstDrawable(); draw; draw = draw->getNextDrawable() )
 			if( callback( draw, userData ) )
 				++count;
 
-		}  // end if
+		return count;
 
-		// If onlyDrawableToTest, then we should bail out now.
-		if (onlyDrawableToTest != NULL)
-			break;
+	}  // end if
 
-	}  // end for draw
+	// a point is a pick, which the scene can answer with a ray cast
+	if (screenRegion->height() == 0 && screenRegion->width() == 0)
+	{
+		// Allow all drawables to be picked.
+		draw = pickDrawable(&screenRegion->lo, TRUE, (PickType) getPickTypesForContext(TheInGameUI->isInForceAttackMode()));
+		if (draw && callback( draw, userData ))
+			++count;
+
+		return count;
+	}
+
+	//
+	// to do this we are projecting the drawable centers onto the screen,
+	// the W3D camera->project method is used to do this and that method
+	// will return normalized screen coords from (-1,-1) bottom left to 
+	// (1,1) top right, normalize our screen region for comparison
+	//
+	/// @todo use fast int->real type casts here later
+	ScreenRegionIterateInfo info;
+	info.camera = m_3DCamera;
+	info.callback = callback;
+	info.userData = userData;
+	info.count = 0;
+	info.normalizedRegion.lo.x = ((Real)(screenRegion->lo.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
+	info.normalizedRegion.lo.y = -(((Real)(screenRegion->hi.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
+	info.normalizedRegion.hi.x = ((Real)(screenRegion->hi.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
+	info.normalizedRegion.hi.y = -(((Real)(screenRegion->lo.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
+
+	//
+	// only project the drawables the client grid has near the part of the world under the
+	// screen region, if we can't bound that part of the world project them all
+	//
+	Region3D worldRegion;
+	if( getScreenRegionWorldBounds( screenRegion, &worldRegion ) )
+		TheGameClient->iterateDrawablesInRegion( &worldRegion, iterateScreenRegionDrawable, &info );
+	else
+		TheGameClient->iterateDrawablesInRegion( NULL, iterateScreenRegionDrawable, &info );
 
-	return count;
+	return info.count;
 
 }  // end iterateDrawablesInRegion
 
@@ -154,27 +154,15 @@ Bool W3DTerrainLogic::loadMap( AsciiString filename , Bool query )
 	if (terrainHeightMap)
 	{	//copy loaded data
 		// Get the whole map, because we don't know which boundary is active yet
-		m_mapDX=terrainHeightMap->getXExtent();
-		m_mapDY=terrainHeightMap->getYExtent();
+		initMapHeights(terrainHeightMap->getDataPtr(), terrainHeightMap->getXExtent(), 
+			terrainHeightMap->getYExtent(), terrainHeightMap->getBorderSize());
 
 		// now, get all the boudnaries, and set the current active boundary to boundary 0.
 		m_boundaries = terrainHeightMap->getAllBoundaries();
 		m_activeBoundary = 0;
 
-		Int i, j, minHt, maxHt;
-
-		minHt = terrainHeightMap->getMaxHeightValue();
-		maxHt = 0;
-
-		for (j=0; j<m_mapDY; j++) {
-			for (i=0; i<m_mapDX; i++) {
-				Short cur = terrainHeightMap->getHeight(i,j);
-				if (cur<minHt) minHt = cur;
-				if (maxHt<cur) maxHt = cur;
-			}
-		}
-		m_mapMinZ = minHt * MAP_HEIGHT_SCALE;
-		m_mapMaxZ = maxHt * MAP_HEIGHT_SCALE;
+		m_mapMinZ = m_mapMinHeight * MAP_HEIGHT_SCALE;
+		m_mapMaxZ = m_mapMaxHeight * MAP_HEIGHT_SCALE;
 		//release temporary object used for loading height values
 		REF_PTR_RELEASE(terrainHeightMap);
 	}
@@ -254,71 +242,19 @@ void W3DTerrainLogic::getExtentIncludingBorder( Region3D *extent ) const
 	extent->lo.x = 0.0f;
 	extent->lo.y = 0.0f;
 
-	Real border = TheTerrainRenderObject->getMap()->getBorderSize() * MAP_XY_FACTOR;
+	Real border = m_mapBorderSize * MAP_XY_FACTOR;
 	extent->lo.x -= border;
 	extent->lo.y -= border;
 	extent->hi.x = (m_mapDX * MAP_XY_FACTOR)-border;
 	extent->hi.y = (m_mapDY * MAP_XY_FACTOR)-border;
 }
 
-//-------------------------------------------------------------------------------------------------
-Bool W3DTerrainLogic::isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const
-{
-	if (TheTerrainRenderObject) 
-	{
-		return TheTerrainRenderObject->isClearLineOfSight(pos, posOther);
-	}	
-	else
-	{
-		return false;
-	}
-}
-
-//-------------------------------------------------------------------------------------------------
-/** W3D specific get height function for logical terrain */
-//-------------------------------------------------------------------------------------------------
-Real W3DTerrainLogic::getGroundHeight( Real x, Real y, Coord3D* normal ) const
-{
-#define USE_THE_TERRAIN_OBJECT
-#ifdef USE_THE_TERRAIN_OBJECT
-	if (TheTerrainRenderObject) 
-	{
-		return TheTerrainRenderObject->getHeightMapHeight(x,y,normal);
-	}	
-	else 
-	{
-		if (normal)
-		{	
-			//return a default normal pointing up
-			normal->x=0.0f;
-			normal->y=0.0f;
-			normal->z=1.0f;
-		}
-		return 0;
-	}
-#endif
-}  // end getHight
-
 //-------------------------------------------------------------------------------------------------
 /** Get the height considering the layer. */
 //-------------------------------------------------------------------------------------------------
 Real W3DTerrainLogic::getLayerHeight( Real x, Real y, PathfindLayerEnum layer, Coord3D* normal, Bool clip ) const
 {
-#ifdef USE_THE_TERRAIN_OBJECT
-
-	if (!TheTerrainRenderObject)
-	{
-		if (normal)
-		{	
-			//return a default normal pointing up
-			normal->x=0.0f;
-			normal->y=0.0f;
-			normal->z=1.0f;
-		}
-		return 0;
-	}
-
-	Real height = TheTerrainRenderObject->getHeightMapHeight(x,y,normal);
+	Real height = getGroundHeight(x,y,normal);
 
 	if (layer != LAYER_GROUND) 
 	{
@@ -350,7 +286,6 @@ Real W3DTerrainLogic::getLayerHeight( Real x, Real y, PathfindLayerEnum layer, C
 
 	return height;
 
-#endif
 }  // end getLayerHeight
 
 //-------------------------------------------------------------------------------------------------
@@ -38,7 +38,11 @@
 // Win32BIGFile::Win32BIGFile
 //============================================================================
 
-Win32BIGFile::Win32BIGFile()
+Win32BIGFile::Win32BIGFile() :
+	m_fileHandle(INVALID_HANDLE_VALUE),
+	m_mappingHandle(NULL),
+	m_mappedData(NULL),
+	m_mappedSize(0)
 {
 
 }
@@ -49,7 +53,67 @@ Win32BIGFile::Win32BIGFile()
 
 Win32BIGFile::~Win32BIGFile()
 {
+	unmapFromMemory();
+}
+
+//============================================================================
+// Win32BIGFile::mapIntoMemory
+//============================================================================
+
+Bool Win32BIGFile::mapIntoMemory( const Char *path )
+{
+	DEBUG_ASSERTCRASH(m_mappedData == NULL, ("BIG file %s is already mapped", path));
+	if (m_mappedData != NULL) {
+		return TRUE;
+	}
+
+	m_fileHandle = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) {
+		return FALSE;
+	}
 
+	DWORD sizeHigh = 0;
+	DWORD sizeLow = GetFileSize(m_fileHandle, &sizeHigh);
+	if (sizeLow == INVALID_FILE_SIZE || sizeHigh != 0 || sizeLow == 0 || sizeLow > 0x7fffffff) {
+		unmapFromMemory();
+		return FALSE;
+	}
+
+	m_mappingHandle = CreateFileMapping(m_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_mappingHandle == NULL) {
+		unmapFromMemory();
+		return FALSE;
+	}
+
+	m_mappedData = (const Char *)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (m_mappedData == NULL) {
+		unmapFromMemory();
+		return FALSE;
+	}
+
+	m_mappedSize = (Int)sizeLow;
+	return TRUE;
+}
+
+//============================================================================
+// Win32BIGFile::unmapFromMemory
+//============================================================================
+
+void Win32BIGFile::unmapFromMemory( void )
+{
+	if (m_mappedData != NULL) {
+		UnmapViewOfFile(m_mappedData);
+		m_mappedData = NULL;
+	}
+	if (m_mappingHandle != NULL) {
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = NULL;
+	}
+	if (m_fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+	m_mappedSize = 0;
 }
 
 //============================================================================
@@ -64,7 +128,30 @@ File* Win32BIGFile::openFile( const Char *filename, Int access )
 		return NULL;
 	}
 
+	return openArchivedFile(fileInfo, filename, access);
+}
+
+//============================================================================
+// Win32BIGFile::openArchivedFile
+//============================================================================
+
+File* Win32BIGFile::openArchivedFile( const ArchivedFileInfo *fileInfo, const Char *filename, Int access ) 
+{
 	RAMFile *ramFile = NULL;
+
+	// read only access to a mapped archive hands out a view of the mapping; nothing is read or copied
+	// until the pages are actually touched.
+	if (m_mappedData != NULL && !BitTest(access, File::STREAMING) && (access & File::WRITE) == 0
+			&& fileInfo->m_offset >= 0 && fileInfo->m_size >= 0 && fileInfo->m_offset <= m_mappedSize - fileInfo->m_size) {
+		ramFile = newInstance( RAMFile );
+		ramFile->deleteOnClose();
+		if (ramFile->openFromMemory(m_mappedData + fileInfo->m_offset, fileInfo->m_filename, fileInfo->m_size) == FALSE) {
+			ramFile->close();
+			ramFile = NULL;
+			return NULL;
+		}
+		return ramFile;
+	}
 	
 	if (BitTest(access, File::STREAMING)) 
 		ramFile = newInstance( StreamingArchiveFile );
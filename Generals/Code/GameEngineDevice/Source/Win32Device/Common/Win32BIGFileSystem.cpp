@@ -34,6 +34,7 @@
 #include "Common/GameAudio.h"
 #include "Common/GameMemory.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/Registry.h"
 #include "Win32Device/Common/Win32BIGFile.h"
 #include "Win32Device/Common/Win32BIGFileSystem.h"
 
@@ -45,7 +46,14 @@
 
 static const char *BIGFileIdentifier = "BIGF";
 
-Win32BIGFileSystem::Win32BIGFileSystem() : ArchiveFileSystem() {
+// BIG files are mapped into our (32 bit) address space rather than copied out file by file.  Keep
+// the total well clear of what the rest of the game needs; archives past the budget use the old read path.
+// The budget can be changed with the MappedArchiveMB registry value (it has to be read before the
+// command line is, since the archives are opened first).
+static const Int DEFAULT_MAPPED_BIG_FILE_MB = 768;
+static const Int MAX_MAPPED_BIG_FILE_MB = 1536;
+
+Win32BIGFileSystem::Win32BIGFileSystem() : ArchiveFileSystem(), m_mappedBytes(0), m_mappedBytesLimit(DEFAULT_MAPPED_BIG_FILE_MB * 1024 * 1024) {
 }
 
 Win32BIGFileSystem::~Win32BIGFileSystem() {
@@ -57,6 +65,15 @@ void Win32BIGFileSystem::init() {
 		return;
 	}
 
+	UnsignedInt mappedMB = DEFAULT_MAPPED_BIG_FILE_MB;
+	if (GetUnsignedIntFromRegistry("", "MappedArchiveMB", mappedMB)) {
+		if (mappedMB > MAX_MAPPED_BIG_FILE_MB) {
+			mappedMB = MAX_MAPPED_BIG_FILE_MB;
+		}
+		DEBUG_LOG(("Win32BIGFileSystem::init - mapping at most %d MB of BIG files\n", mappedMB));
+	}
+	m_mappedBytesLimit = (Int)mappedMB * 1024 * 1024;
+
 	loadBigFilesFromDirectory("", "*.big");
 }
 
@@ -166,6 +183,25 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 	delete fileInfo;
 	fileInfo = NULL;
 
+	// music can be closed out from under us (see closeArchiveFile) and is streamed anyway, so
+	// only map the archives that stay open for the life of the game.
+	if (stricmp(filename, MUSIC_BIG) != 0 && archiveFileSize > 0 && archiveFileSize <= m_mappedBytesLimit - m_mappedBytes) {
+		Win32BIGFile *bigFile = (Win32BIGFile *)archiveFile;
+		if (bigFile->mapIntoMemory(filename) && bigFile->getMappedSize() > m_mappedBytesLimit - m_mappedBytes) {
+			// the header lied about the size; don't let it blow the budget.
+			bigFile->unmapFromMemory();
+		}
+		if (bigFile->getMappedSize() > 0) {
+			m_mappedBytes += bigFile->getMappedSize();
+			DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - mapped %s, %d bytes mapped in total\n", filename, m_mappedBytes));
+		} else {
+			// most likely we're out of contiguous address space, and later archives won't fare any
+			// better, so stop trying and read everything from here on through the file handle.
+			DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - could not map %s, reading it and any later archives instead\n", filename));
+			m_mappedBytesLimit = m_mappedBytes;
+		}
+	}
+
 	// leave fp open as the archive file will be using it.
 
 	return archiveFile;
@@ -187,6 +223,9 @@ void Win32BIGFileSystem::closeArchiveFile(const Char *filename) {
 	DEBUG_ASSERTCRASH(stricmp(filename, MUSIC_BIG) == 0, ("Attempting to close Archive file '%s', need to add code to handle its shutdown correctly.", filename));
 
 	// may need to do some other processing here first.
+	removeFromPathIndex(it->second);
+
+	m_mappedBytes -= ((Win32BIGFile *)it->second)->getMappedSize();
 	
 	delete (it->second);
 	m_archiveFileMap.erase(it);
@@ -0,0 +1,204 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "spherearray.h"
+#include "frustum.h"
+#include "wwdebug.h"
+#include <string.h>
+
+/*
+** The SSE kernel needs a compiler that knows the SSE intrinsics: the Intel compiler (as
+** vp.cpp assumes), VC7 or later, or VC6 with the Processor Pack if SPHERE_ARRAY_SSE is
+** defined.  It is only used when CPUDetectClass says the processor has SSE.
+*/
+#if defined(__ICL) || (defined(_MSC_VER) && _MSC_VER >= 1300) || defined(SPHERE_ARRAY_SSE)
+#define SPHERE_ARRAY_USE_SSE
+#include <xmmintrin.h>
+#include "cpudetect.h"
+#endif
+
+
+SphereArrayClass::SphereArrayClass(void) :
+	X(NULL),
+	Y(NULL),
+	Z(NULL),
+	Radius(NULL),
+	Count(0),
+	Capacity(0)
+{
+}
+
+SphereArrayClass::~SphereArrayClass(void)
+{
+	delete [] X;
+	delete [] Y;
+	delete [] Z;
+	delete [] Radius;
+}
+
+void SphereArrayClass::Grow(int min_capacity)
+{
+	int new_capacity = (Capacity > 0) ? Capacity * 2 : 256;
+	while (new_capacity < min_capacity) {
+		new_capacity *= 2;
+	}
+
+	float * new_x = new float[new_capacity];
+	float * new_y = new float[new_capacity];
+	float * new_z = new float[new_capacity];
+	float * new_radius = new float[new_capacity];
+	if (Count > 0) {
+		memcpy(new_x,X,Count * sizeof(float));
+		memcpy(new_y,Y,Count * sizeof(float));
+		memcpy(new_z,Z,Count * sizeof(float));
+		memcpy(new_radius,Radius,Count * sizeof(float));
+	}
+	delete [] X;
+	delete [] Y;
+	delete [] Z;
+	delete [] Radius;
+	X = new_x;
+	Y = new_y;
+	Z = new_z;
+	Radius = new_radius;
+	Capacity = new_capacity;
+}
+
+/*
+** SphereArrayClass::Add
+** Append a sphere to the array and return its index.
+*/
+int SphereArrayClass::Add(const SphereClass & sphere)
+{
+	if (Count >= Capacity) {
+		Grow(Count + 1);
+	}
+	X[Count] = sphere.Center.X;
+	Y[Count] = sphere.Center.Y;
+	Z[Count] = sphere.Center.Z;
+	Radius[Count] = sphere.Radius;
+	return Count++;
+}
+
+/*
+** SphereArrayClass::Set
+** Overwrite the sphere at index, which must be below Get_Count().
+*/
+void SphereArrayClass::Set(int index,const SphereClass & sphere)
+{
+	WWASSERT(index >= 0 && index < Count);
+	X[index] = sphere.Center.X;
+	Y[index] = sphere.Center.Y;
+	Z[index] = sphere.Center.Z;
+	Radius[index] = sphere.Radius;
+}
+
+/*
+** SphereArrayClass::Set_Count
+** Grow or shrink the array.  The spheres below the new count are kept, and the storage is
+** never given back, so shrinking and growing again costs nothing.
+*/
+void SphereArrayClass::Set_Count(int count)
+{
+	if (count > Capacity) {
+		Grow(count);
+	}
+	Count = count;
+}
+
+/*
+** SphereArrayClass::Cull
+** Write the indices of the spheres which are not outside the frustum into visible_indices
+** and return how many there are.  A sphere is outside if it is entirely in front of any
+** one of the six frustum planes, the same test as CollisionMath::Overlap_Test(frustum,sphere).
+** Spheres are done four at a time with no early out, so the inner loop has no branches
+** and works straight down the packed arrays.
+*/
+int SphereArrayClass::Cull(const FrustumClass & frustum,int * visible_indices) const
+{
+	float nx[6],ny[6],nz[6],d[6];
+	int p;
+	for (p = 0; p < 6; p++) {
+		nx[p] = frustum.Planes[p].N.X;
+		ny[p] = frustum.Planes[p].N.Y;
+		nz[p] = frustum.Planes[p].N.Z;
+		d[p] = frustum.Planes[p].D;
+	}
+
+	int visible_count = 0;
+	int i = 0;
+
+#ifdef SPHERE_ARRAY_USE_SSE
+	if (CPUDetectClass::Has_SSE_Instruction_Set()) {
+		for (; i + 4 <= Count; i += 4) {
+			__m128 x = _mm_loadu_ps(X + i);
+			__m128 y = _mm_loadu_ps(Y + i);
+			__m128 z = _mm_loadu_ps(Z + i);
+			__m128 r = _mm_loadu_ps(Radius + i);
+			__m128 out = _mm_setzero_ps();
+			for (p = 0; p < 6; p++) {
+				__m128 dist = _mm_add_ps(_mm_mul_ps(x,_mm_set1_ps(nx[p])),_mm_mul_ps(y,_mm_set1_ps(ny[p])));
+				dist = _mm_add_ps(dist,_mm_mul_ps(z,_mm_set1_ps(nz[p])));
+				dist = _mm_sub_ps(dist,_mm_set1_ps(d[p]));
+				out = _mm_or_ps(out,_mm_cmpgt_ps(dist,r));
+			}
+			int mask = _mm_movemask_ps(out);
+			visible_indices[visible_count] = i+0;
+			visible_count += !(mask & 1);
+			visible_indices[visible_count] = i+1;
+			visible_count += !(mask & 2);
+			visible_indices[visible_count] = i+2;
+			visible_count += !(mask & 4);
+			visible_indices[visible_count] = i+3;
+			visible_count += !(mask & 8);
+		}
+	}
+#endif
+
+	for (; i + 4 <= Count; i += 4) {
+		int out0 = 0;
+		int out1 = 0;
+		int out2 = 0;
+		int out3 = 0;
+		for (p = 0; p < 6; p++) {
+			out0 |= (X[i+0]*nx[p] + Y[i+0]*ny[p] + Z[i+0]*nz[p] - d[p]) > Radius[i+0];
+			out1 |= (X[i+1]*nx[p] + Y[i+1]*ny[p] + Z[i+1]*nz[p] - d[p]) > Radius[i+1];
+			out2 |= (X[i+2]*nx[p] + Y[i+2]*ny[p] + Z[i+2]*nz[p] - d[p]) > Radius[i+2];
+			out3 |= (X[i+3]*nx[p] + Y[i+3]*ny[p] + Z[i+3]*nz[p] - d[p]) > Radius[i+3];
+		}
+		visible_indices[visible_count] = i+0;
+		visible_count += !out0;
+		visible_indices[visible_count] = i+1;
+		visible_count += !out1;
+		visible_indices[visible_count] = i+2;
+		visible_count += !out2;
+		visible_indices[visible_count] = i+3;
+		visible_count += !out3;
+	}
+
+	for (; i < Count; i++) {
+		int out = 0;
+		for (p = 0; p < 6; p++) {
+			out |= (X[i]*nx[p] + Y[i]*ny[p] + Z[i]*nz[p] - d[p]) > Radius[i];
+		}
+		visible_indices[visible_count] = i;
+		visible_count += !out;
+	}
+
+	return visible_count;
+}
@@ -0,0 +1,73 @@
+/*
+**	Command & Conquer Generals(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef SPHEREARRAY_H
+#define SPHEREARRAY_H
+
+#include "sphere.h"
+
+class FrustumClass;
+
+
+/*
+** SphereArrayClass
+** A packed array of bounding spheres, stored as separate X, Y, Z and Radius arrays so
+** that a whole batch of spheres can be culled against a frustum four at a time without
+** touching the objects they came from.  Cull gives the same answers as
+** CollisionMath::Overlap_Test(frustum,sphere) == OUTSIDE does for each sphere.  The
+** storage is kept when the count shrinks, so an owner can keep one sphere per slot
+** for as long as it likes and just overwrite the ones that change.
+*/
+class SphereArrayClass
+{
+public:
+	SphereArrayClass(void);
+	~SphereArrayClass(void);
+
+	void				Reset(void)									{ Count = 0; }
+	int				Add(const SphereClass & sphere);
+	void				Set(int index,const SphereClass & sphere);
+	void				Set_Count(int count);				// new slots are left unset
+	int				Get_Count(void) const					{ return Count; }
+
+	// Writes the indices of the spheres that are not completely outside the frustum into
+	// visible_indices (which must have room for Get_Count() entries), in increasing order.
+	// Returns the number of indices written.
+	int				Cull(const FrustumClass & frustum,int * visible_indices) const;
+
+private:
+	void				Grow(int min_capacity);
+
+	float *			X;
+	float *			Y;
+	float *			Z;
+	float *			Radius;
+	int				Count;
+	int				Capacity;
+
+	// not implemented
+	SphereArrayClass(const SphereArrayClass &);
+	SphereArrayClass & operator = (const SphereArrayClass &);
+};
+
+
+#endif
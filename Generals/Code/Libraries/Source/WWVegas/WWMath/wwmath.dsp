@@ -253,6 +253,10 @@ SOURCE=.\quat.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\spherearray.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\tcbspline.cpp
 # End Source File
 # Begin Source File
@@ -405,6 +409,10 @@ SOURCE=.\sphere.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\spherearray.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\tcbspline.h
 # End Source File
 # Begin Source File
@@ -1033,6 +1033,12 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 	#endif
 	#if defined(_DEBUG) || defined(_INTERNAL)
 		TheMemoryPoolFactory->memoryPoolUsageReport("AAAMemStats");
+		{
+			MemoryPoolLockStats lockStats;
+			TheMemoryPoolFactory->getLockStats(lockStats);
+			DEBUG_LOG(("MemoryPool locks: %d locked allocs, %d locked frees, %d magazine allocs, %d magazine frees, %d dma locks\n",
+				lockStats.lockedAllocs, lockStats.lockedFrees, lockStats.magazineAllocs, lockStats.magazineFrees, lockStats.dmaLocks));
+		}
 	#endif
 
 		// close the log